@@ -27,6 +27,7 @@
 #include "HandleStatement.hpp"
 #include "ObjectBridge.hpp"
 #include "UnsafeData.hpp"
+#include <cstring>
 
 CPPError WCDBHandleStatementGetError(CPPHandleStatement handleStatement)
 {
@@ -95,6 +96,226 @@ bool WCDBHandleStatementIsDone(CPPHandleStatement handleStatement)
     return cppHandleStatement->done();
 }
 
+static WCDBColumnValueType WCDBGetColumnValueType(WCDB::Syntax::ColumnType type)
+{
+    switch (type) {
+    case WCDB::Syntax::ColumnType::Integer:
+        return WCDBColumnValueTypeInterger;
+    case WCDB::Syntax::ColumnType::Float:
+        return WCDBColumnValueTypeFloat;
+    case WCDB::Syntax::ColumnType::BLOB:
+        return WCDBColumnValueTypeBLOB;
+    case WCDB::Syntax::ColumnType::Text:
+        return WCDBColumnValueTypeString;
+    case WCDB::Syntax::ColumnType::Null:
+        return WCDBColumnValueTypeNull;
+    }
+}
+
+static bool
+WCDBHandleStatementReadRow(WCDB::HandleStatement* cppHandleStatement, CPPHandleStatementBatch* batch)
+{
+    int offset = batch->rowCount * batch->columnCount;
+    unsigned int bufferUsed = batch->bufferUsed;
+    for (int i = 0; i < batch->columnCount; ++i) {
+        WCDBColumnValueType type = WCDBGetColumnValueType(cppHandleStatement->getType(i));
+        CPPBatchValue& value = batch->values[offset + i];
+        batch->types[offset + i] = type;
+        switch (type) {
+        case WCDBColumnValueTypeInterger:
+            value.intValue = cppHandleStatement->getInteger(i);
+            break;
+        case WCDBColumnValueTypeFloat:
+            value.doubleValue = cppHandleStatement->getDouble(i);
+            break;
+        case WCDBColumnValueTypeString:
+        case WCDBColumnValueTypeBLOB: {
+            const void* bytes;
+            size_t length;
+            if (type == WCDBColumnValueTypeString) {
+                WCDB::UnsafeStringView text = cppHandleStatement->getText(i);
+                bytes = text.data();
+                length = text.length();
+            } else {
+                const WCDB::UnsafeData blob = cppHandleStatement->getBLOB(i);
+                bytes = blob.buffer();
+                length = blob.size();
+            }
+            if (length > batch->bufferCapacity - bufferUsed) {
+                unsigned long long required = 0;
+                for (int j = 0; j < batch->columnCount; ++j) {
+                    WCDB::Syntax::ColumnType columnType = cppHandleStatement->getType(j);
+                    if (columnType == WCDB::Syntax::ColumnType::Text
+                        || columnType == WCDB::Syntax::ColumnType::BLOB) {
+                        required += cppHandleStatement->getColumnSize(j);
+                    }
+                }
+                batch->requiredBufferSize = (unsigned int) required;
+                return false;
+            }
+            if (length > 0) {
+                memcpy(batch->buffer + bufferUsed, bytes, length);
+            }
+            value.bytes.offset = bufferUsed;
+            value.bytes.length = (unsigned int) length;
+            bufferUsed += (unsigned int) length;
+        } break;
+        case WCDBColumnValueTypeNull:
+            value.intValue = 0;
+            break;
+        }
+    }
+    batch->bufferUsed = bufferUsed;
+    return true;
+}
+
+bool WCDBHandleStatementStepBatch(CPPHandleStatement handleStatement, CPPHandleStatementBatch* batch)
+{
+    WCDBGetObjectOrReturnValue(
+    handleStatement, WCDB::HandleStatement, cppHandleStatement, false);
+    batch->rowCount = 0;
+    batch->bufferUsed = 0;
+    batch->requiredBufferSize = 0;
+    while (batch->rowCount < batch->rowCapacity) {
+        if (!batch->hasPendingRow) {
+            if (!cppHandleStatement->step()) {
+                return false;
+            }
+            if (cppHandleStatement->done()) {
+                break;
+            }
+        }
+        batch->hasPendingRow = !WCDBHandleStatementReadRow(cppHandleStatement, batch);
+        if (batch->hasPendingRow) {
+            break;
+        }
+        ++batch->rowCount;
+    }
+    return true;
+}
+
+static void WCDBHandleStatementNotifyMisuse(WCDB::HandleStatement* cppHandleStatement,
+                                            const WCDB::UnsafeStringView& message)
+{
+    WCDB::AbstractHandle* cppHandle = cppHandleStatement->getHandle();
+    if (cppHandle != nullptr) {
+        cppHandle->notifyError(WCDB::Error::Code::Misuse, WCDB::UnsafeStringView(), message);
+    }
+}
+
+void WCDBHandleStatementNotifyBatchMisuse(CPPHandleStatement handleStatement,
+                                          const char* _Nonnull message)
+{
+    WCDBGetObjectOrReturn(handleStatement, WCDB::HandleStatement, cppHandleStatement);
+    WCDBHandleStatementNotifyMisuse(cppHandleStatement, message);
+}
+
+// The batch may be written by the caller in another language, so it is checked before any of its bytes is read.
+static bool WCDBHandleStatementCheckRow(WCDB::HandleStatement* cppHandleStatement,
+                                        const CPPHandleStatementBatch* batch,
+                                        int row)
+{
+    if (row < 0 || row >= batch->rowCapacity) {
+        WCDBHandleStatementNotifyMisuse(cppHandleStatement, "Row of batch is out of range.");
+        return false;
+    }
+    int offset = row * batch->columnCount;
+    for (int i = 0; i < batch->columnCount; ++i) {
+        switch (batch->types[offset + i]) {
+        case WCDBColumnValueTypeInterger:
+        case WCDBColumnValueTypeFloat:
+        case WCDBColumnValueTypeNull:
+            break;
+        case WCDBColumnValueTypeString:
+        case WCDBColumnValueTypeBLOB: {
+            // Negative offset or length from a signed caller is a huge unsigned one, which is rejected here as well.
+            const CPPBatchValue& value = batch->values[offset + i];
+            unsigned long long end
+            = (unsigned long long) value.bytes.offset + value.bytes.length;
+            if (end > batch->bufferCapacity
+                || (value.bytes.length > 0 && batch->buffer == nullptr)) {
+                WCDBHandleStatementNotifyMisuse(
+                cppHandleStatement, "Bytes of batch value are out of the buffer.");
+                return false;
+            }
+        } break;
+        default:
+            WCDBHandleStatementNotifyMisuse(cppHandleStatement,
+                                            "Type of batch value is invalid.");
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool WCDBHandleStatementBindRow(WCDB::HandleStatement* cppHandleStatement,
+                                      const CPPHandleStatementBatch* batch,
+                                      int row)
+{
+    if (!WCDBHandleStatementCheckRow(cppHandleStatement, batch, row)) {
+        return false;
+    }
+    int offset = row * batch->columnCount;
+    for (int i = 0; i < batch->columnCount; ++i) {
+        const CPPBatchValue& value = batch->values[offset + i];
+        int index = i + 1;
+        switch (batch->types[offset + i]) {
+        case WCDBColumnValueTypeInterger:
+            cppHandleStatement->bindInteger(value.intValue, index);
+            break;
+        case WCDBColumnValueTypeFloat:
+            cppHandleStatement->bindDouble(value.doubleValue, index);
+            break;
+        case WCDBColumnValueTypeString:
+            cppHandleStatement->bindText(
+            WCDB::UnsafeStringView((const char*) batch->buffer + value.bytes.offset,
+                                   value.bytes.length),
+            index);
+            break;
+        case WCDBColumnValueTypeBLOB:
+            cppHandleStatement->bindBLOB(
+            WCDB::UnsafeData::immutable(batch->buffer + value.bytes.offset,
+                                        value.bytes.length),
+            index);
+            break;
+        case WCDBColumnValueTypeNull:
+            cppHandleStatement->bindNull(index);
+            break;
+        }
+    }
+    return true;
+}
+
+bool WCDBHandleStatementBindBatchRow(CPPHandleStatement handleStatement,
+                                     const CPPHandleStatementBatch* batch,
+                                     int row)
+{
+    WCDBGetObjectOrReturnValue(
+    handleStatement, WCDB::HandleStatement, cppHandleStatement, false);
+    return WCDBHandleStatementBindRow(cppHandleStatement, batch, row);
+}
+
+bool WCDBHandleStatementBindAndStepBatch(CPPHandleStatement handleStatement,
+                                         CPPHandleStatementBatch* batch)
+{
+    WCDBGetObjectOrReturnValue(
+    handleStatement, WCDB::HandleStatement, cppHandleStatement, false);
+    int rowCount = batch->rowCount;
+    batch->rowCount = 0;
+    for (int row = 0; row < rowCount; ++row) {
+        if (!WCDBHandleStatementBindRow(cppHandleStatement, batch, row)) {
+            return false;
+        }
+        bool succeed = cppHandleStatement->step();
+        cppHandleStatement->reset();
+        if (!succeed) {
+            return false;
+        }
+        ++batch->rowCount;
+    }
+    return true;
+}
+
 void WCDBHandleStatementBindInteger(CPPHandleStatement handleStatement,
                                     int index,
                                     signed long long intValue)
@@ -153,18 +374,7 @@ WCDBHandleStatementGetColumnType(CPPHandleStatement handleStatement, int index)
 {
     WCDBGetObjectOrReturnValue(
     handleStatement, WCDB::HandleStatement, cppHandleStatement, WCDBColumnValueTypeNull);
-    switch (cppHandleStatement->getType(index)) {
-    case WCDB::Syntax::ColumnType::Integer:
-        return WCDBColumnValueTypeInterger;
-    case WCDB::Syntax::ColumnType::Float:
-        return WCDBColumnValueTypeFloat;
-    case WCDB::Syntax::ColumnType::BLOB:
-        return WCDBColumnValueTypeBLOB;
-    case WCDB::Syntax::ColumnType::Text:
-        return WCDBColumnValueTypeString;
-    case WCDB::Syntax::ColumnType::Null:
-        return WCDBColumnValueTypeNull;
-    }
+    return WCDBGetColumnValueType(cppHandleStatement->getType(index));
 }
 
 signed long long WCDBHandleStatementGetInteger(CPPHandleStatement handleStatement, int index)
@@ -39,6 +39,36 @@ enum WCDBColumnValueType {
     WCDBColumnValueTypeNull,
 };
 
+typedef union CPPBatchValue {
+    long long intValue;
+    double doubleValue;
+    // Location of text or blob in the buffer of batch.
+    struct {
+        unsigned int offset;
+        unsigned int length;
+    } bytes;
+} CPPBatchValue;
+
+// A flat, row-major buffer of values provided by the caller, to move many rows across the bridge in one call.
+typedef struct CPPHandleStatementBatch {
+    int columnCount;
+    int rowCapacity;
+    // Both of them should be able to hold `rowCapacity * columnCount` cells.
+    enum WCDBColumnValueType* _Nonnull types;
+    CPPBatchValue* _Nonnull values;
+    // Content of texts and blobs. Texts are not null-terminated.
+    unsigned char* _Nullable buffer;
+    unsigned int bufferCapacity;
+
+    int rowCount;
+    unsigned int bufferUsed;
+    // Set when the current row of statement does not fit in the rest of buffer.
+    // Next call of `WCDBHandleStatementStepBatch` will read it without stepping.
+    bool hasPendingRow;
+    // The buffer size needed by the pending row.
+    unsigned int requiredBufferSize;
+} CPPHandleStatementBatch;
+
 CPPError WCDBHandleStatementGetError(CPPHandleStatement handleStatement);
 
 bool WCDBHandleStatementPrepare(CPPHandleStatement handleStatement,
@@ -52,6 +82,23 @@ void WCDBHandleStatementClearBindings(CPPHandleStatement handleStatement);
 void WCDBHandleStatementFinalize(CPPHandleStatement handleStatement);
 bool WCDBHandleStatementIsDone(CPPHandleStatement handleStatement);
 
+// Step at most `rowCapacity` rows and write their first `columnCount` columns into the batch.
+// It stops early when the statement is done or the buffer is full. `hasPendingRow` should be false for the first call.
+bool WCDBHandleStatementStepBatch(CPPHandleStatement handleStatement,
+                                  CPPHandleStatementBatch* _Nonnull batch);
+// Bind the `row`-th row in batch to the parameters from 1 to `columnCount`.
+// It fails with a misuse error if any type is invalid or any text/blob is out of the buffer, and nothing of the row is bound.
+bool WCDBHandleStatementBindBatchRow(CPPHandleStatement handleStatement,
+                                     const CPPHandleStatementBatch* _Nonnull batch,
+                                     int row);
+// Bind each of the `rowCount` rows in batch to the parameters from 1 to `columnCount`, then step and reset.
+// `rowCount` is set to the number of rows executed successfully.
+bool WCDBHandleStatementBindAndStepBatch(CPPHandleStatement handleStatement,
+                                         CPPHandleStatementBatch* _Nonnull batch);
+// Set a misuse error to the handle when the caller fails to provide a valid batch.
+void WCDBHandleStatementNotifyBatchMisuse(CPPHandleStatement handleStatement,
+                                          const char* _Nonnull message);
+
 void WCDBHandleStatementBindInteger(CPPHandleStatement handleStatement,
                                     int index,
                                     signed long long intValue);
@@ -27,8 +27,10 @@
 #include "CoreConst.h"
 #include "FileManager.hpp"
 #include "Notifier.hpp"
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits>
 #ifndef _WIN32
 #include <sys/mman.h>
 #else
@@ -204,15 +206,14 @@ Data FileHandle::read(size_t size)
     return data.subdata(got + prior);
 }
 
-bool FileHandle::write(const UnsafeData &unsafeData)
+bool FileHandle::write(const UnsafeData &unsafeData, offset_t offset)
 {
     WCTAssert(isOpened());
     ssize_t wrote;
     ssize_t prior = 0;
     size_t size = unsafeData.size();
     const unsigned char *buffer = unsafeData.buffer();
-    offset_t offset = (offset_t) wcdb_lseek(m_fd, 0, SEEK_SET);
-    if (offset != 0) {
+    if ((offset_t) wcdb_lseek(m_fd, offset, SEEK_SET) != offset) {
         setThreadedError();
         return false;
     }
@@ -235,7 +236,10 @@ bool FileHandle::write(const UnsafeData &unsafeData)
         }
     } while (wrote > 0);
     if (wrote + prior == unsafeData.size()) {
-        m_fileSize = unsafeData.size();
+        // A write in the middle does not shrink the file, and the size stays unknown if it is.
+        if (m_fileSize >= 0) {
+            m_fileSize = std::max(m_fileSize, (ssize_t) (offset + unsafeData.size()));
+        }
         return true;
     }
     m_fileSize = -1;
@@ -248,6 +252,23 @@ bool FileHandle::write(const UnsafeData &unsafeData)
     return false;
 }
 
+bool FileHandle::adviseWillNeed(offset_t offset, size_t size)
+{
+    WCTAssert(isOpened());
+#if defined(__APPLE__)
+    struct radvisory advisory;
+    advisory.ra_offset = (off_t) offset;
+    advisory.ra_count = (int) std::min(size, (size_t) std::numeric_limits<int>::max());
+    return fcntl(m_fd, F_RDADVISE, &advisory) != -1;
+#elif defined(__linux__)
+    return posix_fadvise(m_fd, (off_t) offset, (off_t) size, POSIX_FADV_WILLNEED) == 0;
+#else
+    WCDB_UNUSED(offset);
+    WCDB_UNUSED(size);
+    return false;
+#endif
+}
+
 #ifdef _WIN32
 void FileHandle::mapExceptHandler(void **mapped, size_t absoluteOffset)
 {
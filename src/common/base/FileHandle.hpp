@@ -65,7 +65,9 @@ public:
     void close();
     ssize_t size();
     Data read(size_t size);
-    bool write(const UnsafeData &unsafeData);
+    bool write(const UnsafeData &unsafeData, offset_t offset = 0);
+    // Hint the system to read the range into its cache asynchronously. It returns false if the hint is not supported.
+    bool adviseWillNeed(offset_t offset, size_t size);
 
 protected:
     int m_mode;
@@ -68,6 +68,17 @@ public:
         }
     }
 
+    void erase(const Key& key)
+    {
+        auto it = m_map.find(key);
+        if (it == m_map.end()) {
+            return;
+        }
+        willPurge(it->second->first, it->second->second);
+        m_list.erase(it->second);
+        m_map.erase(it);
+    }
+
     const Value& get(const Key& key)
     {
         auto it = m_map.find(key);
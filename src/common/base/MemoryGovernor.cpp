@@ -0,0 +1,298 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryGovernor.hpp"
+#include "Assertion.hpp"
+
+namespace WCDB {
+
+MemoryGovernor& MemoryGovernor::shared()
+{
+    static MemoryGovernor* s_governor = new MemoryGovernor;
+    return *s_governor;
+}
+
+MemoryGovernor::MemoryGovernor()
+: m_global(std::make_shared<Budget>()), m_reliefGeneration(0)
+{
+}
+
+#pragma mark - Component
+const char* MemoryGovernor::componentName(Component component)
+{
+    switch (component) {
+    case Component::PageCache:
+        return "PageCache";
+    case Component::PreparedStatement:
+        return "PreparedStatement";
+    case Component::PagerCache:
+        return "PagerCache";
+    case Component::ZSTDContext:
+        return "ZSTDContext";
+    }
+    return "";
+}
+
+#pragma mark - Quota
+void MemoryGovernor::setQuota(const UnsafeStringView& path, size_t quota)
+{
+    std::shared_ptr<Budget> budget = path.empty() ? m_global : getOrCreateBudget(path);
+    budget->quota.store(quota);
+    checkQuota(path, *budget);
+}
+
+size_t MemoryGovernor::getQuota(const UnsafeStringView& path) const
+{
+    std::shared_ptr<Budget> budget = path.empty() ? m_global : getBudget(path);
+    return budget != nullptr ? budget->quota.load() : 0;
+}
+
+MemoryGovernor::Pressure MemoryGovernor::getPressure(const UnsafeStringView& path) const
+{
+    Pressure pressure = pressureOfBudget(*m_global);
+    if (!path.empty()) {
+        std::shared_ptr<Budget> budget = getBudget(path);
+        if (budget != nullptr) {
+            pressure = std::max(pressure, pressureOfBudget(*budget));
+        }
+    }
+    return pressure;
+}
+
+MemoryGovernor::Pressure MemoryGovernor::pressureOfBudget(const Budget& budget)
+{
+    size_t quota = budget.quota.load();
+    ssize_t current = budget.total.getCurrent();
+    if (quota == 0 || current <= (ssize_t) quota) {
+        return Pressure::None;
+    }
+    if (current <= (ssize_t) quota * 2) {
+        return Pressure::Moderate;
+    }
+    return Pressure::Critical;
+}
+
+#pragma mark - Usage
+MemoryGovernor::Budget::Budget() : quota(0), relieving(false)
+{
+}
+
+MemoryGovernor::Usage::Usage() : current(0), highWater(0)
+{
+}
+
+std::shared_ptr<MemoryGovernor::Budget>
+MemoryGovernor::getBudget(const UnsafeStringView& path) const
+{
+    WCTAssert(!path.empty());
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_budgets.find(path);
+    return iter != m_budgets.end() ? iter->second : nullptr;
+}
+
+std::shared_ptr<MemoryGovernor::Budget>
+MemoryGovernor::getOrCreateBudget(const UnsafeStringView& path)
+{
+    std::shared_ptr<Budget> budget = getBudget(path);
+    if (budget == nullptr) {
+        LockGuard lockGuard(m_lock);
+        auto& created = m_budgets[path];
+        if (created == nullptr) {
+            created = std::make_shared<Budget>();
+        }
+        budget = created;
+    }
+    return budget;
+}
+
+void MemoryGovernor::increase(const UnsafeStringView& path, Component component, size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    int index = (int) component;
+    WCTAssert(index < ComponentCount);
+    m_global->components[index].increase(size);
+    m_global->total.increase(size);
+    if (!path.empty()) {
+        std::shared_ptr<Budget> budget = getOrCreateBudget(path);
+        budget->components[index].increase(size);
+        budget->total.increase(size);
+        checkQuota(path, *budget);
+    }
+    checkQuota(UnsafeStringView(), *m_global);
+}
+
+void MemoryGovernor::decrease(const UnsafeStringView& path, Component component, size_t size)
+{
+    if (size == 0) {
+        return;
+    }
+    int index = (int) component;
+    WCTAssert(index < ComponentCount);
+    m_global->components[index].decrease(size);
+    m_global->total.decrease(size);
+    if (!path.empty()) {
+        std::shared_ptr<Budget> budget = getBudget(path);
+        WCTRemedialAssert(budget != nullptr, "Decrease memory without increase.", return;);
+        budget->components[index].decrease(size);
+        budget->total.decrease(size);
+    }
+}
+
+void MemoryGovernor::update(const UnsafeStringView& path,
+                            Component component,
+                            size_t oldSize,
+                            size_t newSize)
+{
+    if (newSize > oldSize) {
+        increase(path, component, newSize - oldSize);
+    } else if (newSize < oldSize) {
+        decrease(path, component, oldSize - newSize);
+    }
+}
+
+MemoryGovernor::Usage
+MemoryGovernor::getUsage(const UnsafeStringView& path, Component component) const
+{
+    Usage usage;
+    std::shared_ptr<Budget> budget = path.empty() ? m_global : getBudget(path);
+    if (budget != nullptr) {
+        const ShareableHighWater& highWater = budget->components[(int) component];
+        usage.current = highWater.getCurrent();
+        usage.highWater = highWater.getHighWater();
+    }
+    return usage;
+}
+
+MemoryGovernor::Usage MemoryGovernor::getTotalUsage(const UnsafeStringView& path) const
+{
+    Usage usage;
+    std::shared_ptr<Budget> budget = path.empty() ? m_global : getBudget(path);
+    if (budget != nullptr) {
+        usage.current = budget->total.getCurrent();
+        usage.highWater = budget->total.getHighWater();
+    }
+    return usage;
+}
+
+void MemoryGovernor::removeBudget(const UnsafeStringView& path, bool keepingQuota)
+{
+    WCTAssert(!path.empty());
+    LockGuard lockGuard(m_lock);
+    auto iter = m_budgets.find(path);
+    if (iter == m_budgets.end()) {
+        return;
+    }
+    const Budget& budget = *iter->second;
+    if (budget.total.getCurrent() != 0 || (keepingQuota && budget.quota.load() != 0)) {
+        return;
+    }
+    m_budgets.erase(iter);
+}
+
+#pragma mark - Relieve
+void MemoryGovernor::setResponder(const UnsafeStringView& key,
+                                  Pressure pressure,
+                                  const Responder& responder)
+{
+    WCTAssert(pressure != Pressure::None);
+    LockGuard lockGuard(m_responderLock);
+    if (responder != nullptr) {
+        m_responders.insert(StringView(key), responder, pressure);
+    } else {
+        m_responders.erase(StringView(key));
+    }
+}
+
+void MemoryGovernor::setNotificationWhenQuotaExceeded(const QuotaExceededNotification& notification)
+{
+    LockGuard lockGuard(m_responderLock);
+    m_quotaExceededNotification = notification;
+}
+
+void MemoryGovernor::checkQuota(const UnsafeStringView& path, Budget& budget)
+{
+    if (pressureOfBudget(budget) == Pressure::None || budget.relieving.exchange(true)) {
+        return;
+    }
+    QuotaExceededNotification notification;
+    {
+        SharedLockGuard lockGuard(m_responderLock);
+        notification = m_quotaExceededNotification;
+    }
+    if (notification != nullptr) {
+        notification(path);
+    } else {
+        budget.relieving.store(false);
+    }
+}
+
+MemoryGovernor::Pressure MemoryGovernor::relieve(const UnsafeStringView& path)
+{
+    std::shared_ptr<Budget> budget = path.empty() ? m_global : getBudget(path);
+    if (budget == nullptr) {
+        return Pressure::None;
+    }
+    Pressure pressure = pressureOfBudget(*budget);
+    if (pressure != Pressure::None) {
+        // Shrink caches first and finalize handles only if that is not enough.
+        ++m_reliefGeneration;
+        respond(path, Pressure::Moderate);
+        pressure = pressureOfBudget(*budget);
+        if (pressure == Pressure::Critical) {
+            respond(path, Pressure::Critical);
+            pressure = pressureOfBudget(*budget);
+        }
+    }
+    budget->relieving.store(false);
+    return pressure;
+}
+
+void MemoryGovernor::cancelRelief(const UnsafeStringView& path)
+{
+    std::shared_ptr<Budget> budget = path.empty() ? m_global : getBudget(path);
+    if (budget != nullptr) {
+        budget->relieving.store(false);
+    }
+}
+
+void MemoryGovernor::respond(const UnsafeStringView& path, Pressure pressure) const
+{
+    std::list<Responder> responders;
+    {
+        SharedLockGuard lockGuard(m_responderLock);
+        for (const auto& element : m_responders) {
+            if (element.order() == pressure) {
+                responders.push_back(element.value());
+            }
+        }
+    }
+    for (const auto& responder : responders) {
+        responder(path);
+    }
+}
+
+uint32_t MemoryGovernor::getReliefGeneration() const
+{
+    return m_reliefGeneration.load();
+}
+
+} // namespace WCDB
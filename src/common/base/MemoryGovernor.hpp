@@ -0,0 +1,133 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "HighWater.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "UniqueList.hpp"
+#include <array>
+
+namespace WCDB {
+
+/*
+ * Memory governor is the central bookkeeper of the memory WCDB holds on its own.
+ * Usage is recorded per database path and per component.
+ * The empty path stands for the whole process, so that it accumulates the usage of all databases
+ * and also holds the components which are not owned by any database, e.g. the ZSTD contexts.
+ *
+ * When the usage exceeds the quota, responders will be called from the gentle ones to the
+ * aggressive ones until the usage gets back under the quota.
+ */
+class MemoryGovernor final {
+public:
+    static MemoryGovernor& shared();
+
+protected:
+    MemoryGovernor();
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+#pragma mark - Component
+public:
+    enum class Component : unsigned char {
+        PageCache = 0,
+        PreparedStatement,
+        PagerCache,
+        ZSTDContext,
+    };
+    static constexpr const int ComponentCount = 4;
+    static const char* componentName(Component component);
+
+#pragma mark - Quota
+public:
+    enum class Pressure : unsigned char {
+        None = 0,
+        Moderate, // shrink the caches
+        Critical, // finalize the handles
+    };
+
+    // 0 for unlimited.
+    void setQuota(const UnsafeStringView& path, size_t quota);
+    size_t getQuota(const UnsafeStringView& path) const;
+    Pressure getPressure(const UnsafeStringView& path) const;
+
+#pragma mark - Usage
+public:
+    void increase(const UnsafeStringView& path, Component component, size_t size);
+    void decrease(const UnsafeStringView& path, Component component, size_t size);
+    void update(const UnsafeStringView& path, Component component, size_t oldSize, size_t newSize);
+
+    struct Usage {
+        Usage();
+        ssize_t current;
+        ssize_t highWater;
+    };
+    Usage getUsage(const UnsafeStringView& path, Component component) const;
+    Usage getTotalUsage(const UnsafeStringView& path) const;
+
+    // The budget is removed only if nothing is held by it, and the one with quota is kept if keepingQuota is true.
+    void removeBudget(const UnsafeStringView& path, bool keepingQuota);
+
+protected:
+    struct Budget {
+        Budget();
+        std::array<ShareableHighWater, ComponentCount> components;
+        ShareableHighWater total;
+        std::atomic<size_t> quota;
+        std::atomic<bool> relieving;
+    };
+    std::shared_ptr<Budget> getBudget(const UnsafeStringView& path) const;
+    std::shared_ptr<Budget> getOrCreateBudget(const UnsafeStringView& path);
+    static Pressure pressureOfBudget(const Budget& budget);
+
+    mutable SharedLock m_lock;
+    StringViewMap<std::shared_ptr<Budget>> m_budgets;
+    std::shared_ptr<Budget> m_global;
+
+#pragma mark - Relieve
+public:
+    // The responder will be called with the path of database, or empty path for all of them.
+    typedef std::function<void(const UnsafeStringView& path)> Responder;
+    void setResponder(const UnsafeStringView& key, Pressure pressure, const Responder& responder);
+
+    typedef std::function<void(const UnsafeStringView& path)> QuotaExceededNotification;
+    void setNotificationWhenQuotaExceeded(const QuotaExceededNotification& notification);
+
+    // Return the pressure after relief.
+    Pressure relieve(const UnsafeStringView& path);
+    // Call it when the scheduled relief is dropped, so that the next exceeding can schedule a new one.
+    void cancelRelief(const UnsafeStringView& path);
+
+    // It will be increased on every relief so that the cache which can't be reached by responders can shrink itself lazily.
+    uint32_t getReliefGeneration() const;
+
+protected:
+    void checkQuota(const UnsafeStringView& path, Budget& budget);
+    void respond(const UnsafeStringView& path, Pressure pressure) const;
+
+    mutable SharedLock m_responderLock;
+    UniqueList<StringView, Responder, Pressure> m_responders;
+    QuotaExceededNotification m_quotaExceededNotification;
+    std::atomic<uint32_t> m_reliefGeneration;
+};
+
+} // namespace WCDB
@@ -24,6 +24,10 @@
 
 #include "Notifier.hpp"
 #include "Assertion.hpp"
+#include "CoreConst.h"
+#include <algorithm>
+#include <climits>
+#include <list>
 
 namespace WCDB {
 
@@ -33,20 +37,42 @@ Notifier &Notifier::shared()
     return *s_notifier;
 }
 
-Notifier::Notifier() = default;
+Notifier::Notifier()
+: m_minimalLevel(INT_MAX), m_summaryScheduled(false), m_summaryEnabled(false)
+{
+}
 
-void Notifier::setNotification(int order, const UnsafeStringView &key, const Callback &callback)
+void Notifier::setNotification(int order,
+                               const UnsafeStringView &key,
+                               const Callback &callback,
+                               Error::Level minimalLevel)
 {
     WCTAssert(callback != nullptr);
     LockGuard lockGuard(m_lock);
     WCTAssert(m_notifications.find(StringView(key)) == m_notifications.end());
-    m_notifications.insert(StringView(key), callback, order);
+    m_notifications.insert(StringView(key), { callback, minimalLevel }, order);
+    updateMinimalLevel();
 }
 
 void Notifier::unsetNotification(const UnsafeStringView &key)
 {
     LockGuard lockGuard(m_lock);
     m_notifications.erase(StringView(key));
+    updateMinimalLevel();
+}
+
+void Notifier::updateMinimalLevel()
+{
+    int minimalLevel = INT_MAX;
+    for (const auto &element : m_notifications) {
+        minimalLevel = std::min(minimalLevel, (int) element.value().minimalLevel);
+    }
+    m_minimalLevel.store(minimalLevel, std::memory_order_relaxed);
+}
+
+bool Notifier::isNotificationNeeded(Error::Level level) const
+{
+    return (int) level >= m_minimalLevel.load(std::memory_order_relaxed);
 }
 
 void Notifier::setNotificationForPreprocessing(const UnsafeStringView &key,
@@ -67,7 +93,129 @@ void Notifier::notify(Error &error) const
         element.second(error);
     }
     for (const auto &element : m_notifications) {
-        element.value()(error);
+        const Subscription &subscription = element.value();
+        if (error.level >= subscription.minimalLevel) {
+            subscription.callback(error);
+        }
+    }
+}
+
+#pragma mark - Ignorable Error Summary
+Notifier::IgnorableErrorShard &Notifier::getIgnorableErrorShard(const UnsafeStringView &path)
+{
+    return m_ignorableErrorShards[path.hash() % NumberOfIgnorableErrorShards];
+}
+
+bool Notifier::shouldNotifyIgnorableError(const UnsafeStringView &path, int rc)
+{
+    if (!m_summaryEnabled.load(std::memory_order_relaxed)) {
+        // The summary can not be notified.
+        return true;
+    }
+    SteadyClock now = SteadyClock::now();
+    double delay = 0;
+    {
+        IgnorableErrorShard &shard = getIgnorableErrorShard(path);
+        std::lock_guard<std::mutex> lockGuard(shard.lock);
+        auto &records = shard.records[path];
+        auto iter = records.find(rc);
+        if (iter == records.end()) {
+            records[rc].lastNotifiedTime = now;
+            return true;
+        }
+        IgnorableErrorRecord &record = iter->second;
+        double elapsed = now.timeIntervalSinceSteadyClock(record.lastNotifiedTime);
+        if (record.suppressedCount == 0 && elapsed >= ErrorIgnorableSummaryInterval) {
+            record.lastNotifiedTime = now;
+            return true;
+        }
+        ++record.suppressedCount;
+        delay = std::max(ErrorIgnorableSummaryInterval - elapsed, 0.0);
+    }
+    scheduleIgnorableErrorSummaries(delay);
+    return false;
+}
+
+void Notifier::scheduleIgnorableErrorSummaries(double delay)
+{
+    if (m_summaryScheduled.exchange(true)) {
+        return;
+    }
+    SummaryScheduler scheduler;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_summarySchedulerLock);
+        scheduler = m_summaryScheduler;
+    }
+    if (scheduler != nullptr) {
+        scheduler(delay);
+    } else {
+        m_summaryScheduled.store(false);
+    }
+}
+
+void Notifier::notifyIgnorableErrorSummaries()
+{
+    // The errors folded from now on will schedule another round.
+    m_summaryScheduled.store(false);
+    SteadyClock now = SteadyClock::now();
+    std::list<Error> summaries;
+    bool pending = false;
+    double delay = ErrorIgnorableSummaryInterval;
+    for (IgnorableErrorShard &shard : m_ignorableErrorShards) {
+        std::lock_guard<std::mutex> lockGuard(shard.lock);
+        for (auto pathIter = shard.records.begin(); pathIter != shard.records.end();) {
+            auto &records = pathIter->second;
+            for (auto iter = records.begin(); iter != records.end();) {
+                IgnorableErrorRecord &record = iter->second;
+                double elapsed = now.timeIntervalSinceSteadyClock(record.lastNotifiedTime);
+                if (elapsed < ErrorIgnorableSummaryInterval) {
+                    if (record.suppressedCount > 0) {
+                        pending = true;
+                        delay = std::min(delay, ErrorIgnorableSummaryInterval - elapsed);
+                    }
+                    ++iter;
+                    continue;
+                }
+                if (record.suppressedCount > 0) {
+                    Error error;
+                    error.setSQLiteCode(iter->first);
+                    error.level = Error::Level::Ignore;
+                    error.infos.insert_or_assign(ErrorStringKeyPath, pathIter->first);
+                    error.infos.insert_or_assign(ErrorIntKeySuppressedCount,
+                                                 record.suppressedCount);
+                    summaries.push_back(std::move(error));
+                }
+                // The next one will be notified at once, so the record is no longer needed.
+                iter = records.erase(iter);
+            }
+            if (records.empty()) {
+                pathIter = shard.records.erase(pathIter);
+            } else {
+                ++pathIter;
+            }
+        }
+    }
+    for (auto &summary : summaries) {
+        notify(summary);
+    }
+    if (pending) {
+        scheduleIgnorableErrorSummaries(delay);
+    }
+}
+
+void Notifier::setIgnorableErrorSummaryScheduler(const SummaryScheduler &scheduler)
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(m_summarySchedulerLock);
+        m_summaryScheduler = scheduler;
+        m_summaryScheduled.store(false);
+        m_summaryEnabled.store(scheduler != nullptr);
+    }
+    if (scheduler == nullptr) {
+        for (IgnorableErrorShard &shard : m_ignorableErrorShards) {
+            std::lock_guard<std::mutex> lockGuard(shard.lock);
+            shard.records.clear();
+        }
     }
 }
 
@@ -25,8 +25,12 @@
 #pragma once
 
 #include "Lock.hpp"
+#include "Time.hpp"
 #include "UniqueList.hpp"
 #include "WCDBError.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
 
 namespace WCDB {
 
@@ -37,13 +41,32 @@ public:
     void notify(Error &error) const;
 
     typedef std::function<void(const Error &)> Callback;
-    void setNotification(int order, const UnsafeStringView &key, const Callback &callback);
+    // Errors below the minimal level will not be delivered to the callback.
+    void setNotification(int order,
+                         const UnsafeStringView &key,
+                         const Callback &callback,
+                         Error::Level minimalLevel = Error::Level::Ignore);
     void unsetNotification(const UnsafeStringView &key);
 
+    // Lock-free. Callers may skip assembling the error if no one is interested in it.
+    bool isNotificationNeeded(Error::Level level) const;
+
     typedef std::function<void(Error &error)> PreprocessCallback;
     void setNotificationForPreprocessing(const UnsafeStringView &key,
                                          const PreprocessCallback &callback);
 
+    /*
+     Identical ignorable sqlite errors of the same path are notified at most once per interval.
+     The ones in between are counted and notified together in a summary after the interval.
+     It returns false if the error is folded into the summary.
+     */
+    bool shouldNotifyIgnorableError(const UnsafeStringView &path, int rc);
+    // Notify the summaries of the intervals that are over.
+    void notifyIgnorableErrorSummaries();
+    // It's called when a summary is pending, to call `notifyIgnorableErrorSummaries()` after the delay.
+    typedef std::function<void(double /* delay */)> SummaryScheduler;
+    void setIgnorableErrorSummaryScheduler(const SummaryScheduler &scheduler);
+
 protected:
     Notifier();
     Notifier(const Notifier &) = delete;
@@ -51,8 +74,34 @@ protected:
 
     mutable SharedLock m_lock;
 
-    UniqueList<StringView, Callback> m_notifications;
+    struct Subscription {
+        Callback callback;
+        Error::Level minimalLevel;
+    };
+    UniqueList<StringView, Subscription> m_notifications;
+    std::atomic<int> m_minimalLevel;
+    void updateMinimalLevel();
     StringViewMap<PreprocessCallback> m_preprocessNotifications;
+
+    struct IgnorableErrorRecord {
+        SteadyClock lastNotifiedTime;
+        uint32_t suppressedCount = 0;
+    };
+    // Records are sharded by path, so that the errors of different databases do not contend for the same lock.
+    struct IgnorableErrorShard {
+        std::mutex lock;
+        // path -> rc -> record
+        StringViewMap<std::map<int, IgnorableErrorRecord>> records;
+    };
+    static constexpr const int NumberOfIgnorableErrorShards = 16;
+    IgnorableErrorShard m_ignorableErrorShards[NumberOfIgnorableErrorShards];
+    IgnorableErrorShard &getIgnorableErrorShard(const UnsafeStringView &path);
+
+    void scheduleIgnorableErrorSummaries(double delay);
+    std::atomic<bool> m_summaryScheduled;
+    std::atomic<bool> m_summaryEnabled;
+    std::mutex m_summarySchedulerLock;
+    SummaryScheduler m_summaryScheduler;
 };
 
 } //namespace WCDB
@@ -385,6 +385,8 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
     if (!isEnough((size_t) offset + 1)) {
         return { 0, 0 };
     }
+    // Bound once instead of querying the capacity for each byte.
+    const size_t available = capacity() - (size_t) offset;
     const unsigned char *p = base() + offset;
 
     uint32_t a = *p;
@@ -393,7 +395,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
         return { 1, a };
     }
 
-    if (!isEnough((size_t) offset + 2)) {
+    if (available < 2) {
         return { 0, 0 };
     }
     ++p;
@@ -409,7 +411,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
 
     /* Verify that constants are precomputed correctly */
 
-    if (!isEnough((size_t) offset + 3)) {
+    if (available < 3) {
         return { 0, 0 };
     }
     ++p;
@@ -427,7 +429,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
     /* CSE1 from below */
 
     a &= slot_2_0;
-    if (!isEnough((size_t) offset + 4)) {
+    if (available < 4) {
         return { 0, 0 };
     }
     ++p;
@@ -452,7 +454,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
     uint64_t s = a;
     /* s: p0<<14 | p2 (masked) */
 
-    if (!isEnough((size_t) offset + 5)) {
+    if (available < 5) {
         return { 0, 0 };
     }
     ++p;
@@ -475,7 +477,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
     s |= b;
     /* s: p0<<21 | p1<<14 | p2<<7 | p3 (masked) */
 
-    if (!isEnough((size_t) offset + 6)) {
+    if (available < 6) {
         return { 0, 0 };
     }
     ++p;
@@ -492,7 +494,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
         return { 6, ((uint64_t) s) << 32 | a };
     }
 
-    if (!isEnough((size_t) offset + 7)) {
+    if (available < 7) {
         return { 0, 0 };
     }
     ++p;
@@ -510,7 +512,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
 
     /* CSE2 from below */
     a &= slot_2_0;
-    if (!isEnough((size_t) offset + 8)) {
+    if (available < 8) {
         return { 0, 0 };
     }
     ++p;
@@ -527,7 +529,7 @@ std::pair<size_t, uint64_t> Deserialization::getVarint(offset_t offset) const
         return { 8, ((uint64_t) s) << 32 | a };
     }
 
-    if (!isEnough((size_t) offset + 9)) {
+    if (available < 9) {
         return { 0, 0 };
     }
     ++p;
@@ -25,6 +25,7 @@
 #include "StringView.hpp"
 #include "Assertion.hpp"
 #include "CrossPlatform.h"
+#include "Lock.hpp"
 #include "Macro.h"
 #include "UnsafeData.hpp"
 #ifdef _WIN32
@@ -692,6 +693,42 @@ StringView StringView::createConstant(const char* string, size_t length)
     }
     return ret;
 }
+StringView StringView::makeInterned(const UnsafeStringView& string)
+{
+    if ((uint64_t) string.m_referenceCount == ConstanceReference || string.empty()
+        || string.length() > MaxInternedLength) {
+        return StringView(string);
+    }
+    // A subset of the pool, so that the names used before by this thread are found without lock.
+    static thread_local StringViewSet s_threadedInterned;
+    auto threadedIter = s_threadedInterned.find(string);
+    if (threadedIter != s_threadedInterned.end()) {
+        return *threadedIter;
+    }
+    static std::atomic<bool>* s_full = new std::atomic<bool>(false);
+    if (s_full->load(std::memory_order_relaxed)) {
+        return StringView(string);
+    }
+    static SharedLock* s_lock = new SharedLock();
+    static StringViewSet* s_interned = new StringViewSet();
+    StringView interned;
+    {
+        LockGuard lockGuard(*s_lock);
+        auto iter = s_interned->find(string);
+        if (iter != s_interned->end()) {
+            interned = *iter;
+        } else if (s_interned->size() >= MaxNumberOfInterned) {
+            s_full->store(true, std::memory_order_relaxed);
+            return StringView(string);
+        } else {
+            interned = createConstant(string.data(), string.length());
+            s_interned->insert(interned);
+        }
+    }
+    s_threadedInterned.insert(interned);
+    return interned;
+}
+
 #ifdef _WIN32
 StringView StringView::createFromWString(const wchar_t* string, size_t length)
 {
@@ -184,6 +184,12 @@ public:
     static StringView hexString(const UnsafeData& data);
     static StringView makeConstant(const char* string);
     static StringView createConstant(const char* string, size_t length = 0);
+    // Identifiers are interned as constants so that copies of them share the same memory without reference counting.
+    // Long strings, or strings after the pool is full, fall back to a normal copy.
+    // The names interned before are found from a thread-local cache, and the pool is not locked any more once it's full.
+    static StringView makeInterned(const UnsafeStringView& string);
+    static constexpr const size_t MaxInternedLength = 64;
+    static constexpr const size_t MaxNumberOfInterned = 4096;
 #ifdef _WIN32
     static StringView createFromWString(const wchar_t* string, size_t length = 0);
 #endif
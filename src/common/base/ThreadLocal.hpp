@@ -25,36 +25,83 @@
 #pragma once
 
 #include <atomic>
-#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace WCDB {
 
+/*
+ Values of each thread are stored in a vector indexed by the slot of ThreadLocal.
+ The slot is recycled when ThreadLocal is destroyed, with its generation increased,
+ so that the stale value in each thread can be told and replaced on the next access to the slot.
+ The registry is only locked while constructing and destroying ThreadLocal, never while accessing values.
+ */
 template<typename T>
 class UntypedThreadLocal {
 protected:
-    typedef unsigned int Identifier;
+    typedef unsigned int Slot;
+    typedef unsigned int Generation;
+
+    struct Registry {
+        std::mutex lock;
+        std::vector<Generation> generations;
+        std::vector<Slot> freeSlots;
+    };
+    static Registry& registry()
+    {
+        static Registry* s_registry = new Registry;
+        return *s_registry;
+    }
+
+    static void acquireSlot(Slot& slot, Generation& generation)
+    {
+        Registry& registry = UntypedThreadLocal<T>::registry();
+        std::lock_guard<std::mutex> lockGuard(registry.lock);
+        if (!registry.freeSlots.empty()) {
+            slot = registry.freeSlots.back();
+            registry.freeSlots.pop_back();
+        } else {
+            slot = (Slot) registry.generations.size();
+            registry.generations.push_back(0);
+        }
+        generation = registry.generations[slot];
+    }
+
+    static void releaseSlot(Slot slot)
+    {
+        Registry& registry = UntypedThreadLocal<T>::registry();
+        std::lock_guard<std::mutex> lockGuard(registry.lock);
+        ++registry.generations[slot];
+        registry.freeSlots.push_back(slot);
+    }
+
+    struct Entry {
+        Generation generation = 0;
+        std::unique_ptr<T> value;
+    };
+
+    struct Storage {
+        std::vector<Entry> entries;
+    };
 
     struct ThreadedStorage {
-        std::map<Identifier, T>* ptr;
-        ThreadedStorage() : ptr(new std::map<Identifier, T>()) {}
+        Storage* ptr;
+        ThreadedStorage() : ptr(new Storage()) {}
         ~ThreadedStorage()
         {
-            delete ptr;
+            // Values destroyed here may access ThreadLocal again, which gets a new storage.
+            Storage* storage = ptr;
             ptr = nullptr;
+            delete storage;
         }
     };
 
-    static Identifier nextIdentifier()
-    {
-        static std::atomic<Identifier>* s_identifier = new std::atomic<Identifier>(0);
-        return ++(*s_identifier);
-    }
-    static std::map<Identifier, T>& threadedStorage()
+    static Storage& threadedStorage()
     {
         thread_local ThreadedStorage s_storage;
         if (s_storage.ptr == nullptr) {
-            s_storage.ptr = new std::map<Identifier, T>();
+            s_storage.ptr = new Storage();
         }
         return *s_storage.ptr;
     }
@@ -63,36 +110,57 @@ protected:
 template<typename T>
 class ThreadLocal : public UntypedThreadLocal<T> {
 public:
-    using UntypedThreadLocal<T>::nextIdentifier;
-    using UntypedThreadLocal<T>::threadedStorage;
-    using Identifier = typename UntypedThreadLocal<T>::Identifier;
+    using Super = UntypedThreadLocal<T>;
+    using Slot = typename Super::Slot;
+    using Generation = typename Super::Generation;
+    using Entry = typename Super::Entry;
+
     ThreadLocal(const typename std::enable_if<std::is_default_constructible<T>::value>::type* = nullptr)
-    : m_identifier(nextIdentifier()), m_default()
+    : m_default()
     {
+        Super::acquireSlot(m_slot, m_generation);
     }
 
-    ThreadLocal(const T& defaultValue)
-    : m_identifier(nextIdentifier()), m_default(defaultValue)
+    ThreadLocal(const T& defaultValue) : m_default(defaultValue)
     {
+        Super::acquireSlot(m_slot, m_generation);
     }
 
-    ThreadLocal(T&& defaultValue)
-    : m_identifier(nextIdentifier()), m_default(std::move(defaultValue))
+    ThreadLocal(T&& defaultValue) : m_default(std::move(defaultValue))
     {
+        Super::acquireSlot(m_slot, m_generation);
     }
 
+    ~ThreadLocal() { Super::releaseSlot(m_slot); }
+
+    ThreadLocal(const ThreadLocal&) = delete;
+    ThreadLocal& operator=(const ThreadLocal&) = delete;
+
     T& getOrCreate()
     {
-        auto& storage = threadedStorage();
-        auto iter = storage.find(m_identifier);
-        if (iter == storage.end()) {
-            iter = storage.emplace(m_identifier, m_default).first;
+        auto& entries = Super::threadedStorage().entries;
+        if (m_slot < entries.size()) {
+            Entry& entry = entries[m_slot];
+            if (entry.value != nullptr && entry.generation == m_generation) {
+                return *entry.value;
+            }
+        }
+        // The new value is created and the stale one is destroyed out of the entry,
+        // since they may access other ThreadLocals of T and resize the entries.
+        std::unique_ptr<T> value(new T(m_default));
+        T& result = *value;
+        if (m_slot >= entries.size()) {
+            entries.resize(m_slot + 1);
         }
-        return *(&iter->second);
+        Entry& entry = entries[m_slot];
+        entry.value.swap(value);
+        entry.generation = m_generation;
+        return result;
     }
 
 private:
-    const Identifier m_identifier;
+    Slot m_slot;
+    Generation m_generation;
     const T m_default;
 };
 
@@ -31,6 +31,7 @@
 #include "FTSConst.h"
 #include "FileManager.hpp"
 #include "Global.hpp"
+#include "MemoryGovernor.hpp"
 #include "Notifier.hpp"
 #include "OneOrBinaryTokenizer.hpp"
 #include "PinyinTokenizer.hpp"
@@ -93,6 +94,23 @@ CommonCore::CommonCore()
     NotifierPreprocessorName,
     std::bind(&CommonCore::preprocessError, this, std::placeholders::_1));
 
+    MemoryGovernor& memoryGovernor = MemoryGovernor::shared();
+    memoryGovernor.setResponder(
+    MemoryGovernorShrinkCacheName,
+    MemoryGovernor::Pressure::Moderate,
+    std::bind(&CommonCore::shrinkMemory, this, std::placeholders::_1));
+    memoryGovernor.setResponder(
+    MemoryGovernorPurgeHandleName,
+    MemoryGovernor::Pressure::Critical,
+    std::bind(&CommonCore::purgeHandles, this, std::placeholders::_1));
+    memoryGovernor.setNotificationWhenQuotaExceeded(std::bind(
+    &OperationQueue::asyncRelieveMemory, m_operationQueue.get(), std::placeholders::_1));
+
+    Notifier::shared().setIgnorableErrorSummaryScheduler(
+    std::bind(&OperationQueue::asyncNotifyIgnorableErrorSummaries,
+              m_operationQueue.get(),
+              std::placeholders::_1));
+
     m_operationQueue->run();
 
     //config FTS
@@ -116,13 +134,20 @@ CommonCore::CommonCore()
     BuiltinAuxiliaryFunction::SubstringMatchInfo,
     FTS5AuxiliaryFunctionTemplate<SubstringMatchInfo>::specializeWithContext(nullptr));
     registerScalarFunction(DecompressFunctionName,
-                           ScalarFunctionTemplate<DecompressFunction>::specialize(2));
+                           ScalarFunctionTemplate<DecompressFunction>::specialize(-1));
 }
 
 CommonCore::~CommonCore()
 {
+    MemoryGovernor& memoryGovernor = MemoryGovernor::shared();
+    memoryGovernor.setNotificationWhenQuotaExceeded(nullptr);
+    memoryGovernor.setResponder(
+    MemoryGovernorShrinkCacheName, MemoryGovernor::Pressure::Moderate, nullptr);
+    memoryGovernor.setResponder(
+    MemoryGovernorPurgeHandleName, MemoryGovernor::Pressure::Critical, nullptr);
     Global::shared().setNotificationForLog(NotifierLoggerName, nullptr);
     Notifier::shared().setNotificationForPreprocessing(NotifierPreprocessorName, nullptr);
+    Notifier::shared().setIgnorableErrorSummaryScheduler(nullptr);
 }
 
 #pragma mark - Database
@@ -136,6 +161,34 @@ void CommonCore::purgeDatabasePool()
     m_databasePool.purge();
 }
 
+void CommonCore::setIdleDatabaseTTL(double seconds)
+{
+    m_databasePool.setIdleTTL(seconds);
+    if (seconds > 0) {
+        m_operationQueue->asyncEvictIdleDatabases(seconds);
+    }
+}
+
+bool CommonCore::evictIdleDatabases()
+{
+    return m_databasePool.evictIdleDatabases();
+}
+
+std::vector<DatabasePool::ShardStatistics> CommonCore::getDatabasePoolStatistics() const
+{
+    return m_databasePool.getStatistics();
+}
+
+void CommonCore::asyncReapIdleHandles(const UnsafeStringView& path, double delay)
+{
+    m_operationQueue->asyncReapIdleHandles(path, delay);
+}
+
+void CommonCore::asyncPrefetchHotPages(const UnsafeStringView& path)
+{
+    m_operationQueue->asyncPrefetchHotPages(path);
+}
+
 void CommonCore::releaseSQLiteMemory(int bytes)
 {
     sqlite3_release_memory(bytes);
@@ -160,6 +213,17 @@ void CommonCore::databaseDidCreate(InnerDatabase* database)
     enableAutoCheckpoint(database, true);
 }
 
+void CommonCore::databaseDidBecomeIdle(InnerDatabase* database)
+{
+    WCDB_UNUSED(database);
+    m_operationQueue->asyncEvictIdleDatabases(m_databasePool.getIdleTTL());
+}
+
+void CommonCore::databaseDidEvict(const UnsafeStringView& path)
+{
+    MemoryGovernor::shared().removeBudget(path, false);
+}
+
 #pragma mark - Error
 
 void CommonCore::setThreadedErrorPath(const UnsafeStringView& path)
@@ -234,6 +298,11 @@ bool CommonCore::tokenizerExists(const UnsafeStringView& name) const
     return m_tokenizerModules->get(name) != nullptr;
 }
 
+const TokenizerModule* CommonCore::getTokenizer(const UnsafeStringView& name) const
+{
+    return m_tokenizerModules->get(name);
+}
+
 std::shared_ptr<Config> CommonCore::tokenizerConfig(const UnsafeStringView& tokenizeName)
 {
     return std::make_shared<TokenizerConfig>(tokenizeName, m_tokenizerModules);
@@ -316,9 +385,98 @@ void CommonCore::purgeShouldBeOperated()
     purgeDatabasePool();
 }
 
+void CommonCore::memoryShouldBeRelieved(const UnsafeStringView& path)
+{
+    MemoryGovernor::shared().relieve(path);
+}
+
+void CommonCore::idleHandlesShouldBeReaped(const UnsafeStringView& path)
+{
+    RecyclableDatabase database = m_databasePool.getReferenced(path);
+    if (database == nullptr) {
+        return;
+    }
+    if (!database->isBlockaded()) {
+        database->reapIdleHandles();
+    } else {
+        // Try again after the database is closed or unblockaded.
+        m_operationQueue->asyncReapIdleHandles(path, database->getIdleHandleTimeout());
+    }
+}
+
+void CommonCore::hotPagesShouldBePrefetched(const UnsafeStringView& path)
+{
+    RecyclableDatabase database = m_databasePool.getReferenced(path);
+    if (database != nullptr && !database->isBlockaded()) {
+        database->prefetchHotPages();
+    }
+}
+
+void CommonCore::idleDatabasesShouldBeEvicted()
+{
+    if (evictIdleDatabases()) {
+        m_operationQueue->asyncEvictIdleDatabases(m_databasePool.getIdleTTL());
+    }
+}
+
+#pragma mark - Memory
+void CommonCore::setMemoryQuota(const UnsafeStringView& path, size_t quota)
+{
+    MemoryGovernor::shared().setQuota(path, quota);
+}
+
+void CommonCore::relieveMemory(const UnsafeStringView& path)
+{
+    MemoryGovernor::shared().relieve(path);
+}
+
+MemoryGovernor::Usage
+CommonCore::getMemoryUsage(const UnsafeStringView& path, MemoryGovernor::Component component) const
+{
+    return MemoryGovernor::shared().getUsage(path, component);
+}
+
+MemoryGovernor::Usage CommonCore::getTotalMemoryUsage(const UnsafeStringView& path) const
+{
+    return MemoryGovernor::shared().getTotalUsage(path);
+}
+
+void CommonCore::shrinkMemory(const UnsafeStringView& path)
+{
+    if (path.empty()) {
+        m_databasePool.shrinkMemory();
+        return;
+    }
+    RecyclableDatabase database = m_databasePool.getReferenced(path);
+    if (database != nullptr && !database->isBlockaded()) {
+        database->shrinkMemory();
+    }
+}
+
+void CommonCore::purgeHandles(const UnsafeStringView& path)
+{
+    if (path.empty()) {
+        m_databasePool.purge();
+        return;
+    }
+    RecyclableDatabase database = m_databasePool.getReferenced(path);
+    if (database != nullptr && !database->isBlockaded()) {
+        database->purge();
+    }
+}
+
 void CommonCore::stopAllDatabaseEvent(const UnsafeStringView& path)
 {
     m_operationQueue->stopAllDatabaseEvent(path);
+    // The pending relief is dropped along with the events above.
+    MemoryGovernor::shared().cancelRelief(path);
+}
+
+void CommonCore::databaseDidClose(const UnsafeStringView& path)
+{
+    m_lockProfiler.evict(path);
+    // The quota set by user is kept until the database is evicted.
+    MemoryGovernor::shared().removeBudget(path, true);
 }
 
 bool CommonCore::isFileObservedCorrupted(const UnsafeStringView& path)
@@ -513,18 +671,20 @@ const ShareablePerformanceTraceConfig::Notification& notification)
     ->setNotification(notification);
 }
 
-void CommonCore::setNotificationWhenErrorTraced(const Notifier::Callback& notification)
+void CommonCore::setNotificationWhenErrorTraced(const Notifier::Callback& notification,
+                                                Error::Level minimalLevel)
 {
     if (notification != nullptr) {
         Notifier::shared().setNotification(
-        std::numeric_limits<int>::min(), WCDB::NotifierLoggerName, notification);
+        std::numeric_limits<int>::min(), WCDB::NotifierLoggerName, notification, minimalLevel);
     } else {
         Notifier::shared().unsetNotification(WCDB::NotifierLoggerName);
     }
 }
 
 void CommonCore::setNotificationWhenErrorTraced(const UnsafeStringView& path,
-                                                const Notifier::Callback& notification)
+                                                const Notifier::Callback& notification,
+                                                Error::Level minimalLevel)
 {
     StringView notifierKey
     = StringView::formatted("%s_%s", NotifierLoggerName.data(), path.data());
@@ -536,7 +696,7 @@ void CommonCore::setNotificationWhenErrorTraced(const UnsafeStringView& path,
             }
         };
         Notifier::shared().setNotification(
-        std::numeric_limits<int>::min() + 1, notifierKey, realNotification);
+        std::numeric_limits<int>::min() + 1, notifierKey, realNotification, minimalLevel);
     } else {
         Notifier::shared().unsetNotification(notifierKey);
     }
@@ -565,7 +725,35 @@ void CommonCore::setBusyMonitor(BusyMonitor monitor, double timeOut)
 
 bool CommonCore::isBusyTraceEnable() const
 {
-    return m_enableBusyTrace;
+    // The running SQL is also needed to attribute the lock waits.
+    return m_enableBusyTrace || m_lockProfiler.isEnabled();
+}
+
+#pragma mark - Lock Profiler
+void CommonCore::setLockProfilerEnabled(bool enabled)
+{
+    if (enabled) {
+        m_lockProfiler.setEnabled(true, [this](const UnsafeStringView& path, uint64_t tid) {
+            // Lock events of a database that is not referenced are not attributed.
+            RecyclableDatabase database = m_databasePool.getReferenced(path);
+            if (database == nullptr) {
+                return StringView();
+            }
+            return database->getRunningSQLInThread(tid);
+        });
+    } else {
+        m_lockProfiler.setEnabled(false);
+    }
+}
+
+LockProfiler::Profile CommonCore::getLockProfile(size_t numberOfTopBlockers) const
+{
+    return m_lockProfiler.getProfile(numberOfTopBlockers);
+}
+
+void CommonCore::resetLockProfile()
+{
+    m_lockProfiler.reset();
 }
 
 #pragma mark - Integrity
@@ -32,6 +32,8 @@
 #include "SQLTraceConfig.hpp"
 
 #include "DatabasePool.hpp"
+#include "LockProfiler.hpp"
+#include "MemoryGovernor.hpp"
 
 #include "AuxiliaryFunctionConfig.hpp"
 #include "ScalarFunctionConfig.hpp"
@@ -58,6 +60,13 @@ public:
     RecyclableDatabase getOrCreateDatabase(const UnsafeStringView& path);
 
     void purgeDatabasePool();
+    // Zero disables the eviction of idle databases.
+    void setIdleDatabaseTTL(double seconds);
+    // Return true if some idle databases remain to be evicted later.
+    bool evictIdleDatabases();
+    std::vector<DatabasePool::ShardStatistics> getDatabasePoolStatistics() const;
+    void asyncReapIdleHandles(const UnsafeStringView& path, double delay);
+    void asyncPrefetchHotPages(const UnsafeStringView& path);
     void releaseSQLiteMemory(int bytes);
     void setSoftHeapLimit(int64_t limit);
 
@@ -65,6 +74,8 @@ public:
 
 protected:
     void databaseDidCreate(InnerDatabase* database) override final;
+    void databaseDidBecomeIdle(InnerDatabase* database) override final;
+    void databaseDidEvict(const UnsafeStringView& path) override final;
     DatabasePool m_databasePool;
 
 #pragma mark - Error
@@ -92,6 +103,7 @@ public:
     void registerTokenizer(const UnsafeStringView& name, const TokenizerModule& module);
     std::shared_ptr<Config> tokenizerConfig(const UnsafeStringView& tokenizeName);
     bool tokenizerExists(const UnsafeStringView& name) const;
+    const TokenizerModule* getTokenizer(const UnsafeStringView& name) const;
 
 protected:
     std::shared_ptr<TokenizerModules> m_tokenizerModules;
@@ -110,6 +122,8 @@ protected:
 #pragma mark - Operation
 public:
     void stopAllDatabaseEvent(const UnsafeStringView& path);
+    // Drop the states kept for the database after all its handles are closed.
+    void databaseDidClose(const UnsafeStringView& path);
     typedef std::function<void(InnerDatabase*)> CorruptedNotification;
     bool isFileObservedCorrupted(const UnsafeStringView& path);
     void setNotificationWhenDatabaseCorrupted(const UnsafeStringView& path,
@@ -122,9 +136,26 @@ protected:
     void checkpointShouldBeOperated(const UnsafeStringView& path) override final;
     void integrityShouldBeChecked(const UnsafeStringView& path) override final;
     void purgeShouldBeOperated() override final;
+    void memoryShouldBeRelieved(const UnsafeStringView& path) override final;
+    void idleDatabasesShouldBeEvicted() override final;
+    void idleHandlesShouldBeReaped(const UnsafeStringView& path) override final;
+    void hotPagesShouldBePrefetched(const UnsafeStringView& path) override final;
 
     std::shared_ptr<OperationQueue> m_operationQueue;
 
+#pragma mark - Memory
+public:
+    // Empty path for the quota of whole process.
+    void setMemoryQuota(const UnsafeStringView& path, size_t quota);
+    void relieveMemory(const UnsafeStringView& path);
+    MemoryGovernor::Usage getMemoryUsage(const UnsafeStringView& path,
+                                         MemoryGovernor::Component component) const;
+    MemoryGovernor::Usage getTotalMemoryUsage(const UnsafeStringView& path) const;
+
+protected:
+    void shrinkMemory(const UnsafeStringView& path);
+    void purgeHandles(const UnsafeStringView& path);
+
 #pragma mark - Checkpoint
 public:
     void enableAutoCheckpoint(InnerDatabase* database, bool enable);
@@ -163,9 +194,12 @@ public:
     void setNotificationForSQLGLobalTraced(const ShareableSQLTraceConfig::Notification& notification);
     void setNotificationWhenPerformanceGlobalTraced(
     const ShareablePerformanceTraceConfig::Notification& notification);
-    void setNotificationWhenErrorTraced(const Notifier::Callback& notification);
+    // Ignorable errors are not assembled when all the traces are set above Level::Ignore.
+    void setNotificationWhenErrorTraced(const Notifier::Callback& notification,
+                                        Error::Level minimalLevel = Error::Level::Ignore);
     void setNotificationWhenErrorTraced(const UnsafeStringView& path,
-                                        const Notifier::Callback& notification);
+                                        const Notifier::Callback& notification,
+                                        Error::Level minimalLevel = Error::Level::Ignore);
 
 protected:
     std::shared_ptr<Config> m_globalSQLTraceConfig;
@@ -186,6 +220,15 @@ protected:
     std::shared_ptr<Config> m_globalBusyRetryConfig;
     bool m_enableBusyTrace;
 
+#pragma mark - Lock Profiler
+public:
+    void setLockProfilerEnabled(bool enabled);
+    LockProfiler::Profile getLockProfile(size_t numberOfTopBlockers) const;
+    void resetLockProfile();
+
+protected:
+    LockProfiler m_lockProfiler;
+
 #pragma mark - Merge FTS Index
 public:
     using TableArray = OperationQueue::TableArray;
@@ -62,6 +62,10 @@ WCDBLiteralStringImplement(ScalarFunctionConfigPrefix);
 
 WCDBLiteralStringImplement(AutoVacuumConfigName);
 
+WCDBLiteralStringImplement(QueryResultCacheConfigName);
+
+WCDBLiteralStringImplement(HotPagePrefetchConfigName);
+
 WCDBLiteralStringImplement(NotifierPreprocessorName);
 
 WCDBLiteralStringImplement(NotifierLoggerName);
@@ -44,6 +44,8 @@ static constexpr const int OperationQueueTolerableFailuresForCompression = 5;
 #pragma mark - Operation Queue - Purge
 static constexpr const double OperationQueueTimeIntervalForPurgingAgain = 30.0;
 static constexpr const double OperationQueueRateForTooManyFileDescriptors = 0.7;
+#pragma mark - Operation Queue - Relieve Memory
+static constexpr const double OperationQueueTimeIntervalForRelievingMemory = 1.0;
 #pragma mark - Operation Queue - Checkpoint
 static constexpr const double OperationQueueTimeIntervalForCheckpoint = 10.0;
 #pragma mark - Operation Queue - Backup
@@ -70,6 +72,15 @@ WCDBLiteralStringDefine(AutoMergeFTSIndexQueueName, "WCDB.MergeIndex");
 static constexpr const int AutoMergeFTS5IndexMinSegmentCount = 4;
 static constexpr const double AutoMergeFTSIndexMaxExpectingDuration = 0.02;
 static constexpr const double AutoMergeFTSIndexMaxInitializeDuration = 0.005;
+static constexpr const int AutoMergeFTS5IndexDefaultPagesPerStep = 256;
+static constexpr const int AutoMergeFTS5IndexMinPagesPerStep = 16;
+static constexpr const int AutoMergeFTS5IndexMaxPagesPerStep = 4096;
+static constexpr const double AutoMergeFTSIndexStepTimeBudget = 0.004;
+static constexpr const double AutoMergeFTSIndexMinBackoff
+= 0.001229; //Use prime numbers to reduce the probability of collision with external logic
+static constexpr const double AutoMergeFTSIndexMaxBackoff = 0.1;
+#pragma mark - Pre-Tokenize
+WCDBLiteralStringDefine(PreTokenizeThreadName, "WCDB.PreTokenize");
 #pragma mark - Config - Basic
 WCDBLiteralStringDefine(BasicConfigName, "com.Tencent.WCDB.Config.Basic");
 static constexpr const int BasicConfigBusyRetryMaxAllowedNumberOfTimes = 3;
@@ -96,6 +107,14 @@ WCDBLiteralStringDefine(AuxiliaryFunctionConfigPrefix,
                         "com.Tencent.WCDB.Config.AuxiliaryFunction.");
 #pragma mark - Config - AutoVaccum
 WCDBLiteralStringDefine(AutoVacuumConfigName, "com.Tencent.WCDB.Config.AutoVaccum");
+#pragma mark - Config - Query Result Cache
+WCDBLiteralStringDefine(QueryResultCacheConfigName, "com.Tencent.WCDB.Config.QueryResultCache");
+#pragma mark - Config - Hot Page Prefetch
+WCDBLiteralStringDefine(HotPagePrefetchConfigName, "com.Tencent.WCDB.Config.HotPagePrefetch");
+
+#pragma mark - Memory Governor
+WCDBLiteralStringDefine(MemoryGovernorShrinkCacheName, "com.Tencent.WCDB.MemoryGovernor.ShrinkCache");
+WCDBLiteralStringDefine(MemoryGovernorPurgeHandleName, "com.Tencent.WCDB.MemoryGovernor.PurgeHandle");
 
 #pragma mark - Notifier
 WCDBLiteralStringDefine(NotifierPreprocessorName, "com.Tencent.WCDB.Notifier.PreprocessTag");
@@ -166,10 +185,30 @@ static constexpr const int MigrationBatchCount = 100;
 #pragma mark - Compression
 static constexpr const int CompressionBatchCount = 10;
 static constexpr const int CompressionUpdateRecordBatchCount = 1000;
+static constexpr const int CompressionDictTrainSampleCount = 4000;
+static constexpr const int CompressionDictHeldOutSampleInterval = 10;
+static constexpr const int CompressionDictHeldOutSampleCount = 400;
+static constexpr const size_t CompressionDictMaxSampleSize = 128 * 1024;
+static constexpr const size_t CompressionDictMaxSamplesSize = 8 * 1024 * 1024;
+static constexpr const int64_t CompressionDictRotationInterval = 24 * 3600;
+static constexpr const double CompressionDictAdoptionRatio = 0.95;
+static constexpr const int CompressionDefaultLevel = 3;
+static constexpr const int CompressionIncompressibleThreshold = 32;
+static constexpr const int CompressionIncompressibleRetryInterval = 64;
+static constexpr const int CompressionLevelWindowSize = 128;
+static constexpr const double CompressionLevelMinSavedSizePerMicrosecond = 8.0;
 
 #pragma mark - Vacuum
 static constexpr const int VacuumBatchCount = 1000;
 
+#pragma mark - Error
+// Identical ignorable errors of a handle are notified at most once per interval.
+static constexpr const double ErrorIgnorableSummaryInterval = 1.0;
+
+#pragma mark - Assemble
+static constexpr const int AssembleCacheSizeInKB = 16 * 1024;
+static constexpr const size_t AssembleMaxBufferedCellSize = 16 * 1024 * 1024;
+
 WCDBLiteralStringDefine(ErrorStringKeyType, "Type");
 WCDBLiteralStringDefine(ErrorStringKeySource, "Source")
 
@@ -188,6 +227,9 @@ WCDBLiteralStringDefine(ErrorIntKeyTag, WCDB_ERROR_INT_KEY_TAG);
 #define WCDB_ERROR_INT_KEY_EXTCODE "ExtCode"
 WCDBLiteralStringDefine(ErrorIntKeyExtCode, WCDB_ERROR_INT_KEY_EXTCODE);
 
+// Number of identical ignorable errors folded into this one since the last notification.
+WCDBLiteralStringDefine(ErrorIntKeySuppressedCount, "SuppressedCount");
+
 #pragma mark - Error - Source
 WCDBLiteralStringDefine(ErrorSourceSQLite, "SQLite");
 WCDBLiteralStringDefine(ErrorSourceRepair, "Repair");
@@ -24,43 +24,77 @@
 
 #include "DatabasePool.hpp"
 #include "Assertion.hpp"
+#include "Time.hpp"
+#include <list>
 
 namespace WCDB {
 
 DatabasePoolEvent::~DatabasePoolEvent() = default;
 
 #pragma mark - DatabasePool
-DatabasePool::DatabasePool(DatabasePoolEvent *event) : m_event(event)
+DatabasePool::DatabasePool(DatabasePoolEvent *event) : m_event(event), m_idleTTL(0)
 {
     WCTAssert(m_event != nullptr);
 }
 
+DatabasePool::Shard::Shard() : numberOfEvictedDatabases(0)
+{
+}
+
+DatabasePool::Shard &DatabasePool::getShard(const UnsafeStringView &path)
+{
+    return m_shards[path.hash() % numberOfShards];
+}
+
 RecyclableDatabase DatabasePool::getOrCreate(const UnsafeStringView &path)
 {
+    Shard &shard = getShard(path);
     {
-        SharedLockGuard lockGuard(m_lock);
-        auto iter = m_databases.find(path);
-        if (iter != m_databases.end()) {
-            return get(iter);
+        SharedLockGuard lockGuard(shard.lock);
+        auto iter = shard.databases.find(path);
+        if (iter != shard.databases.end()) {
+            return get(shard, iter->second);
         }
     }
-    LockGuard lockGuard(m_lock);
-    auto iter = m_databases.find(path);
-    if (iter != m_databases.end()) {
-        return get(iter);
+    LockGuard lockGuard(shard.lock);
+    auto iter = shard.databases.find(path);
+    if (iter != shard.databases.end()) {
+        return get(shard, iter->second);
     }
     ReferencedDatabase referencedDatabase(std::make_shared<InnerDatabase>(path));
-    auto result = m_databases.emplace(path, std::move(referencedDatabase));
+    auto result = shard.databases.emplace(path, std::move(referencedDatabase));
     WCTAssert(result.second);
     m_event->databaseDidCreate(result.first->second.database.get());
-    return get(result.first);
+    return get(shard, result.first->second);
+}
+
+RecyclableDatabase DatabasePool::getReferenced(const UnsafeStringView &path)
+{
+    Shard &shard = getShard(path);
+    SharedLockGuard lockGuard(shard.lock);
+    auto iter = shard.databases.find(path);
+    if (iter == shard.databases.end()) {
+        return nullptr;
+    }
+    ReferencedDatabase &referencedDatabase = iter->second;
+    int reference = referencedDatabase.reference.load();
+    do {
+        if (reference == 0) {
+            return nullptr;
+        }
+    } while (!referencedDatabase.reference.compare_exchange_weak(reference, reference + 1));
+    return RecyclableDatabase(referencedDatabase.database.get(),
+                              [this, &shard, &referencedDatabase](InnerDatabase *) {
+                                  flowBack(shard, referencedDatabase);
+                              });
 }
 
 Tag DatabasePool::getTag(const UnsafeStringView &path)
 {
-    SharedLockGuard lockGuard(m_lock);
-    auto iter = m_databases.find(path);
-    if (iter != m_databases.end()) {
+    Shard &shard = getShard(path);
+    SharedLockGuard lockGuard(shard.lock);
+    auto iter = shard.databases.find(path);
+    if (iter != shard.databases.end()) {
         return iter->second.database->getTag();
     } else {
         return Tag::invalid();
@@ -68,48 +102,157 @@ Tag DatabasePool::getTag(const UnsafeStringView &path)
 }
 
 DatabasePool::ReferencedDatabase::ReferencedDatabase(std::shared_ptr<InnerDatabase> &&database_)
-: database(std::move(database_)), reference(0)
+: database(std::move(database_)), reference(0), idleSince(0)
 {
 }
 
 DatabasePool::ReferencedDatabase::ReferencedDatabase(ReferencedDatabase &&other)
-: database(std::move(other.database)), reference(other.reference.load())
+: database(std::move(other.database))
+, reference(other.reference.load())
+, idleSince(other.idleSince.load())
 {
     other.reference = 0;
 }
 
-RecyclableDatabase
-DatabasePool::get(const StringViewMap<ReferencedDatabase>::iterator &iter)
+RecyclableDatabase DatabasePool::get(Shard &shard, ReferencedDatabase &referencedDatabase)
 {
-    WCTAssert(m_lock.readSafety());
-    WCTAssert(iter != m_databases.end());
-    ++iter->second.reference;
-    return RecyclableDatabase(
-    iter->second.database.get(),
-    std::bind(&DatabasePool::flowBack, this, std::placeholders::_1));
+    WCTAssert(shard.lock.readSafety());
+    ++referencedDatabase.reference;
+    // The node of map is stable, and it's erased only when it's unreferenced.
+    return RecyclableDatabase(referencedDatabase.database.get(),
+                              [this, &shard, &referencedDatabase](InnerDatabase *) {
+                                  flowBack(shard, referencedDatabase);
+                              });
 }
 
-void DatabasePool::flowBack(InnerDatabase *database)
+void DatabasePool::flowBack(Shard &shard, ReferencedDatabase &referencedDatabase)
 {
-    // shared lock is enough.
-    SharedLockGuard lockGuard(m_lock);
-    const auto &iter = m_databases.find(database->getPath());
-    WCTAssert(iter != m_databases.end());
-    WCTAssert(iter->second.database.get() == database);
-    if (--iter->second.reference == 0) {
-        // A created database will never be erased. Instead, it will be empty so that the memory used will be very low.
-        iter->second.database->close(nullptr);
+    // shared lock is enough, which keeps the database from being evicted.
+    SharedLockGuard lockGuard(shard.lock);
+    if (--referencedDatabase.reference == 0) {
+        // A created database is not erased until it's idle for a long time. Instead, it will be empty so that the memory used will be very low.
+        referencedDatabase.database->close(nullptr);
+        referencedDatabase.idleSince = SteadyClock::now().time_since_epoch().count();
+        if (m_idleTTL.load() > 0) {
+            m_event->databaseDidBecomeIdle(referencedDatabase.database.get());
+        }
     }
 }
 
 void DatabasePool::purge()
 {
-    SharedLockGuard lockGuard(m_lock);
-    for (const auto &iter : m_databases) {
-        if (!iter.second.database->isBlockaded()) {
-            iter.second.database->purge();
+    for (const Shard &shard : m_shards) {
+        SharedLockGuard lockGuard(shard.lock);
+        for (const auto &iter : shard.databases) {
+            if (!iter.second.database->isBlockaded()) {
+                iter.second.database->purge();
+            }
+        }
+    }
+}
+
+void DatabasePool::shrinkMemory()
+{
+    for (const Shard &shard : m_shards) {
+        SharedLockGuard lockGuard(shard.lock);
+        for (const auto &iter : shard.databases) {
+            if (!iter.second.database->isBlockaded()) {
+                iter.second.database->shrinkMemory();
+            }
+        }
+    }
+}
+
+#pragma mark - Eviction
+void DatabasePool::setIdleTTL(double seconds)
+{
+    m_idleTTL = std::max(seconds, 0.0);
+}
+
+double DatabasePool::getIdleTTL() const
+{
+    return m_idleTTL.load();
+}
+
+bool DatabasePool::evictIdleDatabases()
+{
+    double idleTTL = m_idleTTL.load();
+    if (idleTTL <= 0) {
+        return false;
+    }
+    SteadyClock now = SteadyClock::now();
+    auto isEvictable = [&now, idleTTL](const ReferencedDatabase &referencedDatabase,
+                                       bool &remaining) {
+        if (referencedDatabase.reference.load() > 0
+            || referencedDatabase.database->isBlockaded()
+            || referencedDatabase.database->isOpened()) {
+            return false;
+        }
+        SteadyClock idleSince{ SteadyClock::duration(referencedDatabase.idleSince.load()) };
+        if (now.timeIntervalSinceSteadyClock(idleSince) < idleTTL) {
+            remaining = true;
+            return false;
+        }
+        return true;
+    };
+    bool remaining = false;
+    for (Shard &shard : m_shards) {
+        // Candidates are collected under shared lock, so that the scan doesn't block getting databases from this shard.
+        std::list<StringView> candidates;
+        {
+            SharedLockGuard lockGuard(shard.lock);
+            for (const auto &iter : shard.databases) {
+                if (isEvictable(iter.second, remaining)) {
+                    candidates.push_back(iter.first);
+                }
+            }
+        }
+        if (candidates.empty()) {
+            continue;
+        }
+        // Databases are released out of lock, since it may take a while.
+        std::list<std::shared_ptr<InnerDatabase>> evictedDatabases;
+        {
+            LockGuard lockGuard(shard.lock);
+            for (const StringView &path : candidates) {
+                auto iter = shard.databases.find(path);
+                // Check it again since it may be referenced after the scan.
+                if (iter == shard.databases.end() || !isEvictable(iter->second, remaining)) {
+                    continue;
+                }
+                evictedDatabases.push_back(std::move(iter->second.database));
+                shard.databases.erase(iter);
+                ++shard.numberOfEvictedDatabases;
+            }
+        }
+        for (const auto &evictedDatabase : evictedDatabases) {
+            m_event->databaseDidEvict(evictedDatabase->getPath());
+        }
+    }
+    return remaining;
+}
+
+#pragma mark - Statistics
+std::vector<DatabasePool::ShardStatistics> DatabasePool::getStatistics() const
+{
+    std::vector<ShardStatistics> statistics;
+    statistics.reserve(numberOfShards);
+    for (const Shard &shard : m_shards) {
+        ShardStatistics shardStatistics;
+        shardStatistics.numberOfActiveDatabases = 0;
+        shardStatistics.numberOfIdleDatabases = 0;
+        SharedLockGuard lockGuard(shard.lock);
+        for (const auto &iter : shard.databases) {
+            if (iter.second.reference.load() > 0) {
+                ++shardStatistics.numberOfActiveDatabases;
+            } else {
+                ++shardStatistics.numberOfIdleDatabases;
+            }
         }
+        shardStatistics.numberOfEvictedDatabases = shard.numberOfEvictedDatabases.load();
+        statistics.push_back(shardStatistics);
     }
+    return statistics;
 }
 
 } //namespace WCDB
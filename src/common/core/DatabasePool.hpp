@@ -28,6 +28,8 @@
 #include "Lock.hpp"
 #include "Path.hpp"
 #include "Tag.hpp"
+#include <array>
+#include <vector>
 
 namespace WCDB {
 
@@ -39,6 +41,8 @@ public:
 
 protected:
     virtual void databaseDidCreate(InnerDatabase* database) = 0;
+    virtual void databaseDidBecomeIdle(InnerDatabase* database) = 0;
+    virtual void databaseDidEvict(const UnsafeStringView& path) = 0;
     friend class DatabasePool;
 };
 
@@ -48,9 +52,12 @@ public:
     DatabasePool(DatabasePoolEvent* event);
 
     RecyclableDatabase getOrCreate(const UnsafeStringView& path);
+    // Return null if the database is not created or not referenced, so that it will be neither created nor reopened.
+    RecyclableDatabase getReferenced(const UnsafeStringView& path);
     Tag getTag(const UnsafeStringView& path);
 
     void purge();
+    void shrinkMemory();
 
 protected:
     struct ReferencedDatabase {
@@ -58,16 +65,56 @@ protected:
         ReferencedDatabase(ReferencedDatabase&& other);
         std::shared_ptr<InnerDatabase> database;
         std::atomic<int> reference;
+        // Ticks of steady clock when the reference drops to zero.
+        std::atomic<int64_t> idleSince;
     };
     typedef struct ReferencedDatabase ReferencedDatabase;
 
-    RecyclableDatabase get(const StringViewMap<ReferencedDatabase>::iterator& iter);
-    void flowBack(InnerDatabase* database);
+    /*
+     Databases are sharded by the hash of path, so that the creating and releasing of different databases rarely contend for the same lock.
+     */
+    struct Shard {
+        Shard();
+        StringViewMap<ReferencedDatabase> databases; //path->{database, reference}
+        mutable SharedLock lock;
+        std::atomic<uint64_t> numberOfEvictedDatabases;
+    };
+    typedef struct Shard Shard;
+
+    static constexpr const int numberOfShards = 16;
+    Shard& getShard(const UnsafeStringView& path);
+
+    RecyclableDatabase get(Shard& shard, ReferencedDatabase& referencedDatabase);
+    void flowBack(Shard& shard, ReferencedDatabase& referencedDatabase);
 
-    StringViewMap<ReferencedDatabase> m_databases; //path->{database, reference}
-    SharedLock m_lock;
+    std::array<Shard, numberOfShards> m_shards;
 
     DatabasePoolEvent* m_event;
+
+#pragma mark - Eviction
+public:
+    // Zero disables the eviction, which is the default.
+    void setIdleTTL(double seconds);
+    double getIdleTTL() const;
+
+    /*
+     Release the databases that have not been referenced for longer than the idle TTL.
+     It returns true if some idle databases remain to be evicted later.
+     */
+    bool evictIdleDatabases();
+
+protected:
+    std::atomic<double> m_idleTTL;
+
+#pragma mark - Statistics
+public:
+    struct ShardStatistics {
+        size_t numberOfActiveDatabases;
+        size_t numberOfIdleDatabases;
+        uint64_t numberOfEvictedDatabases;
+    };
+    typedef struct ShardStatistics ShardStatistics;
+    std::vector<ShardStatistics> getStatistics() const;
 };
 
 } //namespace WCDB
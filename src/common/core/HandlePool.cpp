@@ -36,7 +36,15 @@
 namespace WCDB {
 
 #pragma mark - Initialize
-HandlePool::HandlePool(const UnsafeStringView &thePath) : path(thePath)
+HandlePool::HandlePool(const UnsafeStringView &thePath)
+: path(thePath)
+, m_idleHandleTimeout(0)
+, m_minNumberOfHandles(0)
+, m_reapingScheduled(false)
+, m_numberOfHandlesInUse(0)
+, m_peakNumberOfHandlesInUse(0)
+, m_numberOfAcquires(0)
+, m_acquireTimeInNanoseconds(0)
 {
 }
 
@@ -105,6 +113,9 @@ void HandlePool::clearAllHandles()
         }
         handles.clear();
     }
+    // The pending reaping is removed along with the other database events on closing.
+    m_reapingScheduled = false;
+    m_peakNumberOfHandlesInUse = m_numberOfHandlesInUse.load();
 }
 
 #pragma mark - Handle
@@ -115,14 +126,25 @@ void HandlePool::purge()
     for (unsigned int i = 0; i < HandleSlotCount; ++i) {
         auto &handles = m_handles[i];
         auto &frees = m_frees[i];
-        for (const auto &handle : frees) {
-            handle->close();
-            handles.erase(handle);
+        for (const auto &free : frees) {
+            free.handle->close();
+            handles.erase(free.handle);
         }
         frees.clear();
     }
 }
 
+void HandlePool::shrinkMemory()
+{
+    SharedLockGuard concurrencyGuard(m_concurrency);
+    LockGuard memoryGuard(m_memory);
+    for (const auto &frees : m_frees) {
+        for (const auto &free : frees) {
+            free.handle->releaseMemory();
+        }
+    }
+}
+
 size_t HandlePool::numberOfAliveHandles() const
 {
     size_t count = 0;
@@ -190,6 +212,7 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint, bool threa
         }
     }
 
+    SteadyClock start = SteadyClock::now();
     if (!m_counter.tryIncreaseHandleCount(type, writeHint)) {
         Error error(Error::Code::Exceed,
                     Error::Level::Error,
@@ -207,7 +230,7 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint, bool threa
         LockGuard memoryGuard(m_memory);
         auto &freeSlot = m_frees[slot];
         if (!freeSlot.empty()) {
-            handle = freeSlot.back();
+            handle = freeSlot.back().handle;
             WCTAssert(handle != nullptr);
             freeSlot.pop_back();
         }
@@ -223,6 +246,7 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint, bool threa
         LockGuard memoryGuard(m_memory);
         WCTAssert(m_handles[slot].find(handle) == m_handles[slot].end());
         m_handles[slot].emplace(handle);
+        didCreateHandle();
 
         // Clean free handles of the other slots.
         if (!isNumberOfHandlesAllowed()) {
@@ -250,6 +274,7 @@ RecyclableHandle HandlePool::flowOut(HandleType type, bool writeHint, bool threa
     WCTAssert(referencedHandle.handle == nullptr && referencedHandle.reference == 0);
     referencedHandle.handle = handle;
     referencedHandle.reference = 1;
+    didAcquireHandle(start);
     return RecyclableHandle(
     handle, std::bind(&HandlePool::flowBack, this, type, std::placeholders::_1));
 }
@@ -276,20 +301,159 @@ void HandlePool::flowBack(HandleType type, const std::shared_ptr<InnerHandle> &h
         WCTRemedialAssert(
         !handle->isPrepared(), "Statement is not finalized.", handle->finalize(););
         handle->detachCancellationSignal();
+        handle->updateMemoryUsage();
         handle->finalizeStatements();
         {
             LockGuard memoryGuard(m_memory);
-            m_frees[slot].push_back(handle);
+            m_frees[slot].emplace_back(handle);
             handle->setWriteHint(false);
             handle->setActiveThreadId(0);
         }
         m_concurrency.unlockShared();
         m_counter.decreaseHandleCount(writeHint);
+        --m_numberOfHandlesInUse;
+        didFreeHandle();
     }
 }
 
+HandlePool::FreeHandle::FreeHandle(const std::shared_ptr<InnerHandle> &handle_)
+: handle(handle_), freedTime(SteadyClock::now())
+{
+}
+
 HandlePool::ReferencedHandle::ReferencedHandle() : handle(nullptr), reference(0)
 {
 }
 
+#pragma mark - Reap
+void HandlePool::setIdleHandleTimeout(double seconds)
+{
+    m_idleHandleTimeout = std::max(seconds, 0.0);
+    didFreeHandle();
+}
+
+double HandlePool::getIdleHandleTimeout() const
+{
+    return m_idleHandleTimeout.load();
+}
+
+void HandlePool::setMinNumberOfHandles(size_t minNumberOfHandles)
+{
+    m_minNumberOfHandles = minNumberOfHandles;
+}
+
+void HandlePool::idleHandlesShouldBeReaped(double delay)
+{
+    WCDB_UNUSED(delay);
+}
+
+void HandlePool::didFreeHandle()
+{
+    double timeout = m_idleHandleTimeout.load();
+    if (timeout > 0 && !m_reapingScheduled.exchange(true)) {
+        idleHandlesShouldBeReaped(timeout);
+    }
+}
+
+bool HandlePool::reapIdleHandles()
+{
+    m_reapingScheduled = false;
+    double timeout = m_idleHandleTimeout.load();
+    if (timeout <= 0) {
+        return false;
+    }
+    bool remaining = false;
+    std::list<std::shared_ptr<InnerHandle>> reapedHandles;
+    {
+        SharedLockGuard concurrencyGuard(m_concurrency);
+        {
+            LockGuard memoryGuard(m_memory);
+            // Adapt to the concurrency since the last reaping.
+            size_t targetNumberOfHandles
+            = std::max(m_peakNumberOfHandlesInUse.exchange(m_numberOfHandlesInUse.load()),
+                       m_minNumberOfHandles.load());
+            size_t numberOfAliveHandles = 0;
+            for (const auto &handles : m_handles) {
+                numberOfAliveHandles += handles.size();
+            }
+            SteadyClock now = SteadyClock::now();
+            size_t numberOfFreeHandles = 0;
+            for (unsigned int i = 0; i < HandleSlotCount; ++i) {
+                auto &frees = m_frees[i];
+                while (!frees.empty() && numberOfAliveHandles > targetNumberOfHandles
+                       && now.timeIntervalSinceSteadyClock(frees.front().freedTime) >= timeout) {
+                    m_handles[i].erase(frees.front().handle);
+                    reapedHandles.push_back(std::move(frees.front().handle));
+                    frees.pop_front();
+                    --numberOfAliveHandles;
+                }
+                numberOfFreeHandles += frees.size();
+            }
+            // The target may drop later, so the free handles beyond the min number are checked again.
+            remaining = numberOfFreeHandles > 0
+                        && numberOfAliveHandles > m_minNumberOfHandles.load();
+        }
+        // The reaped handles are not reachable from the pool, so they can be closed out of memory lock.
+        for (const auto &handle : reapedHandles) {
+            handle->close();
+        }
+    }
+    if (remaining && !m_reapingScheduled.exchange(true)) {
+        idleHandlesShouldBeReaped(timeout);
+    }
+    return remaining;
+}
+
+#pragma mark - Statistics
+void HandlePool::didAcquireHandle(const SteadyClock &start)
+{
+    size_t numberOfHandlesInUse = ++m_numberOfHandlesInUse;
+    size_t peak = m_peakNumberOfHandlesInUse.load();
+    while (numberOfHandlesInUse > peak
+           && !m_peakNumberOfHandlesInUse.compare_exchange_weak(peak, numberOfHandlesInUse)) {
+    }
+    ++m_numberOfAcquires;
+    m_acquireTimeInNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  SteadyClock::now() - start)
+                                  .count();
+}
+
+void HandlePool::didCreateHandle()
+{
+    WCTAssert(m_memory.writeSafety());
+    SteadyClock now = SteadyClock::now();
+    m_creationTimes.push_back(now);
+    while (now.timeIntervalSinceSteadyClock(m_creationTimes.front()) > 60) {
+        m_creationTimes.pop_front();
+    }
+}
+
+HandlePool::Statistics HandlePool::getStatistics() const
+{
+    Statistics statistics;
+    statistics.numberOfAliveHandles = 0;
+    statistics.numberOfIdleHandles = 0;
+    statistics.targetNumberOfHandles
+    = std::max(m_peakNumberOfHandlesInUse.load(), m_minNumberOfHandles.load());
+    int64_t numberOfAcquires = m_numberOfAcquires.load();
+    statistics.averageAcquireTimeInNanoseconds
+    = numberOfAcquires > 0 ? m_acquireTimeInNanoseconds.load() / numberOfAcquires : 0;
+
+    SharedLockGuard concurrencyGuard(m_concurrency);
+    LockGuard memoryGuard(m_memory);
+    for (const auto &handles : m_handles) {
+        statistics.numberOfAliveHandles += handles.size();
+    }
+    for (const auto &frees : m_frees) {
+        statistics.numberOfIdleHandles += frees.size();
+    }
+    SteadyClock now = SteadyClock::now();
+    while (!m_creationTimes.empty()
+           && now.timeIntervalSinceSteadyClock(m_creationTimes.front()) > 60) {
+        m_creationTimes.pop_front();
+    }
+    statistics.numberOfCreationsInLastMinute = m_creationTimes.size();
+    return statistics;
+}
+
 } //namespace WCDB
@@ -30,7 +30,10 @@
 #include "Lock.hpp"
 #include "RecyclableHandle.hpp"
 #include "ThreadedErrors.hpp"
+#include "Time.hpp"
 #include <array>
+#include <atomic>
+#include <deque>
 #include <list>
 
 namespace WCDB {
@@ -79,6 +82,8 @@ public:
     typedef unsigned int Slot;
     RecyclableHandle flowOut(HandleType type, bool writeHint = false, bool threaded = false);
     void purge();
+    // Release the cache memory of free handles without closing them.
+    void shrinkMemory();
     size_t numberOfAliveHandles() const;
     size_t numberOfAliveHandlesInSlot(HandleSlot slot) const;
     bool isAliving() const;
@@ -94,9 +99,62 @@ protected:
 
 private:
     void flowBack(HandleType type, const std::shared_ptr<InnerHandle> &handle);
-    std::array<std::list<std::shared_ptr<InnerHandle>>, HandleSlotCount> m_frees;
+    struct FreeHandle {
+        FreeHandle(const std::shared_ptr<InnerHandle> &handle);
+        std::shared_ptr<InnerHandle> handle;
+        SteadyClock freedTime;
+    };
+    typedef struct FreeHandle FreeHandle;
+    // The most recently used handle is at the back and is reused first.
+    std::array<std::list<FreeHandle>, HandleSlotCount> m_frees;
     HandleCounter m_counter;
 
+#pragma mark - Reap
+public:
+    // Zero disables the reaping of idle handles, which is the default.
+    void setIdleHandleTimeout(double seconds);
+    double getIdleHandleTimeout() const;
+    void setMinNumberOfHandles(size_t minNumberOfHandles);
+
+    /*
+     Close the free handles that are idle for longer than the timeout, from the least recently used one.
+     The handles are kept as many as the peak number of handles in use since the last reaping, and the min number of handles.
+     It returns true if some free handles remain to be reaped later.
+     */
+    bool reapIdleHandles();
+
+protected:
+    virtual void idleHandlesShouldBeReaped(double delay);
+
+private:
+    void didFreeHandle();
+
+    std::atomic<double> m_idleHandleTimeout;
+    std::atomic<size_t> m_minNumberOfHandles;
+    std::atomic<bool> m_reapingScheduled;
+    std::atomic<size_t> m_numberOfHandlesInUse;
+    std::atomic<size_t> m_peakNumberOfHandlesInUse;
+
+#pragma mark - Statistics
+public:
+    struct Statistics {
+        size_t numberOfAliveHandles;
+        size_t numberOfIdleHandles;
+        size_t targetNumberOfHandles;
+        int64_t averageAcquireTimeInNanoseconds;
+        size_t numberOfCreationsInLastMinute;
+    };
+    typedef struct Statistics Statistics;
+    Statistics getStatistics() const;
+
+private:
+    void didAcquireHandle(const SteadyClock &start);
+    void didCreateHandle();
+
+    std::atomic<int64_t> m_numberOfAcquires;
+    std::atomic<int64_t> m_acquireTimeInNanoseconds;
+    mutable std::deque<SteadyClock> m_creationTimes;
+
 #pragma mark - Threaded
 private:
     struct ReferencedHandle {
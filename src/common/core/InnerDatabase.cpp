@@ -25,9 +25,12 @@
 #include "InnerDatabase.hpp"
 #include "Assertion.hpp"
 #include "FileManager.hpp"
+#include "HotPageProfiler.hpp"
+#include "MasterItem.hpp"
 #include "Notifier.hpp"
 #include "Path.hpp"
 #include "RepairKit.h"
+#include "Snapshot.hpp"
 #include "StringView.hpp"
 #include "WCDBError.hpp"
 
@@ -48,6 +51,8 @@
 #include "CommonCore.hpp"
 #include "DBOperationNotifier.hpp"
 #include "DecorativeHandle.hpp"
+#include "HotPagePrefetchConfig.hpp"
+#include "QueryResultCacheConfig.hpp"
 #include "SQLite.h"
 
 #include <ctime>
@@ -72,6 +77,7 @@ InnerDatabase::InnerDatabase(const UnsafeStringView &path)
 , m_isInMemory(false)
 , m_sharedInMemoryHandle(nullptr)
 , m_mergeLogic(this)
+, m_queryResultCache(std::make_shared<QueryResultCache>())
 {
     StringViewMap<Value> info;
     DBOperationNotifier::shared().notifyOperation(
@@ -110,6 +116,7 @@ void InnerDatabase::didDrain()
     WCTAssert(m_memory.writeSafety());
     WCTAssert(!isOpened());
     m_initialized = false;
+    CommonCore::shared().databaseDidClose(getPath());
 }
 
 bool InnerDatabase::checkShouldInterruptWhenClosing(const UnsafeStringView &sourceType)
@@ -152,6 +159,11 @@ void InnerDatabase::close(const ClosedCallback &onClosed)
     --m_closing;
 }
 
+void InnerDatabase::idleHandlesShouldBeReaped(double delay)
+{
+    CommonCore::shared().asyncReapIdleHandles(getPath(), delay);
+}
+
 void InnerDatabase::setReadOnly()
 {
     close([this] {
@@ -610,6 +622,7 @@ std::list<StringView> InnerDatabase::pathsOfDatabase(const UnsafeStringView &dat
         Repair::Factory::firstMaterialPathForDatabase(database),
         Repair::Factory::lastMaterialPathForDatabase(database),
         Repair::Factory::factoryPathForDatabase(database),
+        Repair::Factory::hotPageProfilePathForDatabase(database),
         InnerHandle::journalPathOfDatabase(database),
         InnerHandle::shmPathOfDatabase(database),
     };
@@ -742,6 +755,192 @@ bool InnerDatabase::backup(bool interruptible)
     return succeed;
 }
 
+bool InnerDatabase::exportSnapshot(const UnsafeStringView &destination,
+                                   const BackupFilter &tableShouldBeExported)
+{
+    if (m_isInMemory) {
+        return false;
+    }
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return false;
+    }
+
+    WCTRemedialAssert(
+    !isInTransaction(), "Snapshot can't be exported in transaction.", return false;);
+
+    WCTRemedialAssert(
+    !m_liteModeEnable, "Snapshot can't be exported in lite mode.", return false;);
+
+    RecyclableHandle handle = flowOut(HandleType::Normal);
+    if (handle == nullptr) {
+        return false;
+    }
+
+    // The read mark of this transaction keeps wal from being restarted and checkpoint from overwriting the snapshot.
+    if (!handle->executeStatement(StatementBegin().beginDeferred())) {
+        return false;
+    }
+    bool succeed = false;
+    do {
+        if (!handle->getValues(StatementPragma().pragma(Pragma::schemaVersion()), 0).succeed()) {
+            break;
+        }
+        Repair::Snapshot snapshot(path);
+        if (handle->hasCipher()) {
+            size_t pageSize = handle->getCipherPageSize();
+            if (pageSize == 0) {
+                break;
+            }
+            snapshot.setPageSize((int) pageSize);
+        }
+        succeed = snapshot.exportTo(destination);
+        if (!succeed) {
+            setThreadedError(snapshot.getError());
+        }
+    } while (false);
+    handle->executeStatement(StatementRollback().rollback());
+    handle = nullptr;
+
+    if (succeed && tableShouldBeExported != nullptr) {
+        succeed = filterSnapshot(destination, tableShouldBeExported);
+    }
+    return succeed;
+}
+
+bool InnerDatabase::filterSnapshot(const UnsafeStringView &destination,
+                                   const BackupFilter &tableShouldBeExported)
+{
+    // Pages are copied as they are, so the unwanted tables are dropped from the exported database.
+    RecyclableHandle handle = flowOut(HandleType::Assemble);
+    if (handle == nullptr) {
+        return false;
+    }
+    handle->setPath(destination);
+    if (!handle->open()) {
+        return false;
+    }
+    auto tables = handle->getValues(StatementSelect()
+                                    .select(Column("name"))
+                                    .from(Syntax::masterTable)
+                                    .where(Column("type") == "table"),
+                                    0);
+    bool succeed = tables.succeed();
+    if (succeed) {
+        for (const StringView &table : tables.value()) {
+            if (Repair::MasterItem::isReservedTableName(table)
+                || tableShouldBeExported(table)) {
+                continue;
+            }
+            if (!handle->executeStatement(StatementDropTable().dropTable(table).ifExists())) {
+                succeed = false;
+                break;
+            }
+        }
+    }
+    handle->close();
+    return succeed;
+}
+
+bool InnerDatabase::recordHotPages(const std::list<StringView> &tables, int maxNumberOfPages)
+{
+    if (m_isInMemory) {
+        return false;
+    }
+    InitializedGuard initializedGuard = initialize();
+    if (!initializedGuard.valid()) {
+        return false;
+    }
+
+    WCTRemedialAssert(
+    !isInTransaction(), "Hot pages can't be recorded in transaction.", return false;);
+
+    RecyclableHandle handle = flowOut(HandleType::Normal);
+    if (handle == nullptr) {
+        return false;
+    }
+
+    // The read mark of this transaction keeps checkpoint from changing the pages during recording.
+    if (!handle->executeStatement(StatementBegin().beginDeferred())) {
+        return false;
+    }
+    bool succeed = false;
+    do {
+        if (!handle->prepare(StatementSelect()
+                             .select({ Column("tbl_name"), Column("rootpage") })
+                             .from(Syntax::masterTable)
+                             .where(Column("rootpage") > 0))) {
+            break;
+        }
+        auto rows = handle->getAllRows();
+        handle->finalize();
+        if (rows.failed()) {
+            break;
+        }
+        // The indexes of hot tables are hot as well.
+        StringViewSet hotTables(tables.begin(), tables.end());
+        std::list<int> rootpages;
+        for (const auto &row : rows.value()) {
+            if (hotTables.empty() || hotTables.find(row[0].textValue()) != hotTables.end()) {
+                rootpages.push_back((int) row[1].intValue());
+            }
+        }
+        Repair::HotPageProfiler profiler(path);
+        if (handle->hasCipher()) {
+            size_t pageSize = handle->getCipherPageSize();
+            void *pCodec = handle->getCipherContext();
+            if (pageSize == 0 || pCodec == nullptr) {
+                break;
+            }
+            profiler.setPageSize((int) pageSize);
+            profiler.setCipherContext(pCodec);
+        }
+        succeed = profiler.record(rootpages, maxNumberOfPages);
+        if (!succeed) {
+            setThreadedError(profiler.getError());
+        }
+    } while (false);
+    handle->executeStatement(StatementRollback().rollback());
+    return succeed;
+}
+
+void InnerDatabase::enableHotPagePrefetch(bool enable, const HotPagesPrefetchedCallback &onPrefetched)
+{
+    {
+        LockGuard memoryGuard(m_memory);
+        m_hotPagesPrefetchedCallback = enable ? onPrefetched : nullptr;
+    }
+    if (enable) {
+        setConfig(HotPagePrefetchConfigName,
+                  std::static_pointer_cast<Config>(std::make_shared<HotPagePrefetchConfig>()),
+                  Configs::Priority::Low);
+    } else {
+        removeConfig(HotPagePrefetchConfigName);
+    }
+}
+
+void InnerDatabase::prefetchHotPages()
+{
+    // Closing waits for the concurrency, so the files can't be removed or moved during prefetching.
+    SharedLockGuard concurrencyGuard(m_concurrency);
+    if (!isOpened()) {
+        return;
+    }
+    Repair::HotPageProfiler profiler(path);
+    if (!profiler.prefetch()) {
+        setThreadedError(profiler.getError());
+        return;
+    }
+    HotPagesPrefetchedCallback callback;
+    {
+        SharedLockGuard memoryGuard(m_memory);
+        callback = m_hotPagesPrefetchedCallback;
+    }
+    if (callback != nullptr) {
+        callback(this, profiler.getNumberOfPrefetchedPages());
+    }
+}
+
 bool InnerDatabase::deposit()
 {
     if (m_isInMemory) {
@@ -1059,6 +1258,11 @@ StringViewSet InnerDatabase::getPathsOfSourceDatabases() const
     return m_migration.getPathsOfSourceDatabases();
 }
 
+StringViewMap<uint64_t> InnerDatabase::getMigrationRoutedCounts() const
+{
+    return m_migration.getRoutedCounts();
+}
+
 #pragma mark - Compression
 Optional<bool> InnerDatabase::stepCompression(bool interruptible)
 {
@@ -1125,6 +1329,11 @@ bool InnerDatabase::isCompressed() const
     return m_compression.isCompressed();
 }
 
+std::list<Compression::ColumnStatistics> InnerDatabase::getCompressionStatistics() const
+{
+    return m_compression.getStatistics();
+}
+
 bool InnerDatabase::rollbackCompression(const ProgressCallback &callback)
 {
     WCTRemedialAssert(
@@ -1210,4 +1419,34 @@ RecyclableHandle InnerDatabase::getMergeIndexHandle()
     return flowOut(HandleType::MergeIndex);
 }
 
+#pragma mark - Query Result Cache
+void InnerDatabase::setQueryResultCacheSize(size_t size)
+{
+    if (size > 0) {
+        if (!m_queryResultCache->isEnabled()) {
+            setConfig(QueryResultCacheConfigName,
+                      std::static_pointer_cast<Config>(
+                      std::make_shared<QueryResultCacheConfig>(m_queryResultCache)),
+                      Configs::Priority::Low);
+        }
+    } else {
+        removeConfig(QueryResultCacheConfigName);
+    }
+    m_queryResultCache->setCapacity(size);
+    m_queryResultCache->invalidateAll();
+}
+
+QueryResultCache *InnerDatabase::getQueryResultCache()
+{
+    if (!m_queryResultCache->isEnabled()) {
+        return nullptr;
+    }
+    return m_queryResultCache.get();
+}
+
+QueryResultCache::Statistics InnerDatabase::getQueryResultCacheStatistics() const
+{
+    return m_queryResultCache->getStatistics();
+}
+
 } //namespace WCDB
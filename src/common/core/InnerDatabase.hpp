@@ -30,6 +30,7 @@
 #include "HandlePool.hpp"
 #include "MergeFTSIndexLogic.hpp"
 #include "Migration.hpp"
+#include "QueryResultCache.hpp"
 #include "Tag.hpp"
 #include "ThreadLocal.hpp"
 #include "WINQ.h"
@@ -73,6 +74,12 @@ public:
     using HandlePool::unblockade;
     using HandlePool::isBlockaded;
     using HandlePool::numberOfAliveHandles;
+    using HandlePool::setIdleHandleTimeout;
+    using HandlePool::getIdleHandleTimeout;
+    using HandlePool::setMinNumberOfHandles;
+    using HandlePool::reapIdleHandles;
+    using HandlePool::getStatistics;
+    typedef HandlePool::Statistics HandlePoolStatistics;
     void setReadOnly();
 
 protected:
@@ -80,6 +87,7 @@ protected:
     bool m_isReadOnly = false;
 
     void didDrain() override final;
+    void idleHandlesShouldBeReaped(double delay) override final;
     bool checkShouldInterruptWhenClosing(const UnsafeStringView &sourceType);
 
 #pragma mark - Handle
@@ -145,6 +153,21 @@ public:
     bool backup(bool interruptible);
     bool removeMaterials();
 
+    bool exportSnapshot(const UnsafeStringView &destination,
+                        const BackupFilter &tableShouldBeExported);
+
+    bool recordHotPages(const std::list<StringView> &tables, int maxNumberOfPages);
+    typedef std::function<void(InnerDatabase *, int numberOfPages)> HotPagesPrefetchedCallback;
+    void enableHotPagePrefetch(bool enable, const HotPagesPrefetchedCallback &onPrefetched);
+    void prefetchHotPages();
+
+private:
+    bool filterSnapshot(const UnsafeStringView &destination,
+                        const BackupFilter &tableShouldBeExported);
+    HotPagesPrefetchedCallback m_hotPagesPrefetchedCallback;
+
+public:
+
     bool deposit();
     bool removeDeposited();
     bool containsDeposited() const;
@@ -179,6 +202,7 @@ public:
     bool isMigrated() const;
 
     StringViewSet getPathsOfSourceDatabases() const;
+    StringViewMap<uint64_t> getMigrationRoutedCounts() const;
 
 protected:
     void didMigrate(const MigrationBaseInfo *info) override final;
@@ -199,6 +223,8 @@ public:
 
     bool isCompressed() const;
 
+    std::list<Compression::ColumnStatistics> getCompressionStatistics() const;
+
     bool rollbackCompression(const ProgressCallback &callback);
 
 protected:
@@ -214,6 +240,7 @@ public:
 #pragma mark - Memory
 public:
     using HandlePool::purge;
+    using HandlePool::shrinkMemory;
     void setInMemory();
 
 private:
@@ -233,6 +260,16 @@ public:
 
 private:
     MergeFTSIndexLogic m_mergeLogic;
+
+#pragma mark - Query Result Cache
+public:
+    void setQueryResultCacheSize(size_t size);
+    // Nullptr if it's disabled.
+    QueryResultCache *getQueryResultCache();
+    QueryResultCache::Statistics getQueryResultCacheStatistics() const;
+
+private:
+    std::shared_ptr<QueryResultCache> m_queryResultCache;
 };
 
 } //namespace WCDB
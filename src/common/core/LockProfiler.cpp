@@ -0,0 +1,409 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LockProfiler.hpp"
+#include "Assertion.hpp"
+#include "Thread.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace WCDB {
+
+LockProfiler::LockProfiler()
+: m_identifier(StringView::formatted("LockProfiler-%p", this)), m_enabled(false)
+{
+}
+
+LockProfiler::~LockProfiler()
+{
+    setEnabled(false);
+}
+
+void LockProfiler::setEnabled(bool enabled, const RunningSQLGetter& runningSQLGetter)
+{
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        m_runningSQLGetter = runningSQLGetter;
+        if (enabled && !m_enabled.load()) {
+            // Locks taken while disabled were not observed.
+            for (auto& iter : m_states) {
+                iter.second.pagerHoldings.clear();
+                iter.second.shmHoldings.clear();
+            }
+        }
+    }
+    // Global calls back with its lock held, so it must not be called with m_lock held.
+    if (enabled) {
+        if (!m_enabled.exchange(true)) {
+            Global::shared().setNotificationForLockEvent(
+            m_identifier,
+            std::bind(&LockProfiler::willLock, this, std::placeholders::_1, std::placeholders::_2),
+            std::bind(&LockProfiler::lockDidChange,
+                      this,
+                      std::placeholders::_1,
+                      std::placeholders::_2,
+                      std::placeholders::_3),
+            std::bind(&LockProfiler::willShmLock,
+                      this,
+                      std::placeholders::_1,
+                      std::placeholders::_2,
+                      std::placeholders::_3),
+            std::bind(&LockProfiler::shmLockDidChange,
+                      this,
+                      std::placeholders::_1,
+                      std::placeholders::_2,
+                      std::placeholders::_3,
+                      std::placeholders::_4));
+        }
+    } else if (m_enabled.exchange(false)) {
+        Global::shared().setNotificationForLockEvent(
+        m_identifier, nullptr, nullptr, nullptr, nullptr);
+    }
+}
+
+bool LockProfiler::isEnabled() const
+{
+    return m_enabled.load();
+}
+
+void LockProfiler::reset()
+{
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    for (auto& iter : m_states) {
+        iter.second.statistics = LockStatisticsArray();
+        iter.second.threads.clear();
+        iter.second.blockers.clear();
+    }
+}
+
+void LockProfiler::evict(const UnsafeStringView& path)
+{
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    m_states.erase(path);
+}
+
+#pragma mark - Histogram
+void LockProfiler::Histogram::record(double seconds)
+{
+    ++count;
+    totalSeconds += seconds;
+    maxSeconds = std::max(maxSeconds, seconds);
+    uint64_t microseconds = seconds > 0 ? (uint64_t) (seconds * 1E6) : 0;
+    int bucket = 0;
+    while (microseconds > 0 && bucket < HistogramBucketCount - 1) {
+        microseconds >>= 1;
+        ++bucket;
+    }
+    ++buckets[bucket];
+}
+
+void LockProfiler::Histogram::merge(const Histogram& other)
+{
+    count += other.count;
+    totalSeconds += other.totalSeconds;
+    maxSeconds = std::max(maxSeconds, other.maxSeconds);
+    for (int i = 0; i < HistogramBucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+#pragma mark - Profile
+bool LockProfiler::BlockerKey::operator<(const BlockerKey& other) const
+{
+    if (lockType != other.lockType) {
+        return lockType < other.lockType;
+    }
+    return sql.compare(other.sql) < 0;
+}
+
+LockProfiler::Profile LockProfiler::getProfile(size_t numberOfTopBlockers) const
+{
+    Profile profile;
+    std::vector<Blocker> blockers;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        for (const auto& iter : m_states) {
+            profile.paths.emplace(iter.first, iter.second.statistics);
+            for (const auto& thread : iter.second.threads) {
+                LockStatisticsArray& statistics = profile.threads[thread.first];
+                for (size_t i = 0; i < statistics.size(); ++i) {
+                    statistics[i].wait.merge(thread.second[i].wait);
+                    statistics[i].hold.merge(thread.second[i].hold);
+                }
+            }
+            for (const auto& blocker : iter.second.blockers) {
+                blockers.push_back(blocker.second);
+            }
+        }
+    }
+    std::sort(blockers.begin(), blockers.end(), [](const Blocker& left, const Blocker& right) {
+        return left.totalWaitSeconds > right.totalWaitSeconds;
+    });
+    for (size_t i = 0; i < blockers.size() && i < numberOfTopBlockers; ++i) {
+        profile.topBlockers.push_back(blockers[i]);
+    }
+    return profile;
+}
+
+#pragma mark - State
+LockProfiler::Waiting::Waiting()
+: isShm(false)
+, pagerType(PagerLockType::None)
+, shmType(ShmLockType::Shared)
+, shmMask(0)
+, blocked(false)
+, blockerTid(0)
+{
+}
+
+bool LockProfiler::Waiting::valid() const
+{
+    return !path.empty();
+}
+
+LockProfiler::LockType LockProfiler::lockTypeOfPagerLevel(int level)
+{
+    switch ((PagerLockType) level) {
+    case PagerLockType::Shared:
+        return LockType::PagerShared;
+    case PagerLockType::Reserved:
+        return LockType::PagerReserved;
+    case PagerLockType::Pending:
+        return LockType::PagerPending;
+    default:
+        WCTAssert(level == (int) PagerLockType::Exclusive);
+        return LockType::PagerExclusive;
+    }
+}
+
+bool LockProfiler::findBlocker(const State& state,
+                               const Waiting& waiting,
+                               uint64_t tid,
+                               uint64_t& blockerTid) const
+{
+    if (!waiting.isShm) {
+        for (const auto& iter : state.pagerHoldings) {
+            if (iter.second.tid == tid) {
+                continue;
+            }
+            PagerLockType holding = iter.second.type;
+            bool conflicted;
+            switch (waiting.pagerType) {
+            case PagerLockType::Shared:
+                conflicted = holding >= PagerLockType::Pending;
+                break;
+            case PagerLockType::Reserved:
+                conflicted = holding >= PagerLockType::Reserved;
+                break;
+            default:
+                conflicted = holding >= PagerLockType::Shared;
+                break;
+            }
+            if (conflicted) {
+                blockerTid = iter.second.tid;
+                return true;
+            }
+        }
+    } else {
+        for (const auto& iter : state.shmHoldings) {
+            const ShmHolding& holding = iter.second;
+            if (holding.tid == tid) {
+                continue;
+            }
+            int conflictedMask = holding.exclusiveMask;
+            if (waiting.shmType == ShmLockType::Exclusive) {
+                conflictedMask |= holding.sharedMask;
+            }
+            if ((waiting.shmMask & conflictedMask) != 0) {
+                blockerTid = holding.tid;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void LockProfiler::detectBlocker(const UnsafeStringView& path, Waiting& waiting)
+{
+    if (waiting.blocked) {
+        // Retried after busy.
+        return;
+    }
+    RunningSQLGetter runningSQLGetter;
+    {
+        std::lock_guard<std::mutex> lockGuard(m_lock);
+        auto iter = m_states.find(path);
+        if (iter == m_states.end()
+            || !findBlocker(iter->second, waiting, Thread::getCurrentThreadId(), waiting.blockerTid)) {
+            return;
+        }
+        runningSQLGetter = m_runningSQLGetter;
+    }
+    waiting.blocked = true;
+    // The getter may lock the database, so it's called without m_lock held.
+    if (runningSQLGetter != nullptr) {
+        waiting.blockerSQL = runningSQLGetter(path, waiting.blockerTid);
+    }
+}
+
+void LockProfiler::recordWait(
+State& state, const Waiting& waiting, LockType lockType, uint64_t tid, double seconds)
+{
+    state.statistics[(size_t) lockType].wait.record(seconds);
+    state.threads[tid][(size_t) lockType].wait.record(seconds);
+    if (waiting.blocked) {
+        Blocker& blocker = state.blockers[{ waiting.blockerSQL, lockType }];
+        if (blocker.count == 0) {
+            blocker.path = waiting.path;
+            blocker.sql = waiting.blockerSQL;
+            blocker.lockType = lockType;
+        }
+        blocker.tid = waiting.blockerTid;
+        ++blocker.count;
+        blocker.totalWaitSeconds += seconds;
+        blocker.maxWaitSeconds = std::max(blocker.maxWaitSeconds, seconds);
+    }
+}
+
+void LockProfiler::recordHold(State& state, LockType lockType, uint64_t tid, double seconds)
+{
+    state.statistics[(size_t) lockType].hold.record(seconds);
+    state.threads[tid][(size_t) lockType].hold.record(seconds);
+}
+
+#pragma mark - Lock Event
+void LockProfiler::willLock(const UnsafeStringView& path, PagerLockType type)
+{
+    Waiting& waiting = m_waitings.getOrCreate();
+    if (!waiting.valid() || waiting.isShm || waiting.pagerType != type
+        || waiting.path != path) {
+        waiting = Waiting();
+        waiting.path = path;
+        waiting.pagerType = type;
+        waiting.begin = SteadyClock::now();
+    }
+    detectBlocker(path, waiting);
+}
+
+void LockProfiler::lockDidChange(const UnsafeStringView& path, void* identifier, PagerLockType type)
+{
+    SteadyClock now = SteadyClock::now();
+    uint64_t tid = Thread::getCurrentThreadId();
+    Waiting& waiting = m_waitings.getOrCreate();
+    bool waited = waiting.valid() && !waiting.isShm && waiting.path == path
+                  && type >= waiting.pagerType;
+
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    State& state = m_states[path];
+    PagerHolding& holding = state.pagerHoldings[identifier];
+    int oldLevel = (int) holding.type;
+    int newLevel = (int) type;
+    for (int level = oldLevel + 1; level <= newLevel; ++level) {
+        holding.acquired[level] = now;
+    }
+    for (int level = oldLevel; level > newLevel; --level) {
+        recordHold(state,
+                   lockTypeOfPagerLevel(level),
+                   holding.tid,
+                   now.timeIntervalSinceSteadyClock(holding.acquired[level]));
+    }
+    holding.type = type;
+    holding.tid = tid;
+    if (type == PagerLockType::None) {
+        state.pagerHoldings.erase(identifier);
+    }
+
+    if (waited) {
+        LockType lockType = lockTypeOfPagerLevel((int) waiting.pagerType);
+        recordWait(
+        state, waiting, lockType, tid, now.timeIntervalSinceSteadyClock(waiting.begin));
+    }
+    if (waited || type == PagerLockType::None) {
+        waiting = Waiting();
+    }
+}
+
+void LockProfiler::willShmLock(const UnsafeStringView& path, ShmLockType type, int mask)
+{
+    Waiting& waiting = m_waitings.getOrCreate();
+    if (!waiting.valid() || !waiting.isShm || waiting.shmType != type
+        || waiting.shmMask != mask || waiting.path != path) {
+        waiting = Waiting();
+        waiting.path = path;
+        waiting.isShm = true;
+        waiting.shmType = type;
+        waiting.shmMask = mask;
+        waiting.begin = SteadyClock::now();
+    }
+    detectBlocker(path, waiting);
+}
+
+void LockProfiler::shmLockDidChange(const UnsafeStringView& path,
+                                    void* identifier,
+                                    int sharedMask,
+                                    int exclusiveMask)
+{
+    SteadyClock now = SteadyClock::now();
+    uint64_t tid = Thread::getCurrentThreadId();
+    Waiting& waiting = m_waitings.getOrCreate();
+    bool waited = false;
+    if (waiting.valid() && waiting.isShm && waiting.path == path) {
+        int obtainedMask
+        = waiting.shmType == ShmLockType::Shared ? sharedMask : exclusiveMask;
+        waited = (obtainedMask & waiting.shmMask) == waiting.shmMask;
+    }
+
+    std::lock_guard<std::mutex> lockGuard(m_lock);
+    State& state = m_states[path];
+    ShmHolding& holding = state.shmHoldings[identifier];
+    if (holding.sharedMask == 0 && sharedMask != 0) {
+        holding.sharedAcquired = now;
+    } else if (holding.sharedMask != 0 && sharedMask == 0) {
+        recordHold(state,
+                   LockType::ShmShared,
+                   holding.tid,
+                   now.timeIntervalSinceSteadyClock(holding.sharedAcquired));
+    }
+    if (holding.exclusiveMask == 0 && exclusiveMask != 0) {
+        holding.exclusiveAcquired = now;
+    } else if (holding.exclusiveMask != 0 && exclusiveMask == 0) {
+        recordHold(state,
+                   LockType::ShmExclusive,
+                   holding.tid,
+                   now.timeIntervalSinceSteadyClock(holding.exclusiveAcquired));
+    }
+    holding.sharedMask = sharedMask;
+    holding.exclusiveMask = exclusiveMask;
+    holding.tid = tid;
+    if (sharedMask == 0 && exclusiveMask == 0) {
+        state.shmHoldings.erase(identifier);
+    }
+
+    if (waited) {
+        LockType lockType = waiting.shmType == ShmLockType::Shared ?
+                            LockType::ShmShared :
+                            LockType::ShmExclusive;
+        recordWait(
+        state, waiting, lockType, tid, now.timeIntervalSinceSteadyClock(waiting.begin));
+        waiting = Waiting();
+    }
+}
+
+} // namespace WCDB
@@ -0,0 +1,170 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Global.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "ThreadLocal.hpp"
+#include "Time.hpp"
+#include <array>
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace WCDB {
+
+/*
+ Profile the waiting and holding durations of the pager and shm locks of each database file,
+ based on the lock events from Global.
+ A wait is attributed to the SQL running in the thread that holds the conflicting lock when the wait begins.
+ */
+class LockProfiler final {
+public:
+    LockProfiler();
+    ~LockProfiler();
+
+    LockProfiler(const LockProfiler&) = delete;
+    LockProfiler& operator=(const LockProfiler&) = delete;
+
+    typedef std::function<StringView(const UnsafeStringView& /* path */, uint64_t /* tid */)> RunningSQLGetter;
+    void setEnabled(bool enabled, const RunningSQLGetter& runningSQLGetter = nullptr);
+    bool isEnabled() const;
+    void reset();
+    // The profile of the database is dropped after it's closed.
+    void evict(const UnsafeStringView& path);
+
+    enum class LockType : unsigned char {
+        PagerShared = 0,
+        PagerReserved,
+        PagerPending,
+        PagerExclusive,
+        ShmShared,
+        ShmExclusive,
+        Count,
+    };
+
+    // The bucket i counts the durations in [2^(i-1), 2^i) microseconds, and the last one counts all the longer durations.
+    static constexpr const int HistogramBucketCount = 24;
+    typedef struct Histogram {
+        uint64_t count = 0;
+        double totalSeconds = 0;
+        double maxSeconds = 0;
+        std::array<uint64_t, HistogramBucketCount> buckets = {};
+
+        void record(double seconds);
+        void merge(const Histogram& other);
+    } Histogram;
+
+    typedef struct LockStatistics {
+        Histogram wait;
+        Histogram hold;
+    } LockStatistics;
+    typedef std::array<LockStatistics, (size_t) LockType::Count> LockStatisticsArray;
+
+    typedef struct Blocker {
+        StringView path;
+        StringView sql;
+        LockType lockType;
+        uint64_t tid;
+        uint64_t count = 0;
+        double totalWaitSeconds = 0;
+        double maxWaitSeconds = 0;
+    } Blocker;
+
+    typedef struct Profile {
+        StringViewMap<LockStatisticsArray> paths;
+        std::map<uint64_t /* tid */, LockStatisticsArray> threads;
+        // Sorted by the total waiting duration in descending order.
+        std::list<Blocker> topBlockers;
+    } Profile;
+    Profile getProfile(size_t numberOfTopBlockers) const;
+
+#pragma mark - Lock Event
+protected:
+    typedef Global::PagerLock PagerLockType;
+    typedef Global::ShmLock ShmLockType;
+    void willLock(const UnsafeStringView& path, PagerLockType type);
+    void lockDidChange(const UnsafeStringView& path, void* identifier, PagerLockType type);
+    void willShmLock(const UnsafeStringView& path, ShmLockType type, int mask);
+    void shmLockDidChange(const UnsafeStringView& path, void* identifier, int sharedMask, int exclusiveMask);
+
+    const StringView m_identifier;
+
+#pragma mark - State
+protected:
+    static constexpr const int PagerLevelCount = (int) PagerLockType::Exclusive + 1;
+    typedef struct PagerHolding {
+        PagerLockType type = PagerLockType::None;
+        uint64_t tid = 0;
+        std::array<SteadyClock, PagerLevelCount> acquired;
+    } PagerHolding;
+    typedef struct ShmHolding {
+        int sharedMask = 0;
+        int exclusiveMask = 0;
+        uint64_t tid = 0;
+        SteadyClock sharedAcquired;
+        SteadyClock exclusiveAcquired;
+    } ShmHolding;
+    typedef struct BlockerKey {
+        StringView sql;
+        LockType lockType;
+        bool operator<(const BlockerKey& other) const;
+    } BlockerKey;
+    typedef struct State {
+        // Pager locks are held by connections, which may be used by different threads in turn.
+        std::map<void* /* identifier */, PagerHolding> pagerHoldings;
+        std::map<void* /* identifier */, ShmHolding> shmHoldings;
+        LockStatisticsArray statistics;
+        std::map<uint64_t /* tid */, LockStatisticsArray> threads;
+        std::map<BlockerKey, Blocker> blockers;
+    } State;
+
+    // Waiting of current thread
+    typedef struct Waiting {
+        Waiting();
+        StringView path;
+        bool isShm;
+        PagerLockType pagerType;
+        ShmLockType shmType;
+        int shmMask;
+        SteadyClock begin;
+        bool blocked;
+        uint64_t blockerTid;
+        StringView blockerSQL;
+        bool valid() const;
+    } Waiting;
+    ThreadLocal<Waiting> m_waitings;
+
+    bool findBlocker(const State& state, const Waiting& waiting, uint64_t tid, uint64_t& blockerTid) const;
+    void detectBlocker(const UnsafeStringView& path, Waiting& waiting);
+    void recordWait(State& state, const Waiting& waiting, LockType lockType, uint64_t tid, double seconds);
+    void recordHold(State& state, LockType lockType, uint64_t tid, double seconds);
+    static LockType lockTypeOfPagerLevel(int level);
+
+    mutable std::mutex m_lock;
+    StringViewMap<State> m_states;
+    std::atomic<bool> m_enabled;
+    RunningSQLGetter m_runningSQLGetter;
+};
+
+} //namespace WCDB
@@ -0,0 +1,341 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryResultCache.hpp"
+#include "Assertion.hpp"
+#include "Syntax.h"
+#include "WINQ.h"
+
+namespace WCDB {
+
+QueryResultCache::QueryResultCache()
+: m_schemaState(SchemaState::Unchecked)
+, m_capacity(0), m_epoch(0), m_hitCount(0), m_missCount(0), m_invalidationCount(0)
+{
+}
+
+QueryResultCache::~QueryResultCache() = default;
+
+void QueryResultCache::setCapacity(size_t capacity)
+{
+    LockGuard lockGuard(m_lock);
+    m_capacity = capacity;
+    m_storage.setCapacity(capacity);
+}
+
+bool QueryResultCache::isEnabled() const
+{
+    return m_capacity.load() > 0;
+}
+
+Optional<StringViewSet> QueryResultCache::getReadTables(const Statement& statement)
+{
+    if (statement.getType() != Syntax::Identifier::Type::SelectSTMT) {
+        return NullOpt;
+    }
+    static const char* const nonDeterministicFunctions[] = {
+        "random",   "randomblob", "changes",   "total_changes", "last_insert_rowid",
+        "date",     "time",       "datetime",  "julianday",     "strftime",
+        "unixepoch",
+    };
+    bool cacheable = true;
+    StringViewSet tables;
+    statement.iterate([&](const Syntax::Identifier& identifier, bool isBegin, bool& stop) {
+        if (!isBegin) {
+            return;
+        }
+        switch (identifier.getType()) {
+        case Syntax::Identifier::Type::TableOrSubquery: {
+            const Syntax::TableOrSubquery& syntax
+            = static_cast<const Syntax::TableOrSubquery&>(identifier);
+            if (syntax.switcher == Syntax::TableOrSubquery::Switch::Table) {
+                tables.emplace(normalizeTableName(syntax.tableOrFunction));
+            }
+        } break;
+        case Syntax::Identifier::Type::Expression: {
+            const Syntax::Expression& syntax = static_cast<const Syntax::Expression&>(identifier);
+            if (syntax.switcher == Syntax::Expression::Switch::In
+                && syntax.inSwitcher == Syntax::Expression::SwitchIn::Table) {
+                tables.emplace(normalizeTableName(syntax.table()));
+            } else if (syntax.switcher == Syntax::Expression::Switch::Function) {
+                for (const char* function : nonDeterministicFunctions) {
+                    if (syntax.function().caseInsensitiveEqual(function)) {
+                        cacheable = false;
+                        break;
+                    }
+                }
+            }
+        } break;
+        case Syntax::Identifier::Type::LiteralValue: {
+            const Syntax::LiteralValue& syntax
+            = static_cast<const Syntax::LiteralValue&>(identifier);
+            if (syntax.switcher == Syntax::LiteralValue::Switch::CurrentTime
+                || syntax.switcher == Syntax::LiteralValue::Switch::CurrentDate
+                || syntax.switcher == Syntax::LiteralValue::Switch::CurrentTimestamp) {
+                cacheable = false;
+            }
+        } break;
+        case Syntax::Identifier::Type::BindParameter:
+            // The bound values are not part of the description.
+            cacheable = false;
+            break;
+        default:
+            break;
+        }
+        stop = !cacheable;
+    });
+    if (!cacheable || tables.empty()) {
+        return NullOpt;
+    }
+    return tables;
+}
+
+StringView QueryResultCache::normalizeTableName(const UnsafeStringView& table)
+{
+    std::string normalized(table.data(), table.length());
+    for (char& c : normalized) {
+        if (c >= 'A' && c <= 'Z') {
+            c = (char) (c - 'A' + 'a');
+        }
+    }
+    return StringView(std::move(normalized));
+}
+
+bool QueryResultCache::isSchemaChecked() const
+{
+    return m_schemaState.load() != SchemaState::Unchecked;
+}
+
+StatementSelect QueryResultCache::getStatementForCheckingSchema()
+{
+    return StatementSelect()
+    .select(Column("type"))
+    .from(Syntax::masterTable)
+    .where(Column("type") == "view" || Column("type") == "trigger")
+    .limit(1);
+}
+
+QueryResultCache::Epoch QueryResultCache::getEpoch() const
+{
+    return m_epoch.load();
+}
+
+void QueryResultCache::setSchemaChecked(bool hasViewsOrTriggers, Epoch epoch)
+{
+    LockGuard lockGuard(m_lock);
+    // The schema may be changed during checking.
+    if (epoch != m_epoch.load()) {
+        return;
+    }
+    m_schemaState
+    = hasViewsOrTriggers ? SchemaState::Uncacheable : SchemaState::Cacheable;
+}
+
+Optional<MultiRowsValue> QueryResultCache::get(const StringView& key)
+{
+    Optional<MultiRowsValue> rows;
+    {
+        LockGuard lockGuard(m_lock);
+        if (m_storage.exists(key)) {
+            rows = m_storage.get(key).rows;
+        }
+    }
+    if (rows.succeed()) {
+        ++m_hitCount;
+    } else {
+        ++m_missCount;
+    }
+    return rows;
+}
+
+void QueryResultCache::put(const StringView& key,
+                           const StringViewSet& tables,
+                           const MultiRowsValue& rows,
+                           Epoch epoch)
+{
+    WCTAssert(!tables.empty());
+    Entry entry;
+    entry.size = key.length() + sizeOfRows(rows);
+    LockGuard lockGuard(m_lock);
+    // Large result would flush the whole cache.
+    if (entry.size * 4 > m_storage.getCapacity()) {
+        return;
+    }
+    // Some tables are modified during reading, so the result may be outdated.
+    if (epoch != m_epoch.load() || m_schemaState.load() != SchemaState::Cacheable) {
+        return;
+    }
+    entry.rows = rows;
+    entry.tables = tables;
+    m_storage.insert(key, std::move(entry));
+}
+
+void QueryResultCache::invalidate(const UnsafeStringView& table)
+{
+    StringView normalized = normalizeTableName(table);
+    if (normalized.equal(Syntax::masterTable)) {
+        invalidateSchema();
+        return;
+    }
+    LockGuard lockGuard(m_lock);
+    if (m_schemaState.load() != SchemaState::Cacheable) {
+        // The modification may be seen through a view or be spread by a trigger.
+        invalidateAllWithoutLock();
+        return;
+    }
+    ++m_epoch;
+    m_invalidationCount += m_storage.eraseEntriesOfTable(normalized);
+}
+
+void QueryResultCache::invalidateAll()
+{
+    LockGuard lockGuard(m_lock);
+    invalidateAllWithoutLock();
+}
+
+void QueryResultCache::invalidateSchema()
+{
+    LockGuard lockGuard(m_lock);
+    invalidateAllWithoutLock();
+    m_schemaState = SchemaState::Unchecked;
+}
+
+void QueryResultCache::invalidateAllWithoutLock()
+{
+    ++m_epoch;
+    m_invalidationCount += m_storage.size();
+    m_storage.clear();
+}
+
+QueryResultCache::Statistics QueryResultCache::getStatistics() const
+{
+    Statistics statistics;
+    statistics.hitCount = m_hitCount.load();
+    statistics.missCount = m_missCount.load();
+    statistics.invalidationCount = m_invalidationCount.load();
+    SharedLockGuard lockGuard(m_lock);
+    statistics.cachedSize = m_storage.getCachedSize();
+    return statistics;
+}
+
+size_t QueryResultCache::sizeOfRows(const MultiRowsValue& rows)
+{
+    size_t size = 0;
+    for (const auto& row : rows) {
+        size += sizeof(OneRowValue);
+        for (const Value& value : row) {
+            size += sizeof(Value);
+            switch (value.getType()) {
+            case ColumnType::Text:
+                size += value.textValue().length();
+                break;
+            case ColumnType::BLOB:
+                size += value.blobValue().size();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return size;
+}
+
+#pragma mark - Storage
+QueryResultCache::Storage::Storage() : m_capacity(0), m_cachedSize(0)
+{
+}
+
+QueryResultCache::Storage::~Storage() = default;
+
+void QueryResultCache::Storage::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    while (shouldPurge()) {
+        purge();
+    }
+}
+
+size_t QueryResultCache::Storage::getCapacity() const
+{
+    return m_capacity;
+}
+
+size_t QueryResultCache::Storage::getCachedSize() const
+{
+    return m_cachedSize;
+}
+
+void QueryResultCache::Storage::insert(const StringView& key, Entry&& entry)
+{
+    // Replace the old one, whose size is subtracted in willPurge.
+    erase(key);
+    for (const StringView& table : entry.tables) {
+        m_keysOfTables[table].emplace(key);
+    }
+    m_cachedSize += entry.size;
+    put(key, entry);
+    while (shouldPurge()) {
+        purge();
+    }
+}
+
+int QueryResultCache::Storage::eraseEntriesOfTable(const UnsafeStringView& table)
+{
+    auto iter = m_keysOfTables.find(table);
+    if (iter == m_keysOfTables.end()) {
+        return 0;
+    }
+    // Keys are copied since erasing modifies the map.
+    StringViewSet keys = iter->second;
+    for (const StringView& key : keys) {
+        erase(key);
+    }
+    return (int) keys.size();
+}
+
+void QueryResultCache::Storage::clear()
+{
+    purge(size());
+    WCTAssert(m_cachedSize == 0);
+    WCTAssert(m_keysOfTables.empty());
+}
+
+bool QueryResultCache::Storage::shouldPurge() const
+{
+    return m_cachedSize > m_capacity && !empty();
+}
+
+void QueryResultCache::Storage::willPurge(const StringView& key, const Entry& entry)
+{
+    WCTAssert(m_cachedSize >= entry.size);
+    m_cachedSize -= entry.size;
+    for (const StringView& table : entry.tables) {
+        auto iter = m_keysOfTables.find(table);
+        if (iter == m_keysOfTables.end()) {
+            continue;
+        }
+        iter->second.erase(key);
+        if (iter->second.empty()) {
+            m_keysOfTables.erase(iter);
+        }
+    }
+}
+
+} //namespace WCDB
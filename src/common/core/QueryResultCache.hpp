@@ -0,0 +1,140 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "LRUCache.hpp"
+#include "Lock.hpp"
+#include "Statement.hpp"
+#include "StatementSelect.hpp"
+#include "StringView.hpp"
+#include "Value.hpp"
+#include "WCDBOptional.hpp"
+#include <atomic>
+
+namespace WCDB {
+
+/*
+ Bounded cache of the results of read statements, keyed by the description of statement.
+ Each entry records the tables it reads, and is dropped once any of them is modified.
+ Table names are case-insensitive, as they are in SQLite.
+ Nothing is cached while the schema has views or triggers, since the tables they read or write are unknown.
+ */
+class QueryResultCache final {
+public:
+    QueryResultCache();
+    ~QueryResultCache();
+
+    QueryResultCache(const QueryResultCache&) = delete;
+    QueryResultCache& operator=(const QueryResultCache&) = delete;
+
+    // Zero capacity disables the cache.
+    void setCapacity(size_t capacity);
+    bool isEnabled() const;
+
+    /*
+     Only the select statements without bind parameters or non-deterministic functions can be cached.
+     It fails if the statement can not be cached.
+     */
+    static Optional<StringViewSet> getReadTables(const Statement& statement);
+    static StringView normalizeTableName(const UnsafeStringView& table);
+
+    /*
+     The schema should be checked by the statement below before reading, if it's not checked yet.
+     It returns some rows if the schema has views or triggers.
+     */
+    bool isSchemaChecked() const;
+    static StatementSelect getStatementForCheckingSchema();
+
+    typedef uint64_t Epoch;
+    // The epoch should be fetched before reading from database, so that a result read before an invalidation will not be cached.
+    Epoch getEpoch() const;
+    // The result is dropped if the schema is changed after the epoch.
+    void setSchemaChecked(bool hasViewsOrTriggers, Epoch epoch);
+    Optional<MultiRowsValue> get(const StringView& key);
+    void put(const StringView& key,
+             const StringViewSet& tables,
+             const MultiRowsValue& rows,
+             Epoch epoch);
+
+    void invalidate(const UnsafeStringView& table);
+    void invalidateAll();
+    // Drop all and check the schema again, since views or triggers may be created.
+    void invalidateSchema();
+
+    typedef struct Statistics {
+        int64_t hitCount = 0;
+        int64_t missCount = 0;
+        int64_t invalidationCount = 0;
+        size_t cachedSize = 0;
+    } Statistics;
+    Statistics getStatistics() const;
+
+private:
+    typedef struct Entry {
+        MultiRowsValue rows;
+        StringViewSet tables;
+        size_t size;
+    } Entry;
+
+    class Storage final : public LRUCache<StringView, Entry> {
+    public:
+        Storage();
+        ~Storage() override;
+
+        using Super = LRUCache<StringView, Entry>;
+
+        void setCapacity(size_t capacity);
+        size_t getCapacity() const;
+        size_t getCachedSize() const;
+        void insert(const StringView& key, Entry&& entry);
+        int eraseEntriesOfTable(const UnsafeStringView& table);
+        void clear();
+
+    protected:
+        bool shouldPurge() const override final;
+        void willPurge(const StringView& key, const Entry& entry) override final;
+
+        size_t m_capacity;
+        size_t m_cachedSize;
+        // table -> keys of the entries reading it
+        StringViewMap<StringViewSet> m_keysOfTables;
+    };
+
+    static size_t sizeOfRows(const MultiRowsValue& rows);
+    void invalidateAllWithoutLock();
+
+    enum class SchemaState {
+        Unchecked,
+        Cacheable,
+        Uncacheable,
+    };
+
+    mutable SharedLock m_lock;
+    std::atomic<SchemaState> m_schemaState;
+    Storage m_storage;
+    std::atomic<size_t> m_capacity;
+    std::atomic<Epoch> m_epoch;
+    std::atomic<int64_t> m_hitCount;
+    std::atomic<int64_t> m_missCount;
+    std::atomic<int64_t> m_invalidationCount;
+};
+
+} //namespace WCDB
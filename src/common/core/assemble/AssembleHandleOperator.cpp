@@ -23,6 +23,8 @@
  */
 
 #include "AssembleHandleOperator.hpp"
+#include "CoreConst.h"
+#include <algorithm>
 
 namespace WCDB {
 
@@ -31,9 +33,15 @@ AssembleHandleOperator::AssembleHandleOperator(InnerHandle *handle)
 , Repair::AssembleDelegate()
 , m_statementForDisableJounral(StatementPragma().pragma(Pragma::journalMode()).to("OFF"))
 , m_statementForEnableMMap(StatementPragma().pragma(Pragma::mmapSize()).to(2147418112))
+, m_statementsForBulkLoad({
+  StatementPragma().pragma(Pragma::synchronous()).to("OFF"),
+  StatementPragma().pragma(Pragma::lockingMode()).to("EXCLUSIVE"),
+  StatementPragma().pragma(Pragma::cacheSize()).to(-AssembleCacheSizeInKB),
+  })
 , m_integerPrimary(-1)
 , m_withoutRowid(false)
 , m_cellStatement(handle->getStatement(DecoratorAllType))
+, m_bufferedSize(0)
 , m_statementForUpdateSequence(StatementUpdate()
                                .update("sqlite_sequence")
                                .set(Column("seq"))
@@ -74,16 +82,25 @@ void AssembleHandleOperator::suspendAssemble()
 
 void AssembleHandleOperator::finishAssemble()
 {
+    clearBufferedCells();
+    m_deferredSQLs.clear();
     getHandle()->close();
 }
 
 bool AssembleHandleOperator::markAsAssembling()
 {
+    clearBufferedCells();
+    m_deferredSQLs.clear();
     InnerHandle *handle = getHandle();
     bool succeed = handle->open();
     if (succeed) {
-        if (!handle->execute(m_statementForDisableJounral)
-            || !handle->execute(m_statementForEnableMMap) || !markSequenceAsAssembling()) {
+        // The assembled database is rebuilt from scratch if the process crashes, so durability is traded for speed.
+        succeed = handle->execute(m_statementForDisableJounral)
+                  && handle->execute(m_statementForEnableMMap);
+        for (const StatementPragma &statement : m_statementsForBulkLoad) {
+            succeed = succeed && handle->execute(statement);
+        }
+        if (!succeed || !markSequenceAsAssembling()) {
             handle->close();
             succeed = false;
         }
@@ -93,10 +110,12 @@ bool AssembleHandleOperator::markAsAssembling()
 
 bool AssembleHandleOperator::markAsAssembled()
 {
+    flushBufferedCells();
     m_table.clear();
     m_cellStatement->finalize();
     InnerHandle *handle = getHandle();
-    bool succeed = markSequenceAsAssembled();
+    bool succeed = assembleDeferredSQLs();
+    succeed = markSequenceAsAssembled() && succeed;
     if (handle->isInTransaction()) {
         succeed = handle->commitOrRollbackTransaction() && succeed;
     }
@@ -107,8 +126,10 @@ bool AssembleHandleOperator::markAsAssembled()
 
 bool AssembleHandleOperator::markAsMilestone()
 {
+    flushBufferedCells();
     InnerHandle *handle = getHandle();
     if (handle->isInTransaction()) {
+        // The transaction is rolled back if it fails to be committed.
         if (!handle->commitOrRollbackTransaction()) {
             return false;
         }
@@ -117,15 +138,31 @@ bool AssembleHandleOperator::markAsMilestone()
 }
 
 bool AssembleHandleOperator::assembleSQL(const UnsafeStringView &sql)
+{
+    // Building an index on the whole table at once is much faster than maintaining it for each cell.
+    m_deferredSQLs.emplace_back(sql);
+    return true;
+}
+
+bool AssembleHandleOperator::assembleDeferredSQLs()
 {
     InnerHandle *handle = getHandle();
-    bool succeed = false;
+    bool succeed = true;
     handle->markErrorAsIgnorable(Error::Code::Error);
-    succeed = handle->executeSQL(sql);
-    if (!succeed && handle->getError().code() == Error::Code::Error) {
-        succeed = true;
+    // A unique index fails on the duplicated rows of corrupted data. It is skipped, while the rest is still created.
+    handle->markErrorAsIgnorable(Error::Code::Constraint);
+    for (const StringView &sql : m_deferredSQLs) {
+        if (handle->executeSQL(sql)) {
+            continue;
+        }
+        Error::Code code = handle->getError().code();
+        if (code != Error::Code::Error && code != Error::Code::Constraint) {
+            succeed = false;
+            break;
+        }
     }
-    handle->markErrorAsUnignorable();
+    handle->markErrorAsUnignorable(2);
+    m_deferredSQLs.clear();
     return succeed;
 }
 
@@ -133,6 +170,7 @@ bool AssembleHandleOperator::assembleSQL(const UnsafeStringView &sql)
 bool AssembleHandleOperator::assembleTable(const UnsafeStringView &tableName,
                                            const UnsafeStringView &sql)
 {
+    flushBufferedCells();
     m_cellStatement->finalize();
     m_table.clear();
     InnerHandle *handle = getHandle();
@@ -161,6 +199,14 @@ bool AssembleHandleOperator::isAssemblingTableWithoutRowid() const
 bool AssembleHandleOperator::assembleCell(const Repair::Cell &cell)
 {
     WCTAssert(!m_table.empty());
+    if (!m_withoutRowid) {
+        bufferCell(cell);
+        if (m_bufferedSize > AssembleMaxBufferedCellSize) {
+            flushBufferedCells();
+        }
+        return true;
+    }
+    // The cells of without rowid table are crawled in the order of primary key.
     if (!lazyPrepareCell()) {
         return false;
     }
@@ -199,6 +245,128 @@ bool AssembleHandleOperator::assembleCell(const Repair::Cell &cell)
     return succeed;
 }
 
+void AssembleHandleOperator::bufferCell(const Repair::Cell &cell)
+{
+    BufferedCell bufferedCell;
+    bufferedCell.order = m_bufferedCells.size();
+    bufferedCell.rowid = cell.getRowID();
+    bufferedCell.replaceable = isDuplicatedReplaceable();
+    bufferedCell.values.reserve(cell.getCount());
+    size_t size = sizeof(BufferedCell) + cell.getCount() * sizeof(Value);
+    for (int i = 0; i < cell.getCount(); ++i) {
+        switch (cell.getValueType(i)) {
+        case Repair::Cell::Integer:
+            bufferedCell.values.emplace_back(cell.integerValue(i));
+            break;
+        case Repair::Cell::Text: {
+            UnsafeStringView text = cell.textValue(i);
+            bufferedCell.values.emplace_back(StringView(text.data(), text.length()));
+            size += text.length();
+            break;
+        }
+        case Repair::Cell::BLOB: {
+            // Copy it so that the page is not retained.
+            const UnsafeData blob = cell.blobValue(i);
+            bufferedCell.values.emplace_back(Data(blob.buffer(), blob.size()));
+            size += blob.size();
+            break;
+        }
+        case Repair::Cell::Real:
+            bufferedCell.values.emplace_back(cell.doubleValue(i));
+            break;
+        case Repair::Cell::Null:
+            bufferedCell.values.emplace_back(nullptr);
+            break;
+        }
+    }
+    m_bufferedCells.push_back(std::move(bufferedCell));
+    m_bufferedSize += size;
+}
+
+void AssembleHandleOperator::flushBufferedCells()
+{
+    if (m_bufferedCells.empty()) {
+        return;
+    }
+    WCTAssert(!m_table.empty());
+    // The cells from wal are inserted after the others so that they replace the outdated ones.
+    std::stable_sort(m_bufferedCells.begin(),
+                     m_bufferedCells.end(),
+                     [](const BufferedCell &left, const BufferedCell &right) {
+                         if (left.replaceable != right.replaceable) {
+                             return right.replaceable;
+                         }
+                         return left.rowid < right.rowid;
+                     });
+    if (m_bufferedCellResults.empty()) {
+        // The error of the results taken is outdated.
+        m_bufferedCellError = Error();
+    }
+    bool replaceable = isDuplicatedReplaceable();
+    std::vector<bool> results(m_bufferedCells.size(), false);
+    for (const BufferedCell &cell : m_bufferedCells) {
+        if (cell.replaceable != isDuplicatedReplaceable()) {
+            markDuplicatedAsReplaceable(cell.replaceable);
+        }
+        if (stepBufferedCell(cell)) {
+            results[cell.order] = true;
+        } else if (m_bufferedCellError.isOK()
+                   || m_bufferedCellError.code() == Error::Code::Constraint) {
+            // Constraint errors are tolerable, so the first intolerable one is kept for reporting.
+            m_bufferedCellError = getHandle()->getError();
+        }
+    }
+    if (isDuplicatedReplaceable() != replaceable) {
+        markDuplicatedAsReplaceable(replaceable);
+    }
+    m_bufferedCellResults.insert(m_bufferedCellResults.end(), results.begin(), results.end());
+    m_bufferedCells.clear();
+    m_bufferedSize = 0;
+}
+
+void AssembleHandleOperator::clearBufferedCells()
+{
+    m_bufferedCells.clear();
+    m_bufferedSize = 0;
+    m_bufferedCellResults.clear();
+    m_bufferedCellError = Error();
+}
+
+bool AssembleHandleOperator::isAssemblingCellBuffered() const
+{
+    return !m_table.empty() && !m_withoutRowid;
+}
+
+std::vector<bool> AssembleHandleOperator::takeBufferedCellResults()
+{
+    std::vector<bool> results;
+    results.swap(m_bufferedCellResults);
+    return results;
+}
+
+const Error &AssembleHandleOperator::getBufferedCellError() const
+{
+    return m_bufferedCellError;
+}
+
+bool AssembleHandleOperator::stepBufferedCell(const BufferedCell &cell)
+{
+    if (!lazyPrepareCell()) {
+        return false;
+    }
+    WCTAssert(m_cellStatement->isPrepared());
+    m_cellStatement->reset();
+    m_cellStatement->bindInteger(cell.rowid, 1);
+    for (int i = 0; i < (int) cell.values.size(); ++i) {
+        if (i == m_integerPrimary && cell.values[i].getType() == ColumnType::Null) {
+            m_cellStatement->bindInteger(cell.rowid, i + 2);
+        } else {
+            m_cellStatement->bindValue(cell.values[i], i + 2);
+        }
+    }
+    return m_cellStatement->step();
+}
+
 void AssembleHandleOperator::markDuplicatedAsReplaceable(bool replaceable)
 {
     if (isDuplicatedReplaceable() != replaceable && m_cellStatement->isPrepared()) {
@@ -54,6 +54,11 @@ public:
 protected:
     StatementPragma m_statementForDisableJounral;
     StatementPragma m_statementForEnableMMap;
+    std::list<StatementPragma> m_statementsForBulkLoad;
+
+    // Indexes, triggers and views are created after all the cells are assembled.
+    bool assembleDeferredSQLs();
+    std::list<StringView> m_deferredSQLs;
 
 #pragma mark - Assemble - Table
 public:
@@ -63,6 +68,10 @@ public:
     bool assembleCell(const Repair::Cell &cell) override final;
     void markDuplicatedAsReplaceable(bool replaceable) override final;
 
+    bool isAssemblingCellBuffered() const override final;
+    std::vector<bool> takeBufferedCellResults() override final;
+    const Error &getBufferedCellError() const override final;
+
 protected:
     bool lazyPrepareCell();
     int64_t m_integerPrimary;
@@ -70,6 +79,26 @@ protected:
     bool m_withoutRowid;
     HandleStatement *m_cellStatement;
 
+    /*
+     Cells are crawled in the order of pages, which is not the order of rowid after corruption.
+     They are buffered and inserted in the order of rowid at each milestone.
+     A failed cell does not stop the others, and its result is reported in the order it was buffered.
+     */
+    struct BufferedCell {
+        size_t order;
+        int64_t rowid;
+        bool replaceable;
+        OneRowValue values;
+    };
+    void bufferCell(const Repair::Cell &cell);
+    void flushBufferedCells();
+    bool stepBufferedCell(const BufferedCell &cell);
+    void clearBufferedCells();
+    std::vector<BufferedCell> m_bufferedCells;
+    size_t m_bufferedSize;
+    std::vector<bool> m_bufferedCellResults;
+    Error m_bufferedCellError;
+
 #pragma mark - Assemble - Sequence
 public:
     bool assembleSequence(const UnsafeStringView &tableName, int64_t sequence) override final;
@@ -26,6 +26,7 @@
 #include "Assertion.hpp"
 #include "CompressionCenter.hpp"
 #include "CompressionConst.hpp"
+#include "CompressionDictRecord.hpp"
 #include "CompressionRecord.hpp"
 #include "CoreConst.h"
 #include "Notifier.hpp"
@@ -329,7 +330,10 @@ bool CompressHandleOperator::compressRow(OneRowValue& row)
                 continue;
             }
             auto decompressed = CompressionCenter::shared().decompressContent(
-            data, originCompressionType == CompressedType::ZSTDDict, getHandle());
+            data,
+            originCompressionType == CompressedType::ZSTDDict,
+            column.getDictScope(),
+            getHandle());
             if (!decompressed.hasValue()) {
                 return false;
             }
@@ -352,11 +356,12 @@ bool CompressHandleOperator::compressRow(OneRowValue& row)
         case CompressionType::Normal: {
             toCompressedType = CompressedType::ZSTDNormal;
             compressedValue
-            = CompressionCenter::shared().compressContent(data, 0, getHandle());
+            = CompressionCenter::shared().compressContent(data, 0, column, getHandle());
         } break;
         case CompressionType::Dict: {
+            addDictSample(m_compressingTableInfo->getTable(), column, data);
             compressedValue = CompressionCenter::shared().compressContent(
-            data, column.getDictId(), getHandle());
+            data, column.getCurrentDictId(), column, getHandle());
         } break;
         case CompressionType::VariousDict: {
             if (column.getMatchColumnIndex() >= row.size()) {
@@ -370,7 +375,7 @@ bool CompressHandleOperator::compressRow(OneRowValue& row)
             }
             Value& matchValue = row[column.getMatchColumnIndex()];
             compressedValue = CompressionCenter::shared().compressContent(
-            data, column.getMatchDictId(matchValue), getHandle());
+            data, column.getMatchDictId(matchValue), column, getHandle());
         } break;
         }
 
@@ -383,7 +388,10 @@ bool CompressHandleOperator::compressRow(OneRowValue& row)
         if (compressedValue.value().size() < data.size()) {
             value = compressedValue.value();
             if (!CompressionCenter::shared().testContentCanBeDecompressed(
-                value.blobValue(), toCompressedType == CompressedType::ZSTDDict, getHandle())) {
+                value.blobValue(),
+                toCompressedType == CompressedType::ZSTDDict,
+                column.getDictScope(),
+                getHandle())) {
                 return false;
             }
             compressedType = WCDBMergeCompressionType(toCompressedType, valueType);
@@ -584,7 +592,8 @@ int64_t curRowId)
 
 bool CompressHandleOperator::deleteCompressionRecord()
 {
-    return execute(CompressionRecord::getDropTableStatement());
+    return execute(CompressionRecord::getDropTableStatement())
+           && execute(CompressionDictRecord::getDropTableStatement());
 }
 
 bool CompressHandleOperator::execute(const Statement& statement)
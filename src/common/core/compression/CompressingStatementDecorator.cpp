@@ -27,6 +27,7 @@
 #include "CommonCore.hpp"
 #include "CompressionCenter.hpp"
 #include "CompressionConst.hpp"
+#include "CompressionDictRecord.hpp"
 #include "CompressionRecord.hpp"
 #include "InnerHandle.hpp"
 #include "StringView.hpp"
@@ -234,6 +235,7 @@ void CompressingStatementDecorator::bindText(const Text& value, int index)
                     compressedValue = CompressionCenter::shared().compressContent(
                     data,
                     info->columnInfo->getMatchDictId(info->bindedValue.intValue()),
+                    *info->columnInfo,
                     static_cast<InnerHandle*>(getHandle()));
                 } else {
                     compressedValue = data;
@@ -265,9 +267,15 @@ void CompressingStatementDecorator::bindText(const Text& value, int index)
             = info->columnInfo->getCompressionType() == CompressionType::Dict;
             Optional<UnsafeData> compressedValue;
             if (m_compressionBinder->canCompressNewData()) {
+                if (usingDict) {
+                    // New values are sampled as well, since the existing ones may have been compressed.
+                    m_compressionBinder->addDictSample(
+                    m_compressionTableInfo->getTable(), *info->columnInfo, data);
+                }
                 compressedValue = CompressionCenter::shared().compressContent(
                 data,
-                usingDict ? info->columnInfo->getDictId() : 0,
+                usingDict ? info->columnInfo->getCurrentDictId() : 0,
+                *info->columnInfo,
                 static_cast<InnerHandle*>(getHandle()));
             } else {
                 compressedValue = data;
@@ -344,6 +352,7 @@ void CompressingStatementDecorator::bindBLOB(const BLOB& value, int index)
                     compressedValue = CompressionCenter::shared().compressContent(
                     value,
                     info->columnInfo->getMatchDictId(info->bindedValue.intValue()),
+                    *info->columnInfo,
                     static_cast<InnerHandle*>(getHandle()));
                 } else {
                     compressedValue = value;
@@ -375,9 +384,15 @@ void CompressingStatementDecorator::bindBLOB(const BLOB& value, int index)
             = info->columnInfo->getCompressionType() == CompressionType::Dict;
             Optional<UnsafeData> compressedValue;
             if (m_compressionBinder->canCompressNewData()) {
+                if (usingDict) {
+                    // New values are sampled as well, since the existing ones may have been compressed.
+                    m_compressionBinder->addDictSample(
+                    m_compressionTableInfo->getTable(), *info->columnInfo, value);
+                }
                 compressedValue = CompressionCenter::shared().compressContent(
                 value,
-                usingDict ? info->columnInfo->getDictId() : 0,
+                usingDict ? info->columnInfo->getCurrentDictId() : 0,
+                *info->columnInfo,
                 static_cast<InnerHandle*>(getHandle()));
             } else {
                 compressedValue = value;
@@ -472,9 +487,6 @@ bool CompressingStatementDecorator::processInsert(const StatementInsert& insert)
 
     // Find compressing column
     if (m_compressionTableInfo != nullptr) {
-        WCTRemedialAssert(!insertSTMT.isMultiWrite(),
-                          "Insert statement that contains multiple values is not supported while using compression feature.",
-                          return false;);
         for (const auto& compressingColumn : m_compressionTableInfo->getColumnInfos()) {
             m_bindInfoList.emplace_back();
             m_bindInfoList.back().columnInfo = &compressingColumn;
@@ -526,26 +538,39 @@ bool CompressingStatementDecorator::processInsert(const StatementInsert& insert)
         directCompress = false;
     } else {
         WCTAssert(newInsertSTMT.switcher == Syntax::InsertSTMT::Switch::Values);
-        directCompress
-        = checkBindParametersExist(newInsertSTMT.expressionsValues.front());
+        directCompress = checkBindParametersExist(newInsertSTMT.expressionsValues);
+    }
+    if (needCompress && !directCompress) {
+        WCTRemedialAssert(!insertSTMT.isMultiWrite(),
+                          "Insert statement that contains multiple values is not supported while using compression feature.",
+                          return false;);
     }
 
     // Add compression related columns/statements
     if (directCompress) {
+        auto values = newInsertSTMT.expressionsValues.begin();
+        size_t bindInfoCountPerRow
+        = m_bindInfoList.size() / newInsertSTMT.expressionsValues.size();
+        size_t bindInfoIndex = 0;
         for (auto& bindInfo : m_bindInfoList) {
+            if (bindInfoIndex > 0 && bindInfoIndex % bindInfoCountPerRow == 0) {
+                values++;
+            }
             m_bindInfoMap.emplace(bindInfo.columnBindIndex, &bindInfo);
             if (bindInfo.matchColumnBindIndex > 0) {
                 WCTAssert(m_bindInfoMap.find(bindInfo.matchColumnBindIndex)
                           == m_bindInfoMap.end());
                 m_bindInfoMap.emplace(bindInfo.matchColumnBindIndex, &bindInfo);
             }
-            // INSERT INTO compressingTable(...columnA,..., columnB, ..., WCDB_CT_columnA, WCDB_CT_columnB, ...) VALUES(...)
-            newInsertSTMT.columns.push_back(Column(bindInfo.columnInfo->getTypeColumn()));
-            newInsertSTMT.expressionsValues.front().push_back(
-            Expression(BindParameter(++maxBindIndex)));
+            // INSERT INTO compressingTable(...columnA,..., columnB, ..., WCDB_CT_columnA, WCDB_CT_columnB, ...) VALUES(...), (...), ...
+            if (bindInfoIndex < bindInfoCountPerRow) {
+                newInsertSTMT.columns.push_back(Column(bindInfo.columnInfo->getTypeColumn()));
+            }
+            values->push_back(Expression(BindParameter(++maxBindIndex)));
             bindInfo.typeBindIndex = maxBindIndex;
             WCTAssert(m_bindInfoMap.find(maxBindIndex) == m_bindInfoMap.end());
             m_bindInfoMap.emplace(maxBindIndex, &bindInfo);
+            bindInfoIndex++;
         }
         if (!Super::prepare(newInsert)) {
             return false;
@@ -755,10 +780,36 @@ bool CompressingStatementDecorator::processUpdate(const StatementUpdate& update)
     return true;
 }
 
+bool CompressingStatementDecorator::checkBindParametersExist(
+std::list<std::list<Syntax::Expression>>& expsList)
+{
+    WCTAssert(!expsList.empty());
+    auto exps = expsList.begin();
+    // Bind infos of the following rows are copied from the first row, whose bind indexes will be overwritten.
+    const std::list<BindInfo> firstRowBindInfos = m_bindInfoList;
+    if (!checkBindParametersExist(*exps, m_bindInfoList)) {
+        return false;
+    }
+    for (++exps; exps != expsList.end(); ++exps) {
+        std::list<BindInfo> bindInfos = firstRowBindInfos;
+        if (!checkBindParametersExist(*exps, bindInfos)) {
+            return false;
+        }
+        m_bindInfoList.splice(m_bindInfoList.end(), bindInfos);
+    }
+    return true;
+}
+
 bool CompressingStatementDecorator::checkBindParametersExist(std::list<Syntax::Expression>& exps)
+{
+    return checkBindParametersExist(exps, m_bindInfoList);
+}
+
+bool CompressingStatementDecorator::checkBindParametersExist(std::list<Syntax::Expression>& exps,
+                                                             std::list<BindInfo>& bindInfos)
 {
     bool ret = true;
-    for (auto& bindInfo : m_bindInfoList) {
+    for (auto& bindInfo : bindInfos) {
         //Check column value
         auto bindIndex = getBindParameter(exps, bindInfo.columnParaIndex);
         if (bindIndex.failed()) {
@@ -928,6 +979,17 @@ bool CompressingStatementDecorator::processAlterTable(const StatementAlterTable&
         }
         return false;
     }
+    auto dictExists = getHandle()->tableExists(CompressionDictRecord::tableName);
+    if (dictExists.failed()) {
+        return false;
+    }
+    if (dictExists.value()) {
+        HandleStatement& updateDict = addNewHandleStatement();
+        if (!updateDict.prepare(CompressionDictRecord::getUpdateTableStatement(
+            alterTable.syntax().table, alterTable.syntax().newTable))) {
+            return false;
+        }
+    }
     return true;
 }
 
@@ -1091,6 +1153,10 @@ bool CompressingStatementDecorator::adaptCompressingColumn(Statement& statement,
         expression.expressions.push_back(
         Expression(Column(compressingColumn.getTypeColumn())));
         expression.expressions.back().column().table = table;
+        if (compressingColumn.isAutoTrainDictEnabled()) {
+            expression.expressions.push_back(
+            Expression(LiteralValue((int64_t) compressingColumn.getDictScope())));
+        }
         expression.useWildcard = false;
     }
 
@@ -1151,6 +1217,7 @@ void CompressingStatementDecorator::bindValueInInfo(const BindInfo* info, const
         compressedValue = CompressionCenter::shared().compressContent(
         data,
         info->columnInfo->getMatchDictId(matchValue),
+        *info->columnInfo,
         static_cast<InnerHandle*>(getHandle()));
     } else {
         compressedValue = data;
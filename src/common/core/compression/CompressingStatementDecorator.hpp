@@ -85,6 +85,7 @@ protected:
                                 const CompressionTableInfo *curInfo = nullptr);
     typedef StringViewMap<const CompressionTableInfo *> TableInfos;
     bool parseTable(const std::list<Syntax::TableOrSubquery> &tables, TableInfos &tableInfos);
+    bool checkBindParametersExist(std::list<std::list<Syntax::Expression>> &expsList);
     bool checkBindParametersExist(std::list<Syntax::Expression> &exps);
     Optional<int>
     getBindParameter(std::list<Syntax::Expression> &exps, std::pair<int, int> &index);
@@ -102,6 +103,9 @@ protected:
         const CompressionColumnInfo *columnInfo = nullptr;
     } BindInfo;
 
+    bool checkBindParametersExist(std::list<Syntax::Expression> &exps,
+                                  std::list<BindInfo> &bindInfos);
+
     static const int SelectedMatchValueBindIndex = INT_MAX;
     void bindValueInInfo(const BindInfo *bindInfo, const Integer &matchValue);
 
@@ -24,10 +24,13 @@
 
 #include "Compression.hpp"
 #include "Assertion.hpp"
+#include "CompressionCenter.hpp"
 #include "CompressionConst.hpp"
+#include "CompressionDictRecord.hpp"
 #include "CompressionRecord.hpp"
 #include "InnerHandle.hpp"
 #include "Notifier.hpp"
+#include "SQLite.h"
 #include "WCDBError.hpp"
 
 namespace WCDB {
@@ -38,6 +41,8 @@ CompressionEvent::~CompressionEvent() = default;
 Compression::Compression(CompressionEvent* event)
 : m_dataVersion(0)
 , m_hasCreatedRecord(false)
+, m_dictScope(CompressionCenter::shared().newTrainedDictScope())
+, m_hasLoadedDicts(false)
 , m_canCompressNewData(true)
 , m_tableAcquired(false)
 , m_compressed(false)
@@ -45,6 +50,11 @@ Compression::Compression(CompressionEvent* event)
 {
 }
 
+Compression::~Compression()
+{
+    CompressionCenter::shared().unregisterTrainedDicts(m_dictScope);
+}
+
 void Compression::setTableFilter(const TableFilter& tableFilter)
 {
     LockGuard lockGuard(m_lock);
@@ -62,6 +72,9 @@ void Compression::purge()
 {
     LockGuard lockGuard(m_lock);
     m_hasCreatedRecord = false;
+    m_hasLoadedDicts = false;
+    m_trainedDicts.clear();
+    m_dictTrainer.clear();
     m_tableAcquired = false;
     m_compressed = false;
     m_compressings.clear();
@@ -122,6 +135,10 @@ bool Compression::initInfo(InfoInitializer& initializer, const UnsafeStringView&
         return false;
     }
 
+    if (!tryLoadTrainedDicts(initializer)) {
+        return false;
+    }
+
     LockGuard lockGuard(m_lock);
     auto iter = m_filted.find(targetTable);
     if (iter == m_filted.end()) {
@@ -139,6 +156,7 @@ bool Compression::initInfo(InfoInitializer& initializer, const UnsafeStringView&
             WCTAssert(userInfo.shouldCompress());
             m_holder.emplace_back(userInfo);
             const CompressionTableInfo* hold = &m_holder.back();
+            applyTrainedDicts(hold);
             m_filted.insert_or_assign(targetTable, hold);
             m_hints.erase(targetTable);
         }
@@ -298,6 +316,72 @@ bool Compression::tryCreateRecordTable(InfoInitializer& initializer)
     return true;
 }
 
+#pragma mark - Trained Dict
+bool Compression::tryLoadTrainedDicts(InfoInitializer& initializer)
+{
+    if (m_hasLoadedDicts) {
+        return true;
+    }
+    auto exist = initializer.tableExist(CompressionDictRecord::tableName);
+    if (exist.failed()) {
+        return false;
+    }
+    InnerHandle* currentHandle = initializer.getCurrentHandle();
+    WCTAssert(currentHandle != nullptr);
+    // The dicts trained later are also registered in this scope.
+    CompressionCenter::shared().bindTrainedDictScope(
+    sqlite3_db_filename(currentHandle->getRawHandle(), "main"), m_dictScope);
+    StringViewMap<StringViewMap<CompressionColumnInfo::DictId>> trainedDicts;
+    if (exist.value()) {
+        HandleStatement select(currentHandle);
+        if (!select.prepare(CompressionDictRecord::getSelectAllDictsStatement())) {
+            return false;
+        }
+        bool succeed = false;
+        while ((succeed = select.step()) && !select.done()) {
+            int64_t dictId = select.getInteger(0);
+            if (dictId < CompressionCenter::MinTrainedDictId
+                || dictId >= CompressionCenter::MaxTrainedDictId) {
+                continue;
+            }
+            // Errors are reported by the center, and the values compressed by it can not be decompressed.
+            if (!CompressionCenter::shared().registerTrainedDict(
+                m_dictScope, (CompressionColumnInfo::DictId) dictId, select.getBLOB(3))) {
+                continue;
+            }
+            // Dicts are sorted by create time, so the latest one takes effect.
+            trainedDicts[select.getText(1)][select.getText(2)]
+            = (CompressionColumnInfo::DictId) dictId;
+        }
+        select.finalize();
+        if (!succeed) {
+            return false;
+        }
+    }
+    LockGuard lockGuard(m_lock);
+    m_trainedDicts = std::move(trainedDicts);
+    m_hasLoadedDicts = true;
+    return true;
+}
+
+void Compression::applyTrainedDicts(const CompressionTableInfo* info)
+{
+    auto tableIter = m_trainedDicts.find(info->getTable());
+    for (const auto& column : info->getColumnInfos()) {
+        if (!column.isAutoTrainDictEnabled()) {
+            continue;
+        }
+        column.setDictScope(m_dictScope);
+        if (tableIter == m_trainedDicts.end()) {
+            continue;
+        }
+        auto iter = tableIter->second.find(column.getColumn());
+        if (iter != tableIter->second.end()) {
+            column.setCurrentDictId(iter->second);
+        }
+    }
+}
+
 #pragma mark - InfoInitializer
 Compression::InfoInitializer::~InfoInitializer() = default;
 
@@ -402,6 +486,13 @@ bool Compression::Binder::canCompressNewData() const
     return m_compression.canCompressNewData();
 }
 
+void Compression::Binder::addDictSample(const UnsafeStringView& table,
+                                        const CompressionColumnInfo& column,
+                                        const UnsafeData& value)
+{
+    m_compression.m_dictTrainer.addSample(table, column, value);
+}
+
 bool Compression::canCompressNewData() const
 {
     return m_canCompressNewData;
@@ -413,8 +504,21 @@ void Compression::setCanCompressNewData(bool canCompress)
 }
 
 #pragma mark - Step
+Compression::Stepper::Stepper() : m_dictTrainer(nullptr)
+{
+}
+
 Compression::Stepper::~Stepper() = default;
 
+void Compression::Stepper::addDictSample(const UnsafeStringView& table,
+                                         const CompressionColumnInfo& column,
+                                         const UnsafeData& value)
+{
+    if (m_dictTrainer != nullptr) {
+        m_dictTrainer->addSample(table, column, value);
+    }
+}
+
 Optional<bool> Compression::step(Compression::Stepper& stepper)
 {
     auto worked = tryCompressRows(stepper);
@@ -561,6 +665,8 @@ Optional<bool> Compression::tryCompressRows(Compression::Stepper& stepper)
         return NullOpt;
     }
 
+    m_dictTrainer.tryRotateDicts(handle, info);
+    stepper.m_dictTrainer = &m_dictTrainer;
     auto compressed = stepper.compressRows(info);
     if (compressed.failed()) {
         return NullOpt;
@@ -571,6 +677,22 @@ Optional<bool> Compression::tryCompressRows(Compression::Stepper& stepper)
     return true;
 }
 
+#pragma mark - Statistics
+std::list<Compression::ColumnStatistics> Compression::getStatistics() const
+{
+    std::list<ColumnStatistics> statistics;
+    SharedLockGuard lockGuard(m_lock);
+    for (const auto& info : m_holder) {
+        for (const auto& column : info.getColumnInfos()) {
+            statistics.emplace_back();
+            statistics.back().table = info.getTable();
+            statistics.back().column = column.getColumn();
+            statistics.back().snapshot = column.getStatistics().getSnapshot();
+        }
+    }
+    return statistics;
+}
+
 #pragma mark - Event
 bool Compression::isCompressed() const
 {
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "CompressionDictTrainer.hpp"
 #include "CompressionInfo.hpp"
 #include "Lock.hpp"
 #include "Progress.hpp"
@@ -50,6 +51,7 @@ class Compression final : public Progress {
 #pragma mark - Initialize
 public:
     Compression(CompressionEvent* event);
+    ~Compression();
 
     typedef std::function<void(CompressionTableUserInfo&)> TableFilter;
     void setTableFilter(const TableFilter& tableFilter);
@@ -103,6 +105,19 @@ private:
     volatile bool m_hasCreatedRecord;
     ThreadLocal<bool> m_localHasCreatedRecord;
 
+#pragma mark - Trained Dict
+protected:
+    // Register the auto-trained dicts saved in database, which are necessary to decompress the data.
+    bool tryLoadTrainedDicts(InfoInitializer& initializer);
+    void applyTrainedDicts(const CompressionTableInfo* info);
+
+private:
+    const uint32_t m_dictScope;
+    volatile bool m_hasLoadedDicts;
+    // table -> column -> latest trained dict
+    StringViewMap<StringViewMap<CompressionColumnInfo::DictId>> m_trainedDicts;
+    CompressionDictTrainer m_dictTrainer;
+
 #pragma mark - Bind
 public:
     class Binder : public InfoInitializer {
@@ -119,6 +134,9 @@ public:
         tryGetCompressingColumnsForNewTable(const UnsafeStringView& table);
         void notifyTransactionCommitted(bool committed);
         bool canCompressNewData() const;
+        void addDictSample(const UnsafeStringView& table,
+                           const CompressionColumnInfo& column,
+                           const UnsafeData& value);
 
     private:
         Compression& m_compression;
@@ -136,9 +154,14 @@ public:
         friend class Compression;
 
     public:
+        Stepper();
         virtual ~Stepper() override = 0;
 
     protected:
+        void addDictSample(const UnsafeStringView& table,
+                           const CompressionColumnInfo& column,
+                           const UnsafeData& value);
+
         virtual Optional<StringViewSet> getAllTables() = 0;
         virtual bool
         filterComplessingTables(std::set<const CompressionTableInfo*>& allTableInfos)
@@ -148,6 +171,9 @@ public:
         typedef std::function<void(double)> ProgressCallback;
         virtual bool rollbackCompression(const CompressionTableInfo* info) = 0;
         virtual bool deleteCompressionRecord() = 0;
+
+    private:
+        CompressionDictTrainer* m_dictTrainer;
     };
 
     Optional<bool> step(Compression::Stepper& stepper);
@@ -163,6 +189,16 @@ private:
     bool m_tableAcquired;
     bool m_compressed;
 
+#pragma mark - Statistics
+public:
+    typedef struct ColumnStatistics {
+        StringView table;
+        StringView column;
+        CompressionColumnStatistics::Snapshot snapshot;
+    } ColumnStatistics;
+    // Statistics of the compressing columns of the tables that have been read or written.
+    std::list<ColumnStatistics> getStatistics() const;
+
 #pragma mark - Event
 public:
     bool isCompressed() const;
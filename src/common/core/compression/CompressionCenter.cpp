@@ -24,9 +24,12 @@
 
 #include "CompressionCenter.hpp"
 #include "Assertion.hpp"
+#include "CompressionInfo.hpp"
+#include "CoreConst.h"
 #include "InnerHandle.hpp"
 #include "Notifier.hpp"
 #include "ScalarFunctionModule.hpp"
+#include "Time.hpp"
 #include "WCDBError.hpp"
 #include <string.h>
 #if defined(WCDB_ZSTD) && WCDB_ZSTD
@@ -37,14 +40,17 @@
 
 namespace WCDB {
 
-CompressionCenter::CompressionCenter()
+CompressionCenter::CompressionCenter() : m_lastDictScope(0)
 {
-    m_dicts = (ZSTDDict**) calloc(MaxDictId, sizeof(ZSTDDict*));
+    m_dicts = (ZSTDDict**) calloc(MaxTrainedDictId, sizeof(ZSTDDict*));
     WCTAssert(m_dicts != nullptr);
 }
 
 CompressionCenter::~CompressionCenter()
 {
+    for (auto& iter : m_trainedDicts) {
+        delete iter.second;
+    }
     free(m_dicts);
 }
 
@@ -54,12 +60,20 @@ CompressionCenter& CompressionCenter::shared()
     return *g_dictCenter;
 }
 
-ZSTDDict* CompressionCenter::getDict(DictId id) const
+ZSTDDict* CompressionCenter::getDict(DictId id, uint32_t dictScope) const
 {
-    if (id >= MaxDictId || id == 0) {
+    if (id >= MaxTrainedDictId || id == 0) {
         return nullptr;
     }
-    return m_dicts[id];
+    if (id < MinTrainedDictId) {
+        return m_dicts[id];
+    }
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_trainedDicts.find(getTrainedDictKey(dictScope, id));
+    if (iter == m_trainedDicts.end()) {
+        return nullptr;
+    }
+    return iter->second;
 }
 
 bool CompressionCenter::registerDict(DictId dictId, const UnsafeData& data)
@@ -109,6 +123,11 @@ Optional<Data> CompressionCenter::trainDict(DictId dictId, TrainDataEnumerator d
         SharedThreadedErrorProne::setThreadedError(std::move(error));
         return NullOpt;
     }
+    return doTrainDict(dictId, dataEnummerator);
+}
+
+Optional<Data> CompressionCenter::doTrainDict(DictId dictId, TrainDataEnumerator dataEnummerator)
+{
     int64_t totalSize = 0;
     std::vector<size_t> dataSizes;
 
@@ -173,8 +192,11 @@ Optional<Data> CompressionCenter::trainDict(DictId dictId, TrainDataEnumerator d
     return dict;
 }
 
-Optional<UnsafeData>
-CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerHandle* errorReportHandle)
+Optional<UnsafeData> CompressionCenter::doCompressContent(const UnsafeData& data,
+                                                          DictId dictId,
+                                                          uint32_t dictScope,
+                                                          int level,
+                                                          InnerHandle* errorReportHandle)
 {
     if (data.size() == 0) {
         return data;
@@ -197,7 +219,7 @@ CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerH
     }
     int64_t compressSize = 0;
     if (dictId > 0) {
-        ZSTDDict* dict = getDict(dictId);
+        ZSTDDict* dict = getDict(dictId, dictScope);
         if (dict == nullptr) {
             errorReportHandle->notifyError(
             Error::Code::ZstdError,
@@ -219,11 +241,10 @@ CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerH
                                                 data.size(),
                                                 (ZSTD_CDict*) dict->getCDict());
     } else {
-        compressSize = ZSTD_compress2((ZSTD_CCtx*) ctx.getOrCreateCCtx(),
-                                      buffer,
-                                      boundSize,
-                                      data.buffer(),
-                                      data.size());
+        ZSTD_CCtx* cctx = (ZSTD_CCtx*) ctx.getOrCreateCCtx();
+        ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+        compressSize
+        = ZSTD_compress2(cctx, buffer, boundSize, data.buffer(), data.size());
     }
     if (ZSTD_isError(compressSize)) {
         errorReportHandle->notifyError(
@@ -240,9 +261,20 @@ CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerH
 
 void CompressionCenter::decompressContent(const UnsafeData& data,
                                           bool usingDict,
+                                          uint32_t dictScope,
                                           ColumnType originType,
                                           ScalarFunctionAPI& resultAPI)
 {
+    bool cacheEnabled = m_decompressionCache.isEnabled();
+    // The same content compressed by trained dicts of different scopes may be decompressed into different values.
+    uint32_t cacheScope = usingDict ? dictScope : 0;
+    if (cacheEnabled) {
+        auto cached = m_decompressionCache.get(data, cacheScope);
+        if (cached.succeed()) {
+            setDecompressedResult(cached.value(), originType, resultAPI);
+            return;
+        }
+    }
     int64_t frameSize = ZSTD_getFrameContentSize(data.buffer(), data.size());
     if (ZSTD_isError(frameSize)) {
         resultAPI.setErrorResult(Error::Code::ZstdError,
@@ -263,7 +295,7 @@ void CompressionCenter::decompressContent(const UnsafeData& data,
             resultAPI.setErrorResult(Error::Code::ZstdError, "Can not decode dictid");
             return;
         }
-        ZSTDDict* dict = getDict(dictId);
+        ZSTDDict* dict = getDict(dictId, dictScope);
         if (dict == nullptr) {
             resultAPI.setErrorResult(
             Error::Code::ZstdError,
@@ -292,16 +324,18 @@ void CompressionCenter::decompressContent(const UnsafeData& data,
                                           ZSTD_getErrorName(decompressSize)));
         Notifier::shared().notify(error);
         decompressSize = 0;
+    } else if (cacheEnabled) {
+        m_decompressionCache.put(
+        data, cacheScope, UnsafeData((unsigned char*) buffer, decompressSize));
     }
-    if (originType == ColumnType::Text) {
-        resultAPI.setTextResult(UnsafeStringView((char*) buffer, decompressSize));
-    } else {
-        resultAPI.setBlobResult(UnsafeData((unsigned char*) buffer, decompressSize));
-    }
+    setDecompressedResult(
+    UnsafeData((unsigned char*) buffer, decompressSize), originType, resultAPI);
 }
 
-Optional<UnsafeData>
-CompressionCenter::decompressContent(const UnsafeData& data, bool usingDict, InnerHandle* handle)
+Optional<UnsafeData> CompressionCenter::decompressContent(const UnsafeData& data,
+                                                          bool usingDict,
+                                                          uint32_t dictScope,
+                                                          InnerHandle* handle)
 {
     int64_t frameSize = ZSTD_getFrameContentSize(data.buffer(), data.size());
     if (ZSTD_isError(frameSize)) {
@@ -324,7 +358,7 @@ CompressionCenter::decompressContent(const UnsafeData& data, bool usingDict, Inn
             handle->notifyError(Error::Code::ZstdError, nullptr, "Can not decode dictid");
             return NullOpt;
         }
-        ZSTDDict* dict = getDict(dictId);
+        ZSTDDict* dict = getDict(dictId, dictScope);
         if (dict == nullptr) {
             handle->notifyError(
             Error::Code::ZstdError,
@@ -360,6 +394,7 @@ CompressionCenter::decompressContent(const UnsafeData& data, bool usingDict, Inn
 
 bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
                                                      bool usingDict,
+                                                     uint32_t dictScope,
                                                      InnerHandle* errorReportHandle)
 {
     int64_t frameSize = ZSTD_getFrameContentSize(data.buffer(), data.size());
@@ -384,7 +419,7 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
             errorReportHandle->notifyError(Error::Code::ZstdError, "", "Can not decode dictid");
             return false;
         }
-        ZSTDDict* dict = getDict(dictId);
+        ZSTDDict* dict = getDict(dictId, dictScope);
         if (dict == nullptr) {
             errorReportHandle->notifyError(
             Error::Code::ZstdError,
@@ -416,8 +451,72 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData& data,
     return true;
 }
 
+Optional<size_t> CompressionCenter::doGetCompressedSize(const std::vector<Data>& samples,
+                                                        const ZSTDDict* dict,
+                                                        InnerHandle* errorReportHandle)
+{
+    ZSTDContext& ctx = m_ctxes.getOrCreate();
+    size_t totalSize = 0;
+    for (const auto& sample : samples) {
+        int64_t boundSize = ZSTD_compressBound(sample.size());
+        if (ZSTD_isError(boundSize)) {
+            errorReportHandle->notifyError(
+            Error::Code::ZstdError,
+            nullptr,
+            StringView::formatted("Compress bound fail: %s", ZSTD_getErrorName(boundSize)));
+            return NullOpt;
+        }
+        void* buffer = ctx.getOrCreateBuffer(boundSize);
+        if (buffer == nullptr) {
+            errorReportHandle->notifyError(
+            Error::Code::NoMemory, nullptr, "Compress fail due to no memory");
+            return NullOpt;
+        }
+        int64_t compressSize = 0;
+        if (dict != nullptr) {
+            compressSize = ZSTD_compress_usingCDict((ZSTD_CCtx*) ctx.getOrCreateCCtx(),
+                                                    buffer,
+                                                    boundSize,
+                                                    sample.buffer(),
+                                                    sample.size(),
+                                                    (ZSTD_CDict*) dict->getCDict());
+        } else {
+            ZSTD_CCtx* cctx = (ZSTD_CCtx*) ctx.getOrCreateCCtx();
+            ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+            compressSize
+            = ZSTD_compress2(cctx, buffer, boundSize, sample.buffer(), sample.size());
+        }
+        if (ZSTD_isError(compressSize)) {
+            errorReportHandle->notifyError(
+            Error::Code::ZstdError,
+            nullptr,
+            StringView::formatted("Compress fail: %s", ZSTD_getErrorName(compressSize)));
+            return NullOpt;
+        }
+        // Content that can not be compressed is saved as it is.
+        totalSize += std::min<size_t>(compressSize, sample.size());
+    }
+    return totalSize;
+}
+
 #else
 
+Optional<size_t>
+CompressionCenter::doGetCompressedSize(const std::vector<Data>&, const ZSTDDict*, InnerHandle* errorReportHandle)
+{
+    errorReportHandle->notifyError(
+    Error::Code::ZstdError, nullptr, "You need to build WCDB with WCDB_ZSTD macro");
+    return NullOpt;
+}
+
+Optional<Data> CompressionCenter::doTrainDict(DictId, TrainDataEnumerator)
+{
+    Error error(Error::Code::ZstdError, Error::Level::Error, "You need to build WCDB with WCDB_ZSTD macro");
+    Notifier::shared().notify(error);
+    SharedThreadedErrorProne::setThreadedError(std::move(error));
+    return NullOpt;
+}
+
 Optional<Data> CompressionCenter::trainDict(DictId, TrainDataEnumerator)
 {
     Error error(Error::Code::ZstdError, Error::Level::Error, "You need to build WCDB with WCDB_ZSTD macro");
@@ -427,7 +526,7 @@ Optional<Data> CompressionCenter::trainDict(DictId, TrainDataEnumerator)
 }
 
 Optional<UnsafeData>
-CompressionCenter::compressContent(const UnsafeData&, DictId, InnerHandle* errorReportHandle)
+CompressionCenter::doCompressContent(const UnsafeData&, DictId, uint32_t, int, InnerHandle* errorReportHandle)
 {
     errorReportHandle->notifyError(
     Error::Code::ZstdError, nullptr, "You need to build WCDB with WCDB_ZSTD macro");
@@ -435,20 +534,24 @@ CompressionCenter::compressContent(const UnsafeData&, DictId, InnerHandle* error
 }
 
 Optional<UnsafeData>
-CompressionCenter::decompressContent(const UnsafeData& data, bool usingDict, InnerHandle* handle)
+CompressionCenter::decompressContent(const UnsafeData&, bool, uint32_t, InnerHandle* handle)
 {
     handle->notifyError(
     Error::Code::ZstdError, nullptr, "You need to build WCDB with WCDB_ZSTD macro");
     return NullOpt;
 }
 
-void CompressionCenter::decompressContent(const UnsafeData&, bool, ColumnType, ScalarFunctionAPI& resultAPI)
+void CompressionCenter::decompressContent(
+const UnsafeData&, bool, uint32_t, ColumnType, ScalarFunctionAPI& resultAPI)
 {
     resultAPI.setErrorResult(Error::Code::ZstdError,
                              "You need to build WCDB with WCDB_ZSTD macro");
 }
 
-bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData&, bool, InnerHandle* errorReportHandle)
+bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData&,
+                                                     bool,
+                                                     uint32_t,
+                                                     InnerHandle* errorReportHandle)
 {
     errorReportHandle->notifyError(
     Error::Code::ZstdError, "", "You need to build WCDB with WCDB_ZSTD macro");
@@ -457,4 +560,233 @@ bool CompressionCenter::testContentCanBeDecompressed(const UnsafeData&, bool, In
 
 #endif
 
+Optional<UnsafeData>
+CompressionCenter::compressContent(const UnsafeData& data, DictId dictId, InnerHandle* errorReportHandle)
+{
+    return doCompressContent(data, dictId, 0, CompressionDefaultLevel, errorReportHandle);
+}
+
+Optional<UnsafeData> CompressionCenter::compressContent(const UnsafeData& data,
+                                                        DictId dictId,
+                                                        const CompressionColumnInfo& column,
+                                                        InnerHandle* errorReportHandle)
+{
+    CompressionColumnStatistics& statistics = column.getStatistics();
+    if (data.size() == 0 || data.size() < column.getMinCompressSize()
+        || CompressionColumnStatistics::isLikelyCompressed(data)
+        || !statistics.shouldTryCompress()) {
+        statistics.addSkipped(data.size());
+        return data;
+    }
+    // The cost is only used to choose level, which doesn't work with dict.
+    bool measureCost = dictId == 0 && statistics.isAutoLevel();
+    SteadyClock start;
+    if (measureCost) {
+        start = SteadyClock::now();
+    }
+    auto compressed = doCompressContent(
+    data, dictId, column.getDictScope(), statistics.getLevel(), errorReportHandle);
+    if (compressed.failed()) {
+        return NullOpt;
+    }
+    int64_t cost = 0;
+    if (measureCost) {
+        cost = (int64_t) (SteadyClock::timeIntervalSinceSteadyClockToNow(start) * 1E9);
+    }
+    size_t compressedSize = compressed.value().size();
+    bool accepted = compressedSize < data.size()
+                    && compressedSize <= data.size() * column.getMaxCompressedRatio();
+    statistics.addResult(data.size(), compressedSize, accepted, cost);
+    if (!accepted) {
+        return data;
+    }
+    return compressed;
+}
+
+#pragma mark - Decompression Cache
+void CompressionCenter::setDecompressionCacheSize(size_t size)
+{
+    m_decompressionCache.setCapacity(size);
+}
+
+DecompressionCache::Statistics CompressionCenter::getDecompressionCacheStatistics() const
+{
+    return m_decompressionCache.getStatistics();
+}
+
+void CompressionCenter::setDecompressedResult(const UnsafeData& data,
+                                              ColumnType originType,
+                                              ScalarFunctionAPI& resultAPI)
+{
+    if (originType == ColumnType::Text) {
+        resultAPI.setTextResult(UnsafeStringView((const char*) data.buffer(), data.size()));
+    } else {
+        resultAPI.setBlobResult(data);
+    }
+}
+
+#pragma mark - Trained Dict
+uint64_t CompressionCenter::getTrainedDictKey(uint32_t dictScope, DictId dictId)
+{
+    return ((uint64_t) dictScope << 16) | dictId;
+}
+
+uint32_t CompressionCenter::newTrainedDictScope()
+{
+    return ++m_lastDictScope;
+}
+
+void CompressionCenter::unregisterTrainedDicts(uint32_t dictScope)
+{
+    LockGuard lockGuard(m_lock);
+    for (auto iter = m_trainedDicts.begin(); iter != m_trainedDicts.end();) {
+        if ((iter->first >> 16) == dictScope) {
+            delete iter->second;
+            m_trainedDictHashes.erase(iter->first);
+            iter = m_trainedDicts.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+    for (auto iter = m_reservedDictIds.begin(); iter != m_reservedDictIds.end();) {
+        if ((*iter >> 16) == dictScope) {
+            iter = m_reservedDictIds.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+    for (auto iter = m_trainedDictScopes.begin(); iter != m_trainedDictScopes.end();) {
+        if (iter->second == dictScope) {
+            iter = m_trainedDictScopes.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+}
+
+void CompressionCenter::bindTrainedDictScope(const UnsafeStringView& path, uint32_t dictScope)
+{
+    if (path.empty()) {
+        return;
+    }
+    LockGuard lockGuard(m_lock);
+    m_trainedDictScopes[path] = dictScope;
+}
+
+uint32_t
+CompressionCenter::getTrainedDictScope(const UnsafeData& data, const UnsafeStringView& path) const
+{
+#if defined(WCDB_ZSTD) && WCDB_ZSTD
+    DictId dictId = (DictId) ZSTD_getDictID_fromFrame(data.buffer(), data.size());
+    if (dictId < MinTrainedDictId || dictId >= MaxTrainedDictId || path.empty()) {
+        return 0;
+    }
+    SharedLockGuard lockGuard(m_lock);
+    auto iter = m_trainedDictScopes.find(path);
+    if (iter == m_trainedDictScopes.end()) {
+        return 0;
+    }
+    return iter->second;
+#else
+    WCDB_UNUSED(data);
+    WCDB_UNUSED(path);
+    return 0;
+#endif
+}
+
+Optional<CompressionCenter::DictId>
+CompressionCenter::reserveTrainedDictId(uint32_t dictScope, uint32_t seed)
+{
+    static constexpr const uint32_t kTrainedDictIdRange = MaxTrainedDictId - MinTrainedDictId;
+    LockGuard lockGuard(m_lock);
+    for (uint32_t i = 0; i < kTrainedDictIdRange; i++) {
+        DictId dictId = (DictId) (MinTrainedDictId + (seed + i) % kTrainedDictIdRange);
+        uint64_t key = getTrainedDictKey(dictScope, dictId);
+        if (m_trainedDicts.find(key) == m_trainedDicts.end()
+            && m_reservedDictIds.find(key) == m_reservedDictIds.end()) {
+            m_reservedDictIds.insert(key);
+            return dictId;
+        }
+    }
+    Error error(Error::Code::ZstdError, Error::Level::Warning, "No free id for trained dict");
+    Notifier::shared().notify(error);
+    SharedThreadedErrorProne::setThreadedError(std::move(error));
+    return NullOpt;
+}
+
+void CompressionCenter::unreserveTrainedDictId(uint32_t dictScope, DictId dictId)
+{
+    LockGuard lockGuard(m_lock);
+    m_reservedDictIds.erase(getTrainedDictKey(dictScope, dictId));
+}
+
+Optional<Data> CompressionCenter::trainRotatingDict(DictId dictId, TrainDataEnumerator dataEnummerator)
+{
+    WCTAssert(dictId >= MinTrainedDictId && dictId < MaxTrainedDictId);
+    return doTrainDict(dictId, dataEnummerator);
+}
+
+bool CompressionCenter::registerTrainedDict(uint32_t dictScope, DictId dictId, const UnsafeData& data)
+{
+    WCTAssert(dictId >= MinTrainedDictId && dictId < MaxTrainedDictId);
+    uint64_t key = getTrainedDictKey(dictScope, dictId);
+    LockGuard lockGuard(m_lock);
+    auto iter = m_trainedDictHashes.find(key);
+    if (iter != m_trainedDictHashes.end()) {
+        if (iter->second == data.hash()) {
+            // The dicts of database are loaded again after it's purged.
+            return true;
+        }
+        Error error(Error::Code::ZstdError, Error::Level::Error, "Conflicting trained dict!");
+        error.infos.insert_or_assign("DictId", dictId);
+        Notifier::shared().notify(error);
+        SharedThreadedErrorProne::setThreadedError(std::move(error));
+        return false;
+    }
+    ZSTDDict* dict = new ZSTDDict;
+    if (!dict->loadData(data)) {
+        delete dict;
+        return false;
+    }
+    if (dictId != dict->getDictId()) {
+        Error error(Error::Code::ZstdError, Error::Level::Error, "DictId mismatch!");
+        error.infos.insert_or_assign("GivenDictId", dictId);
+        error.infos.insert_or_assign("ActualDictId", dict->getDictId());
+        Notifier::shared().notify(error);
+        SharedThreadedErrorProne::setThreadedError(std::move(error));
+        delete dict;
+        return false;
+    }
+    m_trainedDicts[key] = dict;
+    m_trainedDictHashes[key] = data.hash();
+    m_reservedDictIds.erase(key);
+    return true;
+}
+
+Optional<size_t> CompressionCenter::getCompressedSize(const std::vector<Data>& samples,
+                                                      DictId dictId,
+                                                      uint32_t dictScope,
+                                                      InnerHandle* errorReportHandle)
+{
+    ZSTDDict* dict = nullptr;
+    if (dictId > 0) {
+        dict = getDict(dictId, dictScope);
+        if (dict == nullptr) {
+            errorReportHandle->notifyError(
+            Error::Code::ZstdError,
+            nullptr,
+            StringView::formatted("Can not find compress dict with id: %d", dictId));
+            return NullOpt;
+        }
+    }
+    return doGetCompressedSize(samples, dict, errorReportHandle);
+}
+
+Optional<size_t> CompressionCenter::getCompressedSize(const std::vector<Data>& samples,
+                                                      const ZSTDDict& dict,
+                                                      InnerHandle* errorReportHandle)
+{
+    return doGetCompressedSize(samples, &dict, errorReportHandle);
+}
+
 } // namespace WCDB
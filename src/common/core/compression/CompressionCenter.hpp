@@ -26,15 +26,22 @@
 
 #include "ColumnType.hpp"
 #include "CompressionConst.hpp"
+#include "DecompressionCache.hpp"
+#include "Lock.hpp"
 #include "ThreadLocal.hpp"
 #include "ZSTDContext.hpp"
 #include "ZSTDDict.hpp"
+#include <atomic>
 #include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace WCDB {
 
 class ScalarFunctionAPI;
 class InnerHandle;
+class CompressionColumnInfo;
 
 class CompressionCenter : public SharedThreadedErrorProne {
 public:
@@ -54,21 +61,99 @@ public:
 
     Optional<UnsafeData>
     compressContent(const UnsafeData& data, DictId dictId, InnerHandle* errorReportHandle);
+    // The original data will be returned if the compression is not worthy for the column.
+    Optional<UnsafeData> compressContent(const UnsafeData& data,
+                                         DictId dictId,
+                                         const CompressionColumnInfo& column,
+                                         InnerHandle* errorReportHandle);
+    // Trained dicts are looked up in the given scope, while the ones registered by user are shared by all scopes.
     void decompressContent(const UnsafeData& data,
                            bool usingDict,
+                           uint32_t dictScope,
                            ColumnType originType,
                            ScalarFunctionAPI& resultAPI);
-    Optional<UnsafeData>
-    decompressContent(const UnsafeData& data, bool usingDict, InnerHandle* handle);
+    Optional<UnsafeData> decompressContent(const UnsafeData& data,
+                                           bool usingDict,
+                                           uint32_t dictScope,
+                                           InnerHandle* handle);
 
     bool testContentCanBeDecompressed(const UnsafeData& data,
                                       bool usingDict,
+                                      uint32_t dictScope,
                                       InnerHandle* errorReportHandle);
 
 private:
-    ZSTDDict* getDict(DictId id) const;
+    Optional<UnsafeData> doCompressContent(const UnsafeData& data,
+                                           DictId dictId,
+                                           uint32_t dictScope,
+                                           int level,
+                                           InnerHandle* errorReportHandle);
+    Optional<Data> doTrainDict(DictId dictId, TrainDataEnumerator dataEnummerator);
+    ZSTDDict* getDict(DictId id, uint32_t dictScope) const;
     ZSTDDict** m_dicts;
     ThreadLocal<ZSTDContext> m_ctxes;
+
+#pragma mark - Trained Dict
+public:
+    // Ids of dicts trained automatically are allocated beyond the range of the ones registered by user.
+    static constexpr const DictId MinTrainedDictId = MaxDictId;
+    static constexpr const DictId MaxTrainedDictId = UINT16_MAX;
+
+    /*
+     Trained dicts are saved in each database separately, so that their ids are only unique within the database.
+     Each database registers its dicts in its own scope to avoid conflicting with the others.
+     */
+    uint32_t newTrainedDictScope();
+    void unregisterTrainedDicts(uint32_t dictScope);
+
+    /*
+     The scope is also bound to the path of database, so that the trained dicts can be found by
+     the decompress function without the scope parameter, e.g. in the raw SQL written by user.
+     The path should be the one reported by sqlite, which is resolved to the full path.
+     */
+    void bindTrainedDictScope(const UnsafeStringView& path, uint32_t dictScope);
+    // Zero is returned when the data is not compressed by trained dict or the path is unbound.
+    uint32_t getTrainedDictScope(const UnsafeData& data, const UnsafeStringView& path) const;
+
+    Optional<DictId> reserveTrainedDictId(uint32_t dictScope, uint32_t seed);
+    void unreserveTrainedDictId(uint32_t dictScope, DictId dictId);
+    Optional<Data> trainRotatingDict(DictId dictId, TrainDataEnumerator dataEnummerator);
+    bool registerTrainedDict(uint32_t dictScope, DictId dictId, const UnsafeData& data);
+
+    // The total size of samples after being compressed. Zero dictId means compressing without dict.
+    Optional<size_t> getCompressedSize(const std::vector<Data>& samples,
+                                       DictId dictId,
+                                       uint32_t dictScope,
+                                       InnerHandle* errorReportHandle);
+    Optional<size_t> getCompressedSize(const std::vector<Data>& samples,
+                                       const ZSTDDict& dict,
+                                       InnerHandle* errorReportHandle);
+
+private:
+    Optional<size_t> doGetCompressedSize(const std::vector<Data>& samples,
+                                         const ZSTDDict* dict,
+                                         InnerHandle* errorReportHandle);
+
+    static uint64_t getTrainedDictKey(uint32_t dictScope, DictId dictId);
+
+    mutable SharedLock m_lock;
+    std::atomic<uint32_t> m_lastDictScope;
+    std::set<uint64_t> m_reservedDictIds;
+    std::unordered_map<uint64_t, ZSTDDict*> m_trainedDicts;
+    std::unordered_map<uint64_t, uint32_t> m_trainedDictHashes;
+    StringViewMap<uint32_t> m_trainedDictScopes;
+
+#pragma mark - Decompression Cache
+public:
+    // Zero size disables the cache, which is the default.
+    void setDecompressionCacheSize(size_t size);
+    DecompressionCache::Statistics getDecompressionCacheStatistics() const;
+
+private:
+    void setDecompressedResult(const UnsafeData& data,
+                               ColumnType originType,
+                               ScalarFunctionAPI& resultAPI);
+    DecompressionCache m_decompressionCache;
 };
 
 } // namespace WCDB
@@ -33,6 +33,13 @@ WCDBLiteralStringImplement(CompressionRecordColumn_Table);
 WCDBLiteralStringImplement(CompressionRecordColumn_Columns);
 WCDBLiteralStringImplement(CompressionRecordColumn_Rowid);
 
+WCDBLiteralStringImplement(CompressionDictTable);
+WCDBLiteralStringImplement(CompressionDictColumn_DictId);
+WCDBLiteralStringImplement(CompressionDictColumn_Table);
+WCDBLiteralStringImplement(CompressionDictColumn_Column);
+WCDBLiteralStringImplement(CompressionDictColumn_Dict);
+WCDBLiteralStringImplement(CompressionDictColumn_CreateTime);
+
 WCDBLiteralStringImplement(CompressionColumnTypePrefix);
 
 } // namespace WCDB
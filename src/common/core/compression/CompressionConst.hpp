@@ -49,6 +49,13 @@ WCDBLiteralStringDefine(CompressionRecordColumn_Table, "tableName");
 WCDBLiteralStringDefine(CompressionRecordColumn_Columns, "columns");
 WCDBLiteralStringDefine(CompressionRecordColumn_Rowid, "rowid");
 
+WCDBLiteralStringDefine(CompressionDictTable, "wcdb_builtin_compression_dict");
+WCDBLiteralStringDefine(CompressionDictColumn_DictId, "dictId");
+WCDBLiteralStringDefine(CompressionDictColumn_Table, "tableName");
+WCDBLiteralStringDefine(CompressionDictColumn_Column, "columnName");
+WCDBLiteralStringDefine(CompressionDictColumn_Dict, "dict");
+WCDBLiteralStringDefine(CompressionDictColumn_CreateTime, "createTime");
+
 const char CompressionRecordColumnSeperater = ' ';
 
 WCDBLiteralStringDefine(CompressionColumnTypePrefix, "WCDB_CT_")
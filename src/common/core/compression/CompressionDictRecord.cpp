@@ -0,0 +1,90 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompressionDictRecord.hpp"
+#include "CompressionConst.hpp"
+
+namespace WCDB {
+
+const StringView &CompressionDictRecord::tableName = CompressionDictTable;
+const StringView &CompressionDictRecord::columnDictId = CompressionDictColumn_DictId;
+const StringView &CompressionDictRecord::columnTable = CompressionDictColumn_Table;
+const StringView &CompressionDictRecord::columnColumn = CompressionDictColumn_Column;
+const StringView &CompressionDictRecord::columnDict = CompressionDictColumn_Dict;
+const StringView &CompressionDictRecord::columnCreateTime = CompressionDictColumn_CreateTime;
+
+StatementCreateTable CompressionDictRecord::getCreateTableStatement()
+{
+    StatementCreateTable createTable;
+    createTable.createTable(tableName).ifNotExists();
+    createTable.define(ColumnDef(columnDictId, ColumnType::Integer)
+                       .constraint(ColumnConstraint().primaryKey()));
+    createTable.define(
+    ColumnDef(columnTable, ColumnType::Text).constraint(ColumnConstraint().notNull()));
+    createTable.define(
+    ColumnDef(columnColumn, ColumnType::Text).constraint(ColumnConstraint().notNull()));
+    createTable.define(
+    ColumnDef(columnDict, ColumnType::BLOB).constraint(ColumnConstraint().notNull()));
+    createTable.define(ColumnDef(columnCreateTime, ColumnType::Integer));
+    return createTable;
+}
+
+StatementInsert CompressionDictRecord::getInsertValueStatement()
+{
+    return StatementInsert()
+    .insertIntoTable(tableName)
+    .columns({ columnDictId, columnTable, columnColumn, columnDict, columnCreateTime })
+    .values(BindParameter::bindParameters(5));
+}
+
+StatementSelect CompressionDictRecord::getSelectAllDictsStatement()
+{
+    return StatementSelect()
+    .select({ Column(columnDictId),
+              Column(columnTable),
+              Column(columnColumn),
+              Column(columnDict),
+              Column(columnCreateTime) })
+    .from(tableName)
+    .order(Column(columnCreateTime));
+}
+
+StatementSelect CompressionDictRecord::getSelectLatestCreateTimeStatement()
+{
+    return StatementSelect()
+    .select(Column(columnCreateTime).max())
+    .from(tableName)
+    .where(Column(columnTable) == BindParameter(1)
+           && Column(columnColumn) == BindParameter(2));
+}
+
+StatementUpdate
+CompressionDictRecord::getUpdateTableStatement(const UnsafeStringView &oldTable,
+                                               const UnsafeStringView &newTable)
+{
+    return StatementUpdate().update(tableName).set(columnTable).to(newTable).where(Column(columnTable) == oldTable);
+}
+
+StatementDropTable CompressionDictRecord::getDropTableStatement()
+{
+    return StatementDropTable().dropTable(tableName).ifExists();
+}
+
+} //namespace WCDB
@@ -0,0 +1,88 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Data.hpp"
+#include "StringView.hpp"
+#include "WINQ.h"
+
+namespace WCDB {
+
+typedef struct CompressionDictRecord {
+    static const StringView& tableName;
+
+    int64_t dictId;
+    static const StringView& columnDictId;
+
+    StringView table;
+    static const StringView& columnTable;
+
+    StringView column;
+    static const StringView& columnColumn;
+
+    Data dict;
+    static const StringView& columnDict;
+
+    int64_t createTime;
+    static const StringView& columnCreateTime;
+
+    /*
+     CREATE TABLE IF NOT EXIST wcdb_builtin_compression_dict
+     (dictId INTEGER PRIMARY KEY, tableName TEXT NOT NULL, columnName TEXT NOT NULL,
+     dict BLOB NOT NULL, createTime INTEGER)
+     */
+    static StatementCreateTable getCreateTableStatement();
+
+    /*
+     INSERT OR REPLACE INTO wcdb_builtin_compression_dict
+     (dictId, tableName, columnName, dict, createTime)
+     VALUES(?1, ?2, ?3, ?4, ?5)
+     */
+    static StatementInsert getInsertValueStatement();
+
+    /*
+     SELECT dictId, tableName, columnName, dict, createTime
+     FROM wcdb_builtin_compression_dict
+     ORDER BY createTime
+     */
+    static StatementSelect getSelectAllDictsStatement();
+
+    /*
+     SELECT max(createTime) FROM wcdb_builtin_compression_dict
+     WHERE tableName == ?1 AND columnName == ?2
+     */
+    static StatementSelect getSelectLatestCreateTimeStatement();
+
+    /*
+     UPDATE wcdb_builtin_compression_dict
+     SET tableName = newTable
+     WHERE tableName == oldTable
+     */
+    static StatementUpdate getUpdateTableStatement(const UnsafeStringView& oldTable,
+                                                   const UnsafeStringView& newTable);
+
+    /*
+     DROP TABLE IF EXIST wcdb_builtin_compression_dict
+     */
+    static StatementDropTable getDropTableStatement();
+} CompressionDictRecord;
+
+} // namespace WCDB
@@ -0,0 +1,289 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompressionDictTrainer.hpp"
+#include "Assertion.hpp"
+#include "CompressionCenter.hpp"
+#include "CompressionDictRecord.hpp"
+#include "CoreConst.h"
+#include "InnerHandle.hpp"
+#include "Notifier.hpp"
+#include "Time.hpp"
+
+namespace WCDB {
+
+CompressionDictTrainer::CompressionDictTrainer()
+: m_sampling(false), m_random((unsigned) Time::now().nanoseconds())
+{
+}
+
+CompressionDictTrainer::~CompressionDictTrainer() = default;
+
+#pragma mark - Sample
+void CompressionDictTrainer::addSample(const UnsafeStringView& table,
+                                       const CompressionColumnInfo& column,
+                                       const UnsafeData& value)
+{
+    if (!column.isAutoTrainDictEnabled() || value.size() == 0
+        || value.size() > CompressionDictMaxSampleSize || !m_sampling.load()) {
+        return;
+    }
+    LockGuard lockGuard(m_lock);
+    auto tableIter = m_samples.find(table);
+    if (tableIter == m_samples.end()) {
+        return;
+    }
+    auto iter = tableIter->second.find(column.getColumn());
+    if (iter == tableIter->second.end() || !iter->second.sampling) {
+        return;
+    }
+    Samples& samples = iter->second;
+    if (++samples.seenCount % CompressionDictHeldOutSampleInterval == 0) {
+        addSampleToReservoir(samples.heldOutSamples,
+                             samples.heldOutSize,
+                             samples.heldOutCount,
+                             CompressionDictHeldOutSampleCount,
+                             value);
+    } else {
+        addSampleToReservoir(samples.trainSamples,
+                             samples.trainSize,
+                             samples.trainCount,
+                             CompressionDictTrainSampleCount,
+                             value);
+    }
+}
+
+void CompressionDictTrainer::addSampleToReservoir(std::vector<Data>& reservoir,
+                                                  size_t& reservoirSize,
+                                                  int64_t& seenCount,
+                                                  size_t capacity,
+                                                  const UnsafeData& value)
+{
+    seenCount++;
+    if (reservoir.size() < capacity) {
+        if (reservoirSize + value.size() > CompressionDictMaxSamplesSize) {
+            return;
+        }
+        reservoir.emplace_back(value.buffer(), value.size());
+        reservoirSize += value.size();
+        return;
+    }
+    // Each seen value is kept with the same probability, so that the samples won't be biased to the older rows.
+    size_t index = (size_t) (m_random() % seenCount);
+    if (index >= capacity) {
+        return;
+    }
+    Data& replaced = reservoir[index];
+    if (reservoirSize - replaced.size() + value.size() > CompressionDictMaxSamplesSize) {
+        return;
+    }
+    reservoirSize = reservoirSize - replaced.size() + value.size();
+    replaced = Data(value.buffer(), value.size());
+}
+
+bool CompressionDictTrainer::isReadyToTrain(const Samples& samples) const
+{
+    return samples.trainCount >= CompressionDictTrainSampleCount
+           && !samples.heldOutSamples.empty();
+}
+
+#pragma mark - Rotate
+void CompressionDictTrainer::tryRotateDicts(InnerHandle* handle, const CompressionTableInfo* info)
+{
+    WCTAssert(handle != nullptr && info != nullptr);
+    const StringView& table = info->getTable();
+    for (const auto& column : info->getColumnInfos()) {
+        if (!column.isAutoTrainDictEnabled()) {
+            continue;
+        }
+        Optional<int64_t> lastTrainTime;
+        {
+            LockGuard lockGuard(m_lock);
+            lastTrainTime = m_samples[table][column.getColumn()].lastTrainTime;
+        }
+        if (!lastTrainTime.hasValue()) {
+            lastTrainTime = getLastTrainTime(handle, table, column.getColumn());
+            if (!lastTrainTime.hasValue()) {
+                continue;
+            }
+        }
+        int64_t now = Time::now().seconds();
+        Samples readySamples;
+        {
+            LockGuard lockGuard(m_lock);
+            Samples& samples = m_samples[table][column.getColumn()];
+            samples.lastTrainTime = lastTrainTime;
+            samples.sampling
+            = now - lastTrainTime.value() >= CompressionDictRotationInterval;
+            if (samples.sampling) {
+                m_sampling = true;
+            }
+            if (!samples.sampling || !isReadyToTrain(samples)) {
+                continue;
+            }
+            // Train without lock, so that the writing threads won't be blocked.
+            readySamples = std::move(samples);
+            samples = Samples();
+            samples.lastTrainTime = now;
+        }
+        rotateDict(handle, table, column, readySamples);
+    }
+    LockGuard lockGuard(m_lock);
+    bool sampling = false;
+    for (const auto& tableSamples : m_samples) {
+        for (const auto& columnSamples : tableSamples.second) {
+            sampling = sampling || columnSamples.second.sampling;
+        }
+    }
+    m_sampling = sampling;
+}
+
+void CompressionDictTrainer::clear()
+{
+    LockGuard lockGuard(m_lock);
+    m_samples.clear();
+    m_sampling = false;
+}
+
+Optional<int64_t> CompressionDictTrainer::getLastTrainTime(InnerHandle* handle,
+                                                           const UnsafeStringView& table,
+                                                           const UnsafeStringView& column)
+{
+    auto exists = handle->tableExists(CompressionDictRecord::tableName);
+    if (exists.failed()) {
+        return NullOpt;
+    }
+    if (!exists.value()) {
+        return 0;
+    }
+    HandleStatement* select = handle->getStatement(DecoratorAllType);
+    Optional<int64_t> lastTrainTime;
+    if (select->prepare(CompressionDictRecord::getSelectLatestCreateTimeStatement())) {
+        select->bindText(table, 1);
+        select->bindText(column, 2);
+        if (select->step()) {
+            lastTrainTime = select->done() ? 0 : select->getInteger();
+        }
+    }
+    select->finalize();
+    handle->returnStatement(select);
+    return lastTrainTime;
+}
+
+void CompressionDictTrainer::rotateDict(InnerHandle* handle,
+                                        const UnsafeStringView& table,
+                                        const CompressionColumnInfo& column,
+                                        Samples& samples)
+{
+    CompressionCenter& center = CompressionCenter::shared();
+    int64_t now = Time::now().seconds();
+    CompressionColumnInfo::DictId previousDictId = column.getCurrentDictId();
+    uint32_t seed
+    = StringView::formatted(
+      "%s.%s.%s.%lld", handle->getPath().data(), table.data(), column.getColumn().data(), now)
+      .hash();
+    uint32_t dictScope = column.getDictScope();
+    auto dictId = center.reserveTrainedDictId(dictScope, seed);
+    if (dictId.failed()) {
+        return;
+    }
+
+    int64_t start = Time::currentThreadCPUTimeInMicroseconds();
+    size_t index = 0;
+    auto dict = center.trainRotatingDict(dictId.value(), [&]() -> Optional<UnsafeData> {
+        if (index < samples.trainSamples.size()) {
+            return samples.trainSamples[index++];
+        }
+        return NullOpt;
+    });
+    int64_t trainTime = Time::currentThreadCPUTimeInMicroseconds() - start;
+
+    Optional<size_t> previousSize;
+    Optional<size_t> candidateSize;
+    if (dict.succeed()) {
+        ZSTDDict candidate;
+        if (candidate.loadData(dict.value())) {
+            previousSize = center.getCompressedSize(
+            samples.heldOutSamples, previousDictId, dictScope, handle);
+            candidateSize
+            = center.getCompressedSize(samples.heldOutSamples, candidate, handle);
+        }
+    }
+    bool adopted = false;
+    if (previousSize.succeed() && candidateSize.succeed()
+        && candidateSize.value() <= previousSize.value() * CompressionDictAdoptionRatio) {
+        // Save it before any value is compressed by it.
+        // The id is rejected by the primary key if it's used by a dict saved in the database without being loaded.
+        adopted = saveDict(handle, dictId.value(), table, column.getColumn(), dict.value(), now)
+                  && center.registerTrainedDict(dictScope, dictId.value(), dict.value());
+    }
+    if (adopted) {
+        column.setCurrentDictId(dictId.value());
+    } else {
+        center.unreserveTrainedDictId(dictScope, dictId.value());
+    }
+
+    Error error(Error::Code::Notice, Error::Level::Notice, "Compression dict training");
+    error.infos.insert_or_assign(ErrorStringKeyPath, handle->getPath());
+    error.infos.insert_or_assign(ErrorIntKeyTag, (long) handle->getTag());
+    error.infos.insert_or_assign("Table", table);
+    error.infos.insert_or_assign("Column", column.getColumn());
+    error.infos.insert_or_assign("DictId", dictId.value());
+    error.infos.insert_or_assign("PreviousDictId", previousDictId);
+    error.infos.insert_or_assign("TrainTime", trainTime);
+    error.infos.insert_or_assign("SampleCount", samples.trainSamples.size());
+    error.infos.insert_or_assign("SampleSize", samples.trainSize);
+    error.infos.insert_or_assign("HeldOutSize", samples.heldOutSize);
+    if (previousSize.succeed() && candidateSize.succeed() && samples.heldOutSize > 0) {
+        error.infos.insert_or_assign(
+        "PreviousRatio", (double) previousSize.value() / samples.heldOutSize);
+        error.infos.insert_or_assign(
+        "CandidateRatio", (double) candidateSize.value() / samples.heldOutSize);
+    }
+    error.infos.insert_or_assign("Adopted", adopted ? 1 : 0);
+    Notifier::shared().notify(error);
+}
+
+bool CompressionDictTrainer::saveDict(InnerHandle* handle,
+                                      CompressionColumnInfo::DictId dictId,
+                                      const UnsafeStringView& table,
+                                      const UnsafeStringView& column,
+                                      const UnsafeData& dict,
+                                      int64_t createTime)
+{
+    if (!handle->execute(CompressionDictRecord::getCreateTableStatement())) {
+        return false;
+    }
+    HandleStatement* insert = handle->getStatement(DecoratorAllType);
+    bool succeed = insert->prepare(CompressionDictRecord::getInsertValueStatement());
+    if (succeed) {
+        insert->bindInteger(dictId, 1);
+        insert->bindText(table, 2);
+        insert->bindText(column, 3);
+        insert->bindBLOB(dict, 4);
+        insert->bindInteger(createTime, 5);
+        succeed = insert->step();
+    }
+    insert->finalize();
+    handle->returnStatement(insert);
+    return succeed;
+}
+
+} //namespace WCDB
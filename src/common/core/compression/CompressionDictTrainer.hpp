@@ -0,0 +1,100 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CompressionInfo.hpp"
+#include "Data.hpp"
+#include "Lock.hpp"
+#include "StringView.hpp"
+#include "WCDBOptional.hpp"
+#include <atomic>
+#include <random>
+#include <vector>
+
+namespace WCDB {
+
+class InnerHandle;
+class CompressionTableInfo;
+
+/*
+ It samples the original values of the columns with auto-trained dict while they are being compressed or written,
+ trains a candidate dict with them and adopts it when it beats the current one on the held-out samples.
+ Adopted dicts are saved in wcdb_builtin_compression_dict and never deleted,
+ so that the values compressed by them can still be decompressed.
+ It's shared by all handles of a database.
+ */
+class CompressionDictTrainer final {
+public:
+    CompressionDictTrainer();
+    ~CompressionDictTrainer();
+
+    CompressionDictTrainer(const CompressionDictTrainer&) = delete;
+    CompressionDictTrainer& operator=(const CompressionDictTrainer&) = delete;
+
+    void addSample(const UnsafeStringView& table,
+                   const CompressionColumnInfo& column,
+                   const UnsafeData& value);
+
+    // Errors of training are only reported, since they should not block the compression.
+    void tryRotateDicts(InnerHandle* handle, const CompressionTableInfo* info);
+    void clear();
+
+private:
+    typedef struct Samples {
+        bool sampling = false;
+        Optional<int64_t> lastTrainTime;
+        int64_t seenCount = 0;
+        int64_t trainCount = 0;
+        int64_t heldOutCount = 0;
+        size_t trainSize = 0;
+        size_t heldOutSize = 0;
+        std::vector<Data> trainSamples;
+        std::vector<Data> heldOutSamples;
+    } Samples;
+
+    void addSampleToReservoir(std::vector<Data>& reservoir,
+                              size_t& reservoirSize,
+                              int64_t& seenCount,
+                              size_t capacity,
+                              const UnsafeData& value);
+    bool isReadyToTrain(const Samples& samples) const;
+    Optional<int64_t> getLastTrainTime(InnerHandle* handle,
+                                       const UnsafeStringView& table,
+                                       const UnsafeStringView& column);
+    void rotateDict(InnerHandle* handle,
+                    const UnsafeStringView& table,
+                    const CompressionColumnInfo& column,
+                    Samples& samples);
+    bool saveDict(InnerHandle* handle,
+                  CompressionColumnInfo::DictId dictId,
+                  const UnsafeStringView& table,
+                  const UnsafeStringView& column,
+                  const UnsafeData& dict,
+                  int64_t createTime);
+
+    SharedLock m_lock;
+    // Writing threads skip the lock if none of the columns is sampling.
+    std::atomic<bool> m_sampling;
+    StringViewMap<StringViewMap<Samples>> m_samples;
+    std::minstd_rand m_random;
+};
+
+} //namespace WCDB
@@ -40,6 +40,12 @@ CompressionColumnInfo::CompressionColumnInfo(const Column &column, CompressionTy
 , m_matchColumnIndex(UINT16_MAX)
 , m_compressionType(type)
 , m_commonDictID(-1)
+, m_autoTrainDict(false)
+, m_currentDictID(0)
+, m_dictScope(0)
+, m_minCompressSize(0)
+, m_maxCompressedRatio(1.0)
+, m_statistics(std::make_shared<CompressionColumnStatistics>())
 {
     std::ostringstream stringStream;
     stringStream << CompressionColumnTypePrefix << column.syntax().name;
@@ -53,6 +59,12 @@ CompressionColumnInfo::CompressionColumnInfo(const Column &column, const Column
 , m_matchColumnIndex(UINT16_MAX)
 , m_compressionType(CompressionType::VariousDict)
 , m_commonDictID(-1)
+, m_autoTrainDict(false)
+, m_currentDictID(0)
+, m_dictScope(0)
+, m_minCompressSize(0)
+, m_maxCompressedRatio(1.0)
+, m_statistics(std::make_shared<CompressionColumnStatistics>())
 {
     std::ostringstream stringStream;
     stringStream << CompressionColumnTypePrefix << column.syntax().name;
@@ -68,6 +80,12 @@ CompressionColumnInfo::CompressionColumnInfo(const CompressionColumnInfo &other)
 , m_compressionType(other.m_compressionType)
 , m_commonDictID(other.m_commonDictID)
 , m_matchDicts(other.m_matchDicts)
+, m_autoTrainDict(other.m_autoTrainDict)
+, m_currentDictID(other.m_currentDictID.load())
+, m_dictScope(other.m_dictScope.load())
+, m_minCompressSize(other.m_minCompressSize)
+, m_maxCompressedRatio(other.m_maxCompressedRatio)
+, m_statistics(other.m_statistics)
 {
 }
 
@@ -80,6 +98,12 @@ CompressionColumnInfo::CompressionColumnInfo(CompressionColumnInfo &&other)
 , m_compressionType(other.m_compressionType)
 , m_commonDictID(other.m_commonDictID)
 , m_matchDicts(std::move(other.m_matchDicts))
+, m_autoTrainDict(other.m_autoTrainDict)
+, m_currentDictID(other.m_currentDictID.load())
+, m_dictScope(other.m_dictScope.load())
+, m_minCompressSize(other.m_minCompressSize)
+, m_maxCompressedRatio(other.m_maxCompressedRatio)
+, m_statistics(other.m_statistics)
 {
 }
 
@@ -93,6 +117,12 @@ CompressionColumnInfo &CompressionColumnInfo::operator=(const CompressionColumnI
     m_compressionType = other.m_compressionType;
     m_commonDictID = other.m_commonDictID;
     m_matchDicts = other.m_matchDicts;
+    m_autoTrainDict = other.m_autoTrainDict;
+    m_currentDictID = other.m_currentDictID.load();
+    m_dictScope = other.m_dictScope.load();
+    m_minCompressSize = other.m_minCompressSize;
+    m_maxCompressedRatio = other.m_maxCompressedRatio;
+    m_statistics = other.m_statistics;
     return *this;
 }
 
@@ -106,6 +136,12 @@ CompressionColumnInfo &CompressionColumnInfo::operator=(CompressionColumnInfo &&
     m_compressionType = other.m_compressionType;
     m_commonDictID = other.m_commonDictID;
     m_matchDicts = std::move(other.m_matchDicts);
+    m_autoTrainDict = other.m_autoTrainDict;
+    m_currentDictID = other.m_currentDictID.load();
+    m_dictScope = other.m_dictScope.load();
+    m_minCompressSize = other.m_minCompressSize;
+    m_maxCompressedRatio = other.m_maxCompressedRatio;
+    m_statistics = other.m_statistics;
     return *this;
 }
 
@@ -191,6 +227,81 @@ void CompressionColumnInfo::addMatchDict(const Integer &matchValue, DictId dictI
     m_matchDicts[matchValue] = dictId;
 }
 
+void CompressionColumnInfo::enableAutoTrainDict()
+{
+    WCTAssert(m_compressionType == CompressionType::Dict);
+    m_autoTrainDict = true;
+}
+
+bool CompressionColumnInfo::isAutoTrainDictEnabled() const
+{
+    return m_autoTrainDict;
+}
+
+CompressionColumnInfo::DictId CompressionColumnInfo::getCurrentDictId() const
+{
+    WCTAssert(m_compressionType == CompressionType::Dict);
+    DictId dictId = m_currentDictID.load();
+    if (dictId == 0) {
+        return m_commonDictID;
+    }
+    return dictId;
+}
+
+void CompressionColumnInfo::setCurrentDictId(DictId dictId) const
+{
+    WCTAssert(m_autoTrainDict);
+    m_currentDictID = dictId;
+}
+
+uint32_t CompressionColumnInfo::getDictScope() const
+{
+    return m_dictScope.load();
+}
+
+void CompressionColumnInfo::setDictScope(uint32_t dictScope) const
+{
+    WCTAssert(m_autoTrainDict);
+    m_dictScope = dictScope;
+}
+
+void CompressionColumnInfo::setCompressionLevel(int level)
+{
+    m_statistics->setLevel(level);
+}
+
+void CompressionColumnInfo::enableAutoCompressionLevel()
+{
+    m_statistics->enableAutoLevel();
+}
+
+void CompressionColumnInfo::setMinCompressSize(size_t size)
+{
+    m_minCompressSize = size;
+}
+
+size_t CompressionColumnInfo::getMinCompressSize() const
+{
+    return m_minCompressSize;
+}
+
+void CompressionColumnInfo::setMaxCompressedRatio(double ratio)
+{
+    WCTAssert(ratio > 0 && ratio <= 1.0);
+    m_maxCompressedRatio = ratio;
+}
+
+double CompressionColumnInfo::getMaxCompressedRatio() const
+{
+    return m_maxCompressedRatio;
+}
+
+CompressionColumnStatistics &CompressionColumnInfo::getStatistics() const
+{
+    WCTAssert(m_statistics != nullptr);
+    return *m_statistics;
+}
+
 #pragma mark - CompressionTableBaseInfo
 CompressionTableBaseInfo::CompressionTableBaseInfo(const UnsafeStringView &table)
 : m_table(table), m_replaceCompression(false)
@@ -237,6 +348,16 @@ void CompressionTableUserInfo::addCompressingColumn(const CompressionColumnInfo
     m_compressingColumns.push_back(info);
 }
 
+CompressionColumnInfo *CompressionTableUserInfo::getCompressingColumn(const UnsafeStringView &column)
+{
+    for (auto &info : m_compressingColumns) {
+        if (info.getColumn().equal(column)) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
 void CompressionTableUserInfo::enableReplaceCompresssion()
 {
     m_replaceCompression = true;
@@ -420,11 +541,14 @@ HandleStatement *select, HandleStatement *update, int64_t rowid, ColumnInfoPtrLi
             case CompressionType::Normal: {
                 compressedType = CompressedType::ZSTDNormal;
                 compressedValue = CompressionCenter::shared().compressContent(
-                value, 0, static_cast<InnerHandle *>(select->getHandle()));
+                value, 0, *column, static_cast<InnerHandle *>(select->getHandle()));
             } break;
             case CompressionType::Dict: {
                 compressedValue = CompressionCenter::shared().compressContent(
-                value, column->getDictId(), static_cast<InnerHandle *>(select->getHandle()));
+                value,
+                column->getCurrentDictId(),
+                *column,
+                static_cast<InnerHandle *>(select->getHandle()));
             } break;
             case CompressionType::VariousDict: {
                 int64_t matchValue = select->getInteger(selectIndex + 2);
@@ -432,6 +556,7 @@ HandleStatement *select, HandleStatement *update, int64_t rowid, ColumnInfoPtrLi
                 compressedValue = CompressionCenter::shared().compressContent(
                 value,
                 column->getMatchDictId(matchValue),
+                *column,
                 static_cast<InnerHandle *>(select->getHandle()));
             } break;
             }
@@ -505,8 +630,15 @@ CompressionTableInfo::getSelectCompressedRowStatement(ColumnInfoPtrList *columnL
     ColumnInfoIter columnIter(&m_compressingColumns, columnList);
     const CompressionColumnInfo *column = nullptr;
     while ((column = columnIter.nextInfo()) != nullptr) {
-        resultColumns.emplace_back(CoreFunction::decompress(
-        Column(column->getColumn()), Column(column->getTypeColumn())));
+        if (column->isAutoTrainDictEnabled()) {
+            resultColumns.emplace_back(
+            CoreFunction::decompress(Column(column->getColumn()),
+                                     Column(column->getTypeColumn()),
+                                     LiteralValue((int64_t) column->getDictScope())));
+        } else {
+            resultColumns.emplace_back(CoreFunction::decompress(
+            Column(column->getColumn()), Column(column->getTypeColumn())));
+        }
     }
     return StatementSelect().select(resultColumns).from(m_table).where(Column::rowid() == BindParameter());
 }
@@ -26,6 +26,7 @@
 
 #include "Column.hpp"
 #include "ColumnType.hpp"
+#include "CompressionStatistics.hpp"
 #include "StringView.hpp"
 #include "ZSTDDict.hpp"
 #include <atomic>
@@ -77,6 +78,26 @@ public:
     void setCommonDict(DictId dictId);
     void addMatchDict(const Integer &matchValue, DictId dictId);
 
+    // Dict trained from the sampled values of this column, which takes the place of the common dict.
+    void enableAutoTrainDict();
+    bool isAutoTrainDictEnabled() const;
+    DictId getCurrentDictId() const;
+    void setCurrentDictId(DictId dictId) const;
+    // Scope of the trained dicts in CompressionCenter, which is assigned by the database.
+    uint32_t getDictScope() const;
+    void setDictScope(uint32_t dictScope) const;
+
+    // The level only works with the normal compression, since the level of dict is fixed when it's loaded.
+    void setCompressionLevel(int level);
+    void enableAutoCompressionLevel();
+    // Values shorter than min size are saved without compression.
+    void setMinCompressSize(size_t size);
+    size_t getMinCompressSize() const;
+    // Values whose compressed size is larger than original size * ratio are saved without compression.
+    void setMaxCompressedRatio(double ratio);
+    double getMaxCompressedRatio() const;
+    CompressionColumnStatistics &getStatistics() const;
+
 private:
     mutable std::atomic_ushort m_columnIndex;
     StringView m_typeColumn;
@@ -87,6 +108,12 @@ private:
     CompressionType m_compressionType;
     DictId m_commonDictID;
     std::unordered_map<Integer, DictId> m_matchDicts;
+    bool m_autoTrainDict;
+    mutable std::atomic_ushort m_currentDictID;
+    mutable std::atomic<uint32_t> m_dictScope;
+    size_t m_minCompressSize;
+    double m_maxCompressedRatio;
+    std::shared_ptr<CompressionColumnStatistics> m_statistics;
 };
 
 class CompressionTableBaseInfo {
@@ -110,6 +137,7 @@ public:
     CompressionTableUserInfo(const UnsafeStringView &table,
                              const std::list<CompressionColumnInfo> &columns);
     void addCompressingColumn(const CompressionColumnInfo &info);
+    CompressionColumnInfo *getCompressingColumn(const UnsafeStringView &column);
     void enableReplaceCompresssion();
 };
 
@@ -0,0 +1,224 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CompressionStatistics.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include <string.h>
+
+namespace WCDB {
+
+static constexpr const int kAutoLevels[] = { 1, 3, 5, 7, 9 };
+static constexpr const int kAutoLevelCount = sizeof(kAutoLevels) / sizeof(kAutoLevels[0]);
+static constexpr const int kDefaultAutoLevelIndex = 1;
+
+CompressionColumnStatistics::CompressionColumnStatistics()
+: m_level(CompressionDefaultLevel)
+, m_compressedCount(0)
+, m_uncompressedCount(0)
+, m_skippedCount(0)
+, m_originalSize(0)
+, m_compressedSize(0)
+, m_continuousRejectedCount(0)
+, m_skippedSinceLastTry(0)
+, m_autoLevel(false)
+, m_levelIndex(kDefaultAutoLevelIndex)
+, m_probeStep(0)
+, m_probeUp(true)
+, m_windowCount(0)
+, m_windowOriginalSize(0)
+, m_windowSavedSize(0)
+, m_windowCost(0)
+{
+}
+
+void CompressionColumnStatistics::setLevel(int level)
+{
+    LockGuard lockGuard(m_lock);
+    m_autoLevel = false;
+    m_level = level;
+}
+
+void CompressionColumnStatistics::enableAutoLevel()
+{
+    LockGuard lockGuard(m_lock);
+    m_levelIndex = kDefaultAutoLevelIndex;
+    m_probeStep = 0;
+    m_baseline = Window();
+    m_windowCount = 0;
+    m_windowOriginalSize = 0;
+    m_windowSavedSize = 0;
+    m_windowCost = 0;
+    m_level = kAutoLevels[m_levelIndex];
+    m_autoLevel = true;
+}
+
+bool CompressionColumnStatistics::isAutoLevel() const
+{
+    return m_autoLevel.load(std::memory_order_relaxed);
+}
+
+int CompressionColumnStatistics::getLevel() const
+{
+    return m_level.load(std::memory_order_relaxed);
+}
+
+CompressionColumnStatistics::Snapshot CompressionColumnStatistics::getSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.level = m_level.load();
+    snapshot.compressedCount = m_compressedCount.load();
+    snapshot.uncompressedCount = m_uncompressedCount.load();
+    snapshot.skippedCount = m_skippedCount.load();
+    snapshot.originalSize = m_originalSize.load();
+    snapshot.compressedSize = m_compressedSize.load();
+    return snapshot;
+}
+
+#pragma mark - Incompressible
+bool CompressionColumnStatistics::isLikelyCompressed(const UnsafeData& data)
+{
+    if (data.size() < 8) {
+        return false;
+    }
+    const unsigned char* buffer = data.buffer();
+    static const struct {
+        unsigned char magic[4];
+        size_t length;
+    } s_magics[] = {
+        { { 0xFF, 0xD8, 0xFF }, 3 },       // jpeg
+        { { 0x89, 'P', 'N', 'G' }, 4 },    // png
+        { { 'G', 'I', 'F', '8' }, 4 },     // gif
+        { { 'P', 'K', 0x03, 0x04 }, 4 },   // zip, docx, apk
+        { { 0x1F, 0x8B }, 2 },             // gzip
+        { { 0x28, 0xB5, 0x2F, 0xFD }, 4 }, // zstd
+        { { 'B', 'Z', 'h' }, 3 },          // bzip2
+        { { 0xFD, '7', 'z', 'X' }, 4 },    // xz
+        { { '7', 'z', 0xBC, 0xAF }, 4 },   // 7z
+    };
+    for (const auto& magic : s_magics) {
+        if (memcmp(buffer, magic.magic, magic.length) == 0) {
+            return true;
+        }
+    }
+    // webp and mp4 family
+    if (data.size() >= 12
+        && ((memcmp(buffer, "RIFF", 4) == 0 && memcmp(buffer + 8, "WEBP", 4) == 0)
+            || memcmp(buffer + 4, "ftyp", 4) == 0)) {
+        return true;
+    }
+    return false;
+}
+
+bool CompressionColumnStatistics::shouldTryCompress()
+{
+    if (m_continuousRejectedCount.load(std::memory_order_relaxed)
+        < CompressionIncompressibleThreshold) {
+        return true;
+    }
+    // Retry occasionally in case the content of column changes.
+    return ++m_skippedSinceLastTry % CompressionIncompressibleRetryInterval == 0;
+}
+
+void CompressionColumnStatistics::addSkipped(size_t originalSize)
+{
+    m_skippedCount.fetch_add(1, std::memory_order_relaxed);
+    m_originalSize.fetch_add(originalSize, std::memory_order_relaxed);
+    m_compressedSize.fetch_add(originalSize, std::memory_order_relaxed);
+}
+
+void CompressionColumnStatistics::addResult(size_t originalSize,
+                                            size_t compressedSize,
+                                            bool accepted,
+                                            int64_t costInNanoseconds)
+{
+    WCTAssert(compressedSize <= originalSize);
+    m_originalSize.fetch_add(originalSize, std::memory_order_relaxed);
+    if (accepted) {
+        m_compressedCount.fetch_add(1, std::memory_order_relaxed);
+        m_compressedSize.fetch_add(compressedSize, std::memory_order_relaxed);
+        if (m_continuousRejectedCount.load(std::memory_order_relaxed) != 0) {
+            m_continuousRejectedCount = 0;
+            m_skippedSinceLastTry = 0;
+        }
+    } else {
+        m_uncompressedCount.fetch_add(1, std::memory_order_relaxed);
+        m_compressedSize.fetch_add(originalSize, std::memory_order_relaxed);
+        m_continuousRejectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (isAutoLevel() && costInNanoseconds > 0) {
+        updateLevel(originalSize, accepted ? originalSize - compressedSize : 0, costInNanoseconds);
+    }
+}
+
+#pragma mark - Auto Level
+void CompressionColumnStatistics::updateLevel(size_t originalSize, size_t savedSize, int64_t cost)
+{
+    m_windowOriginalSize.fetch_add(originalSize, std::memory_order_relaxed);
+    m_windowSavedSize.fetch_add(savedSize, std::memory_order_relaxed);
+    m_windowCost.fetch_add(cost, std::memory_order_relaxed);
+    // Only the thread who fills the window finishes it.
+    if (m_windowCount.fetch_add(1) + 1 == CompressionLevelWindowSize) {
+        LockGuard lockGuard(m_lock);
+        if (m_autoLevel) {
+            finishWindow();
+        }
+    }
+}
+
+void CompressionColumnStatistics::finishWindow()
+{
+    Window window;
+    window.count = m_windowCount.exchange(0);
+    window.originalSize = m_windowOriginalSize.exchange(0);
+    window.savedSize = m_windowSavedSize.exchange(0);
+    window.cost = m_windowCost.exchange(0);
+    if (m_probeStep == 0) {
+        // The window of current level is finished. Try a neighboring level in the next window.
+        m_baseline = window;
+        int step = m_probeUp ? 1 : -1;
+        m_probeUp = !m_probeUp;
+        if (m_levelIndex + step < 0 || m_levelIndex + step >= kAutoLevelCount) {
+            step = -step;
+        }
+        m_probeStep = step;
+    } else if (m_baseline.originalSize > 0 && window.originalSize > 0) {
+        const Window& higher = m_probeStep > 0 ? window : m_baseline;
+        const Window& lower = m_probeStep > 0 ? m_baseline : window;
+        // Compare the saved size and the cpu cost of each input byte.
+        double extraSaved = (double) higher.savedSize / higher.originalSize
+                            - (double) lower.savedSize / lower.originalSize;
+        double extraCost = ((double) higher.cost / higher.originalSize
+                            - (double) lower.cost / lower.originalSize)
+                           / 1000;
+        bool higherIsWorthy
+        = extraSaved > 0
+          && (extraCost <= 0 || extraSaved / extraCost >= CompressionLevelMinSavedSizePerMicrosecond);
+        if (m_probeStep > 0 ? higherIsWorthy : !higherIsWorthy) {
+            m_levelIndex += m_probeStep;
+        }
+        m_probeStep = 0;
+    } else {
+        m_probeStep = 0;
+    }
+    m_level = kAutoLevels[m_levelIndex + m_probeStep];
+}
+
+} //namespace WCDB
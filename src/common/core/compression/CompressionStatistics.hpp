@@ -0,0 +1,103 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Lock.hpp"
+#include "UnsafeData.hpp"
+#include <atomic>
+#include <stdint.h>
+
+namespace WCDB {
+
+/*
+ Statistics of values compressed in a column, which are used to
+ 1. skip the column that are mostly incompressible, such as images and encrypted payloads.
+ 2. choose the compression level automatically by comparing the compression ratio and the cpu cost of neighboring levels.
+ They are updated for each value, so that the counters are atomic and the lock is only taken when a window of auto level is finished.
+ */
+class CompressionColumnStatistics final {
+public:
+    CompressionColumnStatistics();
+
+    CompressionColumnStatistics(const CompressionColumnStatistics&) = delete;
+    CompressionColumnStatistics& operator=(const CompressionColumnStatistics&) = delete;
+
+    void setLevel(int level);
+    void enableAutoLevel();
+    bool isAutoLevel() const;
+    int getLevel() const;
+
+    // Data in the formats with builtin compression, like jpeg, png and zip.
+    static bool isLikelyCompressed(const UnsafeData& data);
+
+    bool shouldTryCompress();
+    void addSkipped(size_t originalSize);
+    void addResult(size_t originalSize, size_t compressedSize, bool accepted, int64_t costInNanoseconds);
+
+    typedef struct Snapshot {
+        int level = 0;
+        int64_t compressedCount = 0;
+        int64_t uncompressedCount = 0;
+        int64_t skippedCount = 0;
+        size_t originalSize = 0;
+        size_t compressedSize = 0;
+    } Snapshot;
+    Snapshot getSnapshot() const;
+
+private:
+    std::atomic<int> m_level;
+    std::atomic<int64_t> m_compressedCount;
+    std::atomic<int64_t> m_uncompressedCount;
+    std::atomic<int64_t> m_skippedCount;
+    std::atomic<size_t> m_originalSize;
+    std::atomic<size_t> m_compressedSize;
+
+#pragma mark - Incompressible
+private:
+    std::atomic<int> m_continuousRejectedCount;
+    std::atomic<int> m_skippedSinceLastTry;
+
+#pragma mark - Auto Level
+private:
+    typedef struct Window {
+        int64_t count = 0;
+        size_t originalSize = 0;
+        size_t savedSize = 0;
+        int64_t cost = 0;
+    } Window;
+
+    void updateLevel(size_t originalSize, size_t savedSize, int64_t cost);
+    void finishWindow();
+
+    SharedLock m_lock;
+    std::atomic<bool> m_autoLevel;
+    int m_levelIndex;
+    int m_probeStep;
+    bool m_probeUp;
+    Window m_baseline;
+    // Values of the current window are accumulated without lock.
+    std::atomic<int64_t> m_windowCount;
+    std::atomic<size_t> m_windowOriginalSize;
+    std::atomic<size_t> m_windowSavedSize;
+    std::atomic<int64_t> m_windowCost;
+};
+
+} //namespace WCDB
@@ -39,8 +39,9 @@ DecompressFunction::~DecompressFunction() = default;
 
 void DecompressFunction::process(ScalarFunctionAPI& apiObj)
 {
-    WCTAssert(apiObj.getValueCount() == 2);
-    if (apiObj.getValueCount() != 2) {
+    // The third parameter is the scope of trained dicts, which is only passed for the columns with auto-trained dict.
+    WCTAssert(apiObj.getValueCount() == 2 || apiObj.getValueCount() == 3);
+    if (apiObj.getValueCount() != 2 && apiObj.getValueCount() != 3) {
         apiObj.setErrorResult(Error::Code::Misuse,
                               StringView::formatted("Invalid parameter count for compress funciton: %d",
                                                     apiObj.getValueCount()));
@@ -59,8 +60,19 @@ void DecompressFunction::process(ScalarFunctionAPI& apiObj)
         transferValue(valueType, apiObj);
         return;
     }
-    CompressionCenter::shared().decompressContent(
-    data, compressionType == CompressedType::ZSTDDict, WCDBGetOriginType(type), apiObj);
+    uint32_t dictScope = 0;
+    if (apiObj.getValueCount() == 3) {
+        dictScope = (uint32_t) apiObj.getIntValue(2);
+    } else if (compressionType == CompressedType::ZSTDDict) {
+        // The data compressed by auto-trained dict is also decodable without the scope, e.g. in the raw SQL.
+        dictScope = CompressionCenter::shared().getTrainedDictScope(
+        data, apiObj.getDatabasePath());
+    }
+    CompressionCenter::shared().decompressContent(data,
+                                                  compressionType == CompressedType::ZSTDDict,
+                                                  dictScope,
+                                                  WCDBGetOriginType(type),
+                                                  apiObj);
 }
 
 void DecompressFunction::transferValue(ColumnType type, ScalarFunctionAPI& apiObj)
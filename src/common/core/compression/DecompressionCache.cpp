@@ -0,0 +1,210 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DecompressionCache.hpp"
+#include "Assertion.hpp"
+#include "MemoryGovernor.hpp"
+#include <string.h>
+
+namespace WCDB {
+
+DecompressionCache::DecompressionCache()
+: m_capacity(0)
+, m_reliefGeneration(MemoryGovernor::shared().getReliefGeneration())
+, m_hitCount(0)
+, m_missCount(0)
+, m_savedSize(0)
+{
+}
+
+DecompressionCache::~DecompressionCache() = default;
+
+void DecompressionCache::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    for (auto& shard : m_shards) {
+        LockGuard lockGuard(shard.m_lock);
+        shard.setCapacity(capacity / ShardCount);
+    }
+}
+
+bool DecompressionCache::isEnabled() const
+{
+    return m_capacity.load() > 0;
+}
+
+uint64_t DecompressionCache::getKey(const UnsafeData& compressed, uint32_t dictScope)
+{
+    return ((uint64_t) (compressed.hash() ^ dictScope) << 32) | (uint32_t) compressed.size();
+}
+
+DecompressionCache::Shard& DecompressionCache::getShard(uint64_t key)
+{
+    return m_shards[(key >> 32) % ShardCount];
+}
+
+Optional<Data> DecompressionCache::get(const UnsafeData& compressed, uint32_t dictScope)
+{
+    tryClearForMemoryRelief();
+    uint64_t key = getKey(compressed, dictScope);
+    Shard& shard = getShard(key);
+    Optional<Data> decompressed;
+    {
+        LockGuard lockGuard(shard.m_lock);
+        decompressed = shard.find(key, compressed, dictScope);
+    }
+    if (decompressed.succeed()) {
+        ++m_hitCount;
+        m_savedSize += decompressed.value().size();
+    } else {
+        ++m_missCount;
+    }
+    return decompressed;
+}
+
+void DecompressionCache::put(const UnsafeData& compressed,
+                             uint32_t dictScope,
+                             const UnsafeData& decompressed)
+{
+    uint64_t key = getKey(compressed, dictScope);
+    Shard& shard = getShard(key);
+    LockGuard lockGuard(shard.m_lock);
+    // Large value would flush the whole shard.
+    if ((compressed.size() + decompressed.size()) * 4 > shard.getCapacity()) {
+        return;
+    }
+    shard.insert(key, compressed, dictScope, decompressed);
+}
+
+void DecompressionCache::clear()
+{
+    for (auto& shard : m_shards) {
+        LockGuard lockGuard(shard.m_lock);
+        shard.clear();
+    }
+}
+
+void DecompressionCache::tryClearForMemoryRelief()
+{
+    uint32_t reliefGeneration = MemoryGovernor::shared().getReliefGeneration();
+    uint32_t oldGeneration = m_reliefGeneration.load();
+    if (reliefGeneration != oldGeneration
+        && m_reliefGeneration.compare_exchange_strong(oldGeneration, reliefGeneration)) {
+        clear();
+    }
+}
+
+DecompressionCache::Statistics DecompressionCache::getStatistics() const
+{
+    Statistics statistics;
+    statistics.hitCount = m_hitCount.load();
+    statistics.missCount = m_missCount.load();
+    statistics.savedSize = m_savedSize.load();
+    for (const auto& shard : m_shards) {
+        SharedLockGuard lockGuard(shard.m_lock);
+        statistics.cachedSize += shard.getCachedSize();
+    }
+    return statistics;
+}
+
+#pragma mark - Shard
+DecompressionCache::Shard::Shard() : m_capacity(0), m_cachedSize(0)
+{
+}
+
+DecompressionCache::Shard::~Shard() = default;
+
+void DecompressionCache::Shard::setCapacity(size_t capacity)
+{
+    m_capacity = capacity;
+    while (shouldPurge()) {
+        purge();
+    }
+}
+
+size_t DecompressionCache::Shard::getCapacity() const
+{
+    return m_capacity;
+}
+
+size_t DecompressionCache::Shard::getCachedSize() const
+{
+    return m_cachedSize;
+}
+
+Optional<Data>
+DecompressionCache::Shard::find(uint64_t key, const UnsafeData& compressed, uint32_t dictScope)
+{
+    if (!exists(key)) {
+        return NullOpt;
+    }
+    const Entry& entry = get(key);
+    // Key is not unique, so the content should be checked.
+    if (entry.dictScope != dictScope || entry.compressed.size() != compressed.size()
+        || memcmp(entry.compressed.buffer(), compressed.buffer(), compressed.size()) != 0) {
+        return NullOpt;
+    }
+    return entry.decompressed;
+}
+
+void DecompressionCache::Shard::insert(uint64_t key,
+                                       const UnsafeData& compressed,
+                                       uint32_t dictScope,
+                                       const UnsafeData& decompressed)
+{
+    if (exists(key)) {
+        // Replace the old one, whose size is subtracted in willPurge.
+        willPurge(key, get(key));
+    }
+    Entry entry;
+    entry.dictScope = dictScope;
+    entry.compressed = Data(compressed.buffer(), compressed.size());
+    entry.decompressed = Data(decompressed.buffer(), decompressed.size());
+    if (entry.compressed.size() != compressed.size()
+        || entry.decompressed.size() != decompressed.size()) {
+        // No memory
+        return;
+    }
+    m_cachedSize += compressed.size() + decompressed.size();
+    put(key, entry);
+    while (shouldPurge()) {
+        purge();
+    }
+}
+
+void DecompressionCache::Shard::clear()
+{
+    purge(size());
+    WCTAssert(m_cachedSize == 0);
+}
+
+bool DecompressionCache::Shard::shouldPurge() const
+{
+    return m_cachedSize > m_capacity && !empty();
+}
+
+void DecompressionCache::Shard::willPurge(const uint64_t& key, const Entry& entry)
+{
+    WCDB_UNUSED(key);
+    WCTAssert(m_cachedSize >= entry.compressed.size() + entry.decompressed.size());
+    m_cachedSize -= entry.compressed.size() + entry.decompressed.size();
+}
+
+} //namespace WCDB
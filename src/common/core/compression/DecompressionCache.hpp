@@ -0,0 +1,109 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Data.hpp"
+#include "LRUCache.hpp"
+#include "Lock.hpp"
+#include "WCDBOptional.hpp"
+#include <array>
+#include <atomic>
+
+namespace WCDB {
+
+/*
+ Bounded cache of decompressed values keyed by the compressed content and the scope of its dict.
+ Since a key always maps to the same value, modifications of tables never make the cache stale,
+ and the same value stored in multiple rows shares one entry.
+ */
+class DecompressionCache final {
+public:
+    DecompressionCache();
+    ~DecompressionCache();
+
+    DecompressionCache(const DecompressionCache&) = delete;
+    DecompressionCache& operator=(const DecompressionCache&) = delete;
+
+    // Zero capacity disables the cache.
+    void setCapacity(size_t capacity);
+    bool isEnabled() const;
+
+    Optional<Data> get(const UnsafeData& compressed, uint32_t dictScope);
+    void put(const UnsafeData& compressed, uint32_t dictScope, const UnsafeData& decompressed);
+    void clear();
+
+    typedef struct Statistics {
+        int64_t hitCount = 0;
+        int64_t missCount = 0;
+        // Size of the decompressed values returned from cache.
+        int64_t savedSize = 0;
+        size_t cachedSize = 0;
+    } Statistics;
+    Statistics getStatistics() const;
+
+private:
+    typedef struct Entry {
+        uint32_t dictScope;
+        Data compressed;
+        Data decompressed;
+    } Entry;
+
+    class Shard final : protected LRUCache<uint64_t, Entry> {
+    public:
+        Shard();
+        ~Shard() override;
+
+        using Super = LRUCache<uint64_t, Entry>;
+
+        void setCapacity(size_t capacity);
+        size_t getCapacity() const;
+        size_t getCachedSize() const;
+        Optional<Data> find(uint64_t key, const UnsafeData& compressed, uint32_t dictScope);
+        void insert(uint64_t key,
+                    const UnsafeData& compressed,
+                    uint32_t dictScope,
+                    const UnsafeData& decompressed);
+        void clear();
+
+        mutable SharedLock m_lock;
+
+    protected:
+        bool shouldPurge() const override final;
+        void willPurge(const uint64_t& key, const Entry& entry) override final;
+
+        size_t m_capacity;
+        size_t m_cachedSize;
+    };
+
+    static constexpr const int ShardCount = 8;
+    static uint64_t getKey(const UnsafeData& compressed, uint32_t dictScope);
+    Shard& getShard(uint64_t key);
+    void tryClearForMemoryRelief();
+
+    std::array<Shard, ShardCount> m_shards;
+    std::atomic<size_t> m_capacity;
+    std::atomic<uint32_t> m_reliefGeneration;
+    std::atomic<int64_t> m_hitCount;
+    std::atomic<int64_t> m_missCount;
+    std::atomic<int64_t> m_savedSize;
+};
+
+} //namespace WCDB
@@ -23,6 +23,7 @@
  */
 
 #include "ZSTDContext.hpp"
+#include "MemoryGovernor.hpp"
 #include <memory>
 #include <stdlib.h>
 #if defined(WCDB_ZSTD) && WCDB_ZSTD
@@ -32,7 +33,11 @@
 namespace WCDB {
 
 ZSTDContext::ZSTDContext()
-: m_buffer(nullptr), m_bufferSize(0), m_cctx(nullptr), m_dctx(nullptr)
+: m_buffer(nullptr)
+, m_bufferSize(0)
+, m_reliefGeneration(MemoryGovernor::shared().getReliefGeneration())
+, m_cctx(nullptr)
+, m_dctx(nullptr)
 {
 }
 
@@ -46,9 +51,7 @@ ZSTDContext::~ZSTDContext()
         ZSTD_freeDCtx((ZSTD_DCtx*) m_dctx);
     }
 #endif
-    if (m_buffer != nullptr) {
-        free(m_buffer);
-    }
+    freeBuffer();
 }
 
 ZCCtx* ZSTDContext::getOrCreateCCtx()
@@ -73,20 +76,38 @@ ZDCtx* ZSTDContext::getOrCreateDCtx()
 
 void* ZSTDContext::getOrCreateBuffer(size_t size)
 {
+    uint32_t reliefGeneration = MemoryGovernor::shared().getReliefGeneration();
+    if (reliefGeneration != m_reliefGeneration) {
+        // Memory has been relieved since last use, so don't keep the cached buffer.
+        m_reliefGeneration = reliefGeneration;
+        freeBuffer();
+    }
     if (size < MaxBufferSize && m_bufferSize >= MaxBufferSize) {
         // Free accidentally large buffer
-        free(m_buffer);
-        m_buffer = nullptr;
+        freeBuffer();
     }
     if (m_bufferSize > size && m_buffer != nullptr) {
         return m_buffer;
     }
+    freeBuffer();
+    m_buffer = malloc(size);
     if (m_buffer != nullptr) {
-        free(m_buffer);
+        m_bufferSize = size;
+        MemoryGovernor::shared().increase(
+        UnsafeStringView(), MemoryGovernor::Component::ZSTDContext, m_bufferSize);
     }
-    m_buffer = malloc(size);
-    m_bufferSize = size;
     return m_buffer;
 }
 
+void ZSTDContext::freeBuffer()
+{
+    if (m_buffer != nullptr) {
+        free(m_buffer);
+        m_buffer = nullptr;
+        MemoryGovernor::shared().decrease(
+        UnsafeStringView(), MemoryGovernor::Component::ZSTDContext, m_bufferSize);
+    }
+    m_bufferSize = 0;
+}
+
 } //namespace WCDB
@@ -24,6 +24,7 @@
 
 #pragma once
 #include "SysTypes.h"
+#include <cstdint>
 
 namespace WCDB {
 
@@ -39,9 +40,11 @@ public:
     void* getOrCreateBuffer(size_t size);
 
 private:
+    void freeBuffer();
     static constexpr const size_t MaxBufferSize = 1024 * 1024;
     void* m_buffer;
     size_t m_bufferSize;
+    uint32_t m_reliefGeneration;
     ZCCtx* m_cctx;
     ZDCtx* m_dctx;
 };
@@ -39,7 +39,7 @@ BusyRetryConfig::BusyRetryConfig()
     Global::shared().setNotificationForLockEvent(
     m_identifier,
     std::bind(&BusyRetryConfig::willLock, this, std::placeholders::_1, std::placeholders::_2),
-    std::bind(&BusyRetryConfig::lockDidChange, this, std::placeholders::_1, std::placeholders::_2),
+    std::bind(&BusyRetryConfig::lockDidChange, this, std::placeholders::_1, std::placeholders::_3),
     std::bind(
     &BusyRetryConfig::willShmLock, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
     std::bind(&BusyRetryConfig::shmLockDidChange,
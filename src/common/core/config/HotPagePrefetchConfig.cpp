@@ -0,0 +1,47 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HotPagePrefetchConfig.hpp"
+#include "CommonCore.hpp"
+#include "InnerHandle.hpp"
+
+namespace WCDB {
+
+HotPagePrefetchConfig::HotPagePrefetchConfig() : Config()
+{
+}
+
+HotPagePrefetchConfig::~HotPagePrefetchConfig() = default;
+
+bool HotPagePrefetchConfig::invoke(InnerHandle* handle)
+{
+    StringView path = handle->getPath();
+    {
+        LockGuard lockGuard(m_lock);
+        if (!m_prefetchedPaths.emplace(path).second) {
+            return true;
+        }
+    }
+    // Prefetching is a hint to the system, so it doesn't block the opening of handle.
+    CommonCore::shared().asyncPrefetchHotPages(path);
+    return true;
+}
+
+} //namespace WCDB
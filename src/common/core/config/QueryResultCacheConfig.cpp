@@ -0,0 +1,102 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryResultCacheConfig.hpp"
+#include "Assertion.hpp"
+#include "InnerHandle.hpp"
+#include "StringView.hpp"
+
+namespace WCDB {
+
+QueryResultCacheConfig::QueryResultCacheConfig(const std::shared_ptr<QueryResultCache>& cache)
+: Config(), m_identifier(StringView::formatted("QueryResultCache-%p", this)), m_cache(cache)
+{
+    WCTAssert(m_cache != nullptr);
+}
+
+QueryResultCacheConfig::~QueryResultCacheConfig() = default;
+
+bool QueryResultCacheConfig::invoke(InnerHandle* handle)
+{
+    handle->setNotificationWhenTableModified(
+    m_identifier,
+    [this, handle](const UnsafeStringView&, const UnsafeStringView& newTable, const UnsafeStringView& modifiedTable) {
+        onTableModified(handle, newTable, modifiedTable);
+    });
+    // Run before the others, which may stop the notification chain.
+    handle->setNotificationWhenCommitted(
+    -1, m_identifier, [this, handle](const UnsafeStringView&, int pages) {
+        return onCommitted(handle, pages);
+    });
+    return true;
+}
+
+bool QueryResultCacheConfig::uninvoke(InnerHandle* handle)
+{
+    handle->unsetNotificationWhenCommitted(m_identifier);
+    handle->setNotificationWhenTableModified(m_identifier, nullptr);
+    LockGuard lockGuard(m_lock);
+    m_modifiedTables.erase(handle);
+    return true;
+}
+
+void QueryResultCacheConfig::onTableModified(const InnerHandle* handle,
+                                             const UnsafeStringView& newTable,
+                                             const UnsafeStringView& modifiedTable)
+{
+    if (modifiedTable.empty()) {
+        return;
+    }
+    // Drop the results at once so that the following reads in the same thread see the modification.
+    m_cache->invalidate(modifiedTable);
+    LockGuard lockGuard(m_lock);
+    m_modifiedTables[handle].emplace(StringView(modifiedTable));
+    WCDB_UNUSED(newTable);
+}
+
+bool QueryResultCacheConfig::onCommitted(const InnerHandle* handle, int pages)
+{
+    StringViewSet modifiedTables;
+    {
+        LockGuard lockGuard(m_lock);
+        auto iter = m_modifiedTables.find(handle);
+        if (iter != m_modifiedTables.end()) {
+            modifiedTables = std::move(iter->second);
+            m_modifiedTables.erase(iter);
+        }
+    }
+    if (pages == 0) {
+        return true;
+    }
+    /*
+     Other threads may cache the results read before committing, so they are dropped again.
+     The modifications made by raw SQLs are unknown, including the schema, so all results are dropped for them.
+     */
+    if (modifiedTables.empty()) {
+        m_cache->invalidateSchema();
+    } else {
+        for (const StringView& table : modifiedTables) {
+            m_cache->invalidate(table);
+        }
+    }
+    return true;
+}
+
+} //namespace WCDB
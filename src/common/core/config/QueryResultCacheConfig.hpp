@@ -0,0 +1,52 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Config.hpp"
+#include "Lock.hpp"
+#include "QueryResultCache.hpp"
+#include <map>
+
+namespace WCDB {
+
+class QueryResultCacheConfig final : public Config {
+public:
+    QueryResultCacheConfig(const std::shared_ptr<QueryResultCache>& cache);
+    ~QueryResultCacheConfig() override;
+
+    bool invoke(InnerHandle* handle) override final;
+    bool uninvoke(InnerHandle* handle) override final;
+
+protected:
+    const StringView m_identifier;
+
+    void onTableModified(const InnerHandle* handle,
+                         const UnsafeStringView& newTable,
+                         const UnsafeStringView& modifiedTable);
+    bool onCommitted(const InnerHandle* handle, int pages);
+
+    std::shared_ptr<QueryResultCache> m_cache;
+    // Tables modified by the uncommitted transaction of each handle
+    std::map<const InnerHandle*, StringViewSet> m_modifiedTables;
+    SharedLock m_lock;
+};
+
+} //namespace WCDB
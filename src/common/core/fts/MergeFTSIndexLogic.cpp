@@ -27,8 +27,13 @@
 #include "CommonCore.hpp"
 #include "CoreConst.h"
 #include "Notifier.hpp"
+#include "Serialization.hpp"
+#include "Time.hpp"
 #include "WCDBError.hpp"
+#include <climits>
 #include <cmath>
+#include <cstring>
+#include <thread>
 
 namespace WCDB {
 
@@ -54,6 +59,7 @@ bool MergeFTSIndexLogic::tryInit(InnerHandle &handle)
     }
     m_mergedTables.clear();
     m_mergingTables.clear();
+    m_tableStates.clear();
 
     if (!handle.prepare(m_getTableStatement)) {
         return false;
@@ -175,7 +181,7 @@ void MergeFTSIndexLogic::proccessMerge()
         if (m_mergingTables.size() == 0) {
             return;
         }
-        table = *m_mergingTables.begin();
+        table = pickMergingTable();
     }
     RecyclableHandle recyclableHandle = m_handleProvider->getMergeIndexHandle();
     if (recyclableHandle == nullptr) {
@@ -201,7 +207,7 @@ void MergeFTSIndexLogic::proccessMerge()
         m_mergingTables.erase(table);
         m_mergedTables.emplace(table);
         if (m_mergingTables.size() > 0) {
-            table = *m_mergingTables.begin();
+            table = pickMergingTable();
         } else {
             break;
         }
@@ -211,36 +217,219 @@ void MergeFTSIndexLogic::proccessMerge()
 
 bool MergeFTSIndexLogic::mergeTable(InnerHandle &handle, const StringView &table)
 {
-    int preChangeCount;
-    Statement mergeSTM
-    = StatementInsert()
-      .insertIntoTable(table)
-      .columns({ Column(table), Column("rank"), Column().rowid() })
-      .values({ UnsafeStringView("merge"), 256, WCDB::BindParameter(1) });
-    if (!handle.prepare(mergeSTM)) {
+    TableMergeState state;
+    {
+        SharedLockGuard lockGuard(m_lock);
+        auto iter = m_tableStates.find(table);
+        if (iter != m_tableStates.end()) {
+            state = iter->second;
+        }
+    }
+    if (!readStructure(handle, table, state)) {
         return false;
     }
-    void **callbackPointer = new void *[2];
-    callbackPointer[0] = (void *) MergeFTSIndexLogic::userMergeCallback;
-    callbackPointer[1] = &handle;
-    do {
-        preChangeCount = handle.getTotalChange();
-        handle.bindPointer(callbackPointer, 1, "fts5_user_merge_callback", nullptr);
-        if (!handle.step()) {
-            handle.finalize();
-            delete[] callbackPointer;
+    int originalSegmentCount = state.segmentCount;
+    MergePerformance performance;
+    // A negative segment count means that the structure can not be parsed, so merge it anyway.
+    if (state.segmentCount < 0 || state.segmentCount >= AutoMergeFTS5IndexMinSegmentCount) {
+        Statement mergeSTM
+        = StatementInsert()
+          .insertIntoTable(table)
+          .columns({ Column(table), Column("rank"), Column().rowid() })
+          .values({ UnsafeStringView("merge"), WCDB::BindParameter(2), WCDB::BindParameter(1) });
+        if (!handle.prepare(mergeSTM)) {
             return false;
-        } else {
+        }
+        void **callbackPointer = new void *[2];
+        callbackPointer[0] = (void *) MergeFTSIndexLogic::userMergeCallback;
+        callbackPointer[1] = &handle;
+        double backoff = 0;
+        bool succeed = true;
+        while (true) {
+            int preChangeCount = handle.getTotalChange();
+            handle.bindPointer(callbackPointer, 1, "fts5_user_merge_callback", nullptr);
+            handle.bindInteger(state.pagesPerStep, 2);
+            SteadyClock before = SteadyClock::now();
+            if (!handle.step()) {
+                succeed = false;
+                break;
+            }
             handle.reset();
+            double cost = SteadyClock::timeIntervalSinceSteadyClockToNow(before);
+            int changes = handle.getTotalChange() - preChangeCount;
+            bool contended = handle.checkHasBusyRetry();
+
+            performance.stepCount++;
+            performance.mergeTime += cost;
+            if (contended) {
+                performance.contendedCount++;
+            }
+            if (changes <= 1) {
+                // Only the structure record is rewritten. There is nothing left to merge.
+                break;
+            }
+            // Each leaf page of fts5 is stored as a row of its %_data table.
+            performance.writtenPages += changes - 1;
+
+            tuneStepSize(state, cost, contended);
+            backoff = nextBackoff(backoff, contended);
+            if (backoff > 0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(backoff));
+                performance.backoffTime += backoff;
+            } else {
+                std::this_thread::yield();
+            }
         }
-        //Use prime numbers to reduce the probability of collision with external logic
-        std::this_thread::sleep_for(std::chrono::microseconds(1229));
-    } while (handle.getTotalChange() - preChangeCount > 1);
+        handle.finalize();
+        delete[] callbackPointer;
+        if (!succeed || !readStructure(handle, table, state)) {
+            return false;
+        }
+    }
+    {
+        LockGuard lockGuard(m_lock);
+        m_tableStates[table] = state;
+    }
+    if (performance.stepCount > 0) {
+        reportPerformance(table, originalSegmentCount, state, performance);
+    }
+    return true;
+}
+
+bool MergeFTSIndexLogic::readStructure(InnerHandle &handle,
+                                       const UnsafeStringView &table,
+                                       TableMergeState &state)
+{
+    // The structure record of fts5 index is stored in the row with id 10 of its %_data table.
+    Statement selectStructure = StatementSelect()
+                                .select(Column("block"))
+                                .from(StringView().formatted("%s_data", table.data()))
+                                .where(Column("id") == 10);
+    if (!handle.prepare(selectStructure)) {
+        return false;
+    }
+    if (!handle.step()) {
+        handle.finalize();
+        return false;
+    }
+    if (handle.done()) {
+        state.levelCount = 0;
+        state.segmentCount = 0;
+    } else if (!parseStructure(handle.getBLOB(0), state.levelCount, state.segmentCount)) {
+        state.levelCount = -1;
+        state.segmentCount = -1;
+    }
     handle.finalize();
-    delete[] callbackPointer;
     return true;
 }
 
+bool MergeFTSIndexLogic::parseStructure(const UnsafeData &structure, int &levelCount, int &segmentCount)
+{
+    // 4 bytes cookie, an optional 4 bytes tag of structure v2, varint level count and varint segment count.
+    static constexpr const unsigned char structureV2Tag[] = { 0xff, 0x00, 0x00, 0x01 };
+    Deserialization deserialization(structure);
+    if (!deserialization.canAdvance(4)) {
+        return false;
+    }
+    deserialization.advance(4);
+    if (deserialization.canAdvance(4)
+        && memcmp(structure.buffer() + 4, structureV2Tag, sizeof(structureV2Tag)) == 0) {
+        deserialization.advance(4);
+    }
+    auto level = deserialization.advanceVarint();
+    if (level.first == 0) {
+        return false;
+    }
+    auto segment = deserialization.advanceVarint();
+    if (segment.first == 0) {
+        return false;
+    }
+    levelCount = (int) level.second;
+    segmentCount = (int) segment.second;
+    return true;
+}
+
+void MergeFTSIndexLogic::tuneStepSize(TableMergeState &state, double cost, bool contended)
+{
+    int pages = state.pagesPerStep;
+    if (contended) {
+        pages /= 2;
+    } else if (cost <= 0) {
+        pages *= 2;
+    } else {
+        // Move halfway to the page count fitting the budget so that a single slow step won't collapse the step size.
+        double expected = std::min((double) AutoMergeFTS5IndexMaxPagesPerStep,
+                                   pages * AutoMergeFTSIndexStepTimeBudget / cost);
+        pages = (int) ((pages + expected) / 2);
+    }
+    state.pagesPerStep = std::max(AutoMergeFTS5IndexMinPagesPerStep,
+                                  std::min(AutoMergeFTS5IndexMaxPagesPerStep, pages));
+}
+
+double MergeFTSIndexLogic::nextBackoff(double backoff, bool contended)
+{
+    if (contended) {
+        return std::min(AutoMergeFTSIndexMaxBackoff,
+                        std::max(AutoMergeFTSIndexMinBackoff, backoff * 2));
+    }
+    backoff /= 2;
+    return backoff < AutoMergeFTSIndexMinBackoff ? 0 : backoff;
+}
+
+StringView MergeFTSIndexLogic::pickMergingTable() const
+{
+    // Merge the table with the most segments first. Tables never inspected are the most urgent.
+    StringView table;
+    int maxSegmentCount = -1;
+    for (const StringView &element : m_mergingTables) {
+        int segmentCount = INT_MAX;
+        auto iter = m_tableStates.find(element);
+        if (iter != m_tableStates.end() && iter->second.segmentCount >= 0) {
+            segmentCount = iter->second.segmentCount;
+        }
+        if (segmentCount > maxSegmentCount) {
+            maxSegmentCount = segmentCount;
+            table = element;
+        }
+    }
+    return table;
+}
+
+void MergeFTSIndexLogic::reportPerformance(const UnsafeStringView &table,
+                                           int originalSegmentCount,
+                                           const TableMergeState &state,
+                                           const MergePerformance &performance) const
+{
+    Error error(Error::Code::Notice, Error::Level::Notice, "Merge fts index performance");
+    error.infos.insert_or_assign(ErrorStringKeyPath, m_handleProvider->getPath());
+    error.infos.insert_or_assign(ErrorStringKeyType, ErrorTypeMergeIndex);
+    error.infos.insert_or_assign("Table", table);
+    error.infos.insert_or_assign("OriginalSegmentCount", originalSegmentCount);
+    error.infos.insert_or_assign("SegmentCount", state.segmentCount);
+    error.infos.insert_or_assign("LevelCount", state.levelCount);
+    error.infos.insert_or_assign("PagesPerStep", state.pagesPerStep);
+    error.infos.insert_or_assign("StepCount", performance.stepCount);
+    error.infos.insert_or_assign("ContendedCount", performance.contendedCount);
+    error.infos.insert_or_assign("WrittenPages", performance.writtenPages);
+    error.infos.insert_or_assign("MergeTime", performance.mergeTime);
+    error.infos.insert_or_assign("BackoffTime", performance.backoffTime);
+    if (performance.mergeTime > 0) {
+        error.infos.insert_or_assign("Throughput",
+                                     performance.writtenPages / performance.mergeTime);
+    }
+    Notifier::shared().notify(error);
+}
+
+MergeFTSIndexLogic::TableMergeState::TableMergeState()
+: segmentCount(-1), levelCount(-1), pagesPerStep(AutoMergeFTS5IndexDefaultPagesPerStep)
+{
+}
+
+MergeFTSIndexLogic::MergePerformance::MergePerformance()
+: stepCount(0), contendedCount(0), writtenPages(0), mergeTime(0), backoffTime(0)
+{
+}
+
 void MergeFTSIndexLogic::userMergeCallback(InnerHandle *handle,
                                            int *remainPages,
                                            int totalPagesWriten,
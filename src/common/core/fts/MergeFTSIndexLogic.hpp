@@ -61,6 +61,36 @@ private:
     bool mergeTable(InnerHandle& handle, const StringView& table);
     void increaseErrorCount();
 
+    /*
+     Per table scheduling state. The segment count and level count are parsed from the fts5 structure record,
+     the page count of each merge step is tuned to the time budget of one step,
+     and the interval between steps backs off when other handles are waiting for the write lock.
+     */
+    struct TableMergeState {
+        TableMergeState();
+        int segmentCount;
+        int levelCount;
+        int pagesPerStep;
+    };
+    struct MergePerformance {
+        MergePerformance();
+        int stepCount;
+        int contendedCount;
+        int writtenPages;
+        double mergeTime;
+        double backoffTime;
+    };
+    bool readStructure(InnerHandle& handle, const UnsafeStringView& table, TableMergeState& state);
+    static bool
+    parseStructure(const UnsafeData& structure, int& levelCount, int& segmentCount);
+    static void tuneStepSize(TableMergeState& state, double cost, bool contended);
+    static double nextBackoff(double backoff, bool contended);
+    StringView pickMergingTable() const;
+    void reportPerformance(const UnsafeStringView& table,
+                           int originalSegmentCount,
+                           const TableMergeState& state,
+                           const MergePerformance& performance) const;
+
     static void
     userMergeCallback(InnerHandle* handle, int* remainPages, int totalPagesWriten, int* lastCheckPages);
 
@@ -75,6 +105,7 @@ private:
     Statement m_getTableStatement;
     StringViewSet m_mergingTables;
     StringViewSet m_mergedTables;
+    StringViewMap<TableMergeState> m_tableStates;
 
 private:
     class OperationQueue : public AsyncQueue {
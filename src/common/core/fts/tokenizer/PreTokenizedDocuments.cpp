@@ -0,0 +1,359 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PreTokenizedDocuments.hpp"
+#include "Assertion.hpp"
+#include "CommonCore.hpp"
+#include "CoreConst.h"
+#include "FTSConst.h"
+#include "SQLite.h"
+#include "StatementCreateVirtualTable.hpp"
+#include "Thread.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace WCDB {
+
+static thread_local const PreTokenizedDocuments *g_replayingDocuments = nullptr;
+
+#pragma mark - Workers
+// Workers are kept alive across batches so that tokenizing a batch doesn't pay for spawning threads.
+class PreTokenizeWorkers final {
+public:
+    static PreTokenizeWorkers &shared()
+    {
+        static PreTokenizeWorkers *s_workers = new PreTokenizeWorkers;
+        return *s_workers;
+    }
+
+    // The first task is run on current thread and the others are run on workers.
+    void run(std::vector<std::function<void()>> &&tasks)
+    {
+        if (tasks.empty()) {
+            return;
+        }
+        size_t remaining = tasks.size() - 1;
+        {
+            std::lock_guard<std::mutex> lockGuard(m_lock);
+            for (auto iter = std::next(tasks.begin()); iter != tasks.end(); ++iter) {
+                m_tasks.push_back({ std::move(*iter), &remaining });
+            }
+            while (m_idleWorkers < m_tasks.size() && m_workers < m_maxWorkers) {
+                ++m_workers;
+                ++m_idleWorkers;
+                std::thread(&PreTokenizeWorkers::loop, this).detach();
+            }
+        }
+        m_pending.notify_all();
+        tasks.front()();
+        std::unique_lock<std::mutex> lockGuard(m_lock);
+        while (remaining > 0) {
+            m_done.wait(lockGuard);
+        }
+    }
+
+protected:
+    PreTokenizeWorkers()
+    : m_workers(0)
+    , m_idleWorkers(0)
+    , m_maxWorkers(std::max((size_t) std::thread::hardware_concurrency(), (size_t) 1))
+    {
+    }
+
+    struct Task {
+        std::function<void()> work;
+        size_t *remaining;
+    };
+
+    void loop()
+    {
+        Thread::setName(PreTokenizeThreadName);
+        std::unique_lock<std::mutex> lockGuard(m_lock);
+        while (true) {
+            while (m_tasks.empty()) {
+                m_pending.wait(lockGuard);
+            }
+            Task task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            --m_idleWorkers;
+            lockGuard.unlock();
+            task.work();
+            lockGuard.lock();
+            ++m_idleWorkers;
+            if (--*task.remaining == 0) {
+                m_done.notify_all();
+            }
+        }
+    }
+
+    std::mutex m_lock;
+    Conditional m_pending;
+    Conditional m_done;
+    std::list<Task> m_tasks;
+    size_t m_workers;
+    size_t m_idleWorkers;
+    const size_t m_maxWorkers;
+};
+
+PreTokenizedDocuments::PreTokenizedDocuments() : m_tokenize(nullptr), m_cursor(0)
+{
+}
+
+PreTokenizedDocuments::~PreTokenizedDocuments()
+{
+    WCTAssert(g_replayingDocuments != this);
+}
+
+#pragma mark - Tokenize
+PreTokenizedDocuments::Chunk::Chunk() : begin(0), end(0), rc(FTSError::OK())
+{
+}
+
+bool PreTokenizedDocuments::tokenize(const UnsafeStringView &tokenizer,
+                                     std::vector<StringView> &&documents,
+                                     int parallelism)
+{
+    std::vector<StringView> words;
+    size_t begin = 0;
+    while (begin < tokenizer.length()) {
+        size_t end = tokenizer.find(" ", begin);
+        if (end == UnsafeStringView::npos) {
+            end = tokenizer.length();
+        }
+        if (end > begin) {
+            words.emplace_back(tokenizer.data() + begin, end - begin);
+        }
+        begin = end + 1;
+    }
+    if (words.empty()) {
+        return false;
+    }
+    const TokenizerModule *module = CommonCore::shared().getTokenizer(words.front());
+    if (module == nullptr || module->getFts5Module() == nullptr) {
+        return false;
+    }
+    const FTS5TokenizerModule &fts5Module = *module->getFts5Module();
+    std::vector<const char *> arguments;
+    for (auto iter = std::next(words.begin()); iter != words.end(); ++iter) {
+        arguments.push_back(iter->data());
+    }
+
+    m_texts = std::move(documents);
+    m_documents.clear();
+    m_tokens.clear();
+    m_buffer.clear();
+    m_index.clear();
+    m_cursor = 0;
+    m_tokenize = fts5Module.getTokenize();
+    m_arguments
+    = AbstractFTS5TokenizerModuleTemplate::joinArguments(arguments.data(), (int) arguments.size());
+
+    if (parallelism <= 0) {
+        parallelism = std::max((int) std::thread::hardware_concurrency(), 1);
+    }
+    size_t chunkCount = std::max<size_t>(std::min<size_t>(parallelism, m_texts.size()), 1);
+    std::vector<Chunk> chunks(chunkCount);
+    size_t chunkSize = (m_texts.size() + chunkCount - 1) / chunkCount;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        chunks[i].begin = std::min(i * chunkSize, m_texts.size());
+        chunks[i].end = std::min(chunks[i].begin + chunkSize, m_texts.size());
+    }
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunkCount);
+    for (Chunk &chunk : chunks) {
+        tasks.push_back([this, &fts5Module, &arguments, &chunk]() {
+            tokenizeChunk(fts5Module, arguments, chunk);
+        });
+    }
+    PreTokenizeWorkers::shared().run(std::move(tasks));
+
+    size_t tokenCount = 0;
+    size_t bufferSize = 0;
+    for (const Chunk &chunk : chunks) {
+        if (!FTSError::isOK(chunk.rc)) {
+            m_texts.clear();
+            m_tokenize = nullptr;
+            m_arguments.clear();
+            return false;
+        }
+        tokenCount += chunk.tokens.size();
+        bufferSize += chunk.buffer.size();
+    }
+    m_documents.reserve(m_texts.size());
+    m_tokens.reserve(tokenCount);
+    m_buffer.reserve(bufferSize);
+    for (const Chunk &chunk : chunks) {
+        size_t tokenOffset = m_tokens.size();
+        size_t bufferOffset = m_buffer.size();
+        for (const Document &document : chunk.documents) {
+            m_documents.push_back({ document.firstToken + tokenOffset, document.tokenCount });
+        }
+        for (const Token &token : chunk.tokens) {
+            m_tokens.push_back(token);
+            m_tokens.back().offset += bufferOffset;
+        }
+        m_buffer.append(chunk.buffer);
+    }
+    m_index.reserve(m_texts.size());
+    for (size_t i = 0; i < m_texts.size(); ++i) {
+        m_index.emplace(m_texts[i].hash(), i);
+    }
+    return true;
+}
+
+void PreTokenizedDocuments::tokenizeChunk(const FTS5TokenizerModule &module,
+                                          const std::vector<const char *> &arguments,
+                                          Chunk &chunk) const
+{
+    if (chunk.begin >= chunk.end) {
+        return;
+    }
+    AbstractFTSTokenizer *tokenizer = nullptr;
+    chunk.rc = module.createTokenizer(arguments.data(), (int) arguments.size(), &tokenizer);
+    if (!FTSError::isOK(chunk.rc)) {
+        return;
+    }
+    chunk.documents.reserve(chunk.end - chunk.begin);
+    for (size_t i = chunk.begin; i < chunk.end; ++i) {
+        const StringView &text = m_texts[i];
+        chunk.documents.push_back({ chunk.tokens.size(), 0 });
+        chunk.rc = module.tokenize(tokenizer,
+                                   &chunk,
+                                   FTS5_TOKENIZE_DOCUMENT,
+                                   text.data(),
+                                   (int) text.length(),
+                                   collectToken);
+        if (!FTSError::isOK(chunk.rc)) {
+            break;
+        }
+        chunk.documents.back().tokenCount
+        = chunk.tokens.size() - chunk.documents.back().firstToken;
+    }
+    module.destroyTokenizer(tokenizer);
+}
+
+int PreTokenizedDocuments::collectToken(
+void *pCtx, int tflags, const char *pToken, int nToken, int iStart, int iEnd)
+{
+    Chunk *chunk = static_cast<Chunk *>(pCtx);
+    chunk->tokens.push_back({ chunk->buffer.size(), nToken, iStart, iEnd, tflags });
+    chunk->buffer.append(pToken, nToken);
+    return FTSError::OK();
+}
+
+StringView PreTokenizedDocuments::getFTS5Tokenizer(const StatementCreateVirtualTable &statement)
+{
+    const Syntax::CreateVirtualTableSTMT &syntax = statement.syntax();
+    if (!syntax.module.caseInsensitiveEqual(Module::FTS5)) {
+        return StringView();
+    }
+    StringView prefix = Syntax::CreateVirtualTableSTMT::tokenizerPreFix();
+    for (const StringView &argument : syntax.arguments) {
+        if (argument.hasPrefix(prefix)) {
+            return StringView(argument.data() + prefix.length(),
+                              argument.length() - prefix.length());
+        }
+    }
+    return StringView();
+}
+
+size_t PreTokenizedDocuments::getDocumentCount() const
+{
+    return m_documents.size();
+}
+
+size_t PreTokenizedDocuments::getTokenCount() const
+{
+    return m_tokens.size();
+}
+
+#pragma mark - Replay
+PreTokenizedDocuments::ReplayScope::ReplayScope(const PreTokenizedDocuments &documents)
+: m_previous(g_replayingDocuments)
+{
+    documents.m_cursor = 0;
+    g_replayingDocuments = &documents;
+}
+
+PreTokenizedDocuments::ReplayScope::~ReplayScope()
+{
+    g_replayingDocuments = m_previous;
+}
+
+const PreTokenizedDocuments::Document *
+PreTokenizedDocuments::find(const char *pText, int nText) const
+{
+    UnsafeStringView text(pText, nText);
+    if (m_cursor < m_texts.size() && m_texts[m_cursor].equal(text)) {
+        return &m_documents[m_cursor++];
+    }
+    auto range = m_index.equal_range(text.hash());
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        if (m_texts[iter->second].equal(text)) {
+            m_cursor = iter->second + 1;
+            return &m_documents[iter->second];
+        }
+    }
+    return nullptr;
+}
+
+bool PreTokenizedDocuments::replay(FTS5TokenizerModule::Tokenize tokenize,
+                                   const AbstractFTSTokenizer *tokenizer,
+                                   void *pCtx,
+                                   int flags,
+                                   const char *pText,
+                                   int nText,
+                                   FTS5TokenizerModule::TokenCallback callback,
+                                   int &rc)
+{
+    const PreTokenizedDocuments *documents = g_replayingDocuments;
+    // Queries are never pre-tokenized.
+    if (documents == nullptr || documents->m_tokenize != tokenize
+        || flags != FTS5_TOKENIZE_DOCUMENT
+        || !documents->m_arguments.equal(
+        AbstractFTS5TokenizerModuleTemplate::getArguments(tokenizer))) {
+        return false;
+    }
+    const Document *document = documents->find(pText, nText);
+    if (document == nullptr) {
+        return false;
+    }
+    rc = FTSError::OK();
+    for (size_t i = document->firstToken; i < document->firstToken + document->tokenCount; ++i) {
+        const Token &token = documents->m_tokens[i];
+        rc = callback(pCtx,
+                      token.flags,
+                      documents->m_buffer.data() + token.offset,
+                      token.length,
+                      token.start,
+                      token.end);
+        if (!FTSError::isOK(rc)) {
+            break;
+        }
+    }
+    return true;
+}
+
+} // namespace WCDB
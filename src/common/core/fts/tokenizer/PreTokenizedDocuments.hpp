@@ -0,0 +1,120 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "StringView.hpp"
+#include "TokenizerModule.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace WCDB {
+
+class StatementCreateVirtualTable;
+
+/*
+ Tokens of a batch of fts5 documents, which are tokenized on a worker pool in advance.
+ While a ReplayScope is alive, FTS5TokenizerModuleTemplate replays the tokens of the matched document
+ on the current thread instead of tokenizing it again, so that the writer only does the B-tree work.
+ */
+class WCDB_API PreTokenizedDocuments final {
+public:
+    PreTokenizedDocuments();
+    ~PreTokenizedDocuments();
+
+    PreTokenizedDocuments(const PreTokenizedDocuments &) = delete;
+    PreTokenizedDocuments &operator=(const PreTokenizedDocuments &) = delete;
+
+    /*
+     The tokenizer is the declaration of fts5 table, e.g. "wcdb_verbatim simplify_chinese".
+     0 parallelism means the number of cpu cores.
+     It fails if the tokenizer is not a registered fts5 tokenizer.
+     */
+    bool tokenize(const UnsafeStringView &tokenizer, std::vector<StringView> &&documents, int parallelism = 0);
+
+    // Empty if the table is not fts5 or its tokenizer is not declared.
+    static StringView getFTS5Tokenizer(const StatementCreateVirtualTable &statement);
+
+    size_t getDocumentCount() const;
+    size_t getTokenCount() const;
+
+    class WCDB_API ReplayScope final {
+    public:
+        ReplayScope(const PreTokenizedDocuments &documents);
+        ~ReplayScope();
+
+        ReplayScope(const ReplayScope &) = delete;
+        ReplayScope &operator=(const ReplayScope &) = delete;
+
+    private:
+        const PreTokenizedDocuments *m_previous;
+    };
+
+    // Return false if there is no pre-tokenized tokens for the text, and it should be tokenized as usual.
+    static bool replay(FTS5TokenizerModule::Tokenize tokenize,
+                       const AbstractFTSTokenizer *tokenizer,
+                       void *pCtx,
+                       int flags,
+                       const char *pText,
+                       int nText,
+                       FTS5TokenizerModule::TokenCallback callback,
+                       int &rc);
+
+protected:
+    struct Token {
+        size_t offset;
+        int length;
+        int start;
+        int end;
+        int flags;
+    };
+    struct Document {
+        size_t firstToken;
+        size_t tokenCount;
+    };
+    struct Chunk {
+        Chunk();
+        size_t begin;
+        size_t end;
+        std::vector<Document> documents;
+        std::vector<Token> tokens;
+        std::string buffer;
+        int rc;
+    };
+    static int
+    collectToken(void *pCtx, int tflags, const char *pToken, int nToken, int iStart, int iEnd);
+    void tokenizeChunk(const FTS5TokenizerModule &module,
+                       const std::vector<const char *> &arguments,
+                       Chunk &chunk) const;
+    const Document *find(const char *pText, int nText) const;
+
+    // Tokens are replayed only by the tokenizer of the same module and arguments.
+    FTS5TokenizerModule::Tokenize m_tokenize;
+    StringView m_arguments;
+    std::vector<StringView> m_texts;
+    std::vector<Document> m_documents;
+    std::vector<Token> m_tokens;
+    std::string m_buffer;
+    std::unordered_multimap<uint32_t, size_t> m_index;
+    // Documents are usually tokenized in the order of insertion.
+    mutable size_t m_cursor;
+};
+
+} // namespace WCDB
@@ -24,10 +24,12 @@
 
 #include "TokenizerModule.hpp"
 #include "Assertion.hpp"
+#include "Lock.hpp"
 #include "SQLite.h"
 #include "SQLiteFTS3Tokenizer.h"
 #include <cstring>
 #include <memory>
+#include <unordered_map>
 
 namespace WCDB {
 
@@ -168,6 +170,57 @@ FTS3TokenizerModule::FTS3TokenizerModule(const FTS3TokenizerModule::Create &crea
                   "");
 }
 
+#pragma mark - AbstractFTS5TokenizerModuleTemplate
+StringView AbstractFTS5TokenizerModuleTemplate::joinArguments(const char *const *azArg, int nArg)
+{
+    std::string arguments;
+    for (int i = 0; i < nArg; ++i) {
+        if (i > 0) {
+            arguments.append(" ");
+        }
+        arguments.append(azArg[i]);
+    }
+    return StringView(std::move(arguments));
+}
+
+static SharedLock &argumentsLock()
+{
+    static SharedLock *s_lock = new SharedLock;
+    return *s_lock;
+}
+
+static std::unordered_map<const AbstractFTSTokenizer *, StringView> &argumentsOfTokenizers()
+{
+    static auto *s_arguments
+    = new std::unordered_map<const AbstractFTSTokenizer *, StringView>;
+    return *s_arguments;
+}
+
+void AbstractFTS5TokenizerModuleTemplate::setArguments(const AbstractFTSTokenizer *tokenizer,
+                                                       const char *const *azArg,
+                                                       int nArg)
+{
+    StringView arguments = joinArguments(azArg, nArg);
+    LockGuard lockGuard(argumentsLock());
+    argumentsOfTokenizers()[tokenizer] = std::move(arguments);
+}
+
+void AbstractFTS5TokenizerModuleTemplate::removeArguments(const AbstractFTSTokenizer *tokenizer)
+{
+    LockGuard lockGuard(argumentsLock());
+    argumentsOfTokenizers().erase(tokenizer);
+}
+
+StringView AbstractFTS5TokenizerModuleTemplate::getArguments(const AbstractFTSTokenizer *tokenizer)
+{
+    SharedLockGuard lockGuard(argumentsLock());
+    auto iter = argumentsOfTokenizers().find(tokenizer);
+    if (iter == argumentsOfTokenizers().end()) {
+        return StringView();
+    }
+    return iter->second;
+}
+
 #pragma mark - FTS5TokenizerModule
 FTS5TokenizerModule::FTS5TokenizerModule()
 : m_create(nullptr), m_destroy(nullptr), m_tokenize(nullptr), m_pCtx(nullptr)
@@ -195,6 +248,33 @@ void *FTS5TokenizerModule::getContext()
     return m_pCtx;
 }
 
+int FTS5TokenizerModule::createTokenizer(const char *const *azArg,
+                                         int nArg,
+                                         AbstractFTSTokenizer **ppTokenizer) const
+{
+    return m_create(m_pCtx, azArg, nArg, ppTokenizer);
+}
+
+int FTS5TokenizerModule::destroyTokenizer(AbstractFTSTokenizer *pTokenizer) const
+{
+    return m_destroy(pTokenizer);
+}
+
+int FTS5TokenizerModule::tokenize(AbstractFTSTokenizer *pTokenizer,
+                                  void *pCtx,
+                                  int flags,
+                                  const char *pText,
+                                  int nText,
+                                  TokenCallback callback) const
+{
+    return m_tokenize(pTokenizer, pCtx, flags, pText, nText, callback);
+}
+
+FTS5TokenizerModule::Tokenize FTS5TokenizerModule::getTokenize() const
+{
+    return m_tokenize;
+}
+
 #pragma mark - TokenizerModule
 
 TokenizerModule::TokenizerModule(std::shared_ptr<FTS3TokenizerModule> fts3Module)
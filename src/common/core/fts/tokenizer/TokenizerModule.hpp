@@ -24,6 +24,7 @@
 
 #pragma once
 #include "FTSError.hpp"
+#include "StringView.hpp"
 #include <memory>
 
 namespace WCDB {
@@ -113,6 +114,15 @@ public:
     AbstractFTS5TokenizerModuleTemplate &
     operator=(const AbstractFTS5TokenizerModuleTemplate &)
     = delete;
+
+    // Space-separated arguments, which are the same as the declaration of fts5 table without tokenizer name.
+    static StringView joinArguments(const char *const *azArg, int nArg);
+    // Arguments of the tokenizer created by FTS5TokenizerModuleTemplate, which are kept out of the tokenizer.
+    static StringView getArguments(const AbstractFTSTokenizer *tokenizer);
+
+protected:
+    static void setArguments(const AbstractFTSTokenizer *tokenizer, const char *const *azArg, int nArg);
+    static void removeArguments(const AbstractFTSTokenizer *tokenizer);
 };
 
 class WCDB_API FTS5TokenizerModule final {
@@ -135,6 +145,16 @@ public:
                         void *pCtx);
     void *getContext();
 
+    int createTokenizer(const char *const *azArg, int nArg, AbstractFTSTokenizer **ppTokenizer) const;
+    int destroyTokenizer(AbstractFTSTokenizer *pTokenizer) const;
+    int tokenize(AbstractFTSTokenizer *pTokenizer,
+                 void *pCtx,
+                 int flags,
+                 const char *pText,
+                 int nText,
+                 TokenCallback callback) const;
+    Tokenize getTokenize() const;
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-private-field"
 private:
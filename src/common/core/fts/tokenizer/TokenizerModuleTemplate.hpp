@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "PreTokenizedDocuments.hpp"
 #include "TokenizerModule.hpp"
 #include <cstring>
 #include <type_traits>
@@ -127,11 +128,13 @@ public:
     {
         *ppTokenizer
         = static_cast<AbstractFTSTokenizer *>(new Fts5Tokenizer(azArg, nArg, pCtx));
+        setArguments(*ppTokenizer, azArg, nArg);
         return FTSError::OK();
     }
 
     static int destroy(AbstractFTSTokenizer *pTokenizer)
     {
+        removeArguments(pTokenizer);
         delete pTokenizer;
         return FTSError::OK();
     }
@@ -155,6 +158,10 @@ public:
         } else if (nText <= 0) {
             nText = (int) strlen(pText);
         }
+        if (PreTokenizedDocuments::replay(
+            tokenize, pTokenizer, pCtx, flags, pText, nText, xToken, rc)) {
+            return rc;
+        }
         pTokenizer->loadInput(pText, nText, flags);
         while (FTSError::isOK(rc = pTokenizer->nextToken(
                               &pToken, &nToken, &iStart, &iEnd, &tflags, nullptr))) {
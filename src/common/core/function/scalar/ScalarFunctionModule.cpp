@@ -184,6 +184,15 @@ void *ScalarFunctionAPI::getAuxData(int index)
     return sqlite3_get_auxdata((sqlite3_context *) m_sqliteContext, index);
 }
 
+const UnsafeStringView ScalarFunctionAPI::getDatabasePath() const
+{
+    if (!m_sqliteContext) {
+        return UnsafeStringView();
+    }
+    return sqlite3_db_filename(
+    sqlite3_context_db_handle((sqlite3_context *) m_sqliteContext), "main");
+}
+
 void *ScalarFunctionAPI::getUserData() const
 {
     if (!m_sqliteContext) {
@@ -63,6 +63,9 @@ public:
     void setAuxData(void* data, void (*destroy)(void*), int index = 0);
     void* getAuxData(int index = 0);
 
+    // Full path of the main database that the function is called in.
+    const UnsafeStringView getDatabasePath() const;
+
 protected:
     ScalarFunctionAPI(SQLiteContext* ctx, SQLiteValue** values, int valueNum);
 
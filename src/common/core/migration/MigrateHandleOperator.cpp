@@ -26,6 +26,7 @@
 #include "Assertion.hpp"
 #include "CoreConst.h"
 #include "Time.hpp"
+#include <algorithm>
 #include <cmath>
 
 namespace WCDB {
@@ -177,10 +178,11 @@ Optional<bool> MigrateHandleOperator::migrateRows(const MigrationInfo* info)
     }
 
     Optional<bool> migrated;
-    if (getHandle()->runTransaction([&migrated, this](InnerHandle* handle) -> bool {
+    int64_t migratedRowid = INT64_MAX;
+    if (getHandle()->runTransaction([&migrated, &migratedRowid, this](InnerHandle* handle) -> bool {
             int migratedCount = 0;
             do {
-                migrated = migrateRow();
+                migrated = migrateRow(migratedRowid);
                 migratedCount++;
                 if (handle->checkHasBusyRetry()) {
                     handle->notifyError(
@@ -193,18 +195,22 @@ Optional<bool> MigrateHandleOperator::migrateRows(const MigrationInfo* info)
             return migrated.succeed();
         })) {
         WCTAssert(migrated.succeed());
+        if (migratedRowid != INT64_MAX) {
+            m_migratingInfo->markRowidAsMigrated(migratedRowid);
+        }
         return migrated;
     }
     return NullOpt;
 }
 
-Optional<bool> MigrateHandleOperator::migrateRow()
+Optional<bool> MigrateHandleOperator::migrateRow(int64_t& migratedRowid)
 {
     WCTAssert(m_migrateStatement->isPrepared() && m_removeMigratedStatement->isPrepared());
     WCTAssert(getHandle()->isInTransaction());
     Optional<bool> migrated;
     if (m_migrateStatement->step()) {
         if (getHandle()->getChanges() != 0) {
+            migratedRowid = std::min<int64_t>(migratedRowid, getHandle()->getLastInsertedRowID());
             if (m_removeMigratedStatement->step()) {
                 migrated = false;
             }
@@ -56,7 +56,8 @@ protected:
     Optional<StringViewSet> getAllTables() override final;
     bool dropSourceTable(const MigrationInfo* info) override final;
     Optional<bool> migrateRows(const MigrationInfo* info) override final;
-    Optional<bool> migrateRow();
+    // migratedRowid is updated to the smallest rowid migrated in current transaction.
+    Optional<bool> migrateRow(int64_t& migratedRowid);
 
     bool reAttachMigrationInfo(const MigrationInfo* info);
     void finalizeMigrationStatement();
@@ -40,6 +40,7 @@ MigratingStatementDecorator::MigratingStatementDecorator(Migration::Binder* bind
 , m_migratingInfo(nullptr)
 , m_primaryKeyIndex(0)
 , m_rowidBindIndex(0)
+, m_replayingRow(false)
 {
 }
 
@@ -53,6 +54,9 @@ MigratingStatementDecorator::MigratingStatementDecorator(MigratingStatementDecor
 , m_assignedPrimaryKey(std::move(other.m_assignedPrimaryKey))
 , m_primaryKeyIndex(other.m_primaryKeyIndex)
 , m_rowidBindIndex(other.m_rowidBindIndex)
+, m_rowValuePositions(std::move(other.m_rowValuePositions))
+, m_rowValues(std::move(other.m_rowValues))
+, m_replayingRow(other.m_replayingRow)
 {
     other.m_migrationBinder = nullptr;
     other.m_processing = false;
@@ -62,6 +66,9 @@ MigratingStatementDecorator::MigratingStatementDecorator(MigratingStatementDecor
     other.m_assignedPrimaryKey = NullOpt;
     other.m_primaryKeyIndex = 0;
     other.m_rowidBindIndex = 0;
+    other.m_rowValuePositions.clear();
+    other.m_rowValues.clear();
+    other.m_replayingRow = false;
 }
 
 MigratingStatementDecorator::~MigratingStatementDecorator() = default;
@@ -95,17 +102,25 @@ MigratingStatementDecorator::process(const Statement& originStatement)
 
         // It's dangerous to use origin statement after tampering since all the tokens are not fit.
         Statement falledBackStatement = originStatement;
+        StringView routedTable;
         // fallback
-        falledBackStatement.iterate([&succeed, this, &originStatement](
+        falledBackStatement.iterate([&succeed, this, &originStatement, &falledBackStatement, &routedTable](
                                     Syntax::Identifier& identifier, bool isBegin, bool& stop) {
             if (!isBegin) {
                 return;
             }
             switch (identifier.getType()) {
+            case Syntax::Identifier::Type::SelectSTMT: {
+                // main.table -> main.table, if the rows to be read are all migrated
+                if (&identifier == &falledBackStatement.syntax()) {
+                    succeed = tryRouteToTargetTable((Syntax::SelectSTMT&) identifier, routedTable);
+                }
+            } break;
             case Syntax::Identifier::Type::TableOrSubquery: {
                 // main.table -> temp.unionedView
                 Syntax::TableOrSubquery& syntax = (Syntax::TableOrSubquery&) identifier;
-                if (syntax.switcher == Syntax::TableOrSubquery::Switch::Table) {
+                if (syntax.switcher == Syntax::TableOrSubquery::Switch::Table
+                    && !isRoutedTable(syntax.schema, syntax.tableOrFunction, routedTable)) {
                     succeed = tryFallbackToUnionedView(syntax.schema, syntax.tableOrFunction);
                 }
             } break;
@@ -134,11 +149,14 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 Syntax::Expression& syntax = (Syntax::Expression&) identifier;
                 switch (syntax.switcher) {
                 case Syntax::Expression::Switch::Column:
-                    succeed = tryFallbackToUnionedView(syntax.column().schema,
-                                                       syntax.column().table);
+                    if (!isRoutedTable(syntax.column().schema, syntax.column().table, routedTable)) {
+                        succeed = tryFallbackToUnionedView(syntax.column().schema,
+                                                           syntax.column().table);
+                    }
                     break;
                 case Syntax::Expression::Switch::In:
-                    if (syntax.inSwitcher == Syntax::Expression::SwitchIn::Table) {
+                    if (syntax.inSwitcher == Syntax::Expression::SwitchIn::Table
+                        && !isRoutedTable(syntax.schema(), syntax.table(), routedTable)) {
                         succeed
                         = tryFallbackToUnionedView(syntax.schema(), syntax.table());
                     }
@@ -197,14 +215,19 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                                   "Insert statement that does not explicitly indicate columns is not supported while using migration feature.",
                                   succeed = false;
                                   break;);
-                WCTRemedialAssert(!migratedInsertSTMT.isMultiWrite(),
+                clearMigrateStatus();
+                bool splitted = !migratedInsertSTMT.isMultiWrite()
+                                || trySplitMultiRowInsert(falledBackStatement);
+                WCTRemedialAssert(splitted,
                                   "Insert statement that contains multiple values is not supported while using migration feature.",
                                   succeed = false;
                                   break;);
-                clearMigrateStatus();
                 const MigrationInfo* info
                 = m_migrationBinder->getBoundInfo(migratedInsertSTMT.table);
                 WCTAssert(info != nullptr);
+                if (migratedInsertSTMT.upsertClause.hasValue()) {
+                    tryDisableRowidRouting(info, migratedInsertSTMT.upsertClause->columnsList);
+                }
                 m_migratingInfo = info;
                 info->generateStatementsForInsertMigrating(
                 falledBackStatement, statements, m_primaryKeyIndex, m_rowidBindIndex, m_assignedPrimaryKey);
@@ -224,6 +247,9 @@ MigratingStatementDecorator::process(const Statement& originStatement)
                 const MigrationInfo* info
                 = m_migrationBinder->getBoundInfo(migratedTableName);
                 WCTAssert(info != nullptr);
+                tryDisableRowidRouting(
+                info,
+                static_cast<const Syntax::UpdateSTMT&>(originStatement.syntax()).columnsList);
                 info->generateStatementsForUpdateMigrating(
                 falledBackStatement, statements, m_rowidBindIndex);
             }
@@ -382,7 +408,7 @@ bool MigratingStatementDecorator::realStep()
         return Super::step();
     }
     if (m_currentStatementType == StatementType::InsertSTMT) {
-        return stepInsert();
+        return m_rowValues.empty() ? stepInsert() : stepMultiRowInsert();
     } else if (m_currentStatementType == StatementType::DeleteSTMT
                || m_currentStatementType == StatementType::UpdateSTMT) {
         return stepUpdateOrDelete();
@@ -409,6 +435,13 @@ void MigratingStatementDecorator::reset()
 
 void MigratingStatementDecorator::clearBindings()
 {
+    if (isBufferingRowValues()) {
+        for (auto& values : m_rowValues) {
+            for (auto& value : values) {
+                value = nullptr;
+            }
+        }
+    }
     Super::reset();
     for (auto& handleStatement : m_additionalStatements) {
         handleStatement.clearBindings();
@@ -420,6 +453,10 @@ void MigratingStatementDecorator::clearBindings()
 
 void MigratingStatementDecorator::bindInteger(const Integer& value, int index)
 {
+    if (isBufferingRowValues()) {
+        bufferRowValue(value, index);
+        return;
+    }
     WCTRemedialAssert(index != m_rowidBindIndex, "Binding index is out of range", return;);
     for (auto& handleStatement : m_additionalStatements) {
         if (handleStatement.getBindParameterCount() >= index) {
@@ -437,6 +474,10 @@ void MigratingStatementDecorator::bindInteger(const Integer& value, int index)
 
 void MigratingStatementDecorator::bindDouble(const Float& value, int index)
 {
+    if (isBufferingRowValues()) {
+        bufferRowValue(value, index);
+        return;
+    }
     WCTRemedialAssert(index != m_rowidBindIndex, "Binding index is out of range", return;);
     for (auto& handleStatement : m_additionalStatements) {
         if (handleStatement.getBindParameterCount() >= index) {
@@ -450,6 +491,10 @@ void MigratingStatementDecorator::bindDouble(const Float& value, int index)
 
 void MigratingStatementDecorator::bindText(const Text& value, int index)
 {
+    if (isBufferingRowValues()) {
+        bufferRowValue(value, index);
+        return;
+    }
     WCTRemedialAssert(index != m_rowidBindIndex, "Binding index is out of range", return;);
     for (auto& handleStatement : m_additionalStatements) {
         if (handleStatement.getBindParameterCount() >= index) {
@@ -463,6 +508,10 @@ void MigratingStatementDecorator::bindText(const Text& value, int index)
 
 void MigratingStatementDecorator::bindText16(const char16_t* value, size_t valueLength, int index)
 {
+    if (isBufferingRowValues()) {
+        bufferRowValue(StringView::createFromUTF16(value, valueLength), index);
+        return;
+    }
     WCTRemedialAssert(index != m_rowidBindIndex, "Binding index is out of range", return;);
     for (auto& handleStatement : m_additionalStatements) {
         if (handleStatement.getBindParameterCount() >= index) {
@@ -476,6 +525,10 @@ void MigratingStatementDecorator::bindText16(const char16_t* value, size_t value
 
 void MigratingStatementDecorator::bindBLOB(const BLOB& value, int index)
 {
+    if (isBufferingRowValues()) {
+        bufferRowValue(value, index);
+        return;
+    }
     WCTRemedialAssert(index != m_rowidBindIndex, "Binding index is out of range", return;);
     for (auto& handleStatement : m_additionalStatements) {
         if (handleStatement.getBindParameterCount() >= index) {
@@ -489,6 +542,10 @@ void MigratingStatementDecorator::bindBLOB(const BLOB& value, int index)
 
 void MigratingStatementDecorator::bindNull(int index)
 {
+    if (isBufferingRowValues()) {
+        bufferRowValue(nullptr, index);
+        return;
+    }
     WCTRemedialAssert(index != m_rowidBindIndex, "Binding index is out of range", return;);
     for (auto& handleStatement : m_additionalStatements) {
         if (handleStatement.getBindParameterCount() >= index) {
@@ -509,6 +566,9 @@ void MigratingStatementDecorator::bindPointer(void* ptr,
                                               const Text& type,
                                               void (*destructor)(void*))
 {
+    WCTRemedialAssert(!isBufferingRowValues(),
+                      "Binding pointer is not supported in the insert statement that contains multiple values",
+                      return;);
     WCTRemedialAssert(index != m_rowidBindIndex, "Binding index is out of range", return;);
     for (auto& handleStatement : m_additionalStatements) {
         if (handleStatement.getBindParameterCount() >= index) {
@@ -592,6 +652,113 @@ void MigratingStatementDecorator::clearMigrateStatus()
     m_migratingInfo = nullptr;
     m_assignedPrimaryKey = NullOpt;
     m_primaryKeyIndex = 0;
+    m_rowValuePositions.clear();
+    m_rowValues.clear();
+    m_replayingRow = false;
+}
+
+#pragma mark - Multi-Row Insert
+bool MigratingStatementDecorator::trySplitMultiRowInsert(Statement& statement)
+{
+    WCTAssert(statement.getType() == Syntax::Identifier::Type::InsertSTMT);
+    Syntax::InsertSTMT& insertSTMT = static_cast<Syntax::InsertSTMT&>(statement.syntax());
+    if (insertSTMT.switcher != Syntax::InsertSTMT::Switch::Values
+        || insertSTMT.upsertClause.hasValue()) {
+        return false;
+    }
+    size_t columnCount = insertSTMT.columns.size();
+    size_t row = 0;
+    // Only the values that are all bind parameters can be splitted.
+    for (const auto& values : insertSTMT.expressionsValues) {
+        if (values.size() != columnCount) {
+            return false;
+        }
+        size_t column = 0;
+        for (const auto& value : values) {
+            if (value.switcher != Syntax::Expression::Switch::BindParameter
+                || value.bindParameter().switcher
+                   != Syntax::BindParameter::Switch::QuestionSign
+                || value.bindParameter().n <= 0) {
+                return false;
+            }
+            size_t index = (size_t) value.bindParameter().n;
+            if (index >= m_rowValuePositions.size()) {
+                m_rowValuePositions.resize(index + 1, { -1, -1 });
+            }
+            if (m_rowValuePositions[index].first >= 0) {
+                return false;
+            }
+            m_rowValuePositions[index] = { (int) row, (int) column };
+            column++;
+        }
+        row++;
+    }
+    m_rowValues.resize(row, std::vector<Value>(columnCount));
+
+    auto& values = insertSTMT.expressionsValues.front();
+    int index = 0;
+    for (auto& value : values) {
+        value = Expression(BindParameter(++index)).syntax();
+    }
+    insertSTMT.expressionsValues.resize(1);
+    m_rowidBindIndex = (int) columnCount + 1;
+    return true;
+}
+
+bool MigratingStatementDecorator::isBufferingRowValues() const
+{
+    return !m_rowValues.empty() && !m_replayingRow;
+}
+
+void MigratingStatementDecorator::bufferRowValue(const Value& value, int index)
+{
+    WCTRemedialAssert(index > 0 && (size_t) index < m_rowValuePositions.size()
+                      && m_rowValuePositions[index].first >= 0,
+                      "Binding index is out of range",
+                      return;);
+    const auto& position = m_rowValuePositions[index];
+    m_rowValues[position.first][position.second] = value;
+}
+
+void MigratingStatementDecorator::bindRowValue(const Value& value, int index)
+{
+    switch (value.getType()) {
+    case ColumnType::Integer:
+        bindInteger(value.intValue(), index);
+        break;
+    case ColumnType::Float:
+        bindDouble(value.floatValue(), index);
+        break;
+    case ColumnType::Text:
+        bindText(value.textValue(), index);
+        break;
+    case ColumnType::BLOB:
+        bindBLOB(value.blobValue(), index);
+        break;
+    default:
+        bindNull(index);
+        break;
+    }
+}
+
+bool MigratingStatementDecorator::stepMultiRowInsert()
+{
+    WCTAssert(!m_replayingRow);
+    m_replayingRow = true;
+    bool succeed = true;
+    for (const auto& values : m_rowValues) {
+        reset();
+        int index = 0;
+        for (const auto& value : values) {
+            bindRowValue(value, ++index);
+        }
+        succeed = stepInsert();
+        if (!succeed) {
+            break;
+        }
+    }
+    m_replayingRow = false;
+    return succeed;
 }
 
 #pragma mark - Update/Delete
@@ -624,4 +791,216 @@ bool MigratingStatementDecorator::stepUpdateOrDelete()
     return true;
 }
 
+#pragma mark - Rowid Routing
+bool MigratingStatementDecorator::tryRouteToTargetTable(Syntax::SelectSTMT& stmt,
+                                                        StringView& routedTable)
+{
+    // The snapshot of the transaction may be older than the migrated range.
+    if (getHandle()->isInTransaction()) {
+        return true;
+    }
+    if (!stmt.commonTableExpressions.empty() || !stmt.cores.empty()
+        || !WCDB_SYNTAX_CHECK_OPTIONAL_VALID(stmt.select)) {
+        return true;
+    }
+    const Syntax::SelectCore& core = stmt.select.value();
+    if (core.switcher != Syntax::SelectCore::Switch::Select
+        || core.tableOrSubqueries.size() != 1 || core.joinClause.hasValue()
+        || !WCDB_SYNTAX_CHECK_OPTIONAL_VALID(core.condition)) {
+        return true;
+    }
+    const Syntax::TableOrSubquery& table = core.tableOrSubqueries.front();
+    if (table.switcher != Syntax::TableOrSubquery::Switch::Table || !table.schema.isMain()) {
+        return true;
+    }
+
+    // All references to the table will be left as they are, so it should be read only once.
+    int referenceCount = 0;
+    const Syntax::Identifier& statement = stmt;
+    statement.iterate([&referenceCount, &table](const Syntax::Identifier& identifier, bool isBegin, bool&) {
+        if (!isBegin) {
+            return;
+        }
+        if (identifier.getType() == Syntax::Identifier::Type::TableOrSubquery) {
+            const Syntax::TableOrSubquery& syntax = (const Syntax::TableOrSubquery&) identifier;
+            if (syntax.switcher == Syntax::TableOrSubquery::Switch::Table
+                && isRoutedTable(syntax.schema, syntax.tableOrFunction, table.tableOrFunction)) {
+                ++referenceCount;
+            }
+        } else if (identifier.getType() == Syntax::Identifier::Type::Expression) {
+            const Syntax::Expression& syntax = (const Syntax::Expression&) identifier;
+            if (syntax.switcher == Syntax::Expression::Switch::In
+                && syntax.inSwitcher == Syntax::Expression::SwitchIn::Table
+                && isRoutedTable(syntax.schema(), syntax.table(), table.tableOrFunction)) {
+                ++referenceCount;
+            }
+        }
+    });
+    if (referenceCount != 1) {
+        return true;
+    }
+
+    auto optionalInfo = m_migrationBinder->bindTable(table.tableOrFunction);
+    if (!optionalInfo.succeed()) {
+        return false;
+    }
+    const MigrationInfo* info = optionalInfo.value();
+    if (info == nullptr) {
+        return true;
+    }
+    auto minRowid = getMinRowid(core.condition.value(), info, table);
+    if (minRowid.succeed() && info->isRowidMigrated(minRowid.value())) {
+        routedTable = table.tableOrFunction;
+        info->increaseRoutedCount();
+    }
+    return true;
+}
+
+bool MigratingStatementDecorator::isRoutedTable(const Syntax::Schema& schema,
+                                                const UnsafeStringView& table,
+                                                const UnsafeStringView& routedTable)
+{
+    return !routedTable.empty() && schema.isMain() && table.equal(routedTable);
+}
+
+Optional<int64_t>
+MigratingStatementDecorator::getMinRowid(const Syntax::Expression& condition,
+                                         const MigrationInfo* info,
+                                         const Syntax::TableOrSubquery& table)
+{
+    switch (condition.switcher) {
+    case Syntax::Expression::Switch::Expressions:
+        if (condition.expressions.size() == 1) {
+            return getMinRowid(condition.expressions.front(), info, table);
+        }
+        break;
+    case Syntax::Expression::Switch::BinaryOperation: {
+        WCTAssert(condition.expressions.size() == 2);
+        const Syntax::Expression& left = condition.expressions.front();
+        const Syntax::Expression& right = condition.expressions.back();
+        auto binaryOperator = condition.binaryOperator;
+        if (binaryOperator == Syntax::Expression::BinaryOperator::And) {
+            auto leftMinRowid = getMinRowid(left, info, table);
+            auto rightMinRowid = getMinRowid(right, info, table);
+            if (leftMinRowid.succeed() && rightMinRowid.succeed()) {
+                return std::max(leftMinRowid.value(), rightMinRowid.value());
+            }
+            return leftMinRowid.succeed() ? leftMinRowid : rightMinRowid;
+        }
+        Optional<int64_t> value;
+        if (isRowidColumn(left, info, table)) {
+            value = getIntegerLiteral(right);
+        } else if (isRowidColumn(right, info, table)) {
+            value = getIntegerLiteral(left);
+            // 100 < rowid -> rowid > 100
+            switch (binaryOperator) {
+            case Syntax::Expression::BinaryOperator::Less:
+                binaryOperator = Syntax::Expression::BinaryOperator::Greater;
+                break;
+            case Syntax::Expression::BinaryOperator::LessOrEqual:
+                binaryOperator = Syntax::Expression::BinaryOperator::GreaterOrEqual;
+                break;
+            case Syntax::Expression::BinaryOperator::Greater:
+            case Syntax::Expression::BinaryOperator::GreaterOrEqual:
+                return NullOpt;
+            default:
+                break;
+            }
+        }
+        if (!value.succeed()) {
+            break;
+        }
+        switch (binaryOperator) {
+        case Syntax::Expression::BinaryOperator::Equal:
+        case Syntax::Expression::BinaryOperator::Is:
+        case Syntax::Expression::BinaryOperator::GreaterOrEqual:
+            return value;
+        case Syntax::Expression::BinaryOperator::Greater:
+            if (value.value() < INT64_MAX) {
+                return value.value() + 1;
+            }
+            break;
+        default:
+            break;
+        }
+    } break;
+    case Syntax::Expression::Switch::Between: {
+        WCTAssert(condition.expressions.size() == 3);
+        if (!condition.isNot && isRowidColumn(condition.expressions.front(), info, table)) {
+            return getIntegerLiteral(*(++condition.expressions.begin()));
+        }
+    } break;
+    case Syntax::Expression::Switch::In: {
+        if (condition.isNot || condition.inSwitcher != Syntax::Expression::SwitchIn::Expressions
+            || condition.expressions.size() < 2
+            || !isRowidColumn(condition.expressions.front(), info, table)) {
+            break;
+        }
+        int64_t minRowid = INT64_MAX;
+        for (auto iter = ++condition.expressions.begin(); iter != condition.expressions.end(); ++iter) {
+            auto value = getIntegerLiteral(*iter);
+            if (!value.succeed()) {
+                return NullOpt;
+            }
+            minRowid = std::min(minRowid, value.value());
+        }
+        return minRowid;
+    }
+    default:
+        break;
+    }
+    return NullOpt;
+}
+
+bool MigratingStatementDecorator::isRowidColumn(const Syntax::Expression& expression,
+                                                const MigrationInfo* info,
+                                                const Syntax::TableOrSubquery& table)
+{
+    if (expression.switcher != Syntax::Expression::Switch::Column) {
+        return false;
+    }
+    const Syntax::Column& column = expression.column();
+    if (column.wildcard || !column.schema.isMain()) {
+        return false;
+    }
+    if (!column.table.empty() && !column.table.equal(table.tableOrFunction)
+        && !column.table.equal(table.alias)) {
+        return false;
+    }
+    return info->isRowidColumn(column.name);
+}
+
+Optional<int64_t> MigratingStatementDecorator::getIntegerLiteral(const Syntax::Expression& expression)
+{
+    if (expression.switcher != Syntax::Expression::Switch::LiteralValue) {
+        return NullOpt;
+    }
+    const Syntax::LiteralValue& literalValue = expression.literalValue();
+    switch (literalValue.switcher) {
+    case Syntax::LiteralValue::Switch::Integer:
+        return literalValue.integerValue;
+    case Syntax::LiteralValue::Switch::UnsignedInteger:
+        if (literalValue.unsignedIntegerValue <= INT64_MAX) {
+            return (int64_t) literalValue.unsignedIntegerValue;
+        }
+        break;
+    default:
+        break;
+    }
+    return NullOpt;
+}
+
+void MigratingStatementDecorator::tryDisableRowidRouting(
+const MigrationInfo* info, const std::list<std::list<Syntax::Column>>& columnsList)
+{
+    for (const auto& columns : columnsList) {
+        for (const auto& column : columns) {
+            if (info->isRowidColumn(column.name)) {
+                info->disableRowidRouting();
+                return;
+            }
+        }
+    }
+}
+
 } //namespace WCDB
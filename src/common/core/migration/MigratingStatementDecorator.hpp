@@ -24,7 +24,9 @@
 
 #include "DecorativeHandleStatement.hpp"
 #include "Migration.hpp"
+#include "Value.hpp"
 #include <list>
+#include <vector>
 
 namespace WCDB {
 
@@ -86,9 +88,51 @@ private:
     int m_primaryKeyIndex;
     int m_rowidBindIndex;
 
+#pragma mark - Multi-Row Insert
+protected:
+    /*
+     INSERT INTO migratingTable(...) VALUES(?1, ?2), (?3, ?4) is executed as
+     INSERT INTO migratingTable(...) VALUES(?1, ?2) for each row,
+     with the values of each row buffered while binding.
+     */
+    bool trySplitMultiRowInsert(Statement &statement);
+    bool isBufferingRowValues() const;
+    void bufferRowValue(const Value &value, int index);
+    void bindRowValue(const Value &value, int index);
+    bool stepMultiRowInsert();
+
+private:
+    // [bind index] -> (row, column)
+    std::vector<std::pair<int, int>> m_rowValuePositions;
+    std::vector<std::vector<Value>> m_rowValues;
+    bool m_replayingRow;
+
 #pragma mark - Update/Delete
 protected:
     bool stepUpdateOrDelete();
+
+#pragma mark - Rowid Routing
+protected:
+    /*
+     SELECT ... FROM main.migratingTable WHERE rowid == 100
+     is executed on main.migratingTable directly instead of temp.unionedView,
+     when all the rows with rowid not less than 100 are already migrated.
+     */
+    bool tryRouteToTargetTable(Syntax::SelectSTMT& stmt, StringView& routedTable);
+    static bool isRoutedTable(const Syntax::Schema& schema,
+                              const UnsafeStringView& table,
+                              const UnsafeStringView& routedTable);
+    static Optional<int64_t> getMinRowid(const Syntax::Expression& condition,
+                                         const MigrationInfo* info,
+                                         const Syntax::TableOrSubquery& table);
+    static bool isRowidColumn(const Syntax::Expression& expression,
+                              const MigrationInfo* info,
+                              const Syntax::TableOrSubquery& table);
+    static Optional<int64_t> getIntegerLiteral(const Syntax::Expression& expression);
+
+    // The rows in source table may be moved out of the migrated range by updating their rowids.
+    static void tryDisableRowidRouting(const MigrationInfo* info,
+                                       const std::list<std::list<Syntax::Column>>& columnsList);
 };
 
 } // namespace WCDB
@@ -137,8 +137,7 @@ bool Migration::initInfo(InfoInitializer& initializer, const UnsafeStringView& t
                 m_hints.emplace(targetTable);
                 m_tableAcquired = false;
             } else {
-                m_holder.push_back(MigrationInfo(
-                userInfo, columns, autoincrement, integerPrimaryKey));
+                m_holder.emplace_back(userInfo, columns, autoincrement, integerPrimaryKey);
                 const MigrationInfo* hold = &m_holder.back();
                 m_migratings.emplace(hold);
                 m_referenceds.emplace(hold, 0);
@@ -717,4 +716,18 @@ bool Migration::isMigrated() const
     return m_migrated;
 }
 
+#pragma mark - Rowid Routing
+StringViewMap<uint64_t> Migration::getRoutedCounts() const
+{
+    StringViewMap<uint64_t> routedCounts;
+    SharedLockGuard lockGuard(m_lock);
+    for (const auto& info : m_holder) {
+        uint64_t count = info.getRoutedCount();
+        if (count > 0) {
+            routedCounts[info.getTable()] += count;
+        }
+    }
+    return routedCounts;
+}
+
 } // namespace WCDB
@@ -203,6 +203,11 @@ public:
 
 protected:
     MigrationEvent* m_event;
+
+#pragma mark - Rowid Routing
+public:
+    // [target table] -> the number of selections executed on the target table directly instead of the unioned view
+    StringViewMap<uint64_t> getRoutedCounts() const;
 };
 
 } // namespace WCDB
@@ -236,6 +236,9 @@ MigrationInfo::MigrationInfo(const MigrationUserInfo& userInfo,
 , m_autoincrement(autoincrement)
 , m_integerPrimaryKey(integerPrimaryKey)
 , m_needUpdateSequence(autoincrement)
+, m_maxRowidInSourceTable(INT64_MAX)
+, m_rowidRoutable(true)
+, m_routedCount(0)
 {
     WCTAssert(!uniqueColumns.empty());
 
@@ -602,4 +605,45 @@ const StatementDropTable& MigrationInfo::getStatementForDroppingSourceTable() co
     return m_statementForDroppingSourceTable;
 }
 
+#pragma mark - Rowid Routing
+bool MigrationInfo::isRowidMigrated(int64_t rowid) const
+{
+    return m_rowidRoutable.load() && rowid > m_maxRowidInSourceTable.load();
+}
+
+void MigrationInfo::markRowidAsMigrated(int64_t rowid) const
+{
+    WCTAssert(rowid > INT64_MIN);
+    int64_t maxRowid = m_maxRowidInSourceTable.load();
+    while (rowid - 1 < maxRowid) {
+        if (m_maxRowidInSourceTable.compare_exchange_weak(maxRowid, rowid - 1)) {
+            break;
+        }
+    }
+}
+
+void MigrationInfo::disableRowidRouting() const
+{
+    m_rowidRoutable.store(false);
+}
+
+bool MigrationInfo::isRowidColumn(const UnsafeStringView& column) const
+{
+    if (!m_integerPrimaryKey.empty() && column.caseInsensitiveEqual(m_integerPrimaryKey)) {
+        return true;
+    }
+    return column.caseInsensitiveEqual("rowid") || column.caseInsensitiveEqual("_rowid_")
+           || column.caseInsensitiveEqual("oid");
+}
+
+void MigrationInfo::increaseRoutedCount() const
+{
+    ++m_routedCount;
+}
+
+uint64_t MigrationInfo::getRoutedCount() const
+{
+    return m_routedCount.load();
+}
+
 } // namespace WCDB
@@ -27,6 +27,7 @@
 #include "Lock.hpp"
 #include "StringView.hpp"
 #include "WINQ.h"
+#include <atomic>
 #include <set>
 
 namespace WCDB {
@@ -280,6 +281,28 @@ protected:
     StatementDelete m_statementForDeletingMigratedOneRow;
     StatementDropTable m_statementForDroppingSourceTable;
     StatementSelect m_statementForSelectingAnyRowFromSourceTable;
+
+#pragma mark - Rowid Routing
+public:
+    /*
+     Rows are migrated in the descending order of [rowid/primary key], and the new rows are always inserted into the target table.
+     So the rows with rowid larger than all the rowids remaining in the source table can only be found in the target table.
+     */
+    bool isRowidMigrated(int64_t rowid) const;
+    // It should be called after the transaction migrating the row is committed.
+    void markRowidAsMigrated(int64_t rowid) const;
+    // The range is no longer reliable once the rowid of the rows in source table are updated.
+    void disableRowidRouting() const;
+    bool isRowidColumn(const UnsafeStringView& column) const;
+
+    void increaseRoutedCount() const;
+    uint64_t getRoutedCount() const;
+
+protected:
+    // INT64_MAX if it's not known yet
+    mutable std::atomic<int64_t> m_maxRowidInSourceTable;
+    mutable std::atomic<bool> m_rowidRoutable;
+    mutable std::atomic<uint64_t> m_routedCount;
 };
 
 } // namespace WCDB
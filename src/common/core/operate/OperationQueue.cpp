@@ -42,7 +42,10 @@ OperationQueue::OperationQueue(const UnsafeStringView& name, OperationEvent* eve
 , m_observerForMemoryWarning(registerNotificationWhenMemoryWarning())
 {
     Notifier::shared().setNotification(
-    0, name, std::bind(&OperationQueue::handleError, this, std::placeholders::_1));
+    0,
+    name,
+    std::bind(&OperationQueue::handleError, this, std::placeholders::_1),
+    Error::Level::Warning);
 #ifndef _WIN32
     Global::shared().setNotificationWhenFileOpened(
     name,
@@ -85,6 +88,15 @@ void OperationQueue::stopAllDatabaseEvent(const UnsafeStringView& path)
 
     Operation mergeIndex(Operation::Type::MergeIndex, path);
     m_timedQueue.remove(mergeIndex);
+
+    Operation relieveMemory(Operation::Type::RelieveMemory, path);
+    m_timedQueue.remove(relieveMemory);
+
+    Operation reapIdleHandles(Operation::Type::ReapIdleHandles, path);
+    m_timedQueue.remove(reapIdleHandles);
+
+    Operation prefetchHotPages(Operation::Type::PrefetchHotPages, path);
+    m_timedQueue.remove(prefetchHotPages);
 }
 
 void OperationQueue::stop()
@@ -187,7 +199,8 @@ bool OperationQueue::Operation::operator==(const Operation& other) const
 {
     bool equal = false;
     if (type == other.type) {
-        if (type == Type::Purge) {
+        if (type == Type::Purge || type == Type::EvictIdleDatabases
+            || type == Type::NotifyIgnorableErrorSummaries) {
             equal = true;
         } else {
             equal = (path == other.path);
@@ -233,6 +246,23 @@ void OperationQueue::onTimed(const Operation& operation, const Parameter& parame
         case Operation::Type::Backup:
             doBackup(operation.path);
             break;
+        case Operation::Type::RelieveMemory:
+            doRelieveMemory(operation.path);
+            break;
+        case Operation::Type::EvictIdleDatabases:
+            WCTAssert(operation.path.empty());
+            doEvictIdleDatabases();
+            break;
+        case Operation::Type::ReapIdleHandles:
+            doReapIdleHandles(operation.path);
+            break;
+        case Operation::Type::NotifyIgnorableErrorSummaries:
+            WCTAssert(operation.path.empty());
+            doNotifyIgnorableErrorSummaries();
+            break;
+        case Operation::Type::PrefetchHotPages:
+            doPrefetchHotPages(operation.path);
+            break;
         }
         if (operation.type != Operation::Type::NotifyCorruption) {
             CommonCore::shared().setThreadedErrorIgnorable(false);
@@ -599,6 +629,73 @@ void OperationQueue::asyncPurgeWhenMemoryWarning()
     this->asyncPurge(parameter);
 }
 
+#pragma mark - Relieve Memory
+void OperationQueue::asyncRelieveMemory(const UnsafeStringView& path)
+{
+    Operation operation(Operation::Type::RelieveMemory, path);
+    Parameter parameter; // useless
+    async(operation, OperationQueueTimeIntervalForRelievingMemory, parameter);
+}
+
+void OperationQueue::doRelieveMemory(const UnsafeStringView& path)
+{
+    m_event->memoryShouldBeRelieved(path);
+}
+
+#pragma mark - Evict Idle Databases
+void OperationQueue::asyncEvictIdleDatabases(double delay)
+{
+    Operation operation(Operation::Type::EvictIdleDatabases);
+    Parameter parameter; // useless
+    async(operation, delay, parameter);
+}
+
+void OperationQueue::doEvictIdleDatabases()
+{
+    m_event->idleDatabasesShouldBeEvicted();
+}
+
+#pragma mark - Reap Idle Handles
+void OperationQueue::asyncReapIdleHandles(const UnsafeStringView& path, double delay)
+{
+    Operation operation(Operation::Type::ReapIdleHandles, path);
+    Parameter parameter; // useless
+    async(operation, delay, parameter);
+}
+
+void OperationQueue::doReapIdleHandles(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+    m_event->idleHandlesShouldBeReaped(path);
+}
+
+#pragma mark - Prefetch Hot Pages
+void OperationQueue::asyncPrefetchHotPages(const UnsafeStringView& path)
+{
+    Operation operation(Operation::Type::PrefetchHotPages, path);
+    Parameter parameter; // useless
+    async(operation, 0, parameter);
+}
+
+void OperationQueue::doPrefetchHotPages(const UnsafeStringView& path)
+{
+    WCTAssert(!path.empty());
+    m_event->hotPagesShouldBePrefetched(path);
+}
+
+#pragma mark - Ignorable Error Summary
+void OperationQueue::asyncNotifyIgnorableErrorSummaries(double delay)
+{
+    Operation operation(Operation::Type::NotifyIgnorableErrorSummaries);
+    Parameter parameter; // useless
+    async(operation, delay, parameter);
+}
+
+void OperationQueue::doNotifyIgnorableErrorSummaries()
+{
+    Notifier::shared().notifyIgnorableErrorSummaries();
+}
+
 #pragma mark - Check Integrity
 void OperationQueue::skipIntegrityCheck(const UnsafeStringView& path)
 {
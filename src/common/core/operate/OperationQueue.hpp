@@ -53,6 +53,10 @@ protected:
     virtual void checkpointShouldBeOperated(const UnsafeStringView& path) = 0;
     virtual void integrityShouldBeChecked(const UnsafeStringView& path) = 0;
     virtual void purgeShouldBeOperated() = 0;
+    virtual void memoryShouldBeRelieved(const UnsafeStringView& path) = 0;
+    virtual void idleDatabasesShouldBeEvicted() = 0;
+    virtual void idleHandlesShouldBeReaped(const UnsafeStringView& path) = 0;
+    virtual void hotPagesShouldBePrefetched(const UnsafeStringView& path) = 0;
 
     using TableArray = AutoMergeFTSIndexOperator::TableArray;
     virtual Optional<bool>
@@ -100,6 +104,11 @@ protected:
             Migrate,
             Compress,
             MergeIndex,
+            RelieveMemory,
+            EvictIdleDatabases,
+            ReapIdleHandles,
+            NotifyIgnorableErrorSummaries,
+            PrefetchHotPages,
         };
 
         const Type type;
@@ -221,6 +230,42 @@ protected:
     SteadyClock m_lastPurge;
     void* m_observerForMemoryWarning;
 
+#pragma mark - Relieve Memory
+public:
+    // Empty path for relieving the memory of whole process.
+    void asyncRelieveMemory(const UnsafeStringView& path);
+
+protected:
+    void doRelieveMemory(const UnsafeStringView& path);
+
+#pragma mark - Evict Idle Databases
+public:
+    void asyncEvictIdleDatabases(double delay);
+
+protected:
+    void doEvictIdleDatabases();
+
+#pragma mark - Reap Idle Handles
+public:
+    void asyncReapIdleHandles(const UnsafeStringView& path, double delay);
+
+protected:
+    void doReapIdleHandles(const UnsafeStringView& path);
+
+#pragma mark - Prefetch Hot Pages
+public:
+    void asyncPrefetchHotPages(const UnsafeStringView& path);
+
+protected:
+    void doPrefetchHotPages(const UnsafeStringView& path);
+
+#pragma mark - Ignorable Error Summary
+public:
+    void asyncNotifyIgnorableErrorSummaries(double delay);
+
+protected:
+    void doNotifyIgnorableErrorSummaries();
+
 #pragma mark - Integrity
 public:
     void skipIntegrityCheck(const UnsafeStringView& path);
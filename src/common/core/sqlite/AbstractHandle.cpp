@@ -25,6 +25,7 @@
 #include "AbstractHandle.hpp"
 #include "Assertion.hpp"
 #include "CoreConst.h"
+#include "MemoryGovernor.hpp"
 #include "Notifier.hpp"
 #include "Path.hpp"
 #include "SQLite.h"
@@ -49,6 +50,8 @@ AbstractHandle::AbstractHandle()
 , m_tid(0)
 , m_threadErrorProne(nullptr)
 , m_canBeSuspended(false)
+, m_pageCacheUsed(0)
+, m_statementUsed(0)
 {
 }
 
@@ -138,6 +141,7 @@ void AbstractHandle::close()
         m_notification.purge();
         APIExit(sqlite3_close_v2(m_handle));
         m_handle = nullptr;
+        updateMemoryUsage();
     }
 }
 
@@ -275,6 +279,9 @@ void AbstractHandle::finalizeStatements()
     for (auto &handleStatement : m_handleStatements) {
         handleStatement.finalize();
     }
+    MemoryGovernor::shared().decrease(
+    m_path, MemoryGovernor::Component::PreparedStatement, m_statementUsed);
+    m_statementUsed = 0;
 }
 
 HandleStatement *AbstractHandle::getOrCreatePreparedStatement(const Statement &statement)
@@ -873,6 +880,11 @@ void AbstractHandle::notifyError(Error::Code rc, const UnsafeStringView &sql, co
 void AbstractHandle::notifyError(int rc, const UnsafeStringView &sql, const UnsafeStringView &msg)
 {
     WCTAssert(Error::isError(rc));
+    bool ignorable = std::find(m_ignorableCodes.begin(), m_ignorableCodes.end(), rc)
+                     != m_ignorableCodes.end();
+    if (ignorable && !notifyIgnorableError(rc)) {
+        return;
+    }
     Error::Code code = Error::rc2c(rc);
     if (code == Error::Code::ZstdError) {
         m_error.setCode(code, !msg.empty() ? msg : sqlite3_errmsg(m_handle));
@@ -884,8 +896,7 @@ void AbstractHandle::notifyError(int rc, const UnsafeStringView &sql, const Unsa
         // extended error code/message will not be set in some case for misuse error
         m_error.setSQLiteCode(rc, msg);
     }
-    if (std::find(m_ignorableCodes.begin(), m_ignorableCodes.end(), rc)
-        == m_ignorableCodes.end()) {
+    if (!ignorable) {
         m_error.level = Error::Level::Error;
         if (code == Error::Code::Warning) {
             m_error.level = Error::Level::Warning;
@@ -908,6 +919,21 @@ void AbstractHandle::notifyError(int rc, const UnsafeStringView &sql, const Unsa
     Notifier::shared().notify(m_error);
 }
 
+bool AbstractHandle::notifyIgnorableError(int rc)
+{
+    Notifier &notifier = Notifier::shared();
+    if (notifier.isNotificationNeeded(Error::Level::Ignore)
+        && notifier.shouldNotifyIgnorableError(m_path, rc)) {
+        return true;
+    }
+    // The callers only check the code and level of an ignorable error,
+    // so a constant message and the reused infos are enough.
+    m_error.setSQLiteCode(rc, StringView::makeConstant(sqlite3_errstr(rc)));
+    m_error.level = Error::Level::Ignore;
+    m_error.infos.erase(ErrorStringKeySQL);
+    return false;
+}
+
 void AbstractHandle::markErrorAsIgnorable(Error::Code ignorableCode)
 {
     m_ignorableCodes.emplace_back((int) ignorableCode);
@@ -1073,6 +1099,41 @@ bool AbstractHandle::setCipherSalt(const UnsafeStringView &salt)
     return succeed;
 }
 
+#pragma mark - Memory
+void AbstractHandle::updateMemoryUsage()
+{
+    size_t pageCacheUsed = 0;
+    size_t statementUsed = 0;
+    if (isOpened()) {
+        int current = 0;
+        int highWater = 0;
+        if (sqlite3_db_status(m_handle, SQLITE_DBSTATUS_CACHE_USED, &current, &highWater, false)
+            == SQLITE_OK) {
+            pageCacheUsed = current;
+        }
+        if (sqlite3_db_status(m_handle, SQLITE_DBSTATUS_STMT_USED, &current, &highWater, false)
+            == SQLITE_OK) {
+            statementUsed = current;
+        }
+    }
+    MemoryGovernor &governor = MemoryGovernor::shared();
+    governor.update(
+    m_path, MemoryGovernor::Component::PageCache, m_pageCacheUsed, pageCacheUsed);
+    governor.update(
+    m_path, MemoryGovernor::Component::PreparedStatement, m_statementUsed, statementUsed);
+    m_pageCacheUsed = pageCacheUsed;
+    m_statementUsed = statementUsed;
+}
+
+void AbstractHandle::releaseMemory()
+{
+    if (isOpened()) {
+        sqlite3_db_release_memory(m_handle);
+        updateMemoryUsage();
+    }
+}
+
+#pragma mark - Extra
 void AbstractHandle::tryPreloadAllPages()
 {
     sqlite3_preload_pages_to_cache(m_handle);
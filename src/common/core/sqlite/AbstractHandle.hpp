@@ -53,6 +53,7 @@ public:
 private:
     friend class ScalarFunctionConfig;
     friend class HandleRelated;
+    friend class Compression;
     sqlite3 *getRawHandle();
     sqlite3 *m_handle;
 
@@ -260,6 +261,11 @@ private:
     ThreadedErrorProne *m_threadErrorProne;
     std::vector<int> m_ignorableCodes;
 
+    // Ignorable errors are usually expected and can be raised at a high rate,
+    // e.g. busy or constraint failures. They are assembled only when someone
+    // subscribes to them, and identical ones are folded into a summary by Notifier.
+    bool notifyIgnorableError(int rc);
+
 #pragma mark - Suspend
 public:
     void suspend(bool suspend);                     // thread-safe
@@ -293,6 +299,16 @@ public:
     StringView getCipherSalt();
     bool setCipherSalt(const UnsafeStringView &salt);
 
+#pragma mark - Memory
+public:
+    // Sample the memory used by page cache and prepared statements and report it to the memory governor.
+    void updateMemoryUsage();
+    void releaseMemory();
+
+private:
+    size_t m_pageCacheUsed;
+    size_t m_statementUsed;
+
 #pragma mark - Extra
 public:
     void tryPreloadAllPages();
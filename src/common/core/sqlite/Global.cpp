@@ -218,7 +218,7 @@ void Global::postLockDidChangeNotification(const char *path_, int type_)
     SharedLockGuard lockGuard(m_lock);
     for (const auto &iter : m_lockEventNotifications) {
         if (iter.second.lockDidChange != nullptr) {
-            iter.second.lockDidChange(path, type);
+            iter.second.lockDidChange(path, (void *) path_, type);
         }
     }
 }
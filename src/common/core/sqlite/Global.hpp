@@ -90,7 +90,8 @@ public:
         Exclusive = 8,
     };
     typedef std::function<void(const UnsafeStringView& /* path */, PagerLock)> WillLockNotification;
-    typedef std::function<void(const UnsafeStringView& /* path */, PagerLock)> LockDidChangeNotification;
+    // The identifier is the address of the path owned by the file of the connection, which tells the connections of the same path apart.
+    typedef std::function<void(const UnsafeStringView& /* path */, void* /* identifier */, PagerLock)> LockDidChangeNotification;
     typedef std::function<void(const UnsafeStringView& /* path */, ShmLock, int /* mask */)> WillShmLockNotification;
     typedef std::function<void(const UnsafeStringView& /* path */, void* /* identifier */, int /* sharedMask */, int /* exclMask */)> ShmLockDidChangeNotification;
     void setNotificationForLockEvent(const UnsafeStringView& name,
@@ -180,6 +180,13 @@ void HandleStatement::analysisStatement(const Statement &statement)
         = static_cast<const Syntax::CreateVirtualTableSTMT &>(statement.syntax());
         m_newTable = createSTMT.table;
     } break;
+    case Syntax::Identifier::Type::CreateViewSTMT:
+    case Syntax::Identifier::Type::CreateTriggerSTMT:
+    case Syntax::Identifier::Type::DropViewSTMT:
+    case Syntax::Identifier::Type::DropTriggerSTMT:
+        // Views and triggers change what the other statements read or write.
+        m_modifiedTable = Syntax::masterTable;
+        break;
     default:
         break;
     }
@@ -47,6 +47,21 @@ void AssembleDelegate::markDuplicatedAsReplaceable(bool replaceable)
     m_duplicatedReplaceable = replaceable;
 }
 
+bool AssembleDelegate::isAssemblingCellBuffered() const
+{
+    return false;
+}
+
+std::vector<bool> AssembleDelegate::takeBufferedCellResults()
+{
+    return {};
+}
+
+const Error &AssembleDelegate::getBufferedCellError() const
+{
+    return getAssembleError();
+}
+
 bool AssembleDelegate::isDuplicatedIgnorable() const
 {
     return m_duplicatedIgnorable;
@@ -26,6 +26,7 @@
 
 #include "Cipher.hpp"
 #include <map>
+#include <vector>
 
 namespace WCDB {
 
@@ -60,6 +61,15 @@ public:
 
     virtual const Error &getAssembleError() const = 0;
 
+    /*
+     A buffered cell is not inserted until the buffer is flushed, so its result is unknown when it is assembled.
+     The results of the flushed cells are taken in the order they were assembled,
+     and the error of the first failed one is kept until the results are taken.
+     */
+    virtual bool isAssemblingCellBuffered() const;
+    virtual std::vector<bool> takeBufferedCellResults();
+    virtual const Error &getBufferedCellError() const;
+
     virtual void suspendAssemble() = 0;
     virtual void finishAssemble() = 0;
 
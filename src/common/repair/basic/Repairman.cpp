@@ -30,6 +30,7 @@
 #include "Notifier.hpp"
 #include "Page.hpp"
 #include "ThreadedErrors.hpp"
+#include <algorithm>
 
 namespace WCDB {
 
@@ -99,6 +100,7 @@ Optional<bool> Repairman::isEmptyDatabase()
 
 bool Repairman::markAsAssembling()
 {
+    m_bufferedCellWeights.clear();
     if (m_assembleDelegate->markAsAssembling()) {
         return true;
     }
@@ -109,15 +111,21 @@ bool Repairman::markAsAssembling()
 void Repairman::markAsAssembled()
 {
     markAsMilestone();
-    if (!isErrorCritial() && !m_assembleDelegate->markAsAssembled()) {
+    // Indexes, triggers and views may be deferred to the end, so it should be done even if any error occurs.
+    bool succeed = m_assembleDelegate->markAsAssembled();
+    markBufferedCellsAsCounted();
+    if (!succeed && !isErrorCritial()) {
         setCriticalError(m_assembleDelegate->getAssembleError());
     }
+    m_bufferedCellWeights.clear();
 }
 
 bool Repairman::markAsMilestone()
 {
     m_mile = 0;
-    if (m_assembleDelegate->markAsMilestone()) {
+    bool succeed = m_assembleDelegate->markAsMilestone();
+    markBufferedCellsAsCounted();
+    if (succeed) {
         markSegmentedScoreCounted();
         return true;
     }
@@ -137,7 +145,9 @@ bool Repairman::towardMilestone(int mile)
 
 bool Repairman::assembleTable(const UnsafeStringView &tableName, const UnsafeStringView &sql)
 {
-    if (m_assembleDelegate->assembleTable(tableName, sql)) {
+    bool succeed = m_assembleDelegate->assembleTable(tableName, sql);
+    markBufferedCellsAsCounted();
+    if (succeed) {
         if (markAsMilestone()) {
             return true;
         }
@@ -149,8 +159,16 @@ bool Repairman::assembleTable(const UnsafeStringView &tableName, const UnsafeStr
 
 bool Repairman::assembleCell(const Cell &cell)
 {
-    if (m_assembleDelegate->assembleCell(cell)) {
-        markCellAsCounted(cell);
+    bool buffered = m_assembleDelegate->isAssemblingCellBuffered();
+    if (buffered) {
+        m_bufferedCellWeights.push_back(getCellWeight(cell));
+    }
+    bool succeed = m_assembleDelegate->assembleCell(cell);
+    markBufferedCellsAsCounted();
+    if (succeed) {
+        if (!buffered) {
+            markCellAsCounted(cell);
+        }
         towardMilestone(1);
         return true;
     }
@@ -158,6 +176,29 @@ bool Repairman::assembleCell(const Cell &cell)
     return false;
 }
 
+void Repairman::markBufferedCellsAsCounted()
+{
+    std::vector<bool> results = m_assembleDelegate->takeBufferedCellResults();
+    if (results.empty()) {
+        return;
+    }
+    WCTAssert(results.size() <= m_bufferedCellWeights.size());
+    size_t count = std::min(results.size(), m_bufferedCellWeights.size());
+    bool failed = false;
+    for (size_t i = 0; i < count; ++i) {
+        if (results[i]) {
+            increaseScore(m_bufferedCellWeights[i]);
+        } else {
+            failed = true;
+        }
+    }
+    m_bufferedCellWeights.erase(m_bufferedCellWeights.begin(),
+                                m_bufferedCellWeights.begin() + count);
+    if (failed) {
+        tryUpgrateAssembleError(m_assembleDelegate->getBufferedCellError());
+    }
+}
+
 bool Repairman::assembleSequence(const UnsafeStringView &tableName, int64_t sequence)
 {
     if (m_assembleDelegate->assembleSequence(tableName, sequence)) {
@@ -194,7 +235,12 @@ int Repairman::tryUpgradeCrawlerError()
 
 int Repairman::tryUpgrateAssembleError()
 {
-    Error error = m_assembleDelegate->getAssembleError();
+    return tryUpgrateAssembleError(m_assembleDelegate->getAssembleError());
+}
+
+int Repairman::tryUpgrateAssembleError(const Error &assembleError)
+{
+    Error error = assembleError;
     if (error.code() == Error::Code::Constraint && !isErrorCritial()) {
         error.level = Error::Level::Notice;
     }
@@ -208,16 +254,21 @@ void Repairman::onErrorCritical()
 
 #pragma mark - Evaluation
 void Repairman::markCellAsCounted(const Cell &cell)
+{
+    increaseScore(getCellWeight(cell));
+}
+
+Fraction Repairman::getCellWeight(const Cell &cell) const
 {
     if (cell.getPage().isIndexPage()) {
-        return;
+        return Fraction();
     }
     int numberOfCells = cell.getPage().getNumberOfCells();
     WCTAssert(numberOfCells != 0);
     if (numberOfCells > 0) {
-        Fraction cellWeight(1, numberOfCells);
-        increaseScore(m_pageWeight * cellWeight);
+        return m_pageWeight * Fraction(1, numberOfCells);
     }
+    return Fraction();
 }
 
 void Repairman::markPageAsCounted(const Page &page)
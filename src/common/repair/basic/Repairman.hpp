@@ -66,6 +66,7 @@ protected:
 #pragma mark - Error
 protected:
     int tryUpgrateAssembleError();
+    int tryUpgrateAssembleError(const Error &assembleError);
     int tryUpgradeCrawlerError();
 
     virtual void onErrorCritical() override;
@@ -80,6 +81,11 @@ protected:
     bool assembleSequence(const UnsafeStringView &tableName, int64_t sequence);
     void assembleAssociatedSQLs(const std::list<StringView> &sqls);
 
+private:
+    // The buffered cells are counted after they are flushed into the assembled database.
+    void markBufferedCellsAsCounted();
+    std::vector<Fraction> m_bufferedCellWeights;
+
 protected:
     bool towardMilestone(int mile);
 
@@ -96,6 +102,7 @@ protected:
     void markPageAsCounted(const Page &page);
 
 private:
+    Fraction getCellWeight(const Cell &cell) const;
     Fraction m_pageWeight;
 };
 
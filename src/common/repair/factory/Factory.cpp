@@ -208,6 +208,11 @@ StringView Factory::factoryPathForDatabase(const UnsafeStringView &database)
     return Path::addExtention(database, ".factory");
 }
 
+StringView Factory::hotPageProfilePathForDatabase(const UnsafeStringView &database)
+{
+    return Path::addExtention(database, "-hot.profile");
+}
+
 StringView Factory::getRestoreDirectory() const
 {
     return Path::addComponent(directory, restoreDirectoryName);
@@ -238,6 +243,7 @@ std::list<StringView> Factory::associatedPathsForDatabase(const UnsafeStringView
         incrementalMaterialPathForDatabase(database),
         firstMaterialPathForDatabase(database),
         lastMaterialPathForDatabase(database),
+        hotPageProfilePathForDatabase(database),
     };
 }
 
@@ -89,6 +89,7 @@ public:
     static StringView firstMaterialPathForDatabase(const UnsafeStringView &database);
     static StringView lastMaterialPathForDatabase(const UnsafeStringView &database);
     static StringView factoryPathForDatabase(const UnsafeStringView &database);
+    static StringView hotPageProfilePathForDatabase(const UnsafeStringView &database);
 
     static Optional<StringView>
     materialForSerializingForDatabase(const UnsafeStringView &database);
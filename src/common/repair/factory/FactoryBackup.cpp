@@ -84,7 +84,13 @@ bool FactoryBackup::doBackUp(const UnsafeStringView& database, bool interruptibl
     if (!backup.work(incrementalMaterial)) {
         // Treat database empty error as succeed
         if (backup.getError().code() == Error::Code::Empty) {
-            notifiyBackupEnd(database, 0, 0, backup.getMaterial(), incrementalMaterial);
+            notifiyBackupEnd(database,
+                             0,
+                             0,
+                             backup.getMaterial(),
+                             incrementalMaterial,
+                             backup.getNumberOfBytesRead(),
+                             backup.getEstimatedNumberOfInteriorBytesSkipped());
             return true;
         }
         setError(backup.getError());
@@ -104,8 +110,13 @@ bool FactoryBackup::doBackUp(const UnsafeStringView& database, bool interruptibl
     CommonCore::shared().tryRegisterIncrementalMaterial(database, newIncrementalMaterial);
 
     if (interruptible) {
-        notifiyBackupEnd(
-        database, materialSize.value(), incrementalMaterialSize.value(), material, newIncrementalMaterial);
+        notifiyBackupEnd(database,
+                         materialSize.value(),
+                         incrementalMaterialSize.value(),
+                         material,
+                         newIncrementalMaterial,
+                         backup.getNumberOfBytesRead(),
+                         backup.getEstimatedNumberOfInteriorBytesSkipped());
     }
     return true;
 }
@@ -167,7 +178,9 @@ void FactoryBackup::notifiyBackupEnd(const UnsafeStringView& database,
                                      size_t materialSize,
                                      size_t incrementalMaterialSize,
                                      const Material& material,
-                                     SharedIncrementalMaterial incrementalMaterial)
+                                     SharedIncrementalMaterial incrementalMaterial,
+                                     size_t bytesRead,
+                                     size_t estimatedInteriorBytesSkipped)
 {
     uint32_t associatedTableCount = 0;
     uint32_t leafPageCount = 0;
@@ -184,6 +197,8 @@ void FactoryBackup::notifiyBackupEnd(const UnsafeStringView& database,
     error.infos.insert_or_assign("TableCount", material.contentsMap.size());
     error.infos.insert_or_assign("AssociatedTableCount", associatedTableCount);
     error.infos.insert_or_assign("LeafPageCount", leafPageCount);
+    error.infos.insert_or_assign("BytesRead", bytesRead);
+    error.infos.insert_or_assign("EstimatedInteriorBytesSkipped", estimatedInteriorBytesSkipped);
     error.infos.insert_or_assign(ErrorStringKeyPath, database);
     Notifier::shared().notify(error);
 }
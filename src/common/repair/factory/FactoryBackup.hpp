@@ -52,7 +52,9 @@ protected:
                           size_t materialSize,
                           size_t incrementalMaterialSize,
                           const Material& material,
-                          SharedIncrementalMaterial incrementalMaterial);
+                          SharedIncrementalMaterial incrementalMaterial,
+                          size_t bytesRead,
+                          size_t estimatedInteriorBytesSkipped);
 };
 
 } //namespace Repair
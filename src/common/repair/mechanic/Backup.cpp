@@ -78,6 +78,7 @@ Backup::Backup(const UnsafeStringView &path)
 , m_incrementalMaterial(nullptr)
 , m_verifyingPagenos(nullptr)
 , m_unchangedLeavesCount(0)
+, m_estimatedNumberOfSkippedInteriorPages(0)
 , m_masterCrawler()
 {
     setAssociatedPager(&m_pager);
@@ -236,6 +237,11 @@ bool Backup::incrementalBackup()
     }
     m_verifyingPagenos = &m_incrementalMaterial->pages;
     int schemaCookie = m_pager.getSchemaCookie();
+    if (schemaCookie == m_incrementalMaterial->info.lastSchemaCookie
+        && m_material.info.seqTableRootPage != Material::UnknownPageNo
+        && tryApplyCheckpointedLeaves()) {
+        return true;
+    }
     if (schemaCookie != m_incrementalMaterial->info.lastSchemaCookie
         || m_material.info.seqTableRootPage == Material::UnknownPageNo) {
         if (!loadWal()) {
@@ -338,6 +344,66 @@ bool Backup::incrementalBackup()
     return true;
 }
 
+bool Backup::tryApplyCheckpointedLeaves()
+{
+    // A leaf modified in place leaves its ancestors untouched, so its new hash,
+    // computed when the checkpoint wrote it, can be applied without crawling.
+    // Any change of the tree structure touches an interior page and falls back.
+    std::unordered_map<uint32_t, Material::Page *> leaves;
+    for (const auto &iter : *m_verifyingPagenos) {
+        switch (iter.second.type) {
+        case Page::Type::LeafTable:
+            leaves.emplace(iter.first, nullptr);
+            break;
+        case Page::Type::InteriorTable:
+            return false;
+        default:
+            break;
+        }
+    }
+    std::vector<std::list<Material::Content>::iterator> changedContents;
+    auto &contentList = m_material.contentsList;
+    for (auto content = contentList.begin(); content != contentList.end(); ++content) {
+        bool changed = false;
+        for (auto &page : content->verifiedPagenos) {
+            auto iter = leaves.find(page.number);
+            if (iter == leaves.end()) {
+                continue;
+            }
+            if (iter->second != nullptr) {
+                // Stale page claimed by more than one table
+                return false;
+            }
+            iter->second = &page;
+            changed = true;
+        }
+        if (changed) {
+            changedContents.push_back(content);
+        }
+    }
+    for (const auto &iter : leaves) {
+        if (iter.second == nullptr) {
+            // New leaf or the leaf of sequence table
+            return false;
+        }
+    }
+    for (const auto &iter : leaves) {
+        iter.second->hash = m_verifyingPagenos->at(iter.first).hash;
+    }
+    for (auto &content : changedContents) {
+        size_t numberOfLeaves = 0;
+        for (const auto &page : content->verifiedPagenos) {
+            if (page.number > 0) {
+                numberOfLeaves++;
+            }
+        }
+        m_estimatedNumberOfSkippedInteriorPages += estimateMinNumberOfInteriorPages(numberOfLeaves);
+        contentList.splice(contentList.begin(), contentList, content);
+    }
+    m_verifyingPagenos->clear();
+    return true;
+}
+
 bool Backup::loadWal()
 {
     bool exclusive = false;
@@ -373,6 +439,33 @@ SharedIncrementalMaterial Backup::getIncrementalMaterial()
     return m_incrementalMaterial;
 }
 
+size_t Backup::getNumberOfBytesRead() const
+{
+    return m_pager.getNumberOfBytesRead();
+}
+
+size_t Backup::getEstimatedNumberOfInteriorBytesSkipped() const
+{
+    if (m_estimatedNumberOfSkippedInteriorPages == 0) {
+        return 0;
+    }
+    return m_estimatedNumberOfSkippedInteriorPages * m_pager.getPageSize();
+}
+
+size_t Backup::estimateMinNumberOfInteriorPages(size_t numberOfLeaves) const
+{
+    // The smallest interior cell is a 4-byte child pageno, a 1-byte varint
+    // key and its 2-byte cell pointer, which gives the largest fanout.
+    size_t fanout = (m_pager.getUsableSize() - 12) / 7 + 1;
+    size_t numberOfInteriorPages = 0;
+    size_t numberOfPages = numberOfLeaves;
+    while (numberOfPages > 1) {
+        numberOfPages = (numberOfPages + fanout - 1) / fanout;
+        numberOfInteriorPages += numberOfPages;
+    }
+    return numberOfInteriorPages;
+}
+
 void Backup::updateMaterial(bool isIncremental)
 {
     auto &info = m_material.info;
@@ -101,10 +101,18 @@ public:
     const Material &getMaterial() const;
     SharedIncrementalMaterial getIncrementalMaterial();
 
+    // Bytes read through pager during this backup.
+    size_t getNumberOfBytesRead() const;
+    // Estimated bytes of interior pages not crawled since the changed leaves are taken from the checkpoint.
+    // It is a lower bound derived from the number of leaves, as the skipped pages are never read.
+    size_t getEstimatedNumberOfInteriorBytesSkipped() const;
+
 protected:
     Optional<bool> tryLoadLatestMaterial(SharedIncrementalMaterial incrementalMaterial);
     bool fullBackup();
     bool incrementalBackup();
+    bool tryApplyCheckpointedLeaves();
+    size_t estimateMinNumberOfInteriorPages(size_t numberOfLeaves) const;
     bool loadWal();
     void updateMaterial(bool isIncremental);
 
@@ -119,6 +127,7 @@ protected:
     IncrementalPages *m_verifyingPagenos;
     std::vector<bool> m_unchangedLeaves;
     int m_unchangedLeavesCount;
+    size_t m_estimatedNumberOfSkippedInteriorPages;
 
 #pragma mark - Filter
 public:
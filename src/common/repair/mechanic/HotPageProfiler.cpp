@@ -0,0 +1,289 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HotPageProfiler.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include "Factory.hpp"
+#include "FileHandle.hpp"
+#include "FileManager.hpp"
+#include "Notifier.hpp"
+#include "Page.hpp"
+#include "StringView.hpp"
+#include <algorithm>
+#include <queue>
+#include <set>
+#include <thread>
+
+namespace WCDB {
+
+namespace Repair {
+
+#pragma mark - Initialize
+HotPageProfiler::HotPageProfiler(const UnsafeStringView &path)
+: m_pager(path), m_numberOfRecordedPages(0), m_numberOfPrefetchedPages(0)
+{
+}
+
+HotPageProfiler::~HotPageProfiler() = default;
+
+void HotPageProfiler::setPageSize(int pageSize)
+{
+    m_pager.setPageSize(pageSize);
+}
+
+void HotPageProfiler::setCipherContext(void *ctx)
+{
+    m_pager.setCipherContext(ctx);
+}
+
+#pragma mark - Profile
+HotPageProfiler::Profile::Profile() : pageSize(0)
+{
+}
+
+HotPageProfiler::Profile::~Profile() = default;
+
+bool HotPageProfiler::Profile::serialize(Serialization &serialization) const
+{
+    if (!serialization.expand(headerSize + sizeof(uint32_t) * (2 + pagenos.size()))) {
+        return false;
+    }
+    serialization.put4BytesUInt(magic);
+    serialization.put4BytesUInt(version);
+    serialization.put4BytesUInt(pageSize);
+    serialization.put4BytesUInt((uint32_t) pagenos.size());
+    for (uint32_t pageno : pagenos) {
+        serialization.put4BytesUInt(pageno);
+    }
+    return true;
+}
+
+bool HotPageProfiler::Profile::deserialize(Deserialization &deserialization)
+{
+    if (!deserialization.canAdvance(headerSize + sizeof(uint32_t) * 2)) {
+        markAsCorrupt("Header");
+        return false;
+    }
+    if (deserialization.advance4BytesUInt() != magic) {
+        markAsCorrupt("Magic");
+        return false;
+    }
+    if (deserialization.advance4BytesUInt() != version) {
+        markAsCorrupt("Version");
+        return false;
+    }
+    pageSize = deserialization.advance4BytesUInt();
+    uint32_t numberOfPages = deserialization.advance4BytesUInt();
+    if (!deserialization.canAdvance(sizeof(uint32_t) * numberOfPages)) {
+        markAsCorrupt("Pagenos");
+        return false;
+    }
+    pagenos.resize(numberOfPages);
+    for (uint32_t &pageno : pagenos) {
+        pageno = deserialization.advance4BytesUInt();
+    }
+    return true;
+}
+
+void HotPageProfiler::Profile::markAsCorrupt(const UnsafeStringView &element)
+{
+    Error error(Error::Code::Corrupt, Error::Level::Notice, "Hot page profile is corrupted");
+    error.infos.insert_or_assign(ErrorStringKeySource, ErrorSourceRepair);
+    error.infos.insert_or_assign("Element", element);
+    Notifier::shared().notify(error);
+    setThreadedError(std::move(error));
+}
+
+#pragma mark - Record
+int HotPageProfiler::getNumberOfRecordedPages() const
+{
+    return m_numberOfRecordedPages;
+}
+
+bool HotPageProfiler::record(const std::list<int> &rootpages, int maxNumberOfPages)
+{
+    m_numberOfRecordedPages = 0;
+    StringView profilePath = Factory::hotPageProfilePathForDatabase(m_pager.getPath());
+    if (!m_pager.initialize()) {
+        if (m_pager.getError().code() == Error::Code::Empty) {
+            // Nothing is hot for an empty database.
+            return FileManager::removeItem(profilePath);
+        }
+        setError(m_pager.getError());
+        return false;
+    }
+
+    Profile profile;
+    profile.pageSize = m_pager.getPageSize();
+    std::set<int> visited;
+    std::queue<int> pagenos;
+    pagenos.push(1);
+    for (int rootpage : rootpages) {
+        pagenos.push(rootpage);
+    }
+    while (!pagenos.empty() && profile.pagenos.size() < (size_t) maxNumberOfPages) {
+        int pageno = pagenos.front();
+        pagenos.pop();
+        if (pageno <= 0 || pageno > m_pager.getNumberOfPages()
+            || !visited.insert(pageno).second) {
+            continue;
+        }
+        Page page(pageno, &m_pager);
+        if (!page.initialize()) {
+            setError(m_pager.getError());
+            return false;
+        }
+        if (page.getType() == Page::Type::Unknown) {
+            continue;
+        }
+        profile.pagenos.push_back(pageno);
+        if (!page.isInteriorPage()) {
+            continue;
+        }
+        // B-tree is balanced, so the siblings of a leaf page are all leaves and are not worth reading.
+        Page firstSubpage(page.getSubpageno(0), &m_pager);
+        auto type = firstSubpage.acquireType();
+        if (!type.succeed()) {
+            setError(m_pager.getError());
+            return false;
+        }
+        if (type.value() != Page::Type::InteriorTable
+            && type.value() != Page::Type::InteriorIndex) {
+            continue;
+        }
+        for (int i = 0; i < page.getNumberOfSubpages(); ++i) {
+            pagenos.push(page.getSubpageno(i));
+        }
+    }
+
+    if (!profile.serialize(profilePath)) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    m_numberOfRecordedPages = (int) profile.pagenos.size();
+    return true;
+}
+
+#pragma mark - Prefetch
+int HotPageProfiler::getNumberOfPrefetchedPages() const
+{
+    return m_numberOfPrefetchedPages;
+}
+
+bool HotPageProfiler::prefetch()
+{
+    m_numberOfPrefetchedPages = 0;
+    StringView profilePath = Factory::hotPageProfilePathForDatabase(m_pager.getPath());
+    auto exists = FileManager::fileExists(profilePath);
+    if (!exists.succeed()) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    if (!exists.value()) {
+        return true;
+    }
+    Profile profile;
+    if (!profile.deserialize(profilePath)) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    if (profile.pagenos.empty() || profile.pageSize == 0) {
+        return true;
+    }
+
+    FileHandle fileHandle(m_pager.getPath());
+    if (!fileHandle.open(FileHandle::Mode::ReadOnly)) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    ssize_t fileSize = fileHandle.size();
+    if (fileSize < 0) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+
+    // Consecutive pages are read as a whole.
+    std::vector<uint32_t> pagenos = profile.pagenos;
+    std::sort(pagenos.begin(), pagenos.end());
+    const size_t pageSize = profile.pageSize;
+    std::vector<FileRange> ranges;
+    for (uint32_t pageno : pagenos) {
+        offset_t offset = (offset_t) (pageno - 1) * pageSize;
+        if (pageno == 0 || offset + pageSize > (size_t) fileSize) {
+            continue;
+        }
+        if (!ranges.empty() && ranges.back().first + ranges.back().second == offset) {
+            ranges.back().second += pageSize;
+        } else if (ranges.empty() || ranges.back().first + ranges.back().second < offset) {
+            ranges.emplace_back(offset, pageSize);
+        } else {
+            // Duplicated page.
+            continue;
+        }
+        ++m_numberOfPrefetchedPages;
+    }
+
+    std::vector<FileRange> unadvisedRanges;
+    for (const auto &range : ranges) {
+        if (!fileHandle.adviseWillNeed(range.first, range.second)) {
+            unadvisedRanges.push_back(range);
+        }
+    }
+    fileHandle.close();
+    if (!unadvisedRanges.empty()) {
+        readInParallel(unadvisedRanges, pageSize);
+    }
+    return true;
+}
+
+void HotPageProfiler::readInParallel(const std::vector<FileRange> &ranges, size_t pageSize)
+{
+    const StringView &path = m_pager.getPath();
+    auto readRanges = [&ranges, &path, pageSize](size_t begin, size_t step) {
+        FileHandle fileHandle(path);
+        fileHandle.markErrorAsIgnorable(true);
+        if (!fileHandle.open(FileHandle::Mode::ReadOnly)) {
+            return;
+        }
+        volatile unsigned char touched = 0;
+        for (size_t i = begin; i < ranges.size(); i += step) {
+            MappedData data = fileHandle.map(ranges[i].first, ranges[i].second);
+            // Touching each page makes the system read it from disk.
+            for (size_t offset = 0; offset < data.size(); offset += pageSize) {
+                touched ^= data.buffer()[offset];
+            }
+        }
+        WCDB_UNUSED(touched);
+    };
+    size_t concurrency = std::min(ranges.size(), (size_t) maxConcurrency);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < concurrency; ++i) {
+        workers.emplace_back(readRanges, i, concurrency);
+    }
+    readRanges(0, concurrency);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+} //namespace Repair
+
+} //namespace WCDB
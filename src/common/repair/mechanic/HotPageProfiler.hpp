@@ -0,0 +1,101 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ErrorProne.hpp"
+#include "Pager.hpp"
+#include "Serialization.hpp"
+#include <list>
+#include <vector>
+
+namespace WCDB {
+
+namespace Repair {
+
+class HotPageProfiler final : public ErrorProne {
+#pragma mark - Initialize
+public:
+    HotPageProfiler(const UnsafeStringView &path);
+    ~HotPageProfiler() override;
+
+    void setPageSize(int pageSize);
+    void setCipherContext(void *ctx);
+
+protected:
+    Pager m_pager;
+
+#pragma mark - Profile
+public:
+    class Profile final : public Serializable, public Deserializable {
+    public:
+        Profile();
+        ~Profile() override;
+
+        uint32_t pageSize;
+        // Page numbers in level order, from the roots of b-trees to the bottom interior pages.
+        std::vector<uint32_t> pagenos;
+
+        static constexpr const uint32_t magic = 0x57434450;
+        static constexpr const uint32_t version = 0x01000000;
+        static constexpr const int headerSize = sizeof(magic) + sizeof(version);
+
+        bool serialize(Serialization &serialization) const override final;
+        using Serializable::serialize;
+        bool deserialize(Deserialization &deserialization) override final;
+        using Deserializable::deserialize;
+
+    protected:
+        void markAsCorrupt(const UnsafeStringView &element);
+    };
+
+#pragma mark - Record
+public:
+    /*
+     Only the root and interior pages of the b-trees are recorded, since they are read by almost every lookup.
+     Upper levels are recorded first, so that they are kept if the number of pages exceeds the limit.
+     The root page of schema is always recorded.
+     */
+    bool record(const std::list<int> &rootpages, int maxNumberOfPages);
+    int getNumberOfRecordedPages() const;
+
+protected:
+    int m_numberOfRecordedPages;
+
+#pragma mark - Prefetch
+public:
+    /*
+     Read the recorded pages of main file into the cache of system, so that the first queries after restart don't wait for disk.
+     It's a hint rather than a guarantee, so the pages that are beyond the end of file are skipped.
+     */
+    bool prefetch();
+    int getNumberOfPrefetchedPages() const;
+
+protected:
+    typedef std::pair<offset_t, size_t> FileRange;
+    void readInParallel(const std::vector<FileRange> &ranges, size_t pageSize);
+
+    static constexpr const int maxConcurrency = 4;
+    int m_numberOfPrefetchedPages;
+};
+
+} //namespace Repair
+
+} //namespace WCDB
@@ -0,0 +1,164 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Snapshot.hpp"
+#include "Assertion.hpp"
+#include "CoreConst.h"
+#include "FileHandle.hpp"
+#include "FileManager.hpp"
+#include "Notifier.hpp"
+#include "Path.hpp"
+#include "StringView.hpp"
+
+namespace WCDB {
+
+namespace Repair {
+
+#pragma mark - Initialize
+Snapshot::Snapshot(const UnsafeStringView &path)
+: m_pager(path), m_numberOfExportedPages(0)
+{
+}
+
+Snapshot::~Snapshot() = default;
+
+void Snapshot::setPageSize(int pageSize)
+{
+    m_pager.setPageSize(pageSize);
+    // Reserved bytes are useless since the content of page is not parsed.
+    m_pager.setReservedBytes(0);
+}
+
+#pragma mark - Export
+int Snapshot::getNumberOfExportedPages() const
+{
+    return m_numberOfExportedPages;
+}
+
+bool Snapshot::exportTo(const UnsafeStringView &path)
+{
+    m_numberOfExportedPages = 0;
+    // Stale wal or journal of the destination would be applied to the exported pages on opening.
+    if (!FileManager::removeItems({
+        Path::addExtention(path, "-journal"),
+        Path::addExtention(path, "-wal"),
+        Path::addExtention(path, "-shm"),
+        })) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    FileHandle destination(path);
+    if (!destination.open(FileHandle::Mode::OverWrite)) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    if (!m_pager.initialize()) {
+        if (m_pager.getError().code() == Error::Code::Empty) {
+            // Nothing to export for an empty database.
+            return true;
+        }
+        setError(m_pager.getError());
+        return false;
+    }
+    FileHandle source(m_pager.getPath());
+    if (!source.open(FileHandle::Mode::ReadOnly)) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+
+    const int numberOfPages = m_pager.getNumberOfCommittedPages();
+    const size_t pageSize = m_pager.getPageSize();
+    const int maxPagesPerCopy = std::max((int) (maxCopySize / pageSize), 1);
+    int pageno = 1;
+    while (pageno <= numberOfPages) {
+        if (m_pager.containPageInWal(pageno)) {
+            UnsafeData data = m_pager.acquirePageData(pageno);
+            if (data.empty()) {
+                setError(m_pager.getError());
+                return false;
+            }
+            if (!destination.write(data, (offset_t) (pageno - 1) * pageSize)) {
+                assignWithSharedThreadedError();
+                return false;
+            }
+            ++pageno;
+            continue;
+        }
+        // Copy the consecutive pages that are not overlaid by wal at once.
+        int lastPageno = pageno;
+        while (lastPageno < numberOfPages && lastPageno - pageno + 1 < maxPagesPerCopy
+               && !m_pager.containPageInWal(lastPageno + 1)) {
+            ++lastPageno;
+        }
+        if (!copyMainPages(source, destination, pageno, lastPageno)) {
+            return false;
+        }
+        pageno = lastPageno + 1;
+    }
+    m_numberOfExportedPages = numberOfPages;
+    return true;
+}
+
+bool Snapshot::copyMainPages(FileHandle &source, FileHandle &destination, int from, int to)
+{
+    WCTAssert(from > 0 && from <= to);
+    const size_t pageSize = m_pager.getPageSize();
+    offset_t offset = (offset_t) (from - 1) * pageSize;
+    size_t size = (size_t) (to - from + 1) * pageSize;
+    ssize_t fileSize = source.size();
+    if (fileSize < 0) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    if (offset + size > (size_t) fileSize) {
+        markAsIncomplete(std::max(from, (int) (fileSize / pageSize) + 1));
+        return false;
+    }
+    MappedData data = source.map(offset, size);
+    if (data.size() != size) {
+        if (data.empty()) {
+            assignWithSharedThreadedError();
+        } else {
+            markAsIncomplete(from);
+        }
+        return false;
+    }
+    if (!destination.write(data, offset)) {
+        assignWithSharedThreadedError();
+        return false;
+    }
+    return true;
+}
+
+void Snapshot::markAsIncomplete(int pageno)
+{
+    Error error(Error::Code::Corrupt,
+                Error::Level::Error,
+                StringView::formatted("Page %d is neither in main file nor in wal.", pageno));
+    error.infos.insert_or_assign(ErrorStringKeySource, ErrorSourceRepair);
+    error.infos.insert_or_assign(ErrorStringKeyAssociatePath, m_pager.getPath());
+    error.infos.insert_or_assign("Page", pageno);
+    Notifier::shared().notify(error);
+    setError(std::move(error));
+}
+
+} //namespace Repair
+
+} //namespace WCDB
@@ -0,0 +1,62 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "ErrorProne.hpp"
+#include "Pager.hpp"
+
+namespace WCDB {
+
+namespace Repair {
+
+class Snapshot final : public ErrorProne {
+#pragma mark - Initialize
+public:
+    Snapshot(const UnsafeStringView &path);
+    ~Snapshot() override;
+
+    // Pages are copied as they are, so cipher database only needs its page size.
+    void setPageSize(int pageSize);
+
+protected:
+    Pager m_pager;
+
+#pragma mark - Export
+public:
+    /*
+     The caller should keep a read transaction of the database during exporting,
+     so that the wal can not be restarted and the checkpoint can not write the main file beyond its read mark.
+     The committed frames in wal are overlaid on the pages of main file.
+     */
+    bool exportTo(const UnsafeStringView &path);
+    int getNumberOfExportedPages() const;
+
+protected:
+    bool copyMainPages(FileHandle &source, FileHandle &destination, int from, int to);
+    void markAsIncomplete(int pageno);
+
+    static constexpr const size_t maxCopySize = 4 * 1024 * 1024;
+    int m_numberOfExportedPages;
+};
+
+} //namespace Repair
+
+} //namespace WCDB
@@ -350,10 +350,22 @@ bool Cell::doInitialize()
     const int endOfValues = payloadSize;
     const int endOfSerialTypes = offsetOfValues;
 
+    // Serial types are mostly single-byte varints. When the record header lies
+    // inside the payload, they are read straight from it and only multi-byte
+    // ones go through the checked varint decoding.
+    const unsigned char *serialTypes = nullptr;
+    if ((size_t) endOfSerialTypes <= m_payload.size()) {
+        serialTypes = m_payload.buffer();
+    }
     while (cursorOfSerialTypes < endOfSerialTypes) {
         int lengthOfSerialType, serialType;
-        m_deserialization.seek(cursorOfSerialTypes);
-        std::tie(lengthOfSerialType, serialType) = m_deserialization.advanceVarint();
+        if (serialTypes != nullptr && serialTypes[cursorOfSerialTypes] < 0x80) {
+            lengthOfSerialType = 1;
+            serialType = serialTypes[cursorOfSerialTypes];
+        } else {
+            std::tie(lengthOfSerialType, serialType)
+            = m_deserialization.getVarint(cursorOfSerialTypes);
+        }
         if (lengthOfSerialType == 0) {
             markPagerAsCorrupted(m_page->number, "Unable to deserialize SerialType.");
             return false;
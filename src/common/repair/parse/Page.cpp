@@ -212,15 +212,26 @@ bool Page::doInitialize()
         number, StringView::formatted("Unexpected CellCount: %d.", numberOfCells));
         return false;
     }
-    m_cellPointers.reserve(numberOfCells);
-    for (int i = 0; i < numberOfCells; ++i) {
-        int offset = getOffsetOfHeader() + getOffsetOfCellPointer() + i * 2;
-        if (!m_deserialization.isEnough(offset + 2)) {
-            markPagerAsCorrupted(number, "Unable to deserialize CellPointer.");
-            return false;
+    int offsetOfCellPointers = getOffsetOfHeader() + getOffsetOfCellPointer();
+    if (m_deserialization.isEnough(offsetOfCellPointers + numberOfCells * 2)) {
+        // Well-formed array is bounded once and decoded without per-cell checks.
+        m_cellPointers.resize(numberOfCells);
+        const unsigned char *pointers = m_data.buffer() + offsetOfCellPointers;
+        int *cellPointers = m_cellPointers.data();
+        for (int i = 0; i < numberOfCells; ++i) {
+            cellPointers[i] = (int16_t) ((pointers[2 * i] << 8) | pointers[2 * i + 1]);
+        }
+    } else {
+        m_cellPointers.reserve(numberOfCells);
+        for (int i = 0; i < numberOfCells; ++i) {
+            int offset = offsetOfCellPointers + i * 2;
+            if (!m_deserialization.isEnough(offset + 2)) {
+                markPagerAsCorrupted(number, "Unable to deserialize CellPointer.");
+                return false;
+            }
+            int cellPointer = m_deserialization.get2BytesInt(offset);
+            m_cellPointers.push_back(cellPointer);
         }
-        int cellPointer = m_deserialization.get2BytesInt(offset);
-        m_cellPointers.push_back(cellPointer);
     }
     if (m_type == Type::InteriorTable || m_type == Type::InteriorIndex) {
         int numberOfSubpage = (int) m_cellPointers.size() + hasRightMostPageNo();
@@ -25,6 +25,7 @@
 #include "PageBasedFileHandle.hpp"
 #include "Assertion.hpp"
 #include "CoreConst.h"
+#include "MemoryGovernor.hpp"
 #include "Notifier.hpp"
 #include "WCDBError.hpp"
 
@@ -32,7 +33,7 @@ namespace WCDB {
 
 #pragma mark - PageBasedFileHandle
 PageBasedFileHandle::PageBasedFileHandle(const UnsafeStringView& path)
-: FileHandle(path), m_pageSize(0), m_cache(maxAllowedCacheMemory), m_cachePageSize(0)
+: FileHandle(path), m_pageSize(0), m_cache(path, maxAllowedCacheMemory), m_cachePageSize(0)
 {
     static_assert(maxAllowedCacheMemory % cacheMemoryPerRange == 0, "");
     static_assert((maxAllowedCacheMemory & maxAllowedCacheMemory - 1) == 0, "");
@@ -166,15 +167,20 @@ bool PageBasedFileHandle::purgeOne()
     return true;
 }
 
-PageBasedFileHandle::Cache::Cache(size_t maxAllowedMemory)
+PageBasedFileHandle::Cache::Cache(const UnsafeStringView& path, size_t maxAllowedMemory)
 : LRUCache<WCDB::Range, WCDB::MappedData>()
 , m_range(Range::notFound())
+, m_path(path)
 , m_maxAllowedMemory(maxAllowedMemory)
 , m_currentUsedMemery(0)
 {
 }
 
-PageBasedFileHandle::Cache::~Cache() = default;
+PageBasedFileHandle::Cache::~Cache()
+{
+    MemoryGovernor::shared().decrease(
+    m_path, MemoryGovernor::Component::PagerCache, m_currentUsedMemery);
+}
 
 void PageBasedFileHandle::Cache::setRange(const WCDB::Range& range)
 {
@@ -235,18 +241,31 @@ void PageBasedFileHandle::Cache::insert(const Range& range, const MappedData& da
     WCTAssert(find(range.location).second == nullptr);
     WCTAssert(find(range.edge() - 1).second == nullptr);
     m_currentUsedMemery += data.size();
+    MemoryGovernor::shared().increase(m_path, MemoryGovernor::Component::PagerCache, data.size());
     put(range, data);
 }
 
 bool PageBasedFileHandle::Cache::shouldPurge() const
 {
-    return m_currentUsedMemery > m_maxAllowedMemory;
+    size_t maxAllowedMemory = m_maxAllowedMemory;
+    switch (MemoryGovernor::shared().getPressure(m_path)) {
+    case MemoryGovernor::Pressure::None:
+        break;
+    case MemoryGovernor::Pressure::Moderate:
+        maxAllowedMemory /= 2;
+        break;
+    case MemoryGovernor::Pressure::Critical:
+        maxAllowedMemory = cacheMemoryPerRange;
+        break;
+    }
+    return m_currentUsedMemery > maxAllowedMemory;
 }
 
 void PageBasedFileHandle::Cache::willPurge(const Range& range, const MappedData& data)
 {
     WCDB_UNUSED(range);
     m_currentUsedMemery -= data.size();
+    MemoryGovernor::shared().decrease(m_path, MemoryGovernor::Component::PagerCache, data.size());
 }
 
 PageBasedFileHandle::Cache::MapIterator
@@ -64,7 +64,7 @@ protected:
 
     class Cache final : protected LRUCache<Range, MappedData> {
     public:
-        Cache(size_t maxAllowedMemory);
+        Cache(const UnsafeStringView& path, size_t maxAllowedMemory);
         ~Cache() override;
 
         using Super = LRUCache<Range, MappedData>;
@@ -84,6 +84,8 @@ protected:
 
         bool shouldPurge() const override final;
         void willPurge(const Range& range, const MappedData& data) override final;
+        // Owner of the memory for memory governor.
+        StringView m_path;
         size_t m_maxAllowedMemory;
         size_t m_currentUsedMemery;
     };
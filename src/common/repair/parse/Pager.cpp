@@ -46,6 +46,7 @@ Pager::Pager(const UnsafeStringView& path)
 , m_numberOfPages(0)
 , m_fileSize(0)
 , m_schemaCookie(-1)
+, m_numberOfBytesRead(0)
 , m_wal(this)
 , m_walImportance(true)
 , m_skipWal(false)
@@ -86,6 +87,16 @@ int Pager::getNumberOfPages() const
     return std::max(m_wal.getMaxPageno(), m_numberOfPages);
 }
 
+int Pager::getNumberOfCommittedPages() const
+{
+    WCTAssert(isInitialized());
+    int numberOfPages = m_wal.getCommittedNumberOfPages();
+    if (numberOfPages > 0) {
+        return numberOfPages;
+    }
+    return m_numberOfPages;
+}
+
 int Pager::getUsableSize() const
 {
     WCTAssert(isInitialized() || isInitializing());
@@ -110,6 +121,11 @@ int Pager::getSchemaCookie() const
     return m_schemaCookie;
 }
 
+size_t Pager::getNumberOfBytesRead() const
+{
+    return m_numberOfBytesRead;
+}
+
 UnsafeData Pager::acquirePageData(int number)
 {
     return acquirePageData(number, 0, m_pageSize);
@@ -148,6 +164,7 @@ UnsafeData Pager::acquirePageData(int number, offset_t offset, size_t size)
         }
         return MappedData::null();
     }
+    m_numberOfBytesRead += data.size();
     if (m_pCodec) {
         void* decodedBuffer = sqlite3Codec(m_pCodec, data.buffer(), number, 4);
         if (decodedBuffer == nullptr) {
@@ -188,6 +205,7 @@ UnsafeData Pager::acquireHeader()
     if (data.size() != 100) {
         return MappedData::null();
     }
+    m_numberOfBytesRead += m_pCodec == nullptr ? data.size() : m_pageSize;
     return data;
 }
 
@@ -57,6 +57,7 @@ protected:
 #pragma mark - Page
 public:
     int getNumberOfPages() const;
+    int getNumberOfCommittedPages() const;
     UnsafeData acquirePageData(int number);
     UnsafeData acquirePageData(int number, offset_t offset, size_t size);
 
@@ -64,6 +65,7 @@ public:
     int getPageSize() const;
     int getReservedBytes() const;
     int getSchemaCookie() const;
+    size_t getNumberOfBytesRead() const;
 
 protected:
     UnsafeData acquireHeader();
@@ -72,6 +74,7 @@ protected:
     int m_numberOfPages;
     size_t m_fileSize;
     int m_schemaCookie;
+    size_t m_numberOfBytesRead;
 
 #pragma mark - Wal
 public:
@@ -142,6 +142,14 @@ int Wal::getMaxFrame() const
     return m_maxFrame;
 }
 
+int Wal::getCommittedNumberOfPages() const
+{
+    if (m_truncate == std::numeric_limits<uint32_t>::max()) {
+        return 0;
+    }
+    return (int) m_truncate;
+}
+
 int Wal::getNumberOfFrames() const
 {
     return (int) m_pages2Frames.size();
@@ -74,6 +74,8 @@ public:
     const Salt &getSalt() const;
     void setSalt(const Salt &salt);
     int getMaxFrame() const;
+    // Database size in pages after the last committed frame, or 0 if there is none.
+    int getCommittedNumberOfPages() const;
     int getPageSize() const;
 
 protected:
@@ -67,7 +67,11 @@ public:
 
     explicit SpecifiedSyntax(const SyntaxType& syntax) : Super(syntax) {}
 
-    SpecifiedSyntax(SyntaxType&& syntax) : Super(std::move(syntax)) {}
+    // Move the syntax into its payload instead of cloning it.
+    SpecifiedSyntax(SyntaxType&& syntax)
+    : Super(std::make_shared<SyntaxType>(std::move(syntax)))
+    {
+    }
 
     SpecifiedSyntax(Self&& other) : Super(std::move(other)) {}
 
@@ -65,6 +65,40 @@ const ColumnDef *BaseBinding::getColumnDef(const UnsafeStringView &columnName) c
     return columnDef;
 }
 
+const ColumnDef *BaseBinding::getRowidAliasColumnDef() const
+{
+    if (statementTable.syntax().withoutRowid) {
+        return nullptr;
+    }
+    for (const auto &iter : m_columnDefs) {
+        const Syntax::ColumnDef &syntax = iter.second.syntax();
+        if (syntax.isPrimaryKey()) {
+            return syntax.columnTypeValid() && syntax.columnType == ColumnType::Integer ?
+                   &iter.second :
+                   nullptr;
+        }
+    }
+    for (const auto &iter : m_constraints) {
+        const Syntax::TableConstraint &syntax = iter.second.syntax();
+        if (syntax.switcher != Syntax::TableConstraint::Switch::PrimaryKey) {
+            continue;
+        }
+        // Only the primary key of single integer column is the alias of rowid.
+        if (syntax.indexedColumns.size() != 1
+            || !syntax.indexedColumns.front().column.hasValue()) {
+            return nullptr;
+        }
+        const ColumnDef *columnDef
+        = getColumnDef(syntax.indexedColumns.front().column.value().name);
+        if (columnDef == nullptr || !columnDef->syntax().columnTypeValid()
+            || columnDef->syntax().columnType != ColumnType::Integer) {
+            return nullptr;
+        }
+        return columnDef;
+    }
+    return nullptr;
+}
+
 void BaseBinding::enableAutoIncrementForExistingTable()
 {
     m_enableAutoIncrementForExistingTable = true;
@@ -40,6 +40,8 @@ public:
     const CaseInsensitiveList<ColumnDef> &getColumnDefs() const;
     ColumnDef *getColumnDef(const UnsafeStringView &columnName);
     const ColumnDef *getColumnDef(const UnsafeStringView &columnName) const;
+    // The column declared as integer primary key by column constraint or table constraint, which is the alias of rowid.
+    const ColumnDef *getRowidAliasColumnDef() const;
     void enableAutoIncrementForExistingTable();
 
 protected:
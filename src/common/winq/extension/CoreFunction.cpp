@@ -308,6 +308,15 @@ Expression CoreFunction::decompress(const Expression& value, const Expression& c
     return Expression::function(DecompressFunctionName).invoke().arguments({ value, compressionType });
 }
 
+Expression CoreFunction::decompress(const Expression& value,
+                                    const Expression& compressionType,
+                                    const Expression& dictScope)
+{
+    return Expression::function(DecompressFunctionName)
+    .invoke()
+    .arguments({ value, compressionType, dictScope });
+}
+
 CoreFunctionOperable::~CoreFunctionOperable() = default;
 
 Expression CoreFunctionOperable::abs() const
@@ -90,6 +90,9 @@ public:
 
 protected:
     static Expression decompress(const Expression& value, const Expression& compressionType);
+    static Expression decompress(const Expression& value,
+                                 const Expression& compressionType,
+                                 const Expression& dictScope);
 };
 
 class WCDB_API CoreFunctionOperable : virtual public ExpressionOperable {
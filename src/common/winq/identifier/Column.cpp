@@ -31,13 +31,13 @@ Column::Column() = default;
 Column::Column(const UnsafeStringView& name)
 {
     syntax().wildcard = false;
-    syntax().name = name;
+    syntax().name = StringView::makeInterned(name);
 }
 
 Column::Column(const UnsafeStringView& name, const BaseBinding* binding)
 {
     syntax().wildcard = false;
-    syntax().name = name;
+    syntax().name = StringView::makeInterned(name);
     syntax().tableBinding = binding;
 }
 
@@ -49,7 +49,7 @@ Column& Column::schema(const Schema& schema)
 
 Column& Column::table(const UnsafeStringView& table)
 {
-    syntax().table = table;
+    syntax().table = StringView::makeInterned(table);
     return *this;
 }
 
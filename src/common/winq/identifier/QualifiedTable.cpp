@@ -32,7 +32,7 @@ QualifiedTable::~QualifiedTable() = default;
 
 QualifiedTable::QualifiedTable(const UnsafeStringView& table)
 {
-    syntax().table = table;
+    syntax().table = StringView::makeInterned(table);
 }
 
 QualifiedTable& QualifiedTable::schema(const Schema& schema)
@@ -32,7 +32,7 @@ Schema::~Schema() = default;
 
 Schema::Schema(const UnsafeStringView& name)
 {
-    syntax().name = name;
+    syntax().name = StringView::makeInterned(name);
 }
 
 Schema Schema::main()
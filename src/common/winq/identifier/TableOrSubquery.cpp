@@ -31,7 +31,7 @@ TableOrSubquery::TableOrSubquery() = default;
 TableOrSubquery::TableOrSubquery(const UnsafeStringView& table)
 {
     syntax().switcher = SyntaxType::Switch::Table;
-    syntax().tableOrFunction = table;
+    syntax().tableOrFunction = StringView::makeInterned(table);
 }
 
 TableOrSubquery::~TableOrSubquery() = default;
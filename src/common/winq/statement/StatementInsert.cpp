@@ -44,7 +44,7 @@ StatementInsert& StatementInsert::recursive()
 
 StatementInsert& StatementInsert::insertIntoTable(const UnsafeStringView& table)
 {
-    syntax().table = table;
+    syntax().table = StringView::makeInterned(table);
     return *this;
 }
 
@@ -100,6 +100,18 @@ bool ColumnDef::isUnique() const
     return isUnique;
 }
 
+bool ColumnDef::isUnIndexed() const
+{
+    bool isUnIndexed = false;
+    for (const auto& constraint : constraints) {
+        if (constraint.switcher == ColumnConstraint::Switch::UnIndexed) {
+            isUnIndexed = true;
+            break;
+        }
+    }
+    return isUnIndexed;
+}
+
 } // namespace Syntax
 
 } // namespace WCDB
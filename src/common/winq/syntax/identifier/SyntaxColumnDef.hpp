@@ -54,6 +54,7 @@ public:
     bool isAutoIncrement() const;
     bool isPrimaryKey() const;
     bool isUnique() const;
+    bool isUnIndexed() const;
 };
 
 } // namespace Syntax
@@ -30,6 +30,11 @@ namespace WCDB {
 
 BaseOperation::~BaseOperation() = default;
 
+QueryResultCache* BaseOperation::getQueryResultCache()
+{
+    return nullptr;
+}
+
 void BaseOperation::assignErrorToDatabase(const Error& error)
 {
     auto database = getDatabaseHolder();
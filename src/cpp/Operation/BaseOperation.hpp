@@ -28,11 +28,15 @@
 
 namespace WCDB {
 
+class QueryResultCache;
+
 class WCDB_API BaseOperation {
 protected:
     virtual ~BaseOperation() = 0;
     virtual RecyclableHandle getHandleHolder(bool writeHint) = 0;
     virtual Recyclable<InnerDatabase *> getDatabaseHolder() = 0;
+    // Nullptr if the reads of this operation can not be served from the query result cache.
+    virtual QueryResultCache *getQueryResultCache();
     void assignErrorToDatabase(const Error &error);
 
     template<class StatementType>
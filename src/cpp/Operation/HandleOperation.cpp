@@ -28,6 +28,7 @@
 #include "Handle.hpp"
 #include "InnerHandle.hpp"
 #include "Notifier.hpp"
+#include "QueryResultCache.hpp"
 
 #define GetHandleOrReturnValue(writeHint, value)                               \
     RecyclableHandle handle = getHandleHolder(writeHint);                      \
@@ -243,18 +244,29 @@ OptionalMultiRows HandleOperation::selectAllRow(const ResultColumns &columns,
 OptionalValue HandleOperation::getValueFromStatement(const Statement &statement, int index)
 {
     OptionalValue result;
-    GetHandleOrReturnValue(false, result);
-    if (!handle->prepare(statement)) {
-        assignErrorToDatabase(handle->getError());
-        return result;
-    }
-    bool succeed = false;
-    if ((succeed = handle->step()) && !handle->done()) {
-        result = handle->getValue(index);
-    }
-    handle->finalize();
-    if (!succeed) {
-        assignErrorToDatabase(handle->getError());
+    OptionalMultiRows rows
+    = readRows(statement, StringView::formatted("Value%d", index), [&]() {
+          OptionalMultiRows rows;
+          GetHandleOrReturnValue(false, rows);
+          if (!handle->prepare(statement)) {
+              assignErrorToDatabase(handle->getError());
+              return rows;
+          }
+          bool succeed = false;
+          if ((succeed = handle->step())) {
+              rows = MultiRowsValue();
+              if (!handle->done()) {
+                  rows.value().push_back({ handle->getValue(index) });
+              }
+          }
+          handle->finalize();
+          if (!succeed) {
+              assignErrorToDatabase(handle->getError());
+          }
+          return rows;
+      });
+    if (rows.succeed() && !rows.value().empty()) {
+        result = rows.value().front().front();
     }
     return result;
 }
@@ -263,15 +275,26 @@ OptionalOneColumn
 HandleOperation::getOneColumnFromStatement(const Statement &statement, int index)
 {
     OptionalOneColumn result;
-    GetHandleOrReturnValue(false, result);
-    if (!handle->prepare(statement)) {
-        assignErrorToDatabase(handle->getError());
-        return result;
-    }
-    result = handle->getOneColumn(index);
-    handle->finalize();
-    if (!result.succeed()) {
-        assignErrorToDatabase(handle->getError());
+    OptionalMultiRows rows
+    = readRows(statement, StringView::formatted("Column%d", index), [&]() {
+          OptionalMultiRows rows;
+          GetHandleOrReturnValue(false, rows);
+          if (!handle->prepare(statement)) {
+              assignErrorToDatabase(handle->getError());
+              return rows;
+          }
+          OptionalOneColumn column = handle->getOneColumn(index);
+          handle->finalize();
+          if (column.succeed()) {
+              rows = MultiRowsValue({ std::move(column.value()) });
+          } else {
+              assignErrorToDatabase(handle->getError());
+          }
+          return rows;
+      });
+    if (rows.succeed()) {
+        WCTAssert(rows.value().size() == 1);
+        result = rows.value().front();
     }
     return result;
 }
@@ -279,36 +302,82 @@ HandleOperation::getOneColumnFromStatement(const Statement &statement, int index
 OptionalOneRow HandleOperation::getOneRowFromStatement(const Statement &statement)
 {
     OptionalOneRow result;
-    GetHandleOrReturnValue(false, result);
-    if (!handle->prepare(statement)) {
-        assignErrorToDatabase(handle->getError());
-        return result;
-    }
-    bool succeed = false;
-    if ((succeed = handle->step()) && !handle->done()) {
-        result = handle->getOneRow();
-    }
-    handle->finalize();
-    if (!succeed) {
-        assignErrorToDatabase(handle->getError());
+    OptionalMultiRows rows = readRows(statement, "Row", [&]() {
+        OptionalMultiRows rows;
+        GetHandleOrReturnValue(false, rows);
+        if (!handle->prepare(statement)) {
+            assignErrorToDatabase(handle->getError());
+            return rows;
+        }
+        bool succeed = false;
+        if ((succeed = handle->step())) {
+            rows = MultiRowsValue();
+            if (!handle->done()) {
+                rows.value().push_back(handle->getOneRow());
+            }
+        }
+        handle->finalize();
+        if (!succeed) {
+            assignErrorToDatabase(handle->getError());
+        }
+        return rows;
+    });
+    if (rows.succeed() && !rows.value().empty()) {
+        result = rows.value().front();
     }
     return result;
 }
 
 OptionalMultiRows HandleOperation::getAllRowsFromStatement(const Statement &statement)
 {
-    OptionalMultiRows result;
-    GetHandleOrReturnValue(false, result);
-    if (!handle->prepare(statement)) {
-        assignErrorToDatabase(handle->getError());
+    return readRows(statement, "Rows", [&]() {
+        OptionalMultiRows result;
+        GetHandleOrReturnValue(false, result);
+        if (!handle->prepare(statement)) {
+            assignErrorToDatabase(handle->getError());
+            return result;
+        }
+        result = handle->getAllRows();
+        handle->finalize();
+        if (!result.succeed()) {
+            assignErrorToDatabase(handle->getError());
+        }
         return result;
+    });
+}
+
+OptionalMultiRows HandleOperation::readRows(const Statement &statement,
+                                            const UnsafeStringView &resultKind,
+                                            const RowsReader &reader)
+{
+    QueryResultCache *cache = getQueryResultCache();
+    if (cache == nullptr) {
+        return reader();
     }
-    result = handle->getAllRows();
-    handle->finalize();
-    if (!result.succeed()) {
-        assignErrorToDatabase(handle->getError());
+    auto tables = QueryResultCache::getReadTables(statement);
+    if (!tables.succeed()) {
+        return reader();
     }
-    return result;
+    StringView key = StringView::formatted(
+    "%s:%s", resultKind.data(), statement.getDescription().data());
+    OptionalMultiRows rows = cache->get(key);
+    if (rows.succeed()) {
+        return rows;
+    }
+    QueryResultCache::Epoch epoch = cache->getEpoch();
+    if (!cache->isSchemaChecked()) {
+        GetHandleOrReturnValue(false, reader());
+        auto viewsOrTriggers
+        = handle->getValues(QueryResultCache::getStatementForCheckingSchema(), 0);
+        if (viewsOrTriggers.succeed()) {
+            cache->setSchemaChecked(!viewsOrTriggers.value().empty(), epoch);
+        }
+    }
+    rows = reader();
+    if (rows.succeed()) {
+        cache->put(key, tables.value(), rows.value(), epoch);
+    }
+    return rows;
 }
 
 bool HandleOperation::execute(const Statement &statement)
@@ -235,6 +235,14 @@ protected:
     void notifyError(Error &error);
     void assertCondition(bool condition);
     virtual ~HandleOperation() override = 0;
+
+#pragma mark - Query Result Cache
+private:
+    typedef std::function<OptionalMultiRows()> RowsReader;
+    // Read from the query result cache first if it's available.
+    OptionalMultiRows readRows(const Statement &statement,
+                               const UnsafeStringView &resultKind,
+                               const RowsReader &reader);
 };
 
 } //namespace WCDB
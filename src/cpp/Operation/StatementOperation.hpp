@@ -264,8 +264,19 @@ public:
     template<class ObjectType>
     ObjectType extractOneObject(const ResultFields& resultFields)
     {
-        WCDB_CPP_ORM_STATIC_ASSERT_FOR_OBJECT_TYPE
         ObjectType obj;
+        extractOneObject(obj, resultFields);
+        return obj;
+    }
+
+    /**
+     @brief Extract the values of the current row and assign them into the fields specified by resultFields of an existing object.
+     @note  The fields not specified by resultFields will not be changed.
+     */
+    template<class ObjectType>
+    void extractOneObject(ObjectType& obj, const ResultFields& resultFields)
+    {
+        WCDB_CPP_ORM_STATIC_ASSERT_FOR_OBJECT_TYPE
         int index = 0;
         for (const ResultField& field : resultFields) {
             const BaseAccessor* accessor = field.getAccessor();
@@ -313,7 +324,6 @@ public:
             }
             index++;
         }
-        return obj;
     }
 
     /**
@@ -72,16 +72,23 @@ public:
      @brief The statement that `ChainCall` will execute.
      You can customize this statement directly to implement the capabilities not provided by `ChainCall`.
      */
-    StatementType &getStatement() { return m_statement; }
+    StatementType &getStatement()
+    {
+        m_customized = true;
+        return m_statement;
+    }
 
 protected:
     ChainCall(Recyclable<InnerDatabase *> databaseHolder)
-    : BaseChainCall(databaseHolder)
+    : BaseChainCall(databaseHolder), m_customized(false)
     {
     }
     virtual ~ChainCall() override = default;
 
     StatementType m_statement;
+    // The statement is customized with the clauses other than the table and the conflict action,
+    // so that the canonical statement of ORM can not be used instead.
+    bool m_customized;
 };
 
 } //namespace WCDB
@@ -0,0 +1,251 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Handle.hpp"
+#include "MultiObject.hpp"
+#include "WCDBError.hpp"
+#include <iterator>
+
+namespace WCDB {
+
+/**
+ A cursor steps the select statement lazily and extracts objects on demand, so that the memory it takes is independent of the number of the results.
+ The handle it holds will be released when all the results are iterated or the cursor is closed or destroyed.
+
+     for (const auto& object : table.prepareSelect().where(...).cursor()) {
+         ...
+     }
+ 
+ @warning The chain call creating this cursor should not be used until the cursor is released.
+ */
+template<class ObjectType>
+class Cursor final {
+    template<class>
+    friend class Select;
+    friend class MultiSelect;
+
+public:
+    Cursor(Cursor&& other)
+    : m_handle(std::move(other.m_handle))
+    , m_fields(std::move(other.m_fields))
+    , m_error(std::move(other.m_error))
+    , m_objects(std::move(other.m_objects))
+    , m_objectCount(other.m_objectCount)
+    , m_objectIndex(other.m_objectIndex)
+    , m_prefetchCount(other.m_prefetchCount)
+    , m_reuseObject(other.m_reuseObject)
+    {
+        other.m_handle = nullptr;
+        other.m_objectCount = 0;
+        other.m_objectIndex = 0;
+    }
+    Cursor(const Cursor&) = delete;
+    Cursor& operator=(const Cursor&) = delete;
+
+    ~Cursor() { close(); }
+
+    /**
+     @brief Extract the values of each row into the same object, instead of a new one.
+     @note  The fields that are not selected will keep the values of the previous row.
+     @return this
+     */
+    Cursor& reuseObject(bool reuse = true)
+    {
+        m_reuseObject = reuse;
+        return *this;
+    }
+
+    /**
+     @brief Step and extract at most `count` rows each time the prefetched objects are exhausted.
+     @warning The prefetched objects take memory in proportion to the `count`.
+     @return this
+     */
+    Cursor& prefetch(size_t count)
+    {
+        m_prefetchCount = std::max<size_t>(count, 1);
+        return *this;
+    }
+
+    /**
+     @brief Get the next object.
+     @return The pointer to the next object, which is valid until the next call. Null if all the results are iterated or an error occurs.
+     */
+    ObjectType* nextObject()
+    {
+        if (m_objectIndex >= m_objectCount && !fetch()) {
+            return nullptr;
+        }
+        return &m_objects[m_objectIndex++];
+    }
+
+    /**
+     @brief Get at most `count` objects in next rows.
+     @return An empty array if all the results are iterated. Null if an error occurs.
+     */
+    OptionalValueArray<ObjectType> nextObjects(size_t count)
+    {
+        ValueArray<ObjectType> objects;
+        while (objects.size() < count) {
+            ObjectType* object = nextObject();
+            if (object == nullptr) {
+                break;
+            }
+            objects.push_back(std::move(*object));
+        }
+        if (failed()) {
+            return NullOpt;
+        }
+        return objects;
+    }
+
+    /**
+     @brief Finalize the statement and release the handle.
+     It will be called automatically when all the results are iterated or the cursor is destroyed.
+     */
+    void close()
+    {
+        if (m_handle != nullptr) {
+            m_handle->finalize();
+            m_handle->invalidate();
+            m_handle = nullptr;
+        }
+    }
+
+    bool isClosed() const { return m_handle == nullptr; }
+
+    /**
+     @brief Check whether an error occurs while stepping.
+     */
+    bool failed() const { return !m_error.isOK(); }
+
+    /**
+     @brief The error generated while preparing or stepping.
+     */
+    const Error& getError() const { return m_error; }
+
+    class Iterator final {
+        friend class Cursor;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ObjectType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ObjectType*;
+        using reference = ObjectType&;
+
+        ObjectType& operator*() const { return *m_object; }
+        ObjectType* operator->() const { return m_object; }
+        Iterator& operator++()
+        {
+            m_object = m_cursor->nextObject();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const
+        {
+            return m_object == other.m_object;
+        }
+        bool operator!=(const Iterator& other) const
+        {
+            return m_object != other.m_object;
+        }
+
+    private:
+        Iterator(Cursor* cursor, ObjectType* object)
+        : m_cursor(cursor), m_object(object)
+        {
+        }
+        Cursor* m_cursor;
+        ObjectType* m_object;
+    };
+
+    /**
+     @brief The iterator of the next object. Since the cursor can only be iterated once, it should be called once.
+     */
+    Iterator begin() { return Iterator(this, nextObject()); }
+    Iterator end() { return Iterator(this, nullptr); }
+
+private:
+    Cursor(const std::shared_ptr<Handle>& handle, const ResultFields& fields)
+    : m_handle(handle)
+    , m_fields(fields)
+    , m_objectCount(0)
+    , m_objectIndex(0)
+    , m_prefetchCount(1)
+    , m_reuseObject(false)
+    {
+        if (!m_handle->isPrepared()) {
+            m_error = m_handle->getError();
+            close();
+        }
+    }
+
+    bool fetch()
+    {
+        if (m_handle == nullptr) {
+            return false;
+        }
+        if (!m_reuseObject) {
+            m_objects.clear();
+        }
+        m_objectCount = 0;
+        m_objectIndex = 0;
+        while (m_objectCount < m_prefetchCount) {
+            if (!m_handle->step()) {
+                m_error = m_handle->getError();
+                close();
+                break;
+            }
+            if (m_handle->done()) {
+                close();
+                break;
+            }
+            if (m_objectCount >= m_objects.size()) {
+                m_objects.emplace_back();
+            }
+            extractObject(m_objects[m_objectCount++]);
+        }
+        return m_objectCount > 0;
+    }
+
+    void extractObject(ObjectType& object)
+    {
+        m_handle->extractOneObject(object, m_fields);
+    }
+
+    std::shared_ptr<Handle> m_handle;
+    ResultFields m_fields;
+    Error m_error;
+    // Objects are reused in place if needed.
+    ValueArray<ObjectType> m_objects;
+    size_t m_objectCount;
+    size_t m_objectIndex;
+    size_t m_prefetchCount;
+    bool m_reuseObject;
+};
+
+template<>
+inline void Cursor<MultiObject>::extractObject(MultiObject& object)
+{
+    object = m_handle->extractOneMultiObject(m_fields);
+}
+
+} //namespace WCDB
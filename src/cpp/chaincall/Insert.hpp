@@ -27,7 +27,9 @@
 #include "CPPORM.h"
 #include "CaseInsensitiveList.hpp"
 #include "ChainCall.hpp"
+#include "PreTokenizedDocuments.hpp"
 #include "ValueArray.hpp"
+#include <algorithm>
 #include <assert.h>
 #include <memory>
 #include <stdlib.h>
@@ -84,6 +86,7 @@ public:
     {
         m_fields = fields;
         m_statement.columns(fields).values(BindParameter::bindParameters(fields.size()));
+        m_customized = true;
         return *this;
     }
 
@@ -139,6 +142,21 @@ public:
         return *this;
     }
 
+    /**
+     @brief Tokenize the text fields of objects on a worker pool before inserting them into an fts5 table,
+            so that the tokens are only replayed while the table is locked for writing.
+            It only takes effect on the fts5 table whose tokenizer is implemented with `WCDB::FTS5TokenizerModuleTemplate`.
+     @warning The symbol detector, unicode normalizer and converters configured for WCDB implemented tokenizers will be called concurrently.
+     @param parallelism The maximum number of threads used for tokenization. 0 means the number of cpu cores.
+     @return this
+     */
+    Insert<ObjectType>& preTokenize(int parallelism = 0)
+    {
+        m_preTokenize = true;
+        m_parallelism = parallelism;
+        return *this;
+    }
+
     /**
      @brief Execute the insert statement.
             Note that it will run embedded transaction while values.count>1 .
@@ -153,6 +171,11 @@ public:
             if (!checkHandle(true)) {
                 return false;
             }
+            PreTokenizedDocuments documents;
+            std::unique_ptr<PreTokenizedDocuments::ReplayScope> replayScope;
+            if (m_preTokenize && preTokenizeObjects(documents)) {
+                replayScope.reset(new PreTokenizedDocuments::ReplayScope(documents));
+            }
             if (count > 1) {
                 succeed = m_handle->runTransaction([&](Handle& handle) {
                     WCDB_UNUSED(handle);
@@ -169,7 +192,11 @@ public:
 
 protected:
     Insert(Recyclable<InnerDatabase*> databaseHolder)
-    : ChainCall(databaseHolder), m_valueType(ValueType::Invalid), m_obj(nullptr)
+    : ChainCall(databaseHolder)
+    , m_preTokenize(false)
+    , m_parallelism(0)
+    , m_valueType(ValueType::Invalid)
+    , m_obj(nullptr)
     {
     }
 
@@ -179,29 +206,78 @@ private:
         if (m_fields.size() == 0) {
             m_fields = ObjectType::allFields();
         }
-        if (m_statement.syntax().columns.empty()) {
+        // The statement might be changed since the last execution.
+        m_canonicalStatement = nullptr;
+        const Syntax::InsertSTMT& syntax = m_statement.syntax();
+        if (!m_customized && syntax.columns.empty()) {
+            const Binding& binding = ObjectType::getObjectRelationBinding();
+            if (syntax.conflictActionValid()) {
+                m_canonicalStatement
+                = binding.getInsertAllStatement(syntax.table, syntax.conflictAction);
+            } else {
+                m_canonicalStatement = binding.getInsertAllStatement(syntax.table);
+            }
+        } else if (syntax.columns.empty()) {
             m_statement.columns(m_fields).values(
             BindParameter::bindParameters(m_fields.size()));
         }
+        const StatementInsert& statement = getStatementToExecute();
         std::vector<bool> autoIncrementsOfDefinitions;
-        if (!m_statement.syntax().conflictActionValid()) {
+        // Index of the field that is the alias of rowid.
+        int rowidField = -1;
+        if (!statement.syntax().conflictActionValid()) {
             for (const Field& field : m_fields) {
                 // auto increment?
-                const ColumnDef* def
-                = field.syntax().getTableBinding()->getColumnDef(field.syntax().name);
+                const BaseBinding* binding = field.syntax().getTableBinding();
+                const ColumnDef* def = binding->getColumnDef(field.syntax().name);
                 if (def == nullptr) {
                     assertError("Related columndef is not found.");
                     return false;
                 }
+                if (def == binding->getRowidAliasColumnDef()) {
+                    rowidField = (int) autoIncrementsOfDefinitions.size();
+                }
                 autoIncrementsOfDefinitions.push_back(def->syntax().isAutoIncrement());
             }
         }
+        size_t count = getObjectCount();
+        size_t index = 0;
+        size_t batchCount = getBatchCount();
+        if (batchCount > 1 && count >= batchCount) {
+            bool prepared = false;
+            if (m_canonicalStatement != nullptr) {
+                prepared = m_handle->prepare(
+                *ObjectType::getObjectRelationBinding().getBatchInsertAllStatement(
+                statement.syntax().table, batchCount));
+            } else {
+                prepared = m_handle->prepare(generateBatchStatement(batchCount));
+            }
+            if (!prepared) {
+                return false;
+            }
+            bool succeed = true;
+            while (index + batchCount <= count
+                   && isRowIDAssignedAutomatically(
+                   index, batchCount, autoIncrementsOfDefinitions, rowidField)) {
+                succeed = stepObjects(index, batchCount, autoIncrementsOfDefinitions);
+                if (!succeed) {
+                    break;
+                }
+                index += batchCount;
+            }
+            m_handle->finalize();
+            if (!succeed) {
+                return false;
+            }
+        }
+        if (index == count) {
+            return true;
+        }
         bool succeed = false;
-        if (m_handle->prepare(m_statement)) {
+        if (m_handle->prepare(statement)) {
             succeed = true;
-            size_t count = getObjectCount();
-            for (size_t i = 0; i < count; i++) {
-                const ObjectType& obj = getObjectAtIndex(i);
+            for (; index < count; index++) {
+                const ObjectType& obj = getObjectAtIndex(index);
                 succeed = stepOneObject(obj, autoIncrementsOfDefinitions);
                 if (!(succeed)) {
                     break;
@@ -215,21 +291,168 @@ private:
     bool stepOneObject(const ObjectType& obj, const std::vector<bool>& autoIncrementsOfDefinitions)
     {
         m_handle->reset();
-        int index = 1;
-        assert(!obj.isAutoIncrement || !m_statement.syntax().conflictActionValid());
+        bindOneObject(obj, autoIncrementsOfDefinitions, 0);
+        if (!m_handle->step()) {
+            return false;
+        }
+        *obj.lastInsertedRowID = m_handle->getLastInsertedRowID();
+        return true;
+    }
+
+    void bindOneObject(const ObjectType& obj,
+                       const std::vector<bool>& autoIncrementsOfDefinitions,
+                       int bindIndexOffset)
+    {
+        int index = 0;
+        assert(!obj.isAutoIncrement || !getStatementSyntax().conflictActionValid());
         for (const Field& field : m_fields) {
             if (autoIncrementsOfDefinitions.empty()
-                || !autoIncrementsOfDefinitions[index - 1] || !obj.isAutoIncrement) {
-                m_handle->bindObject(obj, field, index);
+                || !autoIncrementsOfDefinitions[index] || !obj.isAutoIncrement) {
+                m_handle->bindObject(obj, field, bindIndexOffset + index + 1);
             } else {
-                m_handle->bindNull(index);
+                m_handle->bindNull(bindIndexOffset + index + 1);
             }
             ++index;
         }
+    }
+
+    const Syntax::InsertSTMT& getStatementSyntax() const
+    {
+        return getStatementToExecute().syntax();
+    }
+
+    const StatementInsert& getStatementToExecute() const
+    {
+        if (m_canonicalStatement != nullptr) {
+            return *m_canonicalStatement;
+        }
+        return m_statement;
+    }
+
+#pragma mark - Pre-tokenize
+    bool preTokenizeObjects(PreTokenizedDocuments& documents)
+    {
+        StringView tokenizer = PreTokenizedDocuments::getFTS5Tokenizer(
+        ObjectType::getObjectRelationBinding().statementVirtualTable);
+        if (tokenizer.empty()) {
+            return false;
+        }
+        const Fields& fields = m_fields.size() > 0 ? m_fields : ObjectType::allFields();
+        Fields textFields;
+        for (const Field& field : fields) {
+            const ColumnDef* def
+            = field.syntax().getTableBinding()->getColumnDef(field.syntax().name);
+            if (def != nullptr && def->syntax().columnType == ColumnType::Text
+                && !def->syntax().isUnIndexed()) {
+                textFields.push_back(field);
+            }
+        }
+        if (textFields.empty()) {
+            return false;
+        }
+        // Documents are collected in the order that fts5 tokenizes them.
+        size_t count = getObjectCount();
+        std::vector<StringView> texts;
+        texts.reserve(count * textFields.size());
+        for (size_t i = 0; i < count; i++) {
+            const ObjectType& obj = getObjectAtIndex(i);
+            for (const Field& field : textFields) {
+                Value value = field.getValue(obj);
+                if (value.getType() == ColumnType::Text) {
+                    texts.push_back(value.textValue());
+                }
+            }
+        }
+        return documents.tokenize(tokenizer, std::move(texts), m_parallelism);
+    }
+
+#pragma mark - Batch
+    /*
+     Objects are inserted by INSERT INTO table(...) VALUES(?1, ?2), (?3, ?4), ... in batch,
+     which saves the cost of step and decoration for each object.
+     The statements with conflict action are not batched,
+     since the rowids of the objects can not be known after some of them are ignored or replaced.
+     */
+    // Default SQLITE_MAX_VARIABLE_NUMBER of old versions of SQLite.
+    static constexpr const size_t MaxBatchBindParameterCount = 999;
+    static constexpr const size_t MaxBatchObjectCount = 100;
+
+    size_t getBatchCount() const
+    {
+        const Syntax::InsertSTMT& syntax = getStatementToExecute().syntax();
+        if (syntax.conflictActionValid() || syntax.upsertClause.hasValue()
+            || !syntax.commonTableExpressions.empty()
+            || syntax.switcher != Syntax::InsertSTMT::Switch::Values
+            || syntax.expressionsValues.size() != 1) {
+            return 1;
+        }
+        // Only the statement with ?1, ?2, ... can be extended.
+        const auto& values = syntax.expressionsValues.front();
+        if (m_fields.size() == 0 || values.size() != m_fields.size()) {
+            return 1;
+        }
+        int index = 0;
+        for (const auto& value : values) {
+            if (value.switcher != Syntax::Expression::Switch::BindParameter
+                || value.bindParameter().switcher != Syntax::BindParameter::Switch::QuestionSign
+                || value.bindParameter().n != ++index) {
+                return 1;
+            }
+        }
+        return std::min(MaxBatchObjectCount, MaxBatchBindParameterCount / m_fields.size());
+    }
+
+    StatementInsert generateBatchStatement(size_t batchCount) const
+    {
+        StatementInsert statement = m_statement;
+        int index = (int) m_fields.size();
+        for (size_t i = 1; i < batchCount; i++) {
+            Expressions values;
+            for (size_t j = 0; j < m_fields.size(); j++) {
+                values.push_back(BindParameter(++index));
+            }
+            statement.values(values);
+        }
+        return statement;
+    }
+
+    // The rowids assigned automatically in a statement are continuous.
+    bool isRowIDAssignedAutomatically(size_t begin,
+                                      size_t objectCount,
+                                      const std::vector<bool>& autoIncrementsOfDefinitions,
+                                      int rowidField)
+    {
+        if (rowidField < 0) {
+            return true;
+        }
+        if (!autoIncrementsOfDefinitions[rowidField]) {
+            return false;
+        }
+        for (size_t i = begin; i < begin + objectCount; i++) {
+            if (!getObjectAtIndex(i).isAutoIncrement) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool stepObjects(size_t begin,
+                     size_t objectCount,
+                     const std::vector<bool>& autoIncrementsOfDefinitions)
+    {
+        m_handle->reset();
+        int bindIndexOffset = 0;
+        for (size_t i = begin; i < begin + objectCount; i++) {
+            bindOneObject(getObjectAtIndex(i), autoIncrementsOfDefinitions, bindIndexOffset);
+            bindIndexOffset += (int) m_fields.size();
+        }
         if (!m_handle->step()) {
             return false;
         }
-        *obj.lastInsertedRowID = m_handle->getLastInsertedRowID();
+        int64_t rowid = m_handle->getLastInsertedRowID() - (int64_t) objectCount;
+        for (size_t i = begin; i < begin + objectCount; i++) {
+            *getObjectAtIndex(i).lastInsertedRowID = ++rowid;
+        }
         return true;
     }
 
@@ -266,6 +489,10 @@ private:
     }
 
     Fields m_fields;
+    // Shared by all the inserts of all fields into the same table.
+    std::shared_ptr<const StatementInsert> m_canonicalStatement;
+    bool m_preTokenize;
+    int m_parallelism;
 
     enum class ValueType : signed char {
         Invalid = 0,
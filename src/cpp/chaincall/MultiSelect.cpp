@@ -117,4 +117,13 @@ OptionalMultiObjectArray MultiSelect::allMultiObjects()
     return objects;
 }
 
+Cursor<MultiObject> MultiSelect::cursor()
+{
+    WCTRemedialAssert(m_fields.size() != 0,
+                      "Result columns can't be empty.",
+                      return Cursor<MultiObject>(m_handle, m_fields););
+    saveChangesAndError(prepareStatement());
+    return Cursor<MultiObject>(m_handle, m_fields);
+}
+
 } //namespace WCDB
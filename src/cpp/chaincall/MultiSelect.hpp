@@ -25,6 +25,7 @@
 #pragma once
 
 #include "ChainCall.hpp"
+#include "Cursor.hpp"
 #include "MultiObject.hpp"
 
 namespace WCDB {
@@ -98,6 +99,12 @@ public:
      */
     OptionalMultiObjectArray allMultiObjects();
 
+    /**
+     @brief Get a cursor to iterate the selected objects one by one, without extracting all of them in memory.
+     @see   `WCDB::Cursor`
+     */
+    Cursor<MultiObject> cursor();
+
 protected:
     MultiSelect(Recyclable<InnerDatabase *> databaseHolder);
 
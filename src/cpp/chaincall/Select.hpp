@@ -26,6 +26,7 @@
 
 #include "CPPORM.h"
 #include "ChainCall.hpp"
+#include "Cursor.hpp"
 
 namespace WCDB {
 
@@ -47,6 +48,7 @@ public:
     Select<ObjectType> &where(const Expression &condition)
     {
         m_statement.where(condition);
+        m_customized = true;
         return *this;
     }
 
@@ -58,6 +60,7 @@ public:
     Select<ObjectType> &orders(const OrderingTerms &orders)
     {
         m_statement.orders(orders);
+        m_customized = true;
         return *this;
     }
 
@@ -69,6 +72,7 @@ public:
     Select<ObjectType> &limit(const Expression &limit)
     {
         m_statement.limit(limit);
+        m_customized = true;
         return *this;
     }
 
@@ -80,6 +84,7 @@ public:
     Select<ObjectType> &offset(const Expression &offset)
     {
         m_statement.offset(offset);
+        m_customized = true;
         return *this;
     }
 
@@ -91,6 +96,7 @@ public:
     Select<ObjectType> &fromTable(const UnsafeStringView &tableName)
     {
         m_statement.from(tableName);
+        m_table = tableName;
         return *this;
     }
 
@@ -103,6 +109,7 @@ public:
     {
         m_fields = resultFields;
         m_statement.select(resultFields);
+        m_customized = true;
         return *this;
     }
 
@@ -140,6 +147,16 @@ public:
         return object;
     }
 
+    /**
+     @brief Get a cursor to iterate the selected objects one by one, without extracting all of them in memory.
+     @see   `WCDB::Cursor`
+     */
+    Cursor<ObjectType> cursor()
+    {
+        saveChangesAndError(prepareStatement());
+        return Cursor<ObjectType>(m_handle, m_fields);
+    }
+
 protected:
     Select(Recyclable<InnerDatabase *> databaseHolder)
     : ChainCall(databaseHolder)
@@ -155,11 +172,15 @@ private:
         if (m_fields.size() == 0) {
             m_fields = ObjectType::allFields();
         }
+        const Binding &binding = ObjectType::getObjectRelationBinding();
+        if (!m_customized && !m_table.empty()) {
+            m_canonicalStatement = binding.getSelectAllStatement(m_table);
+            return m_handle->prepare(*m_canonicalStatement);
+        }
         if (m_statement.syntax().select.getOrCreate().resultColumns.size() == 0) {
             m_statement.select(m_fields);
         }
         if (m_statement.syntax().orderingTerms.empty()) {
-            const Binding &binding = ObjectType::getObjectRelationBinding();
             const StatementCreateTable &statement = binding.statementTable;
             if (!statement.syntax().withoutRowid) {
                 m_statement.order(OrderingTerm::ascendingRowid());
@@ -168,6 +189,9 @@ private:
         return m_handle->prepare(m_statement);
     }
     ResultFields m_fields;
+    StringView m_table;
+    // Shared by all the selections of all fields from the same table.
+    std::shared_ptr<const StatementSelect> m_canonicalStatement;
 };
 
 } //namespace WCDB
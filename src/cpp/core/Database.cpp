@@ -33,6 +33,7 @@
 #include "FileManager.hpp"
 #include "Global.hpp"
 #include "InnerDatabase.hpp"
+#include "MemoryGovernor.hpp"
 #include "Path.hpp"
 #include "WCDBVersion.h"
 
@@ -84,6 +85,15 @@ Recyclable<InnerDatabase*> Database::getDatabaseHolder()
     return m_databaseHolder;
 }
 
+QueryResultCache* Database::getQueryResultCache()
+{
+    // Reads within a transaction may see its uncommitted modifications.
+    if (m_innerDatabase->isInTransaction()) {
+        return nullptr;
+    }
+    return m_innerDatabase->getQueryResultCache();
+}
+
 void Database::setTag(const long& tag)
 {
     m_innerDatabase->setTag(tag);
@@ -156,6 +166,24 @@ void Database::enableAutoCheckpoint(bool enable)
     CommonCore::shared().enableAutoCheckpoint(m_innerDatabase, enable);
 }
 
+#pragma mark - Query Result Cache
+
+void Database::setQueryResultCacheSize(size_t size)
+{
+    m_innerDatabase->setQueryResultCacheSize(size);
+}
+
+Database::QueryResultCacheStatistics Database::getQueryResultCacheStatistics() const
+{
+    auto statistics = m_innerDatabase->getQueryResultCacheStatistics();
+    QueryResultCacheStatistics result;
+    result.hitCount = statistics.hitCount;
+    result.missCount = statistics.missCount;
+    result.invalidationCount = statistics.invalidationCount;
+    result.cachedSize = statistics.cachedSize;
+    return result;
+}
+
 #pragma mark - Vacuum
 
 bool Database::vacuum(ProgressUpdateCallback onProgressUpdated)
@@ -182,14 +210,14 @@ void Database::setUIThreadId(std::thread::id uiThreadId)
 
 #pragma mark - Monitor
 
-void Database::globalTraceError(Database::ErrorNotification trace)
+void Database::globalTraceError(Database::ErrorNotification trace, Error::Level minimalLevel)
 {
-    CommonCore::shared().setNotificationWhenErrorTraced(trace);
+    CommonCore::shared().setNotificationWhenErrorTraced(trace, minimalLevel);
 }
 
-void Database::traceError(ErrorNotification trace)
+void Database::traceError(ErrorNotification trace, Error::Level minimalLevel)
 {
-    CommonCore::shared().setNotificationWhenErrorTraced(getPath(), trace);
+    CommonCore::shared().setNotificationWhenErrorTraced(getPath(), trace, minimalLevel);
 }
 
 static_assert(sizeof(Database::PerformanceInfo) == sizeof(InnerHandle::PerformanceInfo), "");
@@ -304,6 +332,70 @@ void Database::globalTraceBusy(BusyTrace trace, double timeOut)
     CommonCore::shared().setBusyMonitor(trace, timeOut);
 }
 
+void Database::globalEnableLockProfiler(bool enable)
+{
+    CommonCore::shared().setLockProfilerEnabled(enable);
+}
+
+static Database::LockDurationHistogram
+convertLockDurationHistogram(const LockProfiler::Histogram& histogram)
+{
+    Database::LockDurationHistogram result;
+    result.count = histogram.count;
+    result.totalSeconds = histogram.totalSeconds;
+    result.maxSeconds = histogram.maxSeconds;
+    result.buckets.assign(histogram.buckets.begin(), histogram.buckets.end());
+    return result;
+}
+
+static std::vector<Database::LockStatistics>
+convertLockStatistics(const LockProfiler::LockStatisticsArray& statisticsArray)
+{
+    std::vector<Database::LockStatistics> result;
+    for (size_t i = 0; i < statisticsArray.size(); ++i) {
+        const auto& statistics = statisticsArray[i];
+        if (statistics.wait.count == 0 && statistics.hold.count == 0) {
+            continue;
+        }
+        Database::LockStatistics converted;
+        converted.type = (Database::LockType) i;
+        converted.wait = convertLockDurationHistogram(statistics.wait);
+        converted.hold = convertLockDurationHistogram(statistics.hold);
+        result.push_back(std::move(converted));
+    }
+    return result;
+}
+
+Database::LockProfile Database::getGlobalLockProfile(int numberOfTopBlockers)
+{
+    auto profile = CommonCore::shared().getLockProfile(
+    numberOfTopBlockers > 0 ? (size_t) numberOfTopBlockers : 0);
+    LockProfile result;
+    for (const auto& iter : profile.paths) {
+        result.paths.emplace(iter.first, convertLockStatistics(iter.second));
+    }
+    for (const auto& iter : profile.threads) {
+        result.threads.emplace(iter.first, convertLockStatistics(iter.second));
+    }
+    for (const auto& blocker : profile.topBlockers) {
+        LockBlocker converted;
+        converted.path = blocker.path;
+        converted.sql = blocker.sql;
+        converted.type = (LockType) blocker.lockType;
+        converted.tid = blocker.tid;
+        converted.count = blocker.count;
+        converted.totalWaitSeconds = blocker.totalWaitSeconds;
+        converted.maxWaitSeconds = blocker.maxWaitSeconds;
+        result.topBlockers.push_back(converted);
+    }
+    return result;
+}
+
+void Database::resetGlobalLockProfile()
+{
+    CommonCore::shared().resetLockProfile();
+}
+
 #pragma mark - File
 
 bool Database::removeFiles()
@@ -388,11 +480,103 @@ void Database::purge()
     m_innerDatabase->purge();
 }
 
+void Database::setIdleHandleTimeout(double seconds)
+{
+    m_innerDatabase->setIdleHandleTimeout(seconds);
+}
+
+void Database::setMinNumberOfHandles(size_t number)
+{
+    m_innerDatabase->setMinNumberOfHandles(number);
+}
+
+bool Database::reapIdleHandles()
+{
+    return m_innerDatabase->reapIdleHandles();
+}
+
+Database::HandlePoolStatistics Database::getHandlePoolStatistics() const
+{
+    auto statistics = m_innerDatabase->getStatistics();
+    HandlePoolStatistics result;
+    result.numberOfAliveHandles = statistics.numberOfAliveHandles;
+    result.numberOfIdleHandles = statistics.numberOfIdleHandles;
+    result.targetNumberOfHandles = statistics.targetNumberOfHandles;
+    result.averageAcquireTimeInNanoseconds = statistics.averageAcquireTimeInNanoseconds;
+    result.numberOfCreationsInLastMinute = statistics.numberOfCreationsInLastMinute;
+    return result;
+}
+
 void Database::purgeAll()
 {
     CommonCore::shared().purgeDatabasePool();
 }
 
+void Database::setIdleDatabaseTTL(double seconds)
+{
+    CommonCore::shared().setIdleDatabaseTTL(seconds);
+}
+
+bool Database::evictIdleDatabases()
+{
+    return CommonCore::shared().evictIdleDatabases();
+}
+
+std::vector<Database::DatabasePoolShardStatistics> Database::getDatabasePoolStatistics()
+{
+    std::vector<DatabasePoolShardStatistics> result;
+    for (const auto& statistics : CommonCore::shared().getDatabasePoolStatistics()) {
+        DatabasePoolShardStatistics shardStatistics;
+        shardStatistics.numberOfActiveDatabases = statistics.numberOfActiveDatabases;
+        shardStatistics.numberOfIdleDatabases = statistics.numberOfIdleDatabases;
+        shardStatistics.numberOfEvictedDatabases = statistics.numberOfEvictedDatabases;
+        result.push_back(shardStatistics);
+    }
+    return result;
+}
+
+void Database::setMemoryQuota(size_t quota)
+{
+    CommonCore::shared().setMemoryQuota(getPath(), quota);
+}
+
+void Database::setGlobalMemoryQuota(size_t quota)
+{
+    CommonCore::shared().setMemoryQuota(UnsafeStringView(), quota);
+}
+
+void Database::relieveMemory()
+{
+    CommonCore::shared().relieveMemory(getPath());
+}
+
+static Database::MemoryUsage
+getMemoryUsageOfPath(const UnsafeStringView& path, Database::MemoryComponent component)
+{
+    static_assert((int) Database::MemoryComponent::ZSTDContext
+                  == (int) MemoryGovernor::Component::ZSTDContext,
+                  "");
+    static_assert((int) Database::MemoryComponent::Total == MemoryGovernor::ComponentCount, "");
+    CommonCore& core = CommonCore::shared();
+    MemoryGovernor::Usage usage;
+    if (component == Database::MemoryComponent::Total) {
+        usage = core.getTotalMemoryUsage(path);
+    } else {
+        usage = core.getMemoryUsage(path, (MemoryGovernor::Component) component);
+    }
+    return { usage.current, usage.highWater };
+}
+
+Database::MemoryUsage Database::getMemoryUsage(MemoryComponent component) const
+{
+    return getMemoryUsageOfPath(getPath(), component);
+}
+
+Database::MemoryUsage Database::getGlobalMemoryUsage(MemoryComponent component)
+{
+    return getMemoryUsageOfPath(UnsafeStringView(), component);
+}
+
 #pragma mark - Repair
 
 void Database::setNotificationWhenCorrupted(Database::CorruptionNotification onCorrupted)
@@ -430,6 +614,29 @@ void Database::filterBackup(Database::BackupFilter tableShouldBeBackedUp)
     m_innerDatabase->filterBackup(tableShouldBeBackedUp);
 }
 
+bool Database::exportSnapshot(const UnsafeStringView& path,
+                              Database::BackupFilter tableShouldBeExported)
+{
+    return m_innerDatabase->exportSnapshot(path, tableShouldBeExported);
+}
+
+bool Database::recordHotPages(const std::list<StringView>& tables, int maxNumberOfPages)
+{
+    return m_innerDatabase->recordHotPages(tables, maxNumberOfPages);
+}
+
+void Database::enableHotPagePrefetch(bool enable, HotPagesPrefetchedCallback onPrefetched)
+{
+    InnerDatabase::HotPagesPrefetchedCallback callback = nullptr;
+    if (onPrefetched != nullptr) {
+        callback = [onPrefetched](InnerDatabase* innerDatabase, int numberOfPages) {
+            Database database = Database(innerDatabase);
+            onPrefetched(database, numberOfPages);
+        };
+    }
+    m_innerDatabase->enableHotPagePrefetch(enable, callback);
+}
+
 bool Database::deposit()
 {
     return m_innerDatabase->deposit();
@@ -596,6 +803,11 @@ bool Database::isMigrated() const
     return m_innerDatabase->isMigrated();
 }
 
+StringViewMap<uint64_t> Database::getMigrationRoutedCounts() const
+{
+    return m_innerDatabase->getMigrationRoutedCounts();
+}
+
 #pragma mark - Compression
 
 Database::CompressionInfo::CompressionInfo(void* innerInfo)
@@ -621,6 +833,15 @@ void Database::CompressionInfo::addZSTDDictCompressField(const Field& field, Dic
     ((CompressionTableUserInfo*) m_innerInfo)->addCompressingColumn(columnInfo);
 }
 
+void Database::CompressionInfo::addZSTDAutoTrainedDictCompressField(const Field& field,
+                                                                    DictId initialDictId)
+{
+    CompressionColumnInfo columnInfo(field, CompressionType::Dict);
+    columnInfo.setCommonDict(initialDictId);
+    columnInfo.enableAutoTrainDict();
+    ((CompressionTableUserInfo*) m_innerInfo)->addCompressingColumn(columnInfo);
+}
+
 void Database::CompressionInfo::addZSTDDictCompressField(const Field& field,
                                                          const Field& matchField,
                                                          const std::map<int64_t, DictId>& dictIds)
@@ -639,6 +860,47 @@ void Database::CompressionInfo::addZSTDDictCompressField(const Field& field,
     ((CompressionTableUserInfo*) m_innerInfo)->addCompressingColumn(columnInfo);
 }
 
+void Database::CompressionInfo::setZSTDCompressionLevel(const Field& field, int level)
+{
+    CompressionColumnInfo* columnInfo
+    = ((CompressionTableUserInfo*) m_innerInfo)->getCompressingColumn(field.syntax().name);
+    WCTRemedialAssert(columnInfo != nullptr,
+                      "The compressing field should be added before setting its level.",
+                      return;);
+    columnInfo->setCompressionLevel(level);
+}
+
+void Database::CompressionInfo::enableZSTDAutoCompressionLevel(const Field& field)
+{
+    CompressionColumnInfo* columnInfo
+    = ((CompressionTableUserInfo*) m_innerInfo)->getCompressingColumn(field.syntax().name);
+    WCTRemedialAssert(columnInfo != nullptr,
+                      "The compressing field should be added before setting its level.",
+                      return;);
+    columnInfo->enableAutoCompressionLevel();
+}
+
+void Database::CompressionInfo::setMinCompressSize(const Field& field, size_t size)
+{
+    CompressionColumnInfo* columnInfo
+    = ((CompressionTableUserInfo*) m_innerInfo)->getCompressingColumn(field.syntax().name);
+    WCTRemedialAssert(columnInfo != nullptr,
+                      "The compressing field should be added before setting its min size.",
+                      return;);
+    columnInfo->setMinCompressSize(size);
+}
+
+void Database::CompressionInfo::setMaxCompressedRatio(const Field& field, double ratio)
+{
+    CompressionColumnInfo* columnInfo
+    = ((CompressionTableUserInfo*) m_innerInfo)->getCompressingColumn(field.syntax().name);
+    WCTRemedialAssert(columnInfo != nullptr,
+                      "The compressing field should be added before setting its ratio.",
+                      return;);
+    WCTRemedialAssert(ratio > 0 && ratio <= 1.0, "Ratio should be in (0, 1].", return;);
+    columnInfo->setMaxCompressedRatio(ratio);
+}
+
 void Database::CompressionInfo::enableReplaceCompresssion()
 {
     ((CompressionTableUserInfo*) m_innerInfo)->enableReplaceCompresssion();
@@ -677,6 +939,22 @@ bool Database::registerZSTDDict(const UnsafeData& dict, DictId dictId)
     return CompressionCenter::shared().registerDict(dictId, dict);
 }
 
+void Database::setDecompressionCacheSize(size_t size)
+{
+    CompressionCenter::shared().setDecompressionCacheSize(size);
+}
+
+Database::DecompressionCacheStatistics Database::getDecompressionCacheStatistics()
+{
+    auto statistics = CompressionCenter::shared().getDecompressionCacheStatistics();
+    DecompressionCacheStatistics result;
+    result.hitCount = statistics.hitCount;
+    result.missCount = statistics.missCount;
+    result.savedSize = statistics.savedSize;
+    result.cachedSize = statistics.cachedSize;
+    return result;
+}
+
 void Database::setCompression(const CompressionFilter& filter)
 {
     InnerDatabase::CompressionTableFilter callback = nullptr;
@@ -732,6 +1010,24 @@ bool Database::isCompressed() const
     return m_innerDatabase->isCompressed();
 }
 
+std::vector<Database::CompressionStatistics> Database::getCompressionStatistics() const
+{
+    std::vector<CompressionStatistics> result;
+    for (const auto& statistics : m_innerDatabase->getCompressionStatistics()) {
+        CompressionStatistics columnStatistics;
+        columnStatistics.table = statistics.table;
+        columnStatistics.column = statistics.column;
+        columnStatistics.level = statistics.snapshot.level;
+        columnStatistics.compressedCount = statistics.snapshot.compressedCount;
+        columnStatistics.uncompressedCount = statistics.snapshot.uncompressedCount;
+        columnStatistics.skippedCount = statistics.snapshot.skippedCount;
+        columnStatistics.originalSize = statistics.snapshot.originalSize;
+        columnStatistics.compressedSize = statistics.snapshot.compressedSize;
+        result.push_back(columnStatistics);
+    }
+    return result;
+}
+
 bool Database::rollbackCompression(ProgressUpdateCallback onProgressUpdated)
 {
     return m_innerDatabase->rollbackCompression(onProgressUpdated);
@@ -30,7 +30,9 @@
 #include "Statement.hpp"
 #include "TokenizerModule.hpp"
 #include "WCDBError.hpp"
+#include <map>
 #include <thread>
+#include <vector>
 
 namespace WCDB {
 
@@ -67,6 +69,7 @@ private:
     Database(InnerDatabase *database);
     RecyclableHandle getHandleHolder(bool writeHint) override final;
     Recyclable<InnerDatabase *> getDatabaseHolder() override final;
+    QueryResultCache *getQueryResultCache() override final;
     Recyclable<InnerDatabase *> m_databaseHolder;
     InnerDatabase *m_innerDatabase;
 
@@ -184,6 +187,30 @@ public:
      */
     void enableAutoCheckpoint(bool enable);
 
+#pragma mark - Query Result Cache
+    /**
+     @brief Enable the cache of the results of select statements read by `getValueFromStatement()`, `getAllRowsFromStatement()` and so on.
+     The cached result is returned without taking a handle from database, and it's dropped once any table it reads is modified within current process.
+     Statements with bind parameters or non-deterministic functions, or executed within a transaction, are not cached.
+     Table names are matched case-insensitively. Nothing is cached while the schema has any view or trigger, since the tables they touch can not be tracked.
+     @param size capacity in bytes. Zero size disables the cache, which is the default.
+     */
+    void setQueryResultCacheSize(size_t size);
+
+    struct QueryResultCacheStatistics {
+        int64_t hitCount;
+        int64_t missCount;
+        // Number of results dropped for the modifications of tables.
+        int64_t invalidationCount;
+        // Total size of the results in cache.
+        size_t cachedSize;
+    };
+
+    /**
+     @brief Get the hit rate and the size of the query result cache.
+     */
+    QueryResultCacheStatistics getQueryResultCacheStatistics() const;
+
 #pragma mark - Vacuum
 
     /**
@@ -232,16 +259,24 @@ public:
          });
      
      @param trace closure
+     @param minimalLevel The errors below it are not reported. All errors are reported by default.
+            Pass `Error::Level::Debug` to skip the ignorable errors, e.g. the expected busy or constraint failures,
+            so that they are not assembled at all when no one else needs them.
+            Identical ignorable errors are reported at most once per second,
+            and the number of the others is reported later with `SuppressedCount` in a summary error.
      @see `ErrorNotification`
      */
-    static void globalTraceError(ErrorNotification trace);
+    static void globalTraceError(ErrorNotification trace,
+                                 Error::Level minimalLevel = Error::Level::Ignore);
 
     /**
      @brief You can register a reporter to monitor all errors of current database.
      @param trace closure
+     @param minimalLevel The errors below it are not reported.
      @see `ErrorNotification`
+     @see `globalTraceError`
      */
-    void traceError(ErrorNotification trace);
+    void traceError(ErrorNotification trace, Error::Level minimalLevel = Error::Level::Ignore);
 
     typedef struct PerformanceInfo {
         int tablePageReadCount;
@@ -415,6 +450,65 @@ public:
      */
     static void globalTraceBusy(BusyTrace trace, double timeOut);
 
+    enum class LockType : unsigned char {
+        PagerShared = 0,
+        PagerReserved,
+        PagerPending,
+        PagerExclusive,
+        ShmShared,
+        ShmExclusive,
+    };
+
+    struct LockDurationHistogram {
+        uint64_t count;
+        double totalSeconds;
+        double maxSeconds;
+        // The bucket i counts the durations in [2^(i-1), 2^i) microseconds, and the last one counts all the longer durations.
+        std::vector<uint64_t> buckets;
+    };
+
+    struct LockStatistics {
+        LockType type;
+        LockDurationHistogram wait;
+        LockDurationHistogram hold;
+    };
+
+    struct LockBlocker {
+        StringView path;
+        // SQL executing in the thread holding the lock when the waits began. It's empty if unknown.
+        StringView sql;
+        LockType type;
+        // ID of the thread holding the lock in the latest wait.
+        uint64_t tid;
+        uint64_t count;
+        double totalWaitSeconds;
+        double maxWaitSeconds;
+    };
+
+    struct LockProfile {
+        StringViewMap<std::vector<LockStatistics>> paths;
+        std::map<uint64_t /* tid */, std::vector<LockStatistics>> threads;
+        // Sorted by the total waiting duration in descending order.
+        std::vector<LockBlocker> topBlockers;
+    };
+
+    /**
+     @brief Enable the profiler of the pager and shm locks of all databases.
+     It records how long each lock is waited for and held, per path and per thread,
+     and attributes the waits to the SQL executing in the thread that holds the lock.
+     @note  It's designed for finding out which operations, including the background checkpoint, migration and compression, block the others. It's not recommended to be enabled in release build.
+     */
+    static void globalEnableLockProfiler(bool enable);
+
+    /**
+     @brief Get the lock profile since the profiler is enabled or reset.
+     The profile of a database is dropped after it's closed.
+     @param numberOfTopBlockers the max number of blockers in result.
+     */
+    static LockProfile getGlobalLockProfile(int numberOfTopBlockers = 10);
+
+    static void resetGlobalLockProfile();
+
 #pragma mark - File
 public:
     /**
@@ -556,6 +650,39 @@ public:
      */
     void purge();
 
+    /**
+     @brief Close the free sqlite db handles of this database that are not used for the specified time.
+     The handles are kept as many as the peak number of handles used concurrently since the last check, so that the memory they take follows the actual load.
+     @param seconds 0 to keep them until `purge()` is called, which is the default value.
+     */
+    void setIdleHandleTimeout(double seconds);
+
+    /**
+     @brief Set the number of sqlite db handles that are not closed by `setIdleHandleTimeout()` however long they are idle.
+     */
+    void setMinNumberOfHandles(size_t number);
+
+    /**
+     @brief Close the free sqlite db handles that are idle for longer than the timeout set by `setIdleHandleTimeout()` at once, instead of waiting for the next scheduled check.
+     @return true if some free handles remain to be closed later.
+     */
+    bool reapIdleHandles();
+
+    struct HandlePoolStatistics {
+        // Handles in use and free handles.
+        size_t numberOfAliveHandles;
+        size_t numberOfIdleHandles;
+        // The number of handles that will be kept by idle handle timeout.
+        size_t targetNumberOfHandles;
+        int64_t averageAcquireTimeInNanoseconds;
+        size_t numberOfCreationsInLastMinute;
+    };
+
+    /**
+     @brief Get the size and the load of the sqlite db handle pool of this database.
+     */
+    HandlePoolStatistics getHandlePoolStatistics() const;
+
     /**
      @brief Purge all free memory of all databases.
      Note that WCDB will call this interface automatically while it receives memory warning on iOS.
@@ -563,6 +690,80 @@ public:
      */
     static void purgeAll();
 
+    /**
+     @brief Release the databases that have not been referenced by any `Database` object for the specified time.
+     A database without reference is closed at once, but its object is kept so that creating `Database` with the same path again is cheap.
+     It helps the processes that open lots of databases, e.g. one database for each user, to keep their memory low.
+     @warning The configs of the released database, e.g. cipher key, tokenizers and migration, are dropped with it. You should set them up every time after creating `Database`.
+     @param seconds 0 to never release them, which is the default value.
+     */
+    static void setIdleDatabaseTTL(double seconds);
+
+    /**
+     @brief Release the databases that are idle for longer than the TTL set by `setIdleDatabaseTTL()` at once, instead of waiting for the next scheduled check.
+     @return true if some idle databases remain to be released later.
+     */
+    static bool evictIdleDatabases();
+
+    struct DatabasePoolShardStatistics {
+        // Databases that are referenced by `Database` objects.
+        size_t numberOfActiveDatabases;
+        // Databases that are not referenced but not yet released.
+        size_t numberOfIdleDatabases;
+        uint64_t numberOfEvictedDatabases;
+    };
+
+    /**
+     @brief Get the statistics of databases in each shard of the global database pool.
+     */
+    static std::vector<DatabasePoolShardStatistics> getDatabasePoolStatistics();
+
+    /**
+     @brief Set the memory quota of this database in bytes.
+     The quota covers the page cache and the prepared statements of sqlite handles, and the page cache of repair kit.
+     When the memory used exceeds the quota, WCDB will release the cache of free handles first, and then close them if it is still not enough.
+     @param quota 0 for unlimited, which is the default value.
+     */
+    void setMemoryQuota(size_t quota);
+
+    /**
+     @brief Set the memory quota of all databases in bytes, including the buffers of ZSTD contexts.
+     @see   `setMemoryQuota`
+     */
+    static void setGlobalMemoryQuota(size_t quota);
+
+    /**
+     @brief Relieve the memory of this database according to its quota immediately, instead of waiting for the scheduled relief.
+     @see   `setMemoryQuota`
+     */
+    void relieveMemory();
+
+    enum class MemoryComponent : unsigned char {
+        PageCache = 0,
+        PreparedStatement,
+        PagerCache,
+        ZSTDContext,
+        Total,
+    };
+    struct MemoryUsage {
+        int64_t current;
+        int64_t highWater;
+    };
+
+    /**
+     @brief Get the current and highwater memory usage of specific component of this database.
+     @note  ZSTD contexts are shared by all databases, so their usage can only be got from `getGlobalMemoryUsage`.
+     @note  The high water is reset once the database is closed, unless a memory quota is set for it.
+     @return memory usage in bytes.
+     */
+    MemoryUsage getMemoryUsage(MemoryComponent component) const;
+
+    /**
+     @brief Get the current and highwater memory usage of specific component of all databases.
+     @return memory usage in bytes.
+     */
+    static MemoryUsage getGlobalMemoryUsage(MemoryComponent component);
+
 #pragma mark - Repair
     /**
      Triggered when a database is confirmed to be corrupted.
@@ -625,6 +826,43 @@ public:
      */
     void filterBackup(BackupFilter tableShouldBeBackedUp);
 
+    /**
+     @brief Export a consistent copy of the current database to the specified path without blocking the writers.
+     The pages of main file are copied with the committed frames of wal overlaid on them, so that the copy is as fast as the disk.
+     The exported database is encrypted with the same cipher as the current database.
+     @param path The path of exported database. It will be overwritten if it exists.
+     @param tableShouldBeExported Return false to drop the table from the exported database. nullptr to export all tables.
+     @warning It can't be called within a transaction or in lite mode.
+     @return True if the snapshot is exported successfully.
+     */
+    bool exportSnapshot(const UnsafeStringView &path,
+                        BackupFilter tableShouldBeExported = nullptr);
+
+    /**
+     @brief Record the root and interior pages of the b-trees of hot tables and their indexes into a sidecar profile of the current database.
+     You can find out the hot tables by the page read counts of `PerformanceInfo` in `traceSQLPerformance()`.
+     The profile should be recorded again after the schema of the database or its data are changed significantly.
+     @param tables The hot tables. Empty to record all tables.
+     @param maxNumberOfPages The upper levels of b-trees are kept first if the number of pages exceeds it.
+     @warning It can't be called within a transaction.
+     @return True if the profile is recorded successfully.
+     */
+    bool recordHotPages(const std::list<StringView> &tables = {}, int maxNumberOfPages = 4096);
+
+    /**
+     Triggered in the background queue after the recorded pages of the database are prefetched.
+     */
+    typedef std::function<void(Database &database, int numberOfPages)> HotPagesPrefetchedCallback;
+
+    /**
+     @brief Prefetch the pages recorded by `Database::recordHotPages()` into the cache of system in background, when the database is opened.
+     It reduces the latency of the first queries after restart, especially for large database on slow disk.
+     @param enable enable or not.
+     @param onPrefetched closure, which is called with the number of pages prefetched.
+     @see   `HotPagesPrefetchedCallback`
+     */
+    void enableHotPagePrefetch(bool enable, HotPagesPrefetchedCallback onPrefetched = nullptr);
+
     /**
      @brief Move the current database to a temporary directory and create a new database at current path.
      This method is designed for conditions where the database is corrupted and cannot be repaired temporarily.
@@ -842,6 +1080,14 @@ public:
      */
     bool isMigrated() const;
 
+    /**
+     @brief Get the number of selections on each migrating table that are executed on the target table directly.
+     Since the rows are migrated in the descending order of rowid, the selections that only read the rows with rowid larger than all the rowids remaining in the source table, such as `WHERE rowid == 100` or `WHERE rowid > 100`, can skip the unioned view of the source table and the target table.
+     @note  Only the literal values in the condition are taken into account, and the selections in a transaction always read the unioned view.
+     @return Map from the target table to the number of selections executed on it directly.
+     */
+    StringViewMap<uint64_t> getMigrationRoutedCounts() const;
+
 #pragma mark - Compression
 
     typedef unsigned char DictId;
@@ -864,6 +1110,39 @@ public:
          */
         void addZSTDDictCompressField(const Field &field, DictId dictId);
 
+        /**
+         @brief Configure to compress all data in the specified column with a registered zstd dict at first, and then with the dicts trained from the data of this column automatically.
+         Samples are collected from the newly written data and the existing data compressed by `Database::stepCompression()` or auto-compression. A new dict is trained from them at most once a day, while compressing existing data.
+         The new dict will take effect only if it performs better than the current one on the held-out samples. It will be saved in the database so that the compressed data can always be decompressed.
+         @note The result of each training is reported by `Database::globalTraceError()` with `Error::Level::Notice`.
+         */
+        void addZSTDAutoTrainedDictCompressField(const Field &field, DictId initialDictId);
+
+        /**
+         @brief Configure the zstd compression level of the specified column, which is 3 by default.
+         @note The level only works with `addZSTDNormalCompressField()`, since the level of a dict is fixed when it's registered.
+         */
+        void setZSTDCompressionLevel(const Field &field, int level);
+
+        /**
+         @brief Configure to choose the zstd compression level of the specified column automatically.
+         It compares the compression ratio and the cpu cost of the recent values compressed by neighboring levels, and picks the one that saves enough space for the extra cpu time.
+         @note The level only works with `addZSTDNormalCompressField()`.
+         */
+        void enableZSTDAutoCompressionLevel(const Field &field);
+
+        /**
+         @brief Configure the min size of the values to be compressed in the specified column.
+         Shorter values are saved without compression, which saves the cost of compressing and decompressing them.
+         */
+        void setMinCompressSize(const Field &field, size_t size);
+
+        /**
+         @brief Configure the max ratio of the compressed size to the original size in the specified column, which is 1.0 by default.
+         Values that can not be compressed to this ratio are saved without compression, so that reading them does not need to decompress.
+         */
+        void setMaxCompressedRatio(const Field &field, double ratio);
+
         /**
          @brief Configure to compress all data in the specified column with multi registered zstd dict.
          Which dict to use when compressing is based on the value of the specified matching column.
@@ -916,6 +1195,27 @@ public:
      */
     static bool registerZSTDDict(const UnsafeData &dict, DictId dictId);
 
+    /**
+     @brief Set the capacity of the cache of decompressed values, which is shared by all databases.
+     The cache is keyed by the compressed content, so the hot values read repeatedly can skip decompression.
+     @param size capacity in bytes. Zero size disables the cache, which is the default.
+     */
+    static void setDecompressionCacheSize(size_t size);
+
+    struct DecompressionCacheStatistics {
+        int64_t hitCount;
+        int64_t missCount;
+        // Total size of decompressed values returned from cache.
+        int64_t savedSize;
+        // Total size of compressed and decompressed values in cache.
+        size_t cachedSize;
+    };
+
+    /**
+     @brief Get the hit rate and the saved size of the decompression cache.
+     */
+    static DecompressionCacheStatistics getDecompressionCacheStatistics();
+
     /**
      Triggered at any time when WCDB needs to know whether a table in the current database needs to compress data,
      mainly including creating a new table, reading and writing a table,and starting to compress a new table.
@@ -974,6 +1274,27 @@ public:
      */
     bool isCompressed() const;
 
+    struct CompressionStatistics {
+        StringView table;
+        StringView column;
+        // Current zstd level, which works with the normal compression only.
+        int level;
+        int64_t compressedCount;
+        // Values that were tried but saved without compression, since it's not worthy.
+        int64_t uncompressedCount;
+        // Values that were not tried, since they are too short or the column is mostly incompressible.
+        int64_t skippedCount;
+        size_t originalSize;
+        // Total size of all values after compression, including the ones saved without compression.
+        size_t compressedSize;
+    };
+
+    /**
+     @brief Get the statistics of the compressing columns since the database was opened.
+     @note  Only the tables that have been read, written or compressed are included.
+     */
+    std::vector<CompressionStatistics> getCompressionStatistics() const;
+
     /**
      @brief Decompress all compressed data in the database and resave them.
      @note  It will clear all compression status and progress, and disables automatic compression.
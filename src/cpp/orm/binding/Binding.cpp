@@ -89,4 +89,131 @@ IndexedColumn Binding::getIndexColumn(void *memberPointer)
     return IndexedColumn(name);
 }
 
+#pragma mark - Canonical Statement
+std::shared_ptr<Binding::CanonicalStatements>
+Binding::getOrCreateCanonicalStatements(const UnsafeStringView &table) const
+{
+    std::shared_ptr<const CanonicalStatementsMap> map
+    = std::atomic_load(&m_canonicalStatements);
+    if (map != nullptr) {
+        auto iter = map->find(table);
+        if (iter != map->end()) {
+            return iter->second;
+        }
+    }
+    std::lock_guard<std::mutex> lockGuard(m_canonicalLock);
+    map = std::atomic_load(&m_canonicalStatements);
+    std::shared_ptr<CanonicalStatementsMap> newMap;
+    if (map != nullptr) {
+        auto iter = map->find(table);
+        if (iter != map->end()) {
+            return iter->second;
+        }
+        if (map->size() < MaxNumberOfCanonicalTables) {
+            newMap = std::make_shared<CanonicalStatementsMap>(*map);
+        }
+    }
+    if (newMap == nullptr) {
+        // The statements in use are still held by their chain calls.
+        newMap = std::make_shared<CanonicalStatementsMap>();
+    }
+    std::shared_ptr<CanonicalStatements> statements
+    = std::make_shared<CanonicalStatements>();
+    newMap->insert_or_assign(table, statements);
+    std::atomic_store(&m_canonicalStatements,
+                      std::shared_ptr<const CanonicalStatementsMap>(newMap));
+    return statements;
+}
+
+std::shared_ptr<const StatementInsert>
+Binding::getOrCreateInsertAllStatement(const UnsafeStringView &table, int index) const
+{
+    WCTAssert(index >= 0 && index < NumberOfInsertStatements);
+    std::shared_ptr<CanonicalStatements> statements = getOrCreateCanonicalStatements(table);
+    std::shared_ptr<const StatementInsert> cached
+    = std::atomic_load(&statements->inserts[index]);
+    if (cached == nullptr) {
+        // The same statement might be built by several threads at the same time, which is harmless.
+        std::shared_ptr<StatementInsert> statement = std::make_shared<StatementInsert>();
+        statement->insertIntoTable(table);
+        switch ((Syntax::ConflictAction) index) {
+        case Syntax::ConflictAction::Replace:
+            statement->orReplace();
+            break;
+        case Syntax::ConflictAction::Rollback:
+            statement->orRollback();
+            break;
+        case Syntax::ConflictAction::Abort:
+            statement->orAbort();
+            break;
+        case Syntax::ConflictAction::Fail:
+            statement->orFail();
+            break;
+        case Syntax::ConflictAction::Ignore:
+            statement->orIgnore();
+            break;
+        default:
+            break;
+        }
+        statement->columns(m_fields).values(BindParameter::bindParameters(m_fields.size()));
+        // render it in advance
+        statement->getDescription();
+        cached = statement;
+        std::atomic_store(&statements->inserts[index], cached);
+    }
+    return cached;
+}
+
+std::shared_ptr<const StatementInsert> Binding::getInsertAllStatement(const UnsafeStringView &table) const
+{
+    return getOrCreateInsertAllStatement(table, 0);
+}
+
+std::shared_ptr<const StatementInsert>
+Binding::getInsertAllStatement(const UnsafeStringView &table, Syntax::ConflictAction conflictAction) const
+{
+    return getOrCreateInsertAllStatement(table, (int) conflictAction);
+}
+
+std::shared_ptr<const StatementInsert>
+Binding::getBatchInsertAllStatement(const UnsafeStringView &table, size_t batchCount) const
+{
+    std::shared_ptr<CanonicalStatements> statements = getOrCreateCanonicalStatements(table);
+    std::shared_ptr<const StatementInsert> cached = std::atomic_load(&statements->batchInsert);
+    if (cached == nullptr
+        || cached->syntax().expressionsValues.size() != batchCount) {
+        std::shared_ptr<StatementInsert> statement = std::make_shared<StatementInsert>();
+        statement->insertIntoTable(table).columns(m_fields);
+        int index = 0;
+        for (size_t i = 0; i < batchCount; i++) {
+            Expressions values;
+            for (size_t j = 0; j < m_fields.size(); j++) {
+                values.push_back(BindParameter(++index));
+            }
+            statement->values(values);
+        }
+        statement->getDescription();
+        cached = statement;
+        std::atomic_store(&statements->batchInsert, cached);
+    }
+    return cached;
+}
+
+std::shared_ptr<const StatementSelect> Binding::getSelectAllStatement(const UnsafeStringView &table) const
+{
+    std::shared_ptr<CanonicalStatements> statements = getOrCreateCanonicalStatements(table);
+    std::shared_ptr<const StatementSelect> cached = std::atomic_load(&statements->selectAll);
+    if (cached == nullptr) {
+        std::shared_ptr<StatementSelect> statement = std::make_shared<StatementSelect>();
+        statement->select(m_fields).from(table);
+        if (!statementTable.syntax().withoutRowid) {
+            statement->order(OrderingTerm::ascendingRowid());
+        }
+        statement->getDescription();
+        cached = statement;
+        std::atomic_store(&statements->selectAll, cached);
+    }
+    return cached;
+}
+
 } //namespace WCDB
@@ -27,7 +27,10 @@
 #include "BaseBinding.hpp"
 #include "CPPDeclaration.h"
 #include "Field.hpp"
+#include <array>
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace WCDB {
 
@@ -70,6 +73,42 @@ public:
 #pragma mark - IndexColumn
 public:
     IndexedColumn getIndexColumn(void* memberPointer);
+
+#pragma mark - Canonical Statement
+public:
+    /*
+     The statements fully decided by the fields and the table name.
+     They are built and rendered once for each table, then shared by the ORM chain calls without custom clauses.
+     */
+    std::shared_ptr<const StatementInsert> getInsertAllStatement(const UnsafeStringView& table) const;
+    std::shared_ptr<const StatementInsert>
+    getInsertAllStatement(const UnsafeStringView& table, Syntax::ConflictAction conflictAction) const;
+    // INSERT INTO table(...) VALUES(?1, ?2), (?3, ?4), ...
+    std::shared_ptr<const StatementInsert>
+    getBatchInsertAllStatement(const UnsafeStringView& table, size_t batchCount) const;
+    // SELECT ... FROM table ORDER BY rowid ASC, without the order for the table without rowid.
+    std::shared_ptr<const StatementSelect> getSelectAllStatement(const UnsafeStringView& table) const;
+
+private:
+    // Index 0 is for the statement without conflict action.
+    static constexpr const int NumberOfInsertStatements = (int) Syntax::ConflictAction::Ignore + 1;
+    // Tables beyond it are rare, e.g. the sharded tables, so the cache is simply dropped.
+    static constexpr const size_t MaxNumberOfCanonicalTables = 64;
+    // The statements are set once with std::atomic_store and read with std::atomic_load.
+    struct CanonicalStatements {
+        std::array<std::shared_ptr<const StatementInsert>, NumberOfInsertStatements> inserts;
+        std::shared_ptr<const StatementInsert> batchInsert;
+        std::shared_ptr<const StatementSelect> selectAll;
+    };
+    typedef StringViewMap<std::shared_ptr<CanonicalStatements>> CanonicalStatementsMap;
+    std::shared_ptr<CanonicalStatements>
+    getOrCreateCanonicalStatements(const UnsafeStringView& table) const;
+    std::shared_ptr<const StatementInsert>
+    getOrCreateInsertAllStatement(const UnsafeStringView& table, int index) const;
+    // Only the creation of the statements of a new table is locked. The map is copied on write,
+    // so that the lookups of existing tables are lock-free.
+    mutable std::mutex m_canonicalLock;
+    mutable std::shared_ptr<const CanonicalStatementsMap> m_canonicalStatements;
 };
 
 } //namespace WCDB
@@ -22,7 +22,9 @@
  * limitations under the License.
  */
 
+#include <WCDB/TokenizerModuleTemplate.hpp>
 #include <WCDB/WCDBCpp.h>
+#include <atomic>
 
 class CPPFTS5Object {
 public:
@@ -49,3 +51,28 @@ public:
     bool operator==(const CPPFTS5SymbolObject& other);
     WCDB_CPP_ORM_DECLARATION(CPPFTS5SymbolObject);
 };
+
+// Splits the text by spaces and counts the texts it tokenizes.
+class CPPFTS5CountingTokenizer final : public WCDB::AbstractFTSTokenizer {
+public:
+    CPPFTS5CountingTokenizer(const char* const* azArg, int nArg, void* pCtx);
+    void loadInput(const char* pText, int nText, int flags) override;
+    int nextToken(const char** ppToken, int* nToken, int* iStart, int* iEnd, int* tflags, int* iPosition) override;
+
+    static constexpr const char* name = "counting_tokenizer";
+    static std::atomic<int>& numberOfTokenizedTexts();
+
+private:
+    const char* m_input;
+    int m_inputLength;
+    int m_cursor;
+};
+
+class CPPFTS5CountingObject {
+public:
+    CPPFTS5CountingObject();
+    CPPFTS5CountingObject(WCDB::UnsafeStringView cont, WCDB::UnsafeStringView ext);
+    WCDB::StringView content;
+    WCDB::StringView extension;
+    WCDB_CPP_ORM_DECLARATION(CPPFTS5CountingObject);
+};
@@ -74,3 +74,62 @@ bool CPPFTS5SymbolObject::operator==(const CPPFTS5SymbolObject &other)
 {
     return content.compare(other.content) == 0;
 }
+
+constexpr const char* CPPFTS5CountingTokenizer::name;
+
+CPPFTS5CountingTokenizer::CPPFTS5CountingTokenizer(const char* const* azArg, int nArg, void* pCtx)
+: WCDB::AbstractFTSTokenizer(azArg, nArg, pCtx), m_input(nullptr), m_inputLength(0), m_cursor(0)
+{
+}
+
+void CPPFTS5CountingTokenizer::loadInput(const char* pText, int nText, int flags)
+{
+    WCDB_UNUSED(flags);
+    ++numberOfTokenizedTexts();
+    m_input = pText;
+    m_inputLength = nText;
+    m_cursor = 0;
+}
+
+int CPPFTS5CountingTokenizer::nextToken(const char** ppToken, int* nToken, int* iStart, int* iEnd, int* tflags, int* iPosition)
+{
+    WCDB_UNUSED(iPosition);
+    while (m_cursor < m_inputLength && m_input[m_cursor] == ' ') {
+        m_cursor++;
+    }
+    if (m_cursor >= m_inputLength) {
+        return WCDB::FTSError::Done();
+    }
+    int start = m_cursor;
+    while (m_cursor < m_inputLength && m_input[m_cursor] != ' ') {
+        m_cursor++;
+    }
+    *ppToken = m_input + start;
+    *nToken = m_cursor - start;
+    *iStart = start;
+    *iEnd = m_cursor;
+    *tflags = 0;
+    return WCDB::FTSError::OK();
+}
+
+std::atomic<int>& CPPFTS5CountingTokenizer::numberOfTokenizedTexts()
+{
+    static std::atomic<int> s_numberOfTokenizedTexts(0);
+    return s_numberOfTokenizedTexts;
+}
+
+CPPFTS5CountingObject::CPPFTS5CountingObject() = default;
+
+CPPFTS5CountingObject::CPPFTS5CountingObject(WCDB::UnsafeStringView cont, WCDB::UnsafeStringView ext)
+: content(cont)
+, extension(ext)
+{
+}
+
+WCDB_CPP_ORM_IMPLEMENTATION_BEGIN(CPPFTS5CountingObject)
+WCDB_CPP_SYNTHESIZE(content)
+WCDB_CPP_SYNTHESIZE(extension)
+
+WCDB_CPP_VIRTUAL_TABLE_MODULE(WCDB::Module::FTS5)
+WCDB_CPP_VIRTUAL_TABLE_TOKENIZE_WITH_PARAMETERS(CPPFTS5CountingTokenizer::name, "declared")
+WCDB_CPP_ORM_IMPLEMENTATION_END
@@ -0,0 +1,79 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "CPPFTS5Object.h"
+#import "CPPTestCase.h"
+#import <Foundation/Foundation.h>
+
+@interface CPPFTS5PreTokenizeBenchmark : CPPDatabaseTestCase
+
+@end
+
+@implementation CPPFTS5PreTokenizeBenchmark {
+    WCDB::ValueArray<CPPFTS5Object> _objects;
+}
+
+- (void)setUp
+{
+    [super setUp];
+    self.expectMode = DatabaseTestCaseExpectSomeSQLs;
+    self.database->addTokenizer(WCDB::BuiltinTokenizer::Verbatim);
+    WCDB::Database::configSymbolDetector([](WCDB::Database::UnicodeChar theChar) {
+        if (theChar < 0xC0) {
+            if (!(theChar >= 0x30 && theChar <= 0x39) && !((theChar >= 0x41 && theChar <= 0x5a) || (theChar >= 0x61 && theChar <= 0x7a))) {
+                return true;
+            }
+        }
+        return false;
+    });
+    WCDB::Database::configTraditionalChineseConverter([](const WCDB::UnsafeStringView &token) {
+        return WCDB::StringView(token);
+    });
+    Random.shared.stable = YES;
+    for (int i = 0; i < 20000; i++) {
+        _objects.push_back(CPPFTS5Object([Random.shared chineseStringWithLength:100].UTF8String, [Random.shared englishStringWithLength:100].UTF8String));
+    }
+}
+
+- (double)insertObjectsIntoTable:(NSString *)tableName preTokenize:(BOOL)preTokenize
+{
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5Object>(tableName.UTF8String));
+    WCDB::Insert<CPPFTS5Object> insert = self.database->prepareInsert<CPPFTS5Object>().intoTable(tableName.UTF8String).values(_objects);
+    if (preTokenize) {
+        insert.preTokenize();
+    }
+    NSDate *start = [NSDate date];
+    TestCaseAssertTrue(insert.execute());
+    double cost = [[NSDate date] timeIntervalSinceDate:start];
+    return _objects.size() / cost;
+}
+
+- (void)test_pre_tokenize
+{
+    double inlineSpeed = [self insertObjectsIntoTable:@"inlineTable" preTokenize:NO];
+    double preTokenizedSpeed = [self insertObjectsIntoTable:@"preTokenizedTable" preTokenize:YES];
+    TestCaseLog(@"Inline tokenization: %.0f documents/s", inlineSpeed);
+    TestCaseLog(@"Pre-tokenization on %u cores: %.0f documents/s", (unsigned) NSProcessInfo.processInfo.activeProcessorCount, preTokenizedSpeed);
+#if DEBUG || TARGET_IPHONE_SIMULATOR
+    TestCaseLog(@"Benchmark is run in debug mode or simulator. The result may be untrusted.");
+#endif
+}
+
+@end
@@ -277,6 +277,124 @@
     TestCaseAssertTrue(count.value() == 1);
 }
 
+- (void)test_auto_merge_report
+{
+    for (int i = 0; i < 14; i++) {
+        CPPFTS5Object object(Random.shared.chineseString.UTF8String, "");
+        TestCaseAssertTrue(self.ftsTable.insertObjects(object));
+    }
+
+    bool reported = false;
+    long long originalSegmentCount = 0;
+    long long segmentCount = 0;
+    long long writtenPages = 0;
+    WCDB::Database::globalTraceError([&](const WCDB::Error &error) {
+        if (error.level == WCDB::Error::Level::Notice
+            && strcmp(error.getMessage().data(), "Merge fts index performance") == 0
+            && strcmp(error.getPath().data(), self.path.UTF8String) == 0) {
+            reported = true;
+            originalSegmentCount = error.infos.at("OriginalSegmentCount").intValue();
+            segmentCount = error.infos.at("SegmentCount").intValue();
+            writtenPages = error.infos.at("WrittenPages").intValue();
+        }
+    });
+    self.database->enableAutoMergeFTS5Index(true);
+    CPPFTS5Object object(Random.shared.chineseString.UTF8String, "");
+    TestCaseAssertTrue(self.ftsTable.insertObjects(object));
+
+    [NSThread sleepForTimeInterval:2.5];
+    WCDB::Database::globalTraceError(nullptr);
+
+    TestCaseAssertTrue(reported);
+    TestCaseAssertTrue(originalSegmentCount >= 15);
+    TestCaseAssertTrue(segmentCount == 1);
+    TestCaseAssertTrue(writtenPages > 0);
+}
+
+- (void)test_pre_tokenize
+{
+    WCDB::ValueArray<CPPFTS5Object> objects;
+    for (int i = 0; i < 1000; i++) {
+        objects.push_back(CPPFTS5Object(Random.shared.chineseString.UTF8String, Random.shared.englishString.UTF8String));
+    }
+    objects.push_back(CPPFTS5Object("我們是程序員", "WCDB is a cross-platform database framework developed by WeChat."));
+
+    NSString *preTokenizedTable = @"preTokenizedTable";
+    NSString *inlineTable = @"inlineTable";
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5Object>(preTokenizedTable.UTF8String));
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5Object>(inlineTable.UTF8String));
+    TestCaseAssertTrue(self.database->prepareInsert<CPPFTS5Object>().intoTable(preTokenizedTable.UTF8String).values(objects).preTokenize(4).execute());
+    TestCaseAssertTrue(self.database->prepareInsert<CPPFTS5Object>().intoTable(inlineTable.UTF8String).values(objects).execute());
+
+    // The replayed tokens should build exactly the same index.
+    WCDB::OptionalMultiRows preTokenizedIndex = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select(WCDB::Column("block")).from(WCDB::StringView::formatted("%s_data", preTokenizedTable.UTF8String)).order(WCDB::Column("id")));
+    WCDB::OptionalMultiRows inlineIndex = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select(WCDB::Column("block")).from(WCDB::StringView::formatted("%s_data", inlineTable.UTF8String)).order(WCDB::Column("id")));
+    TestCaseAssertTrue(preTokenizedIndex.succeed() && inlineIndex.succeed());
+    TestCaseAssertTrue(preTokenizedIndex.value().size() > 1);
+    TestCaseAssertTrue(preTokenizedIndex.value() == inlineIndex.value());
+
+    WCDB::OptionalValueArray<CPPFTS5Object> matched = self.database->getAllObjects<CPPFTS5Object>(preTokenizedTable.UTF8String, WCDB_FIELD(CPPFTS5Object::content).match("我们是程序员"));
+    TestCaseAssertTrue(matched.succeed() && matched.value().size() == 1);
+    matched = self.database->getAllObjects<CPPFTS5Object>(preTokenizedTable.UTF8String, WCDB_FIELD(CPPFTS5Object::extension).match("developer"));
+    TestCaseAssertTrue(matched.succeed() && matched.value().size() == 1);
+}
+
+- (WCDB::ValueArray<CPPFTS5CountingObject>)prepareCountingObjects
+{
+    WCDB::Database::registerTokenizer(CPPFTS5CountingTokenizer::name, WCDB::FTS5TokenizerModuleTemplate<CPPFTS5CountingTokenizer>::specializeWithContext(nullptr));
+    self.database->addTokenizer(CPPFTS5CountingTokenizer::name);
+    WCDB::ValueArray<CPPFTS5CountingObject> objects;
+    for (int i = 0; i < 100; i++) {
+        objects.push_back(CPPFTS5CountingObject(Random.shared.englishString.UTF8String, Random.shared.englishString.UTF8String));
+    }
+    return objects;
+}
+
+- (void)test_pre_tokenize_without_tokenizing_again
+{
+    WCDB::ValueArray<CPPFTS5CountingObject> objects = [self prepareCountingObjects];
+    int numberOfTexts = (int) objects.size() * 2;
+
+    NSString *preTokenizedTable = @"preTokenizedTable";
+    NSString *inlineTable = @"inlineTable";
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5CountingObject>(preTokenizedTable.UTF8String));
+    TestCaseAssertTrue(self.database->createVirtualTable<CPPFTS5CountingObject>(inlineTable.UTF8String));
+
+    // Each text is tokenized once by the workers, and only replayed while inserting.
+    CPPFTS5CountingTokenizer::numberOfTokenizedTexts() = 0;
+    TestCaseAssertTrue(self.database->prepareInsert<CPPFTS5CountingObject>().intoTable(preTokenizedTable.UTF8String).values(objects).preTokenize(4).execute());
+    TestCaseAssertEqual(CPPFTS5CountingTokenizer::numberOfTokenizedTexts().load(), numberOfTexts);
+
+    CPPFTS5CountingTokenizer::numberOfTokenizedTexts() = 0;
+    TestCaseAssertTrue(self.database->prepareInsert<CPPFTS5CountingObject>().intoTable(inlineTable.UTF8String).values(objects).execute());
+    TestCaseAssertEqual(CPPFTS5CountingTokenizer::numberOfTokenizedTexts().load(), numberOfTexts);
+
+    WCDB::OptionalMultiRows preTokenizedIndex = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select(WCDB::Column("block")).from(WCDB::StringView::formatted("%s_data", preTokenizedTable.UTF8String)).order(WCDB::Column("id")));
+    WCDB::OptionalMultiRows inlineIndex = self.database->getAllRowsFromStatement(WCDB::StatementSelect().select(WCDB::Column("block")).from(WCDB::StringView::formatted("%s_data", inlineTable.UTF8String)).order(WCDB::Column("id")));
+    TestCaseAssertTrue(preTokenizedIndex.succeed() && inlineIndex.succeed());
+    TestCaseAssertTrue(preTokenizedIndex.value() == inlineIndex.value());
+}
+
+- (void)test_pre_tokenize_with_different_tokenizer_arguments
+{
+    WCDB::ValueArray<CPPFTS5CountingObject> objects = [self prepareCountingObjects];
+    int numberOfTexts = (int) objects.size() * 2;
+
+    // The table is declared with the same tokenizer as the ORM but different arguments.
+    NSString *table = @"differentArgumentsTable";
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateVirtualTable()
+                                              .createVirtualTable(table.UTF8String)
+                                              .usingModule(WCDB::Module::FTS5)
+                                              .argument("content")
+                                              .argument("extension")
+                                              .argument(WCDB::FTSTokenizerUtil::tokenize(CPPFTS5CountingTokenizer::name, "other", nullptr))));
+
+    // The pre-tokenized tokens are not replayed by the tokenizer of table, so the texts are tokenized again.
+    CPPFTS5CountingTokenizer::numberOfTokenizedTexts() = 0;
+    TestCaseAssertTrue(self.database->prepareInsert<CPPFTS5CountingObject>().intoTable(table.UTF8String).values(objects).preTokenize(4).execute());
+    TestCaseAssertEqual(CPPFTS5CountingTokenizer::numberOfTokenizedTexts().load(), numberOfTexts * 2);
+}
+
 - (void)test_thread_conflict
 {
     self.database->enableAutoMergeFTS5Index(true);
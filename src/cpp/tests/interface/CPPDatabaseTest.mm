@@ -138,6 +138,52 @@
     TestCaseAssertFalse(self.database->isOpened());
 }
 
+- (void)test_memory_usage
+{
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:100], self.columns, self.tableName.UTF8String));
+
+    auto usage = self.database->getMemoryUsage(WCDB::Database::MemoryComponent::PageCache);
+    TestCaseAssertTrue(usage.current > 0);
+    TestCaseAssertTrue(usage.highWater >= usage.current);
+    auto total = self.database->getMemoryUsage(WCDB::Database::MemoryComponent::Total);
+    TestCaseAssertTrue(total.current >= usage.current);
+    auto global = WCDB::Database::getGlobalMemoryUsage(WCDB::Database::MemoryComponent::Total);
+    TestCaseAssertTrue(global.current >= total.current);
+
+    self.database->purge();
+    usage = self.database->getMemoryUsage(WCDB::Database::MemoryComponent::PageCache);
+    TestCaseAssertEqual(usage.current, 0);
+
+    // The usage of closed database is dropped.
+    self.database->close();
+    total = self.database->getMemoryUsage(WCDB::Database::MemoryComponent::Total);
+    TestCaseAssertEqual(total.current, 0);
+    TestCaseAssertEqual(total.highWater, 0);
+}
+
+- (void)test_memory_quota
+{
+    TestCaseAssertTrue([self createValueTable]);
+    TestCaseAssertTrue(self.database->insertRows([Random.shared autoIncrementTestCaseValuesWithCount:100], self.columns, self.tableName.UTF8String));
+    TestCaseAssertTrue(self.database->isOpened());
+
+    self.database->setMemoryQuota(1);
+    // trigger the accounting
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+    self.database->relieveMemory();
+    TestCaseAssertFalse(self.database->isOpened());
+
+    // Closing drops the scheduled relief, and the reopened database should still be relieved.
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+    self.database->close();
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion())));
+    TestCaseAssertTrue(self.database->isOpened());
+    self.database->relieveMemory();
+    TestCaseAssertFalse(self.database->isOpened());
+    self.database->setMemoryQuota(0);
+}
+
 - (void)test_purge_all
 {
     // acquire handle
@@ -224,6 +270,246 @@
       isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
 }
 
+- (void)test_export_snapshot
+{
+    [self insertPresetObjects];
+    NSString* snapshotPath = [self.path stringByAppendingString:@"-snapshot"];
+    TestCaseAssertTrue(self.database->exportSnapshot(snapshotPath.UTF8String));
+    {
+        WCDB::Database snapshot(snapshotPath.UTF8String);
+        auto objects = snapshot.getAllObjects<CPPTestCaseObject>(self.tableName.UTF8String);
+        TestCaseAssertTrue(objects.succeed());
+        [self check:CPPMultiRowValueExtract(self.objects)
+          isEqualTo:CPPMultiRowValueExtract(objects.value())];
+        snapshot.close();
+    }
+
+    NSString* tableName = self.tableName;
+    TestCaseAssertTrue(self.database->exportSnapshot(snapshotPath.UTF8String, [tableName](const WCDB::UnsafeStringView& table) {
+        return !table.equal(tableName.UTF8String);
+    }));
+    {
+        WCDB::Database snapshot(snapshotPath.UTF8String);
+        auto exists = snapshot.tableExists(self.tableName.UTF8String);
+        TestCaseAssertTrue(exists.succeed() && !exists.value());
+        snapshot.close();
+    }
+}
+
+- (void)test_export_snapshot_while_writing
+{
+    [self insertPresetObjects];
+    int numberOfPresetObjects = (int) self.objects.size();
+    NSString* snapshotPath = [self.path stringByAppendingString:@"-snapshot"];
+    static constexpr const int NumberOfTransactions = 50;
+    static constexpr const int NumberOfObjectsPerTransaction = 100;
+    [self.dispatch async:^{
+        for (int i = 0; i < NumberOfTransactions; ++i) {
+            auto objects = [[Random shared] testCaseObjectsWithCount:NumberOfObjectsPerTransaction startingFromIdentifier:numberOfPresetObjects + i * NumberOfObjectsPerTransaction + 1];
+            TestCaseAssertTrue(self.table.insertObjects(objects));
+        }
+    }];
+    for (int i = 0; i < 10; ++i) {
+        TestCaseAssertTrue(self.database->exportSnapshot(snapshotPath.UTF8String));
+        WCDB::Database snapshot(snapshotPath.UTF8String);
+        auto integrity = snapshot.getValueFromStatement(WCDB::StatementPragma().pragma(WCDB::Pragma::integrityCheck()));
+        TestCaseAssertTrue(integrity.succeed());
+        TestCaseAssertCPPStringEqual(integrity.value().textValue().data(), "ok");
+        // Each snapshot contains the whole transactions committed before it.
+        auto count = snapshot.getValueFromStatement(WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String));
+        TestCaseAssertTrue(count.succeed());
+        TestCaseAssertTrue((count.value().intValue() - numberOfPresetObjects) % NumberOfObjectsPerTransaction == 0);
+        snapshot.close();
+    }
+    [self.dispatch waitUntilDone];
+}
+
+- (void)test_export_snapshot_over_stale_sidecars
+{
+    [self insertPresetObjects];
+    NSString* snapshotPath = [self.path stringByAppendingString:@"-snapshot"];
+    NSString* stalePath = [self.path stringByAppendingString:@"-stale"];
+    TestCaseAssertTrue(self.database->exportSnapshot(snapshotPath.UTF8String));
+    {
+        // Leave the wal and shm of the other content at the destination.
+        WCDB::Database snapshot(snapshotPath.UTF8String);
+        auto objects = [[Random shared] testCaseObjectsWithCount:100 startingFromIdentifier:(int) self.objects.size() + 1];
+        TestCaseAssertTrue(snapshot.insertObjects<CPPTestCaseObject>(objects, self.tableName.UTF8String));
+        for (NSString* suffix in @[ @"-wal", @"-shm" ]) {
+            NSString* sidecarPath = [snapshotPath stringByAppendingString:suffix];
+            if ([self.fileManager fileExistsAtPath:sidecarPath]) {
+                TestCaseAssertTrue([self.fileManager copyItemAtPath:sidecarPath toPath:[stalePath stringByAppendingString:suffix] error:nil]);
+            }
+        }
+        snapshot.close();
+        for (NSString* suffix in @[ @"-wal", @"-shm" ]) {
+            NSString* sidecarPath = [snapshotPath stringByAppendingString:suffix];
+            NSString* stalePathOfSidecar = [stalePath stringByAppendingString:suffix];
+            if ([self.fileManager fileExistsAtPath:stalePathOfSidecar]) {
+                [self.fileManager removeItemAtPath:sidecarPath error:nil];
+                TestCaseAssertTrue([self.fileManager moveItemAtPath:stalePathOfSidecar toPath:sidecarPath error:nil]);
+            }
+        }
+    }
+
+    TestCaseAssertTrue(self.database->exportSnapshot(snapshotPath.UTF8String));
+    {
+        WCDB::Database snapshot(snapshotPath.UTF8String);
+        auto objects = snapshot.getAllObjects<CPPTestCaseObject>(self.tableName.UTF8String);
+        TestCaseAssertTrue(objects.succeed());
+        [self check:CPPMultiRowValueExtract(self.objects)
+          isEqualTo:CPPMultiRowValueExtract(objects.value())];
+        snapshot.close();
+    }
+}
+
+- (void)test_hot_page_prefetch
+{
+    [self insertPresetObjects];
+    NSString* profilePath = [self.path stringByAppendingString:@"-hot.profile"];
+    TestCaseAssertTrue(self.database->recordHotPages({ self.tableName.UTF8String }));
+    TestCaseAssertTrue([self.fileManager fileExistsAtPath:profilePath]);
+
+    self.database->close();
+    std::atomic<int> numberOfPrefetchedPages(-1);
+    dispatch_semaphore_t prefetched = dispatch_semaphore_create(0);
+    self.database->enableHotPagePrefetch(true, [&](WCDB::Database& database, int numberOfPages) {
+        TestCaseAssertCPPStringEqual(database.getPath().data(), self.path.UTF8String);
+        numberOfPrefetchedPages = numberOfPages;
+        dispatch_semaphore_signal(prefetched);
+    });
+    [self check:CPPMultiRowValueExtract(self.objects)
+      isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
+
+    TestCaseAssertEqual(dispatch_semaphore_wait(prefetched, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)), 0);
+    TestCaseAssertTrue(numberOfPrefetchedPages > 0);
+
+    // The pages are prefetched only once, when the database is opened for the first time.
+    self.database->close();
+    TestCaseAssertTrue(self.database->canOpen());
+    TestCaseAssertNotEqual(dispatch_semaphore_wait(prefetched, dispatch_time(DISPATCH_TIME_NOW, 1 * NSEC_PER_SEC)), 0);
+
+    self.database->enableHotPagePrefetch(false);
+    self.database->close();
+    TestCaseAssertTrue(self.database->removeFiles());
+    TestCaseAssertFalse([self.fileManager fileExistsAtPath:profilePath]);
+}
+
+- (void)test_evict_idle_database
+{
+    auto getNumberOfEvictedDatabases = []() {
+        uint64_t numberOfEvictedDatabases = 0;
+        for (const auto& statistics : WCDB::Database::getDatabasePoolStatistics()) {
+            numberOfEvictedDatabases += statistics.numberOfEvictedDatabases;
+        }
+        return numberOfEvictedDatabases;
+    };
+    uint64_t numberOfEvictedDatabases = getNumberOfEvictedDatabases();
+    // Long enough that the scheduled eviction does not run during the test.
+    WCDB::Database::setIdleDatabaseTTL(100);
+    {
+        WCDB::Database database([self.path stringByAppendingString:@"-idle"].UTF8String);
+        TestCaseAssertTrue(database.canOpen());
+    }
+    // The database is kept since it's not idle for long enough.
+    TestCaseAssertTrue(WCDB::Database::evictIdleDatabases());
+
+    // The database is idle for longer than the TTL now.
+    WCDB::Database::setIdleDatabaseTTL(1e-6);
+    WCDB::Database::evictIdleDatabases();
+    TestCaseAssertTrue(getNumberOfEvictedDatabases() > numberOfEvictedDatabases);
+    WCDB::Database::setIdleDatabaseTTL(0);
+}
+
+- (void)test_query_result_cache
+{
+    [self insertPresetObjects];
+    self.database->setQueryResultCacheSize(1024 * 1024);
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String);
+
+    auto count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 2);
+    count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 2);
+    auto statistics = self.database->getQueryResultCacheStatistics();
+    TestCaseAssertTrue(statistics.hitCount == 1);
+    TestCaseAssertTrue(statistics.missCount == 1);
+
+    TestCaseAssertTrue(self.table.insertObjects(CPPTestCaseObject(3, "c")));
+    count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 3);
+    statistics = self.database->getQueryResultCacheStatistics();
+    TestCaseAssertTrue(statistics.invalidationCount > 0);
+    TestCaseAssertTrue(statistics.hitCount == 1);
+
+    self.database->setQueryResultCacheSize(0);
+    statistics = self.database->getQueryResultCacheStatistics();
+    TestCaseAssertTrue(statistics.cachedSize == 0);
+}
+
+- (void)test_query_result_cache_with_case_insensitive_table
+{
+    [self insertPresetObjects];
+    self.database->setQueryResultCacheSize(1024 * 1024);
+    WCDB::StringView upperTable = WCDB::StringView::formatted("%s", self.tableName.uppercaseString.UTF8String);
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.lowercaseString.UTF8String);
+
+    auto count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 2);
+    count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(self.database->getQueryResultCacheStatistics().hitCount == 1);
+
+    // The same table written in another case.
+    TestCaseAssertTrue(self.database->insertRows(WCDB::MultiRowsValue({ { 3, "c" } }), WCDB::Columns({ WCDB::Column("identifier"), WCDB::Column("content") }), upperTable));
+    count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 3);
+    TestCaseAssertTrue(self.database->getQueryResultCacheStatistics().hitCount == 1);
+}
+
+- (void)test_query_result_cache_with_view
+{
+    [self insertPresetObjects];
+    self.database->setQueryResultCacheSize(1024 * 1024);
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateView().createView("testView").as(WCDB::StatementSelect().select(WCDB::Column::all()).from(self.tableName.UTF8String))));
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column::all().count()).from("testView");
+
+    auto count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 2);
+    count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 2);
+    // Nothing is cached while the schema has views.
+    TestCaseAssertTrue(self.database->getQueryResultCacheStatistics().hitCount == 0);
+
+    // A write to the base table is seen through the view.
+    TestCaseAssertTrue(self.table.insertObjects(CPPTestCaseObject(3, "c")));
+    count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 3);
+
+    // Results are cached again once the view is dropped.
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementDropView().dropView("testView")));
+    WCDB::StatementSelect selectTable = WCDB::StatementSelect().select(WCDB::Column::all().count()).from(self.tableName.UTF8String);
+    count = self.database->getValueFromStatement(selectTable);
+    count = self.database->getValueFromStatement(selectTable);
+    TestCaseAssertTrue(count.succeed() && count.value() == 3);
+    TestCaseAssertTrue(self.database->getQueryResultCacheStatistics().hitCount == 1);
+}
+
+- (void)test_query_result_cache_with_trigger
+{
+    [self insertPresetObjects];
+    self.database->setQueryResultCacheSize(1024 * 1024);
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateTable().createTable("logTable").define(WCDB::ColumnDef("value", WCDB::ColumnType::Integer))));
+    TestCaseAssertTrue(self.database->execute(WCDB::StatementCreateTrigger().createTrigger("testTrigger").after().insert().on(self.tableName.UTF8String).execute(WCDB::StatementInsert().insertIntoTable("logTable").value(1))));
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column::all().count()).from("logTable");
+
+    auto count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 0);
+    // The trigger writes to logTable, which is not the table inserted into.
+    TestCaseAssertTrue(self.table.insertObjects(CPPTestCaseObject(3, "c")));
+    count = self.database->getValueFromStatement(select);
+    TestCaseAssertTrue(count.succeed() && count.value() == 1);
+}
+
 - (void)test_auto_vacuum
 {
     self.database->enableAutoVacuum(false);
@@ -317,6 +603,109 @@
     TestCaseAssertCPPStringEqual(migratedTable.data(), sourceTableName.UTF8String);
 }
 
+- (void)test_batch_insert_with_migration
+{
+    WCDB::Database sourceDatabase([self.path stringByAppendingString:@"_source"].UTF8String);
+    NSString* sourceTableName = @"sourceTable";
+    TestCaseAssertTrue(sourceDatabase.createTable<CPPTestCaseObject>(sourceTableName.UTF8String));
+    WCDB::Table<CPPTestCaseObject> sourceTable = sourceDatabase.getTable<CPPTestCaseObject>(sourceTableName.UTF8String);
+    TestCaseAssertTrue(sourceTable.insertObjects({ CPPTestCaseObject(1, "a"), CPPTestCaseObject(2, "b") }));
+
+    self.database->addMigration(sourceDatabase.getPath(), WCDB::Data(), [=](WCDB::Database::MigrationInfo& info) {
+        if (info.table.compare(self.tableName.UTF8String) == 0) {
+            info.sourceTable = sourceTableName.UTF8String;
+        }
+    });
+    TestCaseAssertTrue([self createObjectTable]);
+
+    // Multi-row insert is executed row by row while the table is migrating.
+    WCDB::ValueArray<CPPTestCaseObject> objects;
+    for (int i = 0; i < 150; i++) {
+        objects.push_back(CPPTestCaseObject::autoIncrementObject(Random.shared.string.UTF8String));
+    }
+    TestCaseAssertTrue(self.table.insertObjects(objects));
+    TestCaseAssertTrue(self.table.selectValue(WCDB::Column::all().count()).value() == 152);
+    TestCaseAssertTrue(sourceTable.selectValue(WCDB::Column::all().count()).value() == 2);
+
+    for (const auto& object : objects) {
+        auto selected = self.table.getFirstObject(WCDB_FIELD(CPPTestCaseObject::content) == object.content);
+        TestCaseAssertTrue(selected.succeed() && selected.value().identifier == *object.lastInsertedRowID);
+    }
+}
+
+- (void)test_routed_select_with_migration
+{
+    WCDB::Database sourceDatabase([self.path stringByAppendingString:@"_source"].UTF8String);
+    NSString* sourceTableName = @"sourceTable";
+    TestCaseAssertTrue(sourceDatabase.createTable<CPPTestCaseObject>(sourceTableName.UTF8String));
+    WCDB::Table<CPPTestCaseObject> sourceTable = sourceDatabase.getTable<CPPTestCaseObject>(sourceTableName.UTF8String);
+    WCDB::ValueArray<CPPTestCaseObject> objects;
+    for (int i = 1; i <= 300; i++) {
+        objects.push_back(CPPTestCaseObject(i, Random.shared.string.UTF8String));
+    }
+    TestCaseAssertTrue(sourceTable.insertObjects(objects));
+
+    self.database->addMigration(sourceDatabase.getPath(), WCDB::Data(), [=](WCDB::Database::MigrationInfo& info) {
+        if (info.table.compare(self.tableName.UTF8String) == 0) {
+            info.sourceTable = sourceTableName.UTF8String;
+        }
+    });
+    TestCaseAssertTrue([self createObjectTable]);
+
+    // Rows are migrated from the largest rowid.
+    while (sourceTable.selectValue(WCDB::Column::all().count()).value() == 300) {
+        TestCaseAssertTrue(self.database->stepMigration());
+    }
+    TestCaseAssertFalse(self.database->isMigrated());
+    TestCaseAssertTrue(self.database->getMigrationRoutedCounts().empty());
+
+    auto object = self.table.getFirstObject(WCDB_FIELD(CPPTestCaseObject::identifier) == 300);
+    TestCaseAssertTrue(object.succeed() && object.value().content.compare(objects.back().content) == 0);
+    auto count = self.table.selectValue(WCDB::Column::all().count(), WCDB_FIELD(CPPTestCaseObject::identifier) > 290);
+    TestCaseAssertTrue(count.succeed() && count.value() == 10);
+    auto routedCounts = self.database->getMigrationRoutedCounts();
+    TestCaseAssertTrue(routedCounts[self.tableName.UTF8String] == 2);
+
+    // The rows remaining in source table are read from the unioned view.
+    object = self.table.getFirstObject(WCDB_FIELD(CPPTestCaseObject::identifier) == 1);
+    TestCaseAssertTrue(object.succeed() && object.value().content.compare(objects.front().content) == 0);
+    count = self.table.selectValue(WCDB::Column::all().count(), WCDB_FIELD(CPPTestCaseObject::identifier) > 0);
+    TestCaseAssertTrue(count.succeed() && count.value() == 300);
+    routedCounts = self.database->getMigrationRoutedCounts();
+    TestCaseAssertTrue(routedCounts[self.tableName.UTF8String] == 2);
+}
+
+- (void)test_batch_insert_compress
+{
+    [[Random shared] setStringType:RandomStringType_English];
+    TestCaseAssertTrue([self createObjectTable]);
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDNormalCompressField(WCDB_FIELD(CPPTestCaseObject::content));
+    });
+
+    WCDB::ValueArray<CPPTestCaseObject> objects;
+    std::string content;
+    for (int i = 0; i < 20; i++) {
+        content.append("compressible content");
+    }
+    for (int i = 0; i < 150; i++) {
+        objects.push_back(CPPTestCaseObject::autoIncrementObject(content + std::to_string(i)));
+    }
+    TestCaseAssertTrue(self.table.insertObjects(objects));
+
+    // All rows in multi-row statement are compressed.
+    auto count = self.database->getValueFromStatement(WCDB::StatementSelect().select(WCDB::Column().count()).from(self.tableName.UTF8String).where(WCDB::Column("WCDB_CT_content") == 4));
+    TestCaseAssertTrue(count.value() == 150);
+
+    for (int i = 0; i < objects.size(); i++) {
+        objects[i].identifier = (int) *objects[i].lastInsertedRowID;
+    }
+    [self check:CPPMultiRowValueExtract(objects)
+      isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
 - (void)test_normal_compress
 {
     [[Random shared] setStringType:RandomStringType_English];
@@ -361,6 +750,116 @@
     [[Random shared] setStringType:RandomStringType_Default];
 }
 
+- (void)test_compress_threshold
+{
+    [[Random shared] setStringType:RandomStringType_English];
+    TestCaseAssertTrue([self createObjectTable]);
+    auto preInsertObjects = [[Random shared] testCaseObjectsWithCount:2 startingFromIdentifier:1];
+    auto newInsertObjects = [[Random shared] testCaseObjectsWithCount:2 startingFromIdentifier:3];
+    TestCaseAssertTrue(self.table.insertObjects(preInsertObjects));
+
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDNormalCompressField(WCDB_FIELD(CPPTestCaseObject::content));
+        info.setZSTDCompressionLevel(WCDB_FIELD(CPPTestCaseObject::content), 9);
+        info.setMinCompressSize(WCDB_FIELD(CPPTestCaseObject::content), 1024 * 1024);
+    });
+
+    TestCaseAssertTrue(self.database->stepCompression());
+    TestCaseAssertTrue(self.database->stepCompression());
+    TestCaseAssertTrue(self.database->isCompressed());
+
+    TestCaseAssertTrue(self.table.insertObjects(newInsertObjects));
+    // All values are shorter than min size, so they are saved without compression.
+    auto count = self.database->getValueFromStatement(WCDB::StatementSelect().select(WCDB::Column().count()).from(self.tableName.UTF8String).where(WCDB::Column("WCDB_CT_content") == 0));
+    TestCaseAssertTrue(count.value() == 4);
+    auto statistics = self.database->getCompressionStatistics();
+    TestCaseAssertTrue(statistics.size() == 1);
+    TestCaseAssertTrue(statistics[0].skippedCount == 4);
+    TestCaseAssertTrue(statistics[0].compressedCount == 0);
+    TestCaseAssertTrue(statistics[0].level == 9);
+    TestCaseAssertTrue(statistics[0].originalSize == statistics[0].compressedSize);
+
+    preInsertObjects.insert(preInsertObjects.end(), newInsertObjects.begin(), newInsertObjects.end());
+
+    [self check:CPPMultiRowValueExtract(preInsertObjects)
+      isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
+- (void)test_compression_statistics
+{
+    TestCaseAssertTrue([self createObjectTable]);
+    std::vector<CPPTestCaseObject> preInsertObjects;
+    std::vector<CPPTestCaseObject> newInsertObjects;
+    size_t originalSize = 0;
+    for (int i = 1; i <= 15; i++) {
+        CPPTestCaseObject object(i, std::string(1000, 'a' + i));
+        originalSize += object.content.size();
+        (i <= 10 ? preInsertObjects : newInsertObjects).push_back(object);
+    }
+    TestCaseAssertTrue(self.table.insertObjects(preInsertObjects));
+
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDNormalCompressField(WCDB_FIELD(CPPTestCaseObject::content));
+        info.setZSTDCompressionLevel(WCDB_FIELD(CPPTestCaseObject::content), 5);
+    });
+    TestCaseAssertTrue(self.database->getCompressionStatistics().empty());
+
+    while (!self.database->isCompressed()) {
+        TestCaseAssertTrue(self.database->stepCompression());
+    }
+    auto statistics = self.database->getCompressionStatistics();
+    TestCaseAssertTrue(statistics.size() == 1);
+    TestCaseAssertCPPStringEqual(statistics[0].table.data(), self.tableName.UTF8String);
+    TestCaseAssertCPPStringEqual(statistics[0].column.data(), "content");
+    TestCaseAssertTrue(statistics[0].level == 5);
+    TestCaseAssertTrue(statistics[0].compressedCount == 10);
+    TestCaseAssertTrue(statistics[0].uncompressedCount == 0);
+    TestCaseAssertTrue(statistics[0].skippedCount == 0);
+
+    // New values are counted when they are written.
+    TestCaseAssertTrue(self.table.insertObjects(newInsertObjects));
+    statistics = self.database->getCompressionStatistics();
+    TestCaseAssertTrue(statistics.size() == 1);
+    TestCaseAssertTrue(statistics[0].compressedCount == 15);
+    TestCaseAssertTrue(statistics[0].originalSize == originalSize);
+    TestCaseAssertTrue(statistics[0].compressedSize < originalSize / 10);
+}
+
+- (void)test_decompression_cache
+{
+    TestCaseAssertTrue([self createObjectTable]);
+    std::vector<CPPTestCaseObject> objects;
+    std::string content;
+    for (int i = 0; i < 100; i++) {
+        content.append("hot value");
+    }
+    for (int i = 1; i <= 10; i++) {
+        objects.push_back(CPPTestCaseObject(i, content));
+    }
+
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDNormalCompressField(WCDB_FIELD(CPPTestCaseObject::content));
+    });
+    TestCaseAssertTrue(self.table.insertObjects(objects));
+
+    WCDB::Database::setDecompressionCacheSize(1024 * 1024);
+    auto oldStatistics = WCDB::Database::getDecompressionCacheStatistics();
+
+    // All rows share the same compressed content, so only the first one needs decompression.
+    [self check:CPPMultiRowValueExtract(objects)
+      isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
+    auto statistics = WCDB::Database::getDecompressionCacheStatistics();
+    TestCaseAssertTrue(statistics.missCount - oldStatistics.missCount == 1);
+    TestCaseAssertTrue(statistics.hitCount - oldStatistics.hitCount == 9);
+    TestCaseAssertTrue(statistics.savedSize - oldStatistics.savedSize == 9 * content.size());
+    TestCaseAssertTrue(statistics.cachedSize > content.size());
+
+    WCDB::Database::setDecompressionCacheSize(0);
+    TestCaseAssertTrue(WCDB::Database::getDecompressionCacheStatistics().cachedSize == 0);
+}
+
 - (void)test_dict_compress
 {
     [[Random shared] setStringType:RandomStringType_English];
@@ -398,6 +897,149 @@
     [[Random shared] setStringType:RandomStringType_Default];
 }
 
+- (void)test_auto_trained_dict_compress
+{
+    [[Random shared] setStringType:RandomStringType_English];
+    TestCaseAssertTrue([self createObjectTable]);
+    auto preInsertObjects = [[Random shared] testCaseObjectsWithCount:5000 startingFromIdentifier:1];
+    TestCaseAssertTrue(self.table.insertObjects(preInsertObjects));
+
+    std::vector<std::string> samples;
+    for (int i = 0; i < 1000; i++) {
+        samples.push_back(std::string([[Random shared] string].UTF8String));
+    }
+    auto dict = WCDB::Database::trainDict(samples, 5);
+    TestCaseAssertTrue(dict.succeed());
+    TestCaseAssertTrue(WCDB::Database::registerZSTDDict(dict.value(), 5));
+
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDAutoTrainedDictCompressField(WCDB_FIELD(CPPTestCaseObject::content), 5);
+    });
+
+    bool trained = false;
+    bool adopted = false;
+    WCDB::Database::globalTraceError([&](const WCDB::Error& error) {
+        if (error.level == WCDB::Error::Level::Notice
+            && strcmp(error.getMessage().data(), "Compression dict training") == 0
+            && strcmp(error.getPath().data(), self.path.UTF8String) == 0) {
+            trained = true;
+            auto iter = error.infos.find("Adopted");
+            adopted = iter != error.infos.end() && iter->second.intValue() == 1;
+        }
+    });
+
+    while (!self.database->isCompressed()) {
+        TestCaseAssertTrue(self.database->stepCompression());
+    }
+    WCDB::Database::globalTraceError(nullptr);
+    TestCaseAssertTrue(trained);
+
+    if (adopted) {
+        auto dictCount = self.database->getValueFromStatement(WCDB::StatementSelect().select(WCDB::Column().count()).from("wcdb_builtin_compression_dict"));
+        TestCaseAssertTrue(dictCount.value() == 1);
+    }
+
+    // Data compressed by both dicts can be read after reopening.
+    self.database->close();
+    [self check:CPPMultiRowValueExtract(preInsertObjects)
+      isEqualTo:CPPMultiRowValueExtract([self getAllObjects])];
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
+- (void)test_read_auto_trained_dict_compressed_data_by_raw_sql
+{
+    [[Random shared] setStringType:RandomStringType_English];
+    TestCaseAssertTrue([self createObjectTable]);
+    auto preInsertObjects = [[Random shared] testCaseObjectsWithCount:5000 startingFromIdentifier:1];
+    TestCaseAssertTrue(self.table.insertObjects(preInsertObjects));
+
+    std::vector<std::string> samples;
+    for (int i = 0; i < 1000; i++) {
+        samples.push_back(std::string([[Random shared] string].UTF8String));
+    }
+    auto dict = WCDB::Database::trainDict(samples, 7);
+    TestCaseAssertTrue(dict.succeed());
+    TestCaseAssertTrue(WCDB::Database::registerZSTDDict(dict.value(), 7));
+
+    self.database->setCompression([](WCDB::Database::CompressionInfo& info) {
+        info.addZSTDAutoTrainedDictCompressField(WCDB_FIELD(CPPTestCaseObject::content), 7);
+    });
+    while (!self.database->isCompressed()) {
+        TestCaseAssertTrue(self.database->stepCompression());
+    }
+
+    // Without compression, the statement is not rewritten, so the decompress function is called with two arguments.
+    self.database->setCompression(nullptr);
+    auto contents = self.database->getOneColumnFromStatement(WCDB::StatementSelect().select(WCDB::Expression::function("wcdb_decompress").invoke().arguments({ WCDB::Column("content"), WCDB::Column("WCDB_CT_content") })).from(self.tableName.UTF8String).order(WCDB::Column("identifier")));
+    TestCaseAssertTrue(contents.succeed());
+    TestCaseAssertTrue(contents.value().size() == preInsertObjects.size());
+    for (int i = 0; i < preInsertObjects.size(); i++) {
+        TestCaseAssertTrue(strcmp(contents.value()[i].textValue().data(), preInsertObjects[i].content.c_str()) == 0);
+    }
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
+- (void)test_auto_trained_dict_compress_in_multiple_databases
+{
+    [[Random shared] setStringType:RandomStringType_English];
+    std::vector<std::string> samples;
+    for (int i = 0; i < 1000; i++) {
+        samples.push_back(std::string([[Random shared] string].UTF8String));
+    }
+    auto dict = WCDB::Database::trainDict(samples, 6);
+    TestCaseAssertTrue(dict.succeed());
+    TestCaseAssertTrue(WCDB::Database::registerZSTDDict(dict.value(), 6));
+
+    NSString* otherPath = [self.path stringByAppendingString:@"_other"];
+    WCDB::Database otherDatabase(otherPath.UTF8String);
+    std::vector<WCDB::Database*> databases = { self.database, &otherDatabase };
+    std::vector<WCDB::ValueArray<CPPTestCaseObject>> preInsertObjects;
+    for (WCDB::Database* database : databases) {
+        TestCaseAssertTrue(database->createTable<CPPTestCaseObject>(self.tableName.UTF8String));
+        auto objects = [[Random shared] testCaseObjectsWithCount:5000 startingFromIdentifier:1];
+        TestCaseAssertTrue(database->insertObjects<CPPTestCaseObject>(objects, self.tableName.UTF8String));
+        preInsertObjects.push_back(objects);
+        database->setCompression([](WCDB::Database::CompressionInfo& info) {
+            info.addZSTDAutoTrainedDictCompressField(WCDB_FIELD(CPPTestCaseObject::content), 6);
+        });
+    }
+
+    std::set<std::string> trainedPaths;
+    bool conflicted = false;
+    WCDB::Database::globalTraceError([&](const WCDB::Error& error) {
+        if (error.level == WCDB::Error::Level::Notice
+            && strcmp(error.getMessage().data(), "Compression dict training") == 0) {
+            trainedPaths.insert(error.getPath().data());
+        }
+        if (strcmp(error.getMessage().data(), "Conflicting trained dict!") == 0) {
+            conflicted = true;
+        }
+    });
+    // Both databases train dicts in the same process, whose ids are allocated separately.
+    for (WCDB::Database* database : databases) {
+        while (!database->isCompressed()) {
+            TestCaseAssertTrue(database->stepCompression());
+        }
+    }
+    WCDB::Database::globalTraceError(nullptr);
+    TestCaseAssertTrue(trainedPaths.size() == 2);
+    TestCaseAssertFalse(conflicted);
+
+    for (int i = 0; i < databases.size(); i++) {
+        databases[i]->close();
+        auto objects = databases[i]->getAllObjects<CPPTestCaseObject>(self.tableName.UTF8String);
+        TestCaseAssertTrue(objects.succeed());
+        [self check:CPPMultiRowValueExtract(preInsertObjects[i])
+          isEqualTo:CPPMultiRowValueExtract(objects.value())];
+    }
+    otherDatabase.close();
+    TestCaseAssertTrue(otherDatabase.removeFiles());
+
+    [[Random shared] setStringType:RandomStringType_Default];
+}
+
 - (void)test_multi_dict_compress
 {
     [[Random shared] setStringType:RandomStringType_English];
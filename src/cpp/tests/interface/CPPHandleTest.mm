@@ -59,6 +59,55 @@
     self.database->traceSQL(nullptr);
 }
 
+- (void)test_reap_idle_handles
+{
+    TestCaseAssertTrue([self createObjectTable]);
+    // Long enough that the scheduled reaping does not run during the test.
+    self.database->setIdleHandleTimeout(100);
+    for (int i = 0; i < 4; i++) {
+        [self.dispatch async:^{
+            WCDB::Handle handle = self.database->getHandle();
+            TestCaseAssertTrue(handle.selectAllRow(self.columns, self.tableName.UTF8String).succeed());
+            [NSThread sleepForTimeInterval:0.2];
+            handle.invalidate();
+        }];
+    }
+    [self.dispatch waitUntilDone];
+    auto statistics = self.database->getHandlePoolStatistics();
+    TestCaseAssertTrue(statistics.numberOfAliveHandles > 1);
+    TestCaseAssertTrue(statistics.numberOfCreationsInLastMinute >= statistics.numberOfAliveHandles);
+
+    // All free handles are idle for longer than the timeout now.
+    self.database->setIdleHandleTimeout(1e-6);
+    // The first reaping keeps as many handles as the peak concurrency, which drops to zero after it.
+    self.database->reapIdleHandles();
+    TestCaseAssertFalse(self.database->reapIdleHandles());
+    statistics = self.database->getHandlePoolStatistics();
+    TestCaseAssertEqual(statistics.numberOfAliveHandles, 0);
+    TestCaseAssertEqual(statistics.targetNumberOfHandles, 0);
+    self.database->setIdleHandleTimeout(0);
+}
+
+- (void)test_reap_idle_handles_after_reopen
+{
+    TestCaseAssertTrue([self createObjectTable]);
+    self.database->setIdleHandleTimeout(0.1);
+    TestCaseAssertTrue(self.database->selectAllRow(self.columns, self.tableName.UTF8String).succeed());
+    // The scheduled reaping is removed on closing.
+    self.database->close();
+
+    // The reaping is scheduled again after the database is reopened.
+    TestCaseAssertTrue(self.database->selectAllRow(self.columns, self.tableName.UTF8String).succeed());
+    TestCaseAssertEqual(self.database->getHandlePoolStatistics().numberOfAliveHandles, 1);
+    bool reaped = false;
+    for (int i = 0; i < 100 && !reaped; i++) {
+        [NSThread sleepForTimeInterval:0.05];
+        reaped = self.database->getHandlePoolStatistics().numberOfAliveHandles == 0;
+    }
+    TestCaseAssertTrue(reaped);
+    self.database->setIdleHandleTimeout(0);
+}
+
 - (void)test_write_with_handle_count_limit
 {
     int maxHandleCount = 0;
@@ -142,6 +142,102 @@
     TestCaseAssertTrue(tested);
 }
 
+- (void)test_ignorable_error_traced_by_default
+{
+    std::atomic<int> numberOfIgnorableErrors(0);
+    WCDB::Database::globalTraceError(nullptr);
+    WCDB::Database::globalTraceError([&](const WCDB::Error &error) {
+        if (error.level == WCDB::Error::Level::Ignore) {
+            ++numberOfIgnorableErrors;
+        }
+    });
+
+    TestCaseAssertTrue(self.database->canOpen());
+    TestCaseAssertFalse(self.database->tableExists("notExistTable").value());
+    TestCaseAssertTrue(numberOfIgnorableErrors.load() > 0);
+
+    WCDB::Database::globalTraceError(nullptr);
+}
+
+- (void)test_ignorable_error_filtered_by_minimal_level
+{
+    std::atomic<int> numberOfIgnorableErrors(0);
+    WCDB::Database::globalTraceError(nullptr);
+    WCDB::Database::globalTraceError(
+    [&](const WCDB::Error &error) {
+        if (error.level == WCDB::Error::Level::Ignore) {
+            ++numberOfIgnorableErrors;
+        }
+    },
+    WCDB::Error::Level::Debug);
+
+    TestCaseAssertTrue(self.database->canOpen());
+    TestCaseAssertFalse(self.database->tableExists("notExistTable").value());
+    TestCaseAssertEqual(numberOfIgnorableErrors.load(), 0);
+
+    WCDB::Database::globalTraceError(nullptr);
+}
+
+- (void)test_ignorable_error_summary
+{
+    std::mutex lock;
+    int numberOfNotified = 0;
+    int numberOfSummaries = 0;
+    int suppressedCount = 0;
+    WCDB::Database::globalTraceError(nullptr);
+    WCDB::Database::globalTraceError(
+    [&](const WCDB::Error &error) {
+        if (error.level != WCDB::Error::Level::Ignore
+            || strcmp(error.getPath().data(), self.path.UTF8String) != 0
+            || error.code() != WCDB::Error::Code::Error) {
+            return;
+        }
+        std::lock_guard<std::mutex> lockGuard(lock);
+        auto iter = error.infos.find(WCDB::UnsafeStringView("SuppressedCount"));
+        if (iter == error.infos.end()) {
+            ++numberOfNotified;
+        } else {
+            ++numberOfSummaries;
+            suppressedCount += (int) iter->second.intValue();
+        }
+    },
+    WCDB::Error::Level::Ignore);
+
+    TestCaseAssertTrue(self.database->canOpen());
+    int times = 10;
+    for (int i = 0; i < times; ++i) {
+        TestCaseAssertFalse(self.database->tableExists("notExistTable").value());
+    }
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        TestCaseAssertEqual(numberOfNotified, 1);
+        TestCaseAssertEqual(numberOfSummaries, 0);
+    }
+
+    // The summary is notified by timer without any further error.
+    bool summarized = false;
+    for (int i = 0; i < 50 && !summarized; ++i) {
+        [NSThread sleepForTimeInterval:0.1];
+        std::lock_guard<std::mutex> lockGuard(lock);
+        summarized = numberOfSummaries > 0;
+    }
+    TestCaseAssertTrue(summarized);
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        TestCaseAssertEqual(numberOfSummaries, 1);
+        TestCaseAssertEqual(suppressedCount, times - 1);
+    }
+
+    // The next error after the summary is notified at once.
+    TestCaseAssertFalse(self.database->tableExists("notExistTable").value());
+    {
+        std::lock_guard<std::mutex> lockGuard(lock);
+        TestCaseAssertEqual(numberOfNotified, 2);
+    }
+
+    WCDB::Database::globalTraceError(nullptr);
+}
+
 - (void)test_global_trace_sql
 {
     WCDB::StatementPragma statement = WCDB::StatementPragma().pragma(WCDB::Pragma::userVersion());
@@ -296,4 +392,56 @@
     WCDB::Database::globalTraceBusy(nullptr, 0);
 }
 
+- (void)test_global_lock_profiler
+{
+    WCDB::Database::globalEnableLockProfiler(true);
+    WCDB::Database::resetGlobalLockProfile();
+
+    XCTAssertTrue([self createObjectTable]);
+    dispatch_semaphore_t locked = dispatch_semaphore_create(0);
+    dispatch_semaphore_t blocked = dispatch_semaphore_create(0);
+    // It is notified while the insertion below is waiting for the lock.
+    WCDB::Database::globalTraceBusy([=](long, const WCDB::UnsafeStringView &, uint64_t, const WCDB::UnsafeStringView &) {
+        dispatch_semaphore_signal(blocked);
+    },
+                                    0.01);
+    [self.dispatch async:^{
+        XCTAssertTrue(self.database->runTransaction([&](WCDB::Handle &handle) {
+            WCDB::StatementInsert statement = WCDB::StatementInsert().insertIntoTable(self.tableName.UTF8String).column(WCDB::Column("identifier")).column(WCDB::Column("content")).values(WCDB::BindParameter::bindParameters(2));
+            TestCaseAssertTrue(handle.prepare(statement));
+            handle.bindInteger(1, 1);
+            handle.bindText(Random.shared.string.UTF8String, 2);
+            TestCaseAssertTrue(handle.step());
+            // Keep the statement running and the write lock held until the other insertion is blocked.
+            dispatch_semaphore_signal(locked);
+            TestCaseAssertTrue(dispatch_semaphore_wait(blocked, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)) == 0);
+            handle.finalize();
+            return true;
+        }));
+    }];
+    dispatch_semaphore_wait(locked, DISPATCH_TIME_FOREVER);
+    XCTAssertTrue(self.table.insertObjects([Random.shared autoIncrementTestCaseObject]));
+    [self.dispatch waitUntilDone];
+    WCDB::Database::globalTraceBusy(nullptr, 0);
+
+    auto profile = WCDB::Database::getGlobalLockProfile(1);
+    auto iter = profile.paths.find(self.database->getPath());
+    TestCaseAssertTrue(iter != profile.paths.end());
+    bool held = false;
+    for (const auto &statistics : iter->second) {
+        held = held || statistics.hold.count > 0;
+    }
+    TestCaseAssertTrue(held);
+    TestCaseAssertTrue(profile.topBlockers.size() == 1);
+    TestCaseAssertCPPStringEqual(profile.topBlockers.front().sql.data(), "INSERT INTO testTable(identifier, content) VALUES(?1, ?2)");
+
+    // The profile is evicted along with the closed database.
+    self.database->close();
+    profile = WCDB::Database::getGlobalLockProfile(1);
+    TestCaseAssertTrue(profile.paths.find(self.database->getPath()) == profile.paths.end());
+    TestCaseAssertTrue(profile.topBlockers.empty());
+
+    WCDB::Database::globalEnableLockProfiler(false);
+}
+
 @end
@@ -22,6 +22,7 @@
  * limitations under the License.
  */
 
+#import "CPPTableConstraintRowidObject.hpp"
 #import "CPPTestCase.h"
 
 @interface ORMInsertTests : CPPCRUDTestCase
@@ -89,6 +90,74 @@
     TestCaseAssertTrue(autoIncrementObject == self.object3);
 }
 
+#pragma mark - Batch Insert
+- (void)test_batch_insert_auto_increment_objects
+{
+    WCDB::ValueArray<CPPTestCaseObject> objects;
+    for (int i = 0; i < 250; i++) {
+        objects.push_back(CPPTestCaseObject::autoIncrementObject(Random.shared.string.UTF8String));
+    }
+    TestCaseAssertTrue(self.table.insertObjects(objects));
+
+    for (int i = 0; i < objects.size(); i++) {
+        // Identifiers of preset objects are 1 and 2.
+        TestCaseAssertTrue(*objects[i].lastInsertedRowID == i + 3);
+        objects[i].identifier = i + 3;
+    }
+    WCDB::ValueArray<CPPTestCaseObject> expectedObjects = self.objects;
+    expectedObjects.insert(expectedObjects.end(), objects.begin(), objects.end());
+    TestCaseAssertTrue([self getAllObjects] == expectedObjects);
+}
+
+- (void)test_batch_insert_objects_with_table_constraint_rowid
+{
+    NSString* tableName = @"rowidTable";
+    TestCaseAssertTrue(self.database->createTable<CPPTableConstraintRowidObject>(tableName.UTF8String));
+    WCDB::ValueArray<CPPTableConstraintRowidObject> objects;
+    for (int i = 0; i < 150; i++) {
+        CPPTableConstraintRowidObject object;
+        // Identifiers are not continuous, so they can not be deduced from the last rowid.
+        object.identifier = 1000 - i * 3;
+        object.content = Random.shared.string.UTF8String;
+        objects.push_back(object);
+    }
+    TestCaseAssertTrue(self.database->insertObjects<CPPTableConstraintRowidObject>(objects, tableName.UTF8String));
+    for (const auto& object : objects) {
+        TestCaseAssertTrue(*object.lastInsertedRowID == object.identifier);
+    }
+}
+
+#pragma mark - Reuse
+- (void)test_reuse_insert_after_changing_statement
+{
+    WCDB::Insert<CPPTestCaseObject> insert = self.database->prepareInsert<CPPTestCaseObject>().intoTable(self.tableName.UTF8String);
+    TestCaseAssertTrue(insert.value(self.object3).execute());
+    TestCaseAssertFalse(insert.value(self.renewedObject1).execute());
+
+    // The shared statement of the previous execution is not reused after the conflict action is changed.
+    TestCaseAssertTrue(insert.orReplace().value(self.renewedObject1).execute());
+    WCDB::ValueArray<CPPTestCaseObject> expectedObjects = { self.renewedObject1, self.object2, self.object3 };
+    TestCaseAssertTrue([self getAllObjects] == expectedObjects);
+
+    // Nor after the table is changed.
+    NSString* otherTableName = @"otherTable";
+    TestCaseAssertTrue(self.database->createTable<CPPTestCaseObject>(otherTableName.UTF8String));
+    TestCaseAssertTrue(insert.intoTable(otherTableName.UTF8String).value(self.object4).execute());
+    auto otherObjects = self.database->getAllObjects<CPPTestCaseObject>(otherTableName.UTF8String);
+    TestCaseAssertTrue(otherObjects.succeed() && otherObjects.value() == WCDB::ValueArray<CPPTestCaseObject>({ self.object4 }));
+    TestCaseAssertTrue([self getAllObjects] == expectedObjects);
+}
+
+- (void)test_insert_with_customized_statement
+{
+    WCDB::Insert<CPPTestCaseObject> insert = self.database->prepareInsert<CPPTestCaseObject>().intoTable(self.tableName.UTF8String);
+    // The statement customized directly is executed instead of the shared one.
+    insert.getStatement().orIgnore();
+    TestCaseAssertTrue(insert.value(self.renewedObject1).execute());
+    TestCaseAssertSQLEqual(insert.getStatement(), @"INSERT OR IGNORE INTO testTable(identifier, content) VALUES(?1, ?2)");
+    TestCaseAssertTrue([self getAllObjects] == self.objects);
+}
+
 #pragma mark - Database - Insert
 - (void)test_database_insert_object
 {
@@ -131,6 +131,34 @@
                  }];
 }
 
+- (void)test_database_cursor
+{
+    WCDB::MultiObject multiObj1;
+    multiObj1.addObject(self.object1, self.tableName.UTF8String);
+    multiObj1.addObject(self.object1InTable2, self.tableName2.UTF8String);
+    WCDB::MultiObject multiObj2;
+    multiObj2.addObject(self.object2, self.tableName.UTF8String);
+    multiObj2.addObject(self.object2InTable2, self.tableName2.UTF8String);
+    [self doTestMultiObjects:{ multiObj1, multiObj2 }
+                      andSQL:@"SELECT testTable.identifier, testTable.content, testTable2.identifier, testTable2.content FROM testTable, testTable2 WHERE testTable.identifier == testTable2.identifier"
+                 bySelecting:^WCDB::OptionalMultiObjectArray {
+                     WCDB::ResultFields resultColumns
+                     = CPPTestCaseObject::allFields()
+                       .redirect([self](const WCDB::Field& field) -> WCDB::ResultColumn {
+                           return field.table(self.tableName.UTF8String);
+                       })
+                       .addingNewResultColumns(CPPTestCaseObject::allFields().redirect([self](const WCDB::Field& field) -> WCDB::ResultColumn {
+                           return field.table(self.tableName2.UTF8String);
+                       }));
+                     WCDB::MultiSelect select = self.database->prepareMultiSelect().onResultFields(resultColumns).fromTables({ self.tableName.UTF8String, self.tableName2.UTF8String }).where(WCDB_FIELD(CPPTestCaseObject::identifier).table(self.tableName.UTF8String) == WCDB_FIELD(CPPTestCaseObject::identifier).table(self.tableName2.UTF8String));
+                     WCDB::ValueArray<WCDB::MultiObject> objects;
+                     for (const auto& object : select.cursor()) {
+                         objects.push_back(object);
+                     }
+                     return objects;
+                 }];
+}
+
 #pragma mark - Handle
 - (void)test_handle_next
 {
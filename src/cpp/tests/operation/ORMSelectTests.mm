@@ -468,6 +468,49 @@
            }];
 }
 
+#pragma mark - Table - Cursor
+- (void)test_table_cursor
+{
+    [self doTestObjects:self.objects
+                 andSQL:@"SELECT identifier, content FROM testTable ORDER BY rowid ASC"
+            bySelecting:^WCDB::OptionalValueArray<CPPTestCaseObject> {
+                WCDB::ValueArray<CPPTestCaseObject> objects;
+                auto cursor = self.table.prepareSelect().cursor();
+                for (const auto& object : cursor) {
+                    objects.push_back(object);
+                }
+                TestCaseAssertTrue(cursor.isClosed());
+                TestCaseAssertFalse(cursor.failed());
+                return objects;
+            }];
+}
+
+- (void)test_table_cursor_reuse_object_with_prefetch
+{
+    [self doTestObjects:self.objects
+                 andSQL:@"SELECT identifier, content FROM testTable ORDER BY rowid ASC"
+            bySelecting:^WCDB::OptionalValueArray<CPPTestCaseObject> {
+                auto cursor = self.table.prepareSelect().cursor();
+                cursor.reuseObject().prefetch(1);
+                CPPTestCaseObject* first = cursor.nextObject();
+                TestCaseAssertTrue(first != nullptr && *first == self.object1);
+                CPPTestCaseObject* second = cursor.nextObject();
+                TestCaseAssertTrue(first == second && *second == self.object2);
+                TestCaseAssertTrue(cursor.nextObject() == nullptr);
+                return self.objects;
+            }];
+}
+
+- (void)test_table_cursor_next_objects
+{
+    [self doTestObjects:self.objects
+                 andSQL:@"SELECT identifier, content FROM testTable ORDER BY rowid ASC"
+            bySelecting:^WCDB::OptionalValueArray<CPPTestCaseObject> {
+                auto cursor = self.table.prepareSelect().cursor();
+                return cursor.nextObjects(10);
+            }];
+}
+
 #pragma mark - Table - Get Objects
 - (void)test_table_get_objects
 {
@@ -808,6 +808,8 @@ static const JNINativeMethod g_handleStatementMethods[] = {
     { "clearBindings", "(J)V", (void *) WCDBJNIHandleStatementFuncName(clearBindings) },
     { "finalize", "(J)V", (void *) WCDBJNIHandleStatementFuncName(finalize) },
     { "isDone", "(J)Z", (void *) WCDBJNIHandleStatementFuncName(isDone) },
+    { "stepBatch", "(JLjava/nio/ByteBuffer;II)Z", (void *) WCDBJNIHandleStatementFuncName(stepBatch) },
+    { "bindBatchRow", "(JLjava/nio/ByteBuffer;I)Z", (void *) WCDBJNIHandleStatementFuncName(bindBatchRow) },
     { "bindInteger", "(JJI)V", (void *) WCDBJNIHandleStatementFuncName(bindInteger) },
     { "bindDouble", "(JDI)V", (void *) WCDBJNIHandleStatementFuncName(bindDouble) },
     { "bindText", "(J" WCDBJNIStringSignature "I)V", (void *) WCDBJNIHandleStatementFuncName(bindText) },
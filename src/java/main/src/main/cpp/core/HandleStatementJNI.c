@@ -23,6 +23,7 @@
 
 #include "HandleStatementJNI.h"
 #include "HandleStatementBridge.h"
+#include <string.h>
 
 jlong WCDBJNIHandleStatementClassMethod(getError, jlong self)
 {
@@ -81,6 +82,68 @@ jboolean WCDBJNIHandleStatementClassMethod(isDone, jlong self)
     return WCDBHandleStatementIsDone(selfStruct);
 }
 
+/*
+ Layout of the direct buffer used by batch methods, in native byte order:
+ [0, 16): header of int32 number of rows, has pending row, required size of pending row and a reserved one.
+ Types: int32 x cells, starting from 16.
+ Values: 8 bytes x cells, aligned to 8. Integer, double, or int32 offset + int32 length of text/blob.
+ Bytes: the rest of buffer. Texts are UTF-8 and not null-terminated. Offsets are relative to its start.
+ */
+#define WCDBJNIBatchHeaderSize 16
+
+static bool WCDBJNIMapBatchBuffer(JNIEnv *env,
+                                  jobject buffer,
+                                  jint columnCount,
+                                  jint rowCapacity,
+                                  CPPHandleStatementBatch *batch)
+{
+    unsigned char *address = (unsigned char *) (*env)->GetDirectBufferAddress(env, buffer);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, buffer);
+    jlong cellCount = (jlong) columnCount * rowCapacity;
+    jlong valuesOffset = (WCDBJNIBatchHeaderSize + 4 * cellCount + 7) & ~7;
+    jlong bytesOffset = valuesOffset + 8 * cellCount;
+    if (address == NULL || columnCount <= 0 || rowCapacity <= 0 || bytesOffset > capacity) {
+        return false;
+    }
+    memset(batch, 0, sizeof(CPPHandleStatementBatch));
+    batch->columnCount = columnCount;
+    batch->rowCapacity = rowCapacity;
+    batch->types = (enum WCDBColumnValueType *) (address + WCDBJNIBatchHeaderSize);
+    batch->values = (CPPBatchValue *) (address + valuesOffset);
+    batch->buffer = address + bytesOffset;
+    batch->bufferCapacity = (unsigned int) (capacity - bytesOffset);
+    return true;
+}
+
+jboolean WCDBJNIHandleStatementClassMethod(
+stepBatch, jlong self, jobject buffer, jint columnCount, jint rowCapacity)
+{
+    WCDBJNIBridgeStruct(CPPHandleStatement, self);
+    CPPHandleStatementBatch batch;
+    if (!WCDBJNIMapBatchBuffer(env, buffer, columnCount, rowCapacity, &batch)) {
+        WCDBHandleStatementNotifyBatchMisuse(selfStruct, "Invalid buffer for batch.");
+        return false;
+    }
+    int *header = (int *) (*env)->GetDirectBufferAddress(env, buffer);
+    batch.hasPendingRow = header[1] != 0;
+    jboolean ret = WCDBHandleStatementStepBatch(selfStruct, &batch);
+    header[0] = batch.rowCount;
+    header[1] = batch.hasPendingRow ? 1 : 0;
+    header[2] = (int) batch.requiredBufferSize;
+    return ret;
+}
+
+jboolean WCDBJNIHandleStatementClassMethod(bindBatchRow, jlong self, jobject buffer, jint columnCount)
+{
+    WCDBJNIBridgeStruct(CPPHandleStatement, self);
+    CPPHandleStatementBatch batch;
+    if (!WCDBJNIMapBatchBuffer(env, buffer, columnCount, 1, &batch)) {
+        WCDBHandleStatementNotifyBatchMisuse(selfStruct, "Invalid buffer for batch.");
+        return false;
+    }
+    return WCDBHandleStatementBindBatchRow(selfStruct, &batch, 0);
+}
+
 void WCDBJNIHandleStatementClassMethod(bindInteger, jlong self, jlong value, jint index)
 {
     WCDBJNIBridgeStruct(CPPHandleStatement, self);
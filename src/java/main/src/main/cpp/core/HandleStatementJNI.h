@@ -45,6 +45,9 @@ void WCDBJNIHandleStatementClassMethod(reset, jlong self);
 void WCDBJNIHandleStatementClassMethod(clearBindings, jlong self);
 void WCDBJNIHandleStatementClassMethod(finalize, jlong self);
 jboolean WCDBJNIHandleStatementClassMethod(isDone, jlong self);
+jboolean WCDBJNIHandleStatementClassMethod(
+stepBatch, jlong self, jobject buffer, jint columnCount, jint rowCapacity);
+jboolean WCDBJNIHandleStatementClassMethod(bindBatchRow, jlong self, jobject buffer, jint columnCount);
 void WCDBJNIHandleStatementClassMethod(bindInteger, jlong self, jlong value, jint index);
 void WCDBJNIHandleStatementClassMethod(bindDouble, jlong self, jdouble value, jint index);
 void WCDBJNIHandleStatementClassMethod(bindText, jlong self, jstring value, jint index);
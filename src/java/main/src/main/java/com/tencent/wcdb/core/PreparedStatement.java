@@ -33,6 +33,9 @@ import com.tencent.wcdb.winq.Statement;
 import org.jetbrains.annotations.NotNull;
 import org.jetbrains.annotations.Nullable;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.Collections;
 import java.util.List;
@@ -40,6 +43,7 @@ import java.util.List;
 public class PreparedStatement extends CppObject {
     boolean autoFinalize = false;
     int columnCount = -1;
+    private ByteBuffer batchBuffer = null;
 
     PreparedStatement(long cppObj) {
         this.cppObj = cppObj;
@@ -331,15 +335,72 @@ public class PreparedStatement extends CppObject {
      * It will call the appropriate routine according to the column type returned by {@code value.getType()}.
      *
      * @param row An array of value.
+     * @throws WCDBException if the row can not be passed to native.
      */
-    public void bindRow(@NotNull Value[] row) {
-        int index = 1;
-        for (Value value : row) {
-            bindValue(value, index);
-            index++;
+    public void bindRow(@NotNull Value[] row) throws WCDBException {
+        int count = row.length;
+        if (count == 0) {
+            return;
+        }
+        // Bind the whole row with one native call, passing texts as UTF-8 bytes.
+        byte[][] contents = new byte[count][];
+        int bytesLength = 0;
+        for (int i = 0; i < count; i++) {
+            Value value = row[i];
+            if (value == null) {
+                continue;
+            }
+            ColumnType type = value.getType();
+            if (type == ColumnType.Text) {
+                contents[i] = value.getText().getBytes(StandardCharsets.UTF_8);
+            } else if (type == ColumnType.BLOB) {
+                contents[i] = value.getBLOB();
+            }
+            if (contents[i] != null) {
+                bytesLength += contents[i].length;
+            }
+        }
+        int valuesOffset = getBatchValuesOffset(count);
+        int bytesOffset = getBatchBytesOffset(count);
+        ByteBuffer buffer = getBatchBuffer(bytesOffset + bytesLength);
+        int bytesUsed = 0;
+        for (int i = 0; i < count; i++) {
+            Value value = row[i];
+            int typeIndex = batchHeaderSize + 4 * i;
+            int valueIndex = valuesOffset + 8 * i;
+            ColumnType type = value != null ? value.getType() : ColumnType.Null;
+            switch (type) {
+                case Integer:
+                    buffer.putInt(typeIndex, batchTypeInteger);
+                    buffer.putLong(valueIndex, value.getLong());
+                    break;
+                case Float:
+                    buffer.putInt(typeIndex, batchTypeFloat);
+                    buffer.putDouble(valueIndex, value.getDouble());
+                    break;
+                case Text:
+                case BLOB:
+                    byte[] content = contents[i];
+                    buffer.putInt(typeIndex, type == ColumnType.Text ? batchTypeText : batchTypeBLOB);
+                    buffer.putInt(valueIndex, bytesUsed);
+                    buffer.putInt(valueIndex + 4, content.length);
+                    buffer.position(bytesOffset + bytesUsed);
+                    buffer.put(content);
+                    bytesUsed += content.length;
+                    break;
+                default:
+                    buffer.putInt(typeIndex, batchTypeNull);
+                    buffer.putLong(valueIndex, 0);
+                    break;
+            }
+        }
+        if (!bindBatchRow(cppObj, buffer, count)) {
+            throw createException();
         }
     }
 
+    private static native boolean bindBatchRow(long self, ByteBuffer buffer, int columnCount);
+
     /**
      * The wrapper of {@code sqlite3_bind_*} for binding all fields of object.
      * It will call the appropriate routine according to the data type of field.
@@ -651,12 +712,98 @@ public class PreparedStatement extends CppObject {
     @NotNull
     public List<Value[]> getMultiRows() throws WCDBException {
         List<Value[]> rows = new ArrayList<Value[]>();
-        step();
-        while (!isDone(cppObj)) {
-            rows.add(getOneRow());
+        int count = getColumnCount();
+        if (count == 0) {
             step();
+            while (!isDone(cppObj)) {
+                rows.add(getOneRow());
+                step();
+            }
+            return rows;
+        }
+        // Fetch rows in batches through a direct buffer to avoid a native call for each value.
+        int rowCapacity = Math.max(1, batchCellCapacity / count);
+        int cellCount = rowCapacity * count;
+        int valuesOffset = getBatchValuesOffset(cellCount);
+        int bytesOffset = getBatchBytesOffset(cellCount);
+        ByteBuffer buffer = getBatchBuffer(bytesOffset + batchBytesCapacity);
+        buffer.putInt(4, 0);
+        while (true) {
+            if (!stepBatch(cppObj, buffer, count, rowCapacity)) {
+                if (autoFinalize) {
+                    finalizeStatement();
+                }
+                throw createException();
+            }
+            int rowCount = buffer.getInt(0);
+            boolean hasPendingRow = buffer.getInt(4) != 0;
+            for (int i = 0; i < rowCount; i++) {
+                Value[] row = new Value[count];
+                for (int j = 0; j < count; j++) {
+                    int cell = i * count + j;
+                    int valueIndex = valuesOffset + 8 * cell;
+                    switch (buffer.getInt(batchHeaderSize + 4 * cell)) {
+                        case batchTypeInteger:
+                            row[j] = new Value(buffer.getLong(valueIndex));
+                            break;
+                        case batchTypeFloat:
+                            row[j] = new Value(buffer.getDouble(valueIndex));
+                            break;
+                        case batchTypeText:
+                            row[j] = new Value(new String(getBatchBytes(buffer, bytesOffset, valueIndex), StandardCharsets.UTF_8));
+                            break;
+                        case batchTypeBLOB:
+                            row[j] = new Value(getBatchBytes(buffer, bytesOffset, valueIndex));
+                            break;
+                        default:
+                            row[j] = new Value();
+                            break;
+                    }
+                }
+                rows.add(row);
+            }
+            if (hasPendingRow && rowCount == 0) {
+                // The pending row is larger than the whole buffer.
+                buffer = getBatchBuffer(bytesOffset + buffer.getInt(8));
+                buffer.putInt(4, 1);
+            } else if (!hasPendingRow && rowCount < rowCapacity) {
+                return rows;
+            }
+        }
+    }
+
+    private static native boolean stepBatch(long self, ByteBuffer buffer, int columnCount, int rowCapacity);
+
+    // The layout of batch buffer is documented in HandleStatementJNI.c.
+    private static final int batchHeaderSize = 16;
+    private static final int batchCellCapacity = 4096;
+    private static final int batchBytesCapacity = 64 * 1024;
+    private static final int batchTypeInteger = 1;
+    private static final int batchTypeFloat = 2;
+    private static final int batchTypeText = 3;
+    private static final int batchTypeBLOB = 4;
+    private static final int batchTypeNull = 5;
+
+    private static int getBatchValuesOffset(int cellCount) {
+        return (batchHeaderSize + 4 * cellCount + 7) & ~7;
+    }
+
+    private static int getBatchBytesOffset(int cellCount) {
+        return getBatchValuesOffset(cellCount) + 8 * cellCount;
+    }
+
+    private ByteBuffer getBatchBuffer(int capacity) {
+        if (batchBuffer == null || batchBuffer.capacity() < capacity) {
+            batchBuffer = ByteBuffer.allocateDirect(capacity).order(ByteOrder.nativeOrder());
         }
-        return rows;
+        return batchBuffer;
+    }
+
+    private static byte[] getBatchBytes(ByteBuffer buffer, int bytesOffset, int valueIndex) {
+        byte[] bytes = new byte[buffer.getInt(valueIndex + 4)];
+        buffer.position(bytesOffset + buffer.getInt(valueIndex));
+        buffer.get(bytes);
+        return bytes;
     }
 
     /**
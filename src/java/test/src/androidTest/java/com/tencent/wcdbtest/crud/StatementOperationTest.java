@@ -28,6 +28,7 @@ import com.tencent.wcdb.base.WCDBException;
 import com.tencent.wcdb.core.PreparedStatement;
 import com.tencent.wcdb.winq.BindParameter;
 import com.tencent.wcdb.winq.Column;
+import com.tencent.wcdb.winq.Order;
 import com.tencent.wcdb.winq.Pragma;
 import com.tencent.wcdb.winq.StatementDelete;
 import com.tencent.wcdb.winq.StatementInsert;
@@ -41,6 +42,7 @@ import static org.junit.Assert.*;
 import org.junit.Before;
 import org.junit.Test;
 
+import java.util.List;
 import java.util.Random;
 
 public class StatementOperationTest extends ValueCRUDTestCase {
@@ -276,4 +278,32 @@ public class StatementOperationTest extends ValueCRUDTestCase {
         assertEquals(prepareSelect.getText(0), value);
         prepareSelect.finalizeStatement();
     }
+
+    @Test
+    public void testBindRowAndGetMultiRowsInBatch() throws WCDBException {
+        handle.execute(new StatementDelete().deleteFrom(tableName));
+        StringBuilder builder = new StringBuilder();
+        for (int i = 0; i < 200 * 1024; i++) {
+            builder.append('\u4e2d');
+        }
+        String largeText = builder.toString();
+        PreparedStatement preparedInsert = handle.getOrCreatePreparedStatement(
+                new StatementInsert().insertInto(tableName).columns(columns()).valuesWithBindParameters(2));
+        for (int i = 1; i <= 5000; i++) {
+            preparedInsert.reset();
+            preparedInsert.bindRow(new Value[]{new Value(i), new Value(i == 2500 ? largeText : "text" + i)});
+            preparedInsert.step();
+        }
+        preparedInsert.finalizeStatement();
+
+        PreparedStatement prepareSelect = handle.getOrCreatePreparedStatement(
+                new StatementSelect().select(columns()).from(tableName).orderBy(new Column("id").order(Order.Asc)));
+        List<Value[]> result = prepareSelect.getMultiRows();
+        prepareSelect.finalizeStatement();
+        assertEquals(result.size(), 5000);
+        assertEquals(result.get(0)[0].getLong(), 1);
+        assertEquals(result.get(0)[1].getText(), "text1");
+        assertEquals(result.get(2499)[1].getText(), largeText);
+        assertEquals(result.get(4999)[1].getText(), "text5000");
+    }
 }
@@ -0,0 +1,103 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "Cell.hpp"
+#import "Page.hpp"
+#import "Pager.hpp"
+#import "SizeBasedFactory.h"
+#import "TestCase.h"
+
+@interface PageParseBenchmark : Benchmark
+
+@end
+
+@implementation PageParseBenchmark {
+    SizeBasedFactory* _factory;
+}
+
+- (SizeBasedFactory*)factory
+{
+    @synchronized(self) {
+        if (_factory == nil) {
+            _factory = [[SizeBasedFactory alloc] initWithDirectory:self.class.cacheRoot];
+        }
+        return _factory;
+    }
+}
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.factory.needCipher = NO;
+    [self.database setCipherKey:nil];
+    self.factory.quality = 100 * 1024 * 1024;
+    self.factory.tolerance = 0.02;
+}
+
+- (void)setUpDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+    [self.factory produce:self.path];
+}
+
+- (void)tearDownDatabase
+{
+    TestCaseAssertTrue([self.database removeFiles]);
+}
+
+- (void)test_parse_pages
+{
+    __block BOOL result;
+    __block int numberOfCells;
+    [self
+    doMeasure:^{
+        WCDB::Repair::Pager pager(self.path.UTF8String);
+        result = pager.initialize();
+        for (int pageno = 1; result && pageno <= pager.getNumberOfPages(); ++pageno) {
+            WCDB::Repair::Page page(pageno, &pager);
+            result = page.initialize();
+            if (!result
+                || page.getType() == WCDB::Repair::Page::Type::Unknown
+                || page.getType() == WCDB::Repair::Page::Type::InteriorTable) {
+                continue;
+            }
+            for (int i = 0; result && i < page.getNumberOfCells(); ++i) {
+                WCDB::Repair::Cell cell = page.getCell(i);
+                result = cell.initialize();
+                ++numberOfCells;
+            }
+        }
+    }
+    setUp:^{
+        [self setUpDatabase];
+        numberOfCells = 0;
+    }
+    tearDown:^{
+        [self tearDownDatabase];
+        result = NO;
+    }
+    checkCorrectness:^{
+        TestCaseAssertTrue(result);
+        TestCaseAssertTrue(numberOfCells > 0);
+    }];
+}
+
+@end
@@ -0,0 +1,140 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#import "TestCase.h"
+#include "ThreadLocal.hpp"
+#include <map>
+#include <thread>
+
+namespace ThreadLocalBenchmark {
+
+// The per-thread map based implementation that ThreadLocal used to be.
+template<typename T>
+class MapBasedThreadLocal {
+public:
+    MapBasedThreadLocal() : m_identifier(++s_identifier), m_default() {}
+
+    T& getOrCreate()
+    {
+        thread_local std::map<unsigned int, T> s_storage;
+        auto iter = s_storage.find(m_identifier);
+        if (iter == s_storage.end()) {
+            iter = s_storage.emplace(m_identifier, m_default).first;
+        }
+        return iter->second;
+    }
+
+private:
+    static std::atomic<unsigned int> s_identifier;
+    const unsigned int m_identifier;
+    const T m_default;
+};
+
+template<typename T>
+std::atomic<unsigned int> MapBasedThreadLocal<T>::s_identifier(0);
+
+static constexpr const int NumberOfThreadLocals = 64;
+static constexpr const int NumberOfAccesses = 10000000;
+
+} // namespace ThreadLocalBenchmark
+
+@interface ThreadLocalBenchmark : BaseTestCase
+
+@end
+
+@implementation ThreadLocalBenchmark
+
+- (double)nanosecondsPerAccess:(int (^)(int))access
+{
+    int sum = 0;
+    NSDate* start = [NSDate date];
+    for (int i = 0; i < ThreadLocalBenchmark::NumberOfAccesses; ++i) {
+        sum += access(i % ThreadLocalBenchmark::NumberOfThreadLocals);
+    }
+    double cost = [[NSDate date] timeIntervalSinceDate:start];
+    TestCaseAssertTrue(sum != 0);
+    return cost * 1E9 / ThreadLocalBenchmark::NumberOfAccesses;
+}
+
+- (void)test_get_or_create
+{
+    auto slotBased = new WCDB::ThreadLocal<int>[ThreadLocalBenchmark::NumberOfThreadLocals];
+    auto mapBased = new ThreadLocalBenchmark::MapBasedThreadLocal<int>[ThreadLocalBenchmark::NumberOfThreadLocals];
+
+    double slotBasedCost = [self nanosecondsPerAccess:^int(int index) {
+        return ++slotBased[index].getOrCreate();
+    }];
+    double mapBasedCost = [self nanosecondsPerAccess:^int(int index) {
+        return ++mapBased[index].getOrCreate();
+    }];
+    TestCaseLog(@"Slot based: %.2f ns/access, map based: %.2f ns/access", slotBasedCost, mapBasedCost);
+
+    delete[] slotBased;
+    delete[] mapBased;
+#if DEBUG || TARGET_IPHONE_SIMULATOR
+    TestCaseLog(@"Benchmark is run in debug mode or simulator. The result may be untrusted.");
+#endif
+}
+
+- (void)test_create_and_destroy
+{
+    NSDate* start = [NSDate date];
+    for (int i = 0; i < ThreadLocalBenchmark::NumberOfAccesses / ThreadLocalBenchmark::NumberOfThreadLocals; ++i) {
+        WCDB::ThreadLocal<int> threadLocal;
+        threadLocal.getOrCreate() = i;
+    }
+    double cost = [[NSDate date] timeIntervalSinceDate:start];
+    TestCaseLog(@"Slot based: %.2f ns/lifetime", cost * 1E9 * ThreadLocalBenchmark::NumberOfThreadLocals / ThreadLocalBenchmark::NumberOfAccesses);
+#if DEBUG || TARGET_IPHONE_SIMULATOR
+    TestCaseLog(@"Benchmark is run in debug mode or simulator. The result may be untrusted.");
+#endif
+}
+
+- (void)test_get_or_create_while_churning
+{
+    // Accesses should not be slowed down by the ThreadLocals created and destroyed on other threads, e.g. by the churn of handles.
+    auto threadLocals = new WCDB::ThreadLocal<int>[ThreadLocalBenchmark::NumberOfThreadLocals];
+    double quietCost = [self nanosecondsPerAccess:^int(int index) {
+        return ++threadLocals[index].getOrCreate();
+    }];
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> numberOfLifetimes(0);
+    std::thread churner([&]() {
+        while (!stop.load()) {
+            WCDB::ThreadLocal<int> threadLocal;
+            threadLocal.getOrCreate() = 1;
+            ++numberOfLifetimes;
+        }
+    });
+    double churningCost = [self nanosecondsPerAccess:^int(int index) {
+        return ++threadLocals[index].getOrCreate();
+    }];
+    stop.store(true);
+    churner.join();
+    TestCaseLog(@"Quiet: %.2f ns/access, churning: %.2f ns/access with %d lifetimes", quietCost, churningCost, numberOfLifetimes.load());
+
+    delete[] threadLocals;
+#if DEBUG || TARGET_IPHONE_SIMULATOR
+    TestCaseLog(@"Benchmark is run in debug mode or simulator. The result may be untrusted.");
+#endif
+}
+
+@end
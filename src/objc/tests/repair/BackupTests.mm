@@ -348,4 +348,45 @@
     XCTAssertTrue(tested);
 }
 
+- (void)test_incremental_backup_with_checkpointed_leaves
+{
+    __block BOOL incremental = NO;
+    __block long long bytesRead = 0;
+    __block long long estimatedInteriorBytesSkipped = 0;
+    [self.database traceError:^(WCTError *error) {
+        if (error.level == WCTErrorLevelNotice
+            && [error.message isEqualToString:@"Backup End."]) {
+            NSDictionary *userInfo = error.userInfo;
+            incremental = ((NSNumber *) [userInfo objectForKey:@"Incremental"]).boolValue;
+            bytesRead = ((NSNumber *) [userInfo objectForKey:@"BytesRead"]).longLongValue;
+            estimatedInteriorBytesSkipped = ((NSNumber *) [userInfo objectForKey:@"EstimatedInteriorBytesSkipped"]).longLongValue;
+        }
+    }];
+    [self.database enableAutoCheckpoint:NO];
+    [self.database enableAutoBackup:YES];
+    XCTAssertTrue([self createTable]);
+    TestCaseAssertTrue([self.table insertObjects:[Random.shared autoIncrementTestCaseObjectsWithCount:1000]]);
+    TestCaseAssertTrue([self.database passiveCheckpoint]);
+    [NSThread sleepForTimeInterval:WCDB::OperationQueueTimeIntervalForBackup + self.delayForTolerance];
+    TestCaseAssertTrue([self.fileManager fileExistsAtPath:self.database.firstMaterialPath]);
+    TestCaseAssertFalse(incremental);
+    long long bytesReadByFullBackup = bytesRead;
+    TestCaseAssertTrue(bytesReadByFullBackup > 0);
+
+    // Leaves updated in place are backed up from the hashes taken at checkpoint, without crawling interior pages.
+    TestCaseAssertTrue([self.table updateProperty:TestCaseObject.content toValue:@"abc" where:TestCaseObject.identifier == 1 || TestCaseObject.identifier == 1000]);
+    TestCaseAssertTrue([self.database passiveCheckpoint]);
+    usleep(10000);
+    TestCaseAssertTrue([self.fileManager fileExistsAtPath:self.database.lastMaterialPath]);
+    TestCaseAssertTrue(incremental);
+    // The skipped bytes are only estimated, so compare the bytes really read with the full backup instead.
+    TestCaseAssertTrue(estimatedInteriorBytesSkipped > 0);
+    TestCaseAssertTrue(bytesRead < bytesReadByFullBackup);
+
+    [self.database corruptPage:1];
+    TestCaseAssertTrue([self.database retrieve:nil] > 0);
+    NSArray<TestCaseObject *> *objects = [self.table getObjectsWhere:TestCaseObject.content == @"abc"];
+    TestCaseAssertTrue(objects.count == 2);
+}
+
 @end
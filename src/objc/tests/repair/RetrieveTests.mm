@@ -312,6 +312,90 @@
     }];
 }
 
+#pragma mark - Failed Cells
+- (void)doInsertCellsFailingToBeRetrieved
+{
+    // The checks are ignored here so that the invalid rows fail when they are assembled.
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE TABLE checkedTable(id INTEGER PRIMARY KEY, value INTEGER CHECK(abs(value) >= 0) CHECK(value >= 0), content TEXT)"]);
+    WCTHandle* handle = [self.database getHandle];
+    TestCaseAssertTrue([handle rawExecute:@"PRAGMA ignore_check_constraints = 1"]);
+    // Every tenth row violates a constraint, and the abs of the minimum integer is an intolerable error.
+    TestCaseAssertTrue([handle rawExecute:@"WITH RECURSIVE seq(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM seq WHERE i < 2000) "
+                                           "INSERT INTO checkedTable SELECT i, "
+                                           "CASE WHEN i % 10 == 0 THEN -1 WHEN i == 1501 THEN -9223372036854775808 ELSE i END, "
+                                           "hex(randomblob(100)) FROM seq"]);
+    TestCaseAssertTrue([handle rawExecute:@"PRAGMA ignore_check_constraints = 0"]);
+    [handle invalidate];
+}
+
+- (void)test_retrieve_score_with_failed_cells
+{
+    [self doInsertCellsFailingToBeRetrieved];
+    [self.database close];
+
+    double score = [self.database retrieve:nil];
+    TestCaseAssertTrue(score > 0);
+    // The failed cells must not be counted.
+    TestCaseAssertTrue(score < 1.0);
+
+    // The cells after an intolerable one in the same buffer are still retrieved.
+    WCTValue* count = [self.database getValueFromStatement:WCDB::StatementSelect().select(WCDB::Column::all().count()).from(@"checkedTable")];
+    TestCaseAssertEqual(count.numberValue.intValue, 1799);
+    WCTValue* value = [self.database getValueFromStatement:WCDB::StatementSelect().select(WCDB::Column("value")).from(@"checkedTable").where(WCDB::Column("id") == 1999)];
+    TestCaseAssertEqual(value.numberValue.intValue, 1999);
+}
+
+- (void)test_retrieve_deferred_sqls_with_failed_cells
+{
+    [self doInsertCellsFailingToBeRetrieved];
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE INDEX checkedIndex ON checkedTable(value)"]);
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE TRIGGER checkedTrigger AFTER DELETE ON checkedTable BEGIN SELECT 1; END"]);
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE VIEW checkedView AS SELECT id FROM checkedTable"]);
+    [self.database close];
+
+    TestCaseAssertTrue([self.database retrieve:nil] > 0);
+
+    // Indexes, triggers and views are created at the end of the assembling, no matter whether some cells failed.
+    NSArray<WCTMaster*>* masters = [self.database getObjectsOfClass:WCTMaster.class fromTable:WCTMaster.tableName where:WCTMaster.tblName == @"checkedTable"];
+    NSMutableSet<NSString*>* names = [NSMutableSet set];
+    for (WCTMaster* master in masters) {
+        [names addObject:master.name];
+    }
+    TestCaseAssertTrue([names containsObject:@"checkedIndex"]);
+    TestCaseAssertTrue([names containsObject:@"checkedTrigger"]);
+    TestCaseAssertTrue([names containsObject:@"checkedView"]);
+}
+
+- (void)test_retrieve_duplicated_keys_under_unique_index
+{
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE TABLE duplicatedTable(id INTEGER PRIMARY KEY, key INTEGER)"]);
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE INDEX duplicatedIndex ON duplicatedTable(key)"]);
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE TRIGGER duplicatedTrigger AFTER DELETE ON duplicatedTable BEGIN SELECT 1; END"]);
+    TestCaseAssertTrue([self.database rawExecute:@"CREATE VIEW duplicatedView AS SELECT id FROM duplicatedTable"]);
+    TestCaseAssertTrue([self.database rawExecute:@"WITH RECURSIVE seq(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM seq WHERE i < 100) "
+                                                  "INSERT INTO duplicatedTable SELECT i, i % 10 FROM seq"]);
+    // Corrupted data may contain duplicated keys under a unique index.
+    WCTHandle* handle = [self.database getHandle];
+    TestCaseAssertTrue([handle execute:WCDB::StatementPragma().pragma(WCDB::Pragma::writableSchema()).to(true)]);
+    TestCaseAssertTrue([handle rawExecute:@"UPDATE sqlite_master SET sql = 'CREATE UNIQUE INDEX duplicatedIndex ON duplicatedTable(key)' WHERE name = 'duplicatedIndex'"]);
+    [handle invalidate];
+    [self.database close];
+
+    TestCaseAssertTrue([self.database retrieve:nil] > 0);
+
+    WCTValue* count = [self.database getValueOnResultColumn:WCDB::Column::all().count() fromTable:@"duplicatedTable"];
+    TestCaseAssertEqual(count.numberValue.intValue, 100);
+    // The unique index is skipped, while the others after it are still created.
+    NSArray<WCTMaster*>* masters = [self.database getObjectsOfClass:WCTMaster.class fromTable:WCTMaster.tableName where:WCTMaster.tblName == @"duplicatedTable"];
+    NSMutableSet<NSString*>* names = [NSMutableSet set];
+    for (WCTMaster* master in masters) {
+        [names addObject:master.name];
+    }
+    TestCaseAssertFalse([names containsObject:@"duplicatedIndex"]);
+    TestCaseAssertTrue([names containsObject:@"duplicatedTrigger"]);
+    TestCaseAssertTrue([names containsObject:@"duplicatedView"]);
+}
+
 #ifndef WCDB_QUICK_TESTS
 - (void)test_backup_huge_database
 {
@@ -89,6 +89,34 @@ static void* threadEntry(void*)
 
 } // namespace ThreadLocalStressTest
 
+namespace ThreadLocalReclamationTest {
+
+static int s_aliveCount = 0;
+
+struct Counted {
+    Counted() { ++s_aliveCount; }
+    Counted(const Counted&) { ++s_aliveCount; }
+    ~Counted() { --s_aliveCount; }
+};
+
+struct Reentrant;
+static WCDB::ThreadLocal<Reentrant>* s_reentered = nullptr;
+static std::atomic<int> s_numberOfReentrances(0);
+
+struct Reentrant {
+    bool reenter = false;
+    ~Reentrant()
+    {
+        if (reenter && s_reentered != nullptr) {
+            // It accesses a ThreadLocal of the same type while being reclaimed.
+            s_reentered->getOrCreate();
+            ++s_numberOfReentrances;
+        }
+    }
+};
+
+} // namespace ThreadLocalReclamationTest
+
 static size_t getPhysicalFootprint()
 {
     task_vm_info_data_t vmInfo;
@@ -523,6 +551,49 @@ static size_t getPhysicalFootprint()
     TestCaseAssertTrue(growth < 2 * 1024 * 1024);
 }
 
+// The value of a destroyed ThreadLocal should be released on the next access of the same thread,
+// and its slot should be reused without exposing the stale value.
+- (void)test_threadLocal_reclaim_after_destruction
+{
+    using namespace ThreadLocalReclamationTest;
+    int aliveCount = s_aliveCount;
+    {
+        auto threadLocal = new WCDB::ThreadLocal<Counted>();
+        threadLocal->getOrCreate();
+        TestCaseAssertEqual(s_aliveCount, aliveCount + 2);
+        delete threadLocal;
+        TestCaseAssertEqual(s_aliveCount, aliveCount + 1);
+
+        WCDB::ThreadLocal<Counted> reused;
+        reused.getOrCreate();
+        TestCaseAssertEqual(s_aliveCount, aliveCount + 2);
+    }
+    TestCaseAssertEqual(s_aliveCount, aliveCount + 1);
+
+    auto intThreadLocal = new WCDB::ThreadLocal<int>(1);
+    intThreadLocal->getOrCreate() = 2;
+    delete intThreadLocal;
+    WCDB::ThreadLocal<int> reusedIntThreadLocal(3);
+    TestCaseAssertEqual(reusedIntThreadLocal.getOrCreate(), 3);
+}
+
+- (void)test_threadLocal_reentered_while_reclaiming
+{
+    using namespace ThreadLocalReclamationTest;
+    WCDB::ThreadLocal<Reentrant> reentered;
+    s_reentered = &reentered;
+    int numberOfReentrances = s_numberOfReentrances.load();
+
+    auto threadLocal = new WCDB::ThreadLocal<Reentrant>();
+    threadLocal->getOrCreate().reenter = true;
+    delete threadLocal;
+    // The stale value is destroyed while the slot is reused, without deadlock.
+    WCDB::ThreadLocal<Reentrant> reused;
+    TestCaseAssertFalse(reused.getOrCreate().reenter);
+    TestCaseAssertEqual(s_numberOfReentrances.load(), numberOfReentrances + 1);
+    s_reentered = nullptr;
+}
+
 - (void)test_multithread_with_error
 {
     for (int i = 0; i < 10000; i++) {
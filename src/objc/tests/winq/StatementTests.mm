@@ -50,4 +50,24 @@
     TestCaseAssertSQLEqual(statement3, @"INSERT INTO testTable VALUES(1)");
 }
 
+- (void)test_move_syntax
+{
+    WCDB::StatementSelect select = WCDB::StatementSelect().select(WCDB::Column("a")).from("testTable").where(WCDB::Column("a") == 1 && WCDB::Column("b").in({ 1, 2 }));
+    WCDB::StatementSelect moved(std::move(select.syntax()));
+    TestCaseAssertSQLEqual(moved, @"SELECT a FROM testTable WHERE (a == 1) AND (b IN(1, 2))");
+    WCDB::StatementSelect copied = moved;
+    copied.limit(1);
+    TestCaseAssertSQLEqual(copied, @"SELECT a FROM testTable WHERE (a == 1) AND (b IN(1, 2)) LIMIT 1");
+    TestCaseAssertSQLEqual(moved, @"SELECT a FROM testTable WHERE (a == 1) AND (b IN(1, 2))");
+}
+
+- (void)test_interned_identifier
+{
+    std::string name = "internedColumn";
+    WCDB::Column column1(name);
+    WCDB::Column column2(name);
+    TestCaseAssertTrue(column1.syntax().name.data() == column2.syntax().name.data());
+    TestCaseAssertTrue(column1.syntax().name.data() != name.data());
+}
+
 @end
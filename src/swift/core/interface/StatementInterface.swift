@@ -378,9 +378,84 @@ extension StatementInterface where Self: RawStatementmentRepresentable {
     }
 
     public func multiRowsValue() throws -> MultiRowsValue {
+        let columnCount = self.columnCount()
+        guard columnCount > 0 else {
+            var rows: MultiRowsValue = []
+            while try step() {
+                rows.append(oneRowValue())
+            }
+            return rows
+        }
+        // Fetch rows in batches to avoid crossing the bridge for each cell.
+        let rowCapacity = max(1, StatementBatch.cellCapacity / columnCount)
+        var types = [WCDBColumnValueType](repeating: WCDBColumnValueTypeNull, count: rowCapacity * columnCount)
+        var values = [CPPBatchValue](repeating: CPPBatchValue(), count: rowCapacity * columnCount)
+        var buffer = [UInt8](repeating: 0, count: StatementBatch.bufferSize)
         var rows: MultiRowsValue = []
-        while try step() {
-            rows.append(oneRowValue())
+        var hasPendingRow = false
+        var done = false
+        while !done {
+            var requiredBufferSize = 0
+            let succeed = types.withUnsafeMutableBufferPointer { typesPointer in
+                values.withUnsafeMutableBufferPointer { valuesPointer in
+                    buffer.withUnsafeMutableBufferPointer { bufferPointer -> Bool in
+                        var batch = CPPHandleStatementBatch(columnCount: Int32(columnCount),
+                                                            rowCapacity: Int32(rowCapacity),
+                                                            types: typesPointer.baseAddress!,
+                                                            values: valuesPointer.baseAddress!,
+                                                            buffer: bufferPointer.baseAddress,
+                                                            bufferCapacity: UInt32(bufferPointer.count),
+                                                            rowCount: 0,
+                                                            bufferUsed: 0,
+                                                            hasPendingRow: hasPendingRow,
+                                                            requiredBufferSize: 0)
+                        guard WCDBHandleStatementStepBatch(getRawStatement(), &batch) else {
+                            return false
+                        }
+                        for row in 0..<Int(batch.rowCount) {
+                            var oneRow: OneRowValue = []
+                            oneRow.reserveCapacity(columnCount)
+                            for column in 0..<columnCount {
+                                let index = row * columnCount + column
+                                let value = valuesPointer[index]
+                                switch typesPointer[index] {
+                                case WCDBColumnValueTypeInterger:
+                                    oneRow.append(Value(value.intValue))
+                                case WCDBColumnValueTypeFloat:
+                                    oneRow.append(Value(value.doubleValue))
+                                case WCDBColumnValueTypeString:
+                                    let begin = Int(value.bytes.offset)
+                                    let bytes = UnsafeBufferPointer(rebasing: bufferPointer[begin..<begin + Int(value.bytes.length)])
+                                    oneRow.append(Value(String(decoding: bytes, as: UTF8.self)))
+                                case WCDBColumnValueTypeBLOB:
+                                    let begin = Int(value.bytes.offset)
+                                    let bytes = UnsafeBufferPointer(rebasing: bufferPointer[begin..<begin + Int(value.bytes.length)])
+                                    oneRow.append(Value(Data(buffer: bytes)))
+                                default:
+                                    oneRow.append(Value(nil))
+                                }
+                            }
+                            rows.append(oneRow)
+                        }
+                        hasPendingRow = batch.hasPendingRow
+                        if hasPendingRow && batch.rowCount == 0 {
+                            requiredBufferSize = Int(batch.requiredBufferSize)
+                        }
+                        done = !hasPendingRow && batch.rowCount < batch.rowCapacity
+                        return true
+                    }
+                }
+            }
+            guard succeed else {
+                let cppError = WCDBHandleStatementGetError(getRawStatement())
+                if finalizeWhenError() {
+                    finalize()
+                }
+                throw ErrorBridge.getErrorFrom(cppError: cppError)
+            }
+            if requiredBufferSize > buffer.count {
+                buffer = [UInt8](repeating: 0, count: requiredBufferSize)
+            }
         }
         return rows
     }
@@ -508,3 +583,8 @@ extension StatementInterface where Self: RawStatementmentRepresentable {
         return String(cString: cString)
     }
 }
+
+fileprivate enum StatementBatch {
+    static let cellCapacity = 4096
+    static let bufferSize = 64 * 1024
+}
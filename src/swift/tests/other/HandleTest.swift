@@ -25,8 +25,10 @@
 import XCTest
 #if TEST_WCDB_SWIFT
 import WCDBSwift
+import WCDBSwift.Private
 #else
 import WCDB
+import WCDB.Private
 #endif
 
 class HandleTests: DatabaseTestCase, @unchecked Sendable {
@@ -71,6 +73,152 @@ class HandleTests: DatabaseTestCase, @unchecked Sendable {
         self.database.traceError(nil)
     }
 
+    func testGetRowsInBatches() {
+        XCTAssertNoThrow(try database.create(table: TestObject.name, of: TestObject.self))
+        var objects: [TestObject] = []
+        for i in 0..<5000 {
+            objects.append(TestObject(variable1: i, variable2: "\(i)"))
+        }
+        // Larger than the default batch buffer.
+        let largeText = String(repeating: "a", count: 200 * 1024)
+        objects.append(TestObject(variable1: 5000, variable2: largeText))
+        objects.append(TestObject(variable1: 5001, variable2: nil))
+        XCTAssertNoThrow(try database.insert(objects, intoTable: TestObject.name))
+
+        let rows: MultiRowsValue = WCDBAssertNoThrowReturned(
+            try database.getRows(from: StatementSelect().select(TestObject.Properties.all).from(TestObject.name).order(by: TestObject.Properties.variable1)),
+            whenFailed: []
+        )
+        XCTAssertEqual(rows.count, objects.count)
+        XCTAssertEqual(rows[row: 1234, column: 0].int64Value, 1234)
+        XCTAssertEqual(rows[row: 1234, column: 1].stringValue, "1234")
+        XCTAssertEqual(rows[row: 5000, column: 1].stringValue, largeText)
+        XCTAssertEqual(rows[row: 5001, column: 1].type, .null)
+    }
+
+    func testBindAndStepInBatches() {
+        XCTAssertNoThrow(try database.create(table: TestObject.name, of: TestObject.self))
+        var constraintErrorCount = 0
+        database.traceError { error in
+            if error.level == .Error && error.code == .Constraint {
+                constraintErrorCount += 1
+            }
+        }
+        let handle = WCDBAssertNoThrowReturned(try database.getHandle())!
+        XCTAssertNoThrow(try handle.prepare(StatementInsert().insert(intoTable: TestObject.name).values(BindParameter.bindParameters(2))))
+
+        // The third row conflicts with the first one, so that the batch stops there.
+        let identifiers: [Int64] = [1, 2, 1, 3]
+        let columnCount = 2
+        var types = [WCDBColumnValueType](repeating: WCDBColumnValueTypeNull, count: identifiers.count * columnCount)
+        var values = [CPPBatchValue](repeating: CPPBatchValue(), count: identifiers.count * columnCount)
+        var buffer: [UInt8] = []
+        for (row, identifier) in identifiers.enumerated() {
+            types[row * columnCount] = WCDBColumnValueTypeInterger
+            values[row * columnCount].intValue = identifier
+            let text = Array("\(row)".utf8)
+            types[row * columnCount + 1] = WCDBColumnValueTypeString
+            values[row * columnCount + 1].bytes.offset = UInt32(buffer.count)
+            values[row * columnCount + 1].bytes.length = UInt32(text.count)
+            buffer.append(contentsOf: text)
+        }
+
+        var rowCount: Int32 = 0
+        let succeed = types.withUnsafeMutableBufferPointer { typesPointer in
+            values.withUnsafeMutableBufferPointer { valuesPointer in
+                buffer.withUnsafeMutableBufferPointer { bufferPointer -> Bool in
+                    var batch = CPPHandleStatementBatch(columnCount: Int32(columnCount),
+                                                        rowCapacity: Int32(identifiers.count),
+                                                        types: typesPointer.baseAddress!,
+                                                        values: valuesPointer.baseAddress!,
+                                                        buffer: bufferPointer.baseAddress,
+                                                        bufferCapacity: UInt32(bufferPointer.count),
+                                                        rowCount: Int32(identifiers.count),
+                                                        bufferUsed: UInt32(bufferPointer.count),
+                                                        hasPendingRow: false,
+                                                        requiredBufferSize: 0)
+                    let succeed = WCDBHandleStatementBindAndStepBatch(handle.getRawStatement(), &batch)
+                    rowCount = batch.rowCount
+                    return succeed
+                }
+            }
+        }
+        XCTAssertFalse(succeed)
+        // Only the rows before the failed one are reported.
+        XCTAssertEqual(rowCount, 2)
+        XCTAssertEqual(constraintErrorCount, 1)
+        handle.finalize()
+        database.traceError(nil)
+
+        let objects: [TestObject] = WCDBAssertNoThrowReturned(
+            try database.getObjects(fromTable: TestObject.name, orderBy: [TestObject.Properties.variable1.order(.ascending)]),
+            whenFailed: [TestObject]()
+        )
+        XCTAssertEqual(objects.map { $0.variable1 }, [1, 2])
+        XCTAssertEqual(objects.map { $0.variable2 }, ["0", "1"])
+    }
+
+    func testBindInvalidBatchRow() {
+        XCTAssertNoThrow(try database.create(table: TestObject.name, of: TestObject.self))
+        var misuseErrorCount = 0
+        database.traceError { error in
+            if error.code == .Misuse {
+                misuseErrorCount += 1
+            }
+        }
+        let handle = WCDBAssertNoThrowReturned(try database.getHandle())!
+        XCTAssertNoThrow(try handle.prepare(StatementInsert().insert(intoTable: TestObject.name).values(BindParameter.bindParameters(2))))
+
+        var types = [WCDBColumnValueTypeInterger, WCDBColumnValueTypeString]
+        var values = [CPPBatchValue(intValue: 1), CPPBatchValue()]
+        var buffer = Array("text".utf8)
+        func bind() -> Bool {
+            return types.withUnsafeMutableBufferPointer { typesPointer in
+                values.withUnsafeMutableBufferPointer { valuesPointer in
+                    buffer.withUnsafeMutableBufferPointer { bufferPointer -> Bool in
+                        let batch = CPPHandleStatementBatch(columnCount: 2,
+                                                            rowCapacity: 1,
+                                                            types: typesPointer.baseAddress!,
+                                                            values: valuesPointer.baseAddress!,
+                                                            buffer: bufferPointer.baseAddress,
+                                                            bufferCapacity: UInt32(bufferPointer.count),
+                                                            rowCount: 1,
+                                                            bufferUsed: UInt32(bufferPointer.count),
+                                                            hasPendingRow: false,
+                                                            requiredBufferSize: 0)
+                        return withUnsafePointer(to: batch) {
+                            WCDBHandleStatementBindBatchRow(handle.getRawStatement(), $0, 0)
+                        }
+                    }
+                }
+            }
+        }
+
+        // The text ends beyond the buffer.
+        values[1].bytes.offset = 2
+        values[1].bytes.length = UInt32(buffer.count)
+        XCTAssertFalse(bind())
+        XCTAssertEqual(misuseErrorCount, 1)
+
+        // The type is out of range.
+        values[1].bytes.offset = 0
+        types[1] = WCDBColumnValueType(rawValue: 100)
+        XCTAssertFalse(bind())
+        XCTAssertEqual(misuseErrorCount, 2)
+
+        types[1] = WCDBColumnValueTypeString
+        XCTAssertTrue(bind())
+        XCTAssertNoThrow(try handle.step())
+        handle.finalize()
+        database.traceError(nil)
+
+        let objects: [TestObject] = WCDBAssertNoThrowReturned(
+            try database.getObjects(fromTable: TestObject.name),
+            whenFailed: [TestObject]()
+        )
+        XCTAssertEqual(objects.map { $0.variable2 }, ["text"])
+    }
+
     func testWriteWithHandleCountLimit() {
         var maxHandleCount = 0
         Database.globalTraceDatabaseOperation {
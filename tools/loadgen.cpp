@@ -0,0 +1,825 @@
+/*
+ * Tencent is pleased to support the open source community by making
+ * WCDB available.
+ *
+ * Copyright (C) 2017 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the BSD 3-Clause License (the "License"); you may not use
+ * this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ *       https://opensource.org/licenses/BSD-3-Clause
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * A multi-threaded workload generator built on the WCDB C++ interface.
+ * It mixes ORM reads, batched writes and FTS5 searches on one database,
+ * with the background features of WCDB toggled on demand, and emits the
+ * latency histograms, throughput, WAL size and busy-wait time as JSON.
+ *
+ * Build it against the WCDB library, e.g.
+ *   c++ -std=c++14 -O2 loadgen.cpp -lWCDB -lpthread -o wcdb-loadgen
+ */
+
+#include <WCDB/WCDBCpp.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+#pragma mark - Objects
+
+class LoadObject {
+public:
+    int64_t identifier = 0;
+    int64_t category = 0;
+    std::string content;
+    WCDB_CPP_ORM_DECLARATION(LoadObject)
+};
+
+WCDB_CPP_ORM_IMPLEMENTATION_BEGIN(LoadObject)
+WCDB_CPP_SYNTHESIZE(identifier)
+WCDB_CPP_SYNTHESIZE(category)
+WCDB_CPP_SYNTHESIZE(content)
+WCDB_CPP_PRIMARY(identifier)
+WCDB_CPP_INDEX("_category_index", category)
+WCDB_CPP_ORM_IMPLEMENTATION_END
+
+class LoadFTSObject {
+public:
+    std::string content;
+    WCDB_CPP_ORM_DECLARATION(LoadFTSObject)
+};
+
+WCDB_CPP_ORM_IMPLEMENTATION_BEGIN(LoadFTSObject)
+WCDB_CPP_SYNTHESIZE(content)
+WCDB_CPP_VIRTUAL_TABLE_MODULE(WCDB::Module::FTS5)
+WCDB_CPP_VIRTUAL_TABLE_TOKENIZE(WCDB::BuiltinTokenizer::Verbatim)
+WCDB_CPP_ORM_IMPLEMENTATION_END
+
+static const char *g_table = "loadgen";
+static const char *g_fts_table = "loadgen_fts";
+
+#pragma mark - Histogram
+
+/*
+ * Log-linear histogram of nanoseconds. Values below 128 are exact and
+ * larger ones are kept with 64 sub-buckets per power of two, so that
+ * every percentile is reported within 1.6% of the recorded value.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() : m_buckets(NumberOfBuckets, 0) {}
+
+    void record(uint64_t value)
+    {
+        ++m_buckets[indexOf(value)];
+        ++m_count;
+        m_sum += value;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    void merge(const LatencyHistogram &other)
+    {
+        for (size_t i = 0; i < NumberOfBuckets; ++i) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    uint64_t getCount() const { return m_count; }
+    uint64_t getSum() const { return m_sum; }
+
+    uint64_t getPercentile(double percentile) const
+    {
+        if (m_count == 0) {
+            return 0;
+        }
+        uint64_t rank = (uint64_t) (percentile / 100.0 * m_count + 0.5);
+        rank = std::max<uint64_t>(1, std::min(rank, m_count));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < NumberOfBuckets; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                return std::min(upperBoundOf(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+    void print(FILE *file, const char *indent) const
+    {
+        fprintf(file, "{\n");
+        fprintf(file, "%s  \"count\": %llu,\n", indent, (unsigned long long) m_count);
+        fprintf(file, "%s  \"min_us\": %.3f,\n", indent, m_count > 0 ? m_min / 1000.0 : 0);
+        fprintf(file, "%s  \"mean_us\": %.3f,\n", indent, m_count > 0 ? (double) m_sum / m_count / 1000.0 : 0);
+        fprintf(file, "%s  \"p50_us\": %.3f,\n", indent, getPercentile(50) / 1000.0);
+        fprintf(file, "%s  \"p90_us\": %.3f,\n", indent, getPercentile(90) / 1000.0);
+        fprintf(file, "%s  \"p99_us\": %.3f,\n", indent, getPercentile(99) / 1000.0);
+        fprintf(file, "%s  \"p999_us\": %.3f,\n", indent, getPercentile(99.9) / 1000.0);
+        fprintf(file, "%s  \"max_us\": %.3f,\n", indent, m_max / 1000.0);
+        // [upper bound in microseconds, count] of all non-empty buckets
+        fprintf(file, "%s  \"histogram\": [", indent);
+        bool first = true;
+        for (size_t i = 0; i < NumberOfBuckets; ++i) {
+            if (m_buckets[i] > 0) {
+                fprintf(file, "%s[%.3f, %llu]", first ? "" : ", ", upperBoundOf(i) / 1000.0, (unsigned long long) m_buckets[i]);
+                first = false;
+            }
+        }
+        fprintf(file, "]\n%s}", indent);
+    }
+
+private:
+    static constexpr int SubBucketBits = 7;
+    static constexpr uint64_t SubBucketCount = 1 << SubBucketBits;
+    static constexpr uint64_t HalfSubBucketCount = SubBucketCount / 2;
+    static constexpr size_t NumberOfBuckets
+    = SubBucketCount + (64 - SubBucketBits) * HalfSubBucketCount;
+
+    static size_t indexOf(uint64_t value)
+    {
+        if (value < SubBucketCount) {
+            return (size_t) value;
+        }
+        int shift = 63 - __builtin_clzll(value) - (SubBucketBits - 1);
+        return (size_t) (SubBucketCount + (shift - 1) * HalfSubBucketCount
+                         + ((value >> shift) - HalfSubBucketCount));
+    }
+
+    static uint64_t upperBoundOf(size_t index)
+    {
+        if (index < SubBucketCount) {
+            return index;
+        }
+        size_t offset = index - SubBucketCount;
+        int shift = (int) (offset / HalfSubBucketCount) + 1;
+        uint64_t subBucket = offset % HalfSubBucketCount + HalfSubBucketCount;
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_min = UINT64_MAX;
+    uint64_t m_max = 0;
+};
+
+#pragma mark - Options
+
+static struct {
+    const char *path = NULL;
+    double duration = 10;
+    int threads = 4;
+    int read_ratio = 80;
+    int update_ratio = 20;
+    int fts_threads = 0;
+    int object_size = 256;
+    int batch = 10;
+    int read_limit = 10;
+    int preload = 10000;
+    unsigned int seed = 0;
+    double busy_timeout = 0.05;
+    bool fts = false;
+    bool auto_checkpoint = true;
+    bool auto_backup = false;
+    bool auto_migration = false;
+    bool auto_compression = false;
+    bool auto_merge_fts = false;
+    int auto_vacuum = 0; // 0: off, 1: full, 2: incremental
+    bool keep = false;
+    bool verbose = false;
+    const char *output = NULL;
+} g_options;
+
+static const struct option g_long_options[] = {
+    { "help", no_argument, NULL, 'h' },
+    { "verbose", no_argument, NULL, 'v' },
+    { "output", required_argument, NULL, 'o' },
+    { "duration", required_argument, NULL, 'd' },
+    { "threads", required_argument, NULL, 't' },
+    { "read-ratio", required_argument, NULL, 'r' },
+    { "update-ratio", required_argument, NULL, 'u' },
+    { "fts-threads", required_argument, NULL, 'f' },
+    { "object-size", required_argument, NULL, 's' },
+    { "batch", required_argument, NULL, 'b' },
+    { "read-limit", required_argument, NULL, 'l' },
+    { "preload", required_argument, NULL, 'p' },
+    { "seed", required_argument, NULL, 0x100 },
+    { "busy-timeout", required_argument, NULL, 0x101 },
+    { "fts", no_argument, NULL, 0x102 },
+    { "auto-checkpoint", required_argument, NULL, 0x103 },
+    { "auto-backup", no_argument, NULL, 0x104 },
+    { "auto-migration", no_argument, NULL, 0x105 },
+    { "auto-compression", no_argument, NULL, 0x106 },
+    { "auto-merge-fts", no_argument, NULL, 0x107 },
+    { "auto-vacuum", optional_argument, NULL, 0x108 },
+    { "keep", no_argument, NULL, 0x109 },
+    { NULL, 0, NULL, 0 },
+};
+
+static void usage(const char *argv0)
+{
+    printf("USAGE:\n"
+           "  %s [OPTIONS] <db_path>\n",
+           argv0);
+    puts("\n"
+         "WORKLOAD OPTIONS:\n"
+         "  -d, --duration=<seconds>   Run the workload for <seconds>. [10]\n"
+         "  -t, --threads=<count>      Number of threads mixing reads and writes. [4]\n"
+         "  -r, --read-ratio=<0-100>   Percentage of reads in the operations of each thread. [80]\n"
+         "  -u, --update-ratio=<0-100> Percentage of rows in a write that replace existing rows. [20]\n"
+         "  -f, --fts-threads=<count>  Number of threads running FTS5 queries. Implies --fts. [0]\n"
+         "  -s, --object-size=<bytes>  Size of the text content of each row. [256]\n"
+         "  -b, --batch=<count>        Number of rows written in each transaction. [10]\n"
+         "  -l, --read-limit=<count>   Max number of rows fetched by each read or query. [10]\n"
+         "  -p, --preload=<count>      Number of rows inserted before the workload starts. [10000]\n"
+         "      --seed=<seed>          Seed of the random generators. [0]\n"
+         "      --fts                  Also write the content into an FTS5 table.\n"
+         "      --keep                 Run on the existing database instead of removing it first.\n"
+         "\n"
+         "BACKGROUND OPTIONS:\n"
+         "      --auto-checkpoint=<0|1>    Enable auto-checkpoint. [1]\n"
+         "      --auto-backup              Enable auto-backup.\n"
+         "      --auto-migration           Preload rows into a separate database and migrate them\n"
+         "                                 into <db_path> while the workload is running.\n"
+         "      --auto-compression         Compress the content with zstd in background.\n"
+         "      --auto-merge-fts           Enable auto-merge of the FTS5 index.\n"
+         "      --auto-vacuum[=incremental]\n"
+         "                                 Enable auto-vacuum, or incremental auto-vacuum.\n"
+         "\n"
+         "OUTPUT OPTIONS:\n"
+         "  -o, --output=<path>        Write the JSON report to <path> instead of stdout.\n"
+         "      --busy-timeout=<sec>   Count the operations blocked longer than <sec>. [0.05]\n"
+         "  -v, --verbose              Print the errors reported by WCDB to stderr.\n"
+         "  -h, --help                 Show this help message and exit.\n"
+         "\n"
+         "The busy-wait time is measured as the time a write waits from calling\n"
+         "runTransaction() until its transaction is begun.\n");
+    exit(1);
+}
+
+static int parse_int(const char *argv0, const char *value, int min, int max)
+{
+    char *end = NULL;
+    long result = strtol(value, &end, 10);
+    if (end == value || *end != '\0' || result < min || result > max) {
+        fprintf(stderr, "Invalid value: %s\n", value);
+        usage(argv0);
+    }
+    return (int) result;
+}
+
+static double parse_double(const char *argv0, const char *value)
+{
+    char *end = NULL;
+    double result = strtod(value, &end);
+    if (end == value || *end != '\0' || result < 0) {
+        fprintf(stderr, "Invalid value: %s\n", value);
+        usage(argv0);
+    }
+    return result;
+}
+
+static void parse_options(int argc, char *argv[])
+{
+    int opt;
+    if (argc < 2) usage(argv[0]);
+
+    optind = 1;
+    while ((opt = getopt_long(argc, argv, "hvo:d:t:r:u:f:s:b:l:p:", g_long_options, NULL))
+           != -1) {
+        switch (opt) {
+        case 'h':
+            usage(argv[0]);
+            break;
+        case 'v':
+            g_options.verbose = true;
+            break;
+        case 'o':
+            g_options.output = optarg;
+            break;
+        case 'd':
+            g_options.duration = parse_double(argv[0], optarg);
+            break;
+        case 't':
+            g_options.threads = parse_int(argv[0], optarg, 0, 1024);
+            break;
+        case 'r':
+            g_options.read_ratio = parse_int(argv[0], optarg, 0, 100);
+            break;
+        case 'u':
+            g_options.update_ratio = parse_int(argv[0], optarg, 0, 100);
+            break;
+        case 'f':
+            g_options.fts_threads = parse_int(argv[0], optarg, 0, 1024);
+            break;
+        case 's':
+            g_options.object_size = parse_int(argv[0], optarg, 1, 64 * 1024 * 1024);
+            break;
+        case 'b':
+            g_options.batch = parse_int(argv[0], optarg, 1, 1000000);
+            break;
+        case 'l':
+            g_options.read_limit = parse_int(argv[0], optarg, 1, 1000000);
+            break;
+        case 'p':
+            g_options.preload = parse_int(argv[0], optarg, 0, INT32_MAX);
+            break;
+        case 0x100:
+            g_options.seed = (unsigned int) strtoul(optarg, NULL, 10);
+            break;
+        case 0x101:
+            g_options.busy_timeout = parse_double(argv[0], optarg);
+            break;
+        case 0x102:
+            g_options.fts = true;
+            break;
+        case 0x103:
+            g_options.auto_checkpoint = parse_int(argv[0], optarg, 0, 1) != 0;
+            break;
+        case 0x104:
+            g_options.auto_backup = true;
+            break;
+        case 0x105:
+            g_options.auto_migration = true;
+            break;
+        case 0x106:
+            g_options.auto_compression = true;
+            break;
+        case 0x107:
+            g_options.auto_merge_fts = true;
+            break;
+        case 0x108:
+            if (optarg == NULL) {
+                g_options.auto_vacuum = 1;
+            } else if (strcmp(optarg, "incremental") == 0) {
+                g_options.auto_vacuum = 2;
+            } else {
+                usage(argv[0]);
+            }
+            break;
+        case 0x109:
+            g_options.keep = true;
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1) usage(argv[0]);
+    g_options.path = argv[optind];
+    if (g_options.fts_threads > 0 || g_options.auto_merge_fts) {
+        g_options.fts = true;
+    }
+}
+
+#pragma mark - Workload
+
+typedef std::chrono::steady_clock Clock;
+
+static uint64_t nanoseconds_between(Clock::time_point begin, Clock::time_point end)
+{
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+}
+
+struct WorkerStatistics {
+    LatencyHistogram read;
+    LatencyHistogram write;
+    LatencyHistogram search;
+    LatencyHistogram busy_wait;
+    uint64_t read_rows = 0;
+    uint64_t written_rows = 0;
+    uint64_t searched_rows = 0;
+    uint64_t read_errors = 0;
+    uint64_t write_errors = 0;
+    uint64_t search_errors = 0;
+
+    void merge(const WorkerStatistics &other)
+    {
+        read.merge(other.read);
+        write.merge(other.write);
+        search.merge(other.search);
+        busy_wait.merge(other.busy_wait);
+        read_rows += other.read_rows;
+        written_rows += other.written_rows;
+        searched_rows += other.searched_rows;
+        read_errors += other.read_errors;
+        write_errors += other.write_errors;
+        search_errors += other.search_errors;
+    }
+};
+
+static std::atomic<bool> g_stop(false);
+static std::atomic<int64_t> g_max_identifier(0);
+static std::atomic<uint64_t> g_busy_events(0);
+static std::atomic<uint64_t> g_errors(0);
+static std::vector<std::string> g_vocabulary;
+
+static void generate_vocabulary()
+{
+    std::mt19937_64 random(g_options.seed);
+    g_vocabulary.reserve(4096);
+    for (int i = 0; i < 4096; ++i) {
+        std::string word(3 + random() % 6, 'a');
+        for (auto &c : word) {
+            c = (char) ('a' + random() % 26);
+        }
+        g_vocabulary.push_back(std::move(word));
+    }
+}
+
+static std::string generate_content(std::mt19937_64 &random)
+{
+    std::string content;
+    content.reserve(g_options.object_size + 8);
+    while (content.size() < (size_t) g_options.object_size) {
+        if (!content.empty()) {
+            content.push_back(' ');
+        }
+        content.append(g_vocabulary[random() % g_vocabulary.size()]);
+    }
+    content.resize(g_options.object_size);
+    return content;
+}
+
+static LoadObject generate_object(std::mt19937_64 &random, int64_t identifier)
+{
+    LoadObject object;
+    object.identifier = identifier;
+    object.category = (int64_t) (random() % 128);
+    object.content = generate_content(random);
+    return object;
+}
+
+static bool write_rows(std::mt19937_64 &random, WCDB::Handle &handle, WorkerStatistics &statistics)
+{
+    WCDB::ValueArray<LoadObject> insertions;
+    WCDB::ValueArray<LoadObject> replacements;
+    WCDB::ValueArray<LoadFTSObject> searchables;
+    for (int i = 0; i < g_options.batch; ++i) {
+        int64_t max = g_max_identifier.load(std::memory_order_relaxed);
+        if (max > 0 && (int) (random() % 100) < g_options.update_ratio) {
+            replacements.push_back(generate_object(random, 1 + (int64_t) (random() % max)));
+        } else {
+            insertions.push_back(generate_object(random, ++g_max_identifier));
+            if (g_options.fts) {
+                LoadFTSObject searchable;
+                searchable.content = insertions.back().content;
+                searchables.push_back(std::move(searchable));
+            }
+        }
+    }
+    if (!insertions.empty() && !handle.insertObjects(insertions, g_table)) {
+        return false;
+    }
+    if (!replacements.empty() && !handle.insertOrReplaceObjects(replacements, g_table)) {
+        return false;
+    }
+    if (!searchables.empty() && !handle.insertObjects(searchables, g_fts_table)) {
+        return false;
+    }
+    statistics.written_rows += g_options.batch;
+    return true;
+}
+
+static void run_write(WCDB::Database &database, std::mt19937_64 &random, WorkerStatistics &statistics)
+{
+    Clock::time_point begin = Clock::now();
+    bool begun = false;
+    bool succeed = database.runTransaction([&](WCDB::Handle &handle) {
+        if (!begun) {
+            begun = true;
+            statistics.busy_wait.record(nanoseconds_between(begin, Clock::now()));
+        }
+        return write_rows(random, handle, statistics);
+    });
+    statistics.write.record(nanoseconds_between(begin, Clock::now()));
+    if (!succeed) {
+        ++statistics.write_errors;
+    }
+}
+
+static void run_read(WCDB::Database &database, std::mt19937_64 &random, WorkerStatistics &statistics)
+{
+    int64_t max = std::max<int64_t>(1, g_max_identifier.load(std::memory_order_relaxed));
+    int64_t from = 1 + (int64_t) (random() % max);
+    Clock::time_point begin = Clock::now();
+    auto objects = database.getAllObjects<LoadObject>(
+    g_table,
+    WCDB_FIELD(LoadObject::identifier).between(from, from + g_options.read_limit - 1));
+    statistics.read.record(nanoseconds_between(begin, Clock::now()));
+    if (objects.succeed()) {
+        statistics.read_rows += objects.value().size();
+    } else {
+        ++statistics.read_errors;
+    }
+}
+
+static void run_search(WCDB::Database &database, std::mt19937_64 &random, WorkerStatistics &statistics)
+{
+    const std::string &word = g_vocabulary[random() % g_vocabulary.size()];
+    Clock::time_point begin = Clock::now();
+    auto objects = database.getAllObjects<LoadFTSObject>(
+    g_fts_table,
+    WCDB_FIELD(LoadFTSObject::content).match(word),
+    WCDB::OrderingTerms(),
+    g_options.read_limit);
+    statistics.search.record(nanoseconds_between(begin, Clock::now()));
+    if (objects.succeed()) {
+        statistics.searched_rows += objects.value().size();
+    } else {
+        ++statistics.search_errors;
+    }
+}
+
+static void run_worker(WCDB::Database &database, unsigned int index, bool searcher, WorkerStatistics &statistics)
+{
+    std::mt19937_64 random(g_options.seed + index + 1);
+    while (!g_stop.load(std::memory_order_relaxed)) {
+        if (searcher) {
+            run_search(database, random, statistics);
+        } else if ((int) (random() % 100) < g_options.read_ratio) {
+            run_read(database, random, statistics);
+        } else {
+            run_write(database, random, statistics);
+        }
+    }
+}
+
+#pragma mark - Setup
+
+static const char *g_source_suffix = "-source";
+
+static bool preload(WCDB::Database &database)
+{
+    std::mt19937_64 random(g_options.seed);
+    if (!database.createTable<LoadObject>(g_table)) {
+        return false;
+    }
+    if (g_options.fts && !database.createVirtualTable<LoadFTSObject>(g_fts_table)) {
+        return false;
+    }
+    int64_t identifier = 0;
+    while (identifier < g_options.preload) {
+        bool succeed = database.runTransaction([&](WCDB::Handle &handle) {
+            WCDB::ValueArray<LoadObject> objects;
+            WCDB::ValueArray<LoadFTSObject> searchables;
+            for (int i = 0; i < 1000 && identifier < g_options.preload; ++i) {
+                objects.push_back(generate_object(random, ++identifier));
+                if (g_options.fts) {
+                    LoadFTSObject searchable;
+                    searchable.content = objects.back().content;
+                    searchables.push_back(std::move(searchable));
+                }
+            }
+            return handle.insertObjects(objects, g_table)
+                   && (searchables.empty() || handle.insertObjects(searchables, g_fts_table));
+        });
+        if (!succeed) {
+            return false;
+        }
+    }
+    g_max_identifier.store(identifier);
+    return true;
+}
+
+static bool setup(WCDB::Database &database)
+{
+    std::string sourcePath = std::string(g_options.path) + g_source_suffix;
+    if (!g_options.keep) {
+        WCDB::Database source(sourcePath);
+        if (!database.removeFiles() || !source.removeFiles()) {
+            return false;
+        }
+    }
+
+    if (g_options.fts) {
+        database.addTokenizer(WCDB::BuiltinTokenizer::Verbatim);
+    }
+    if (g_options.auto_migration) {
+        // The rows to migrate are preloaded into the source database,
+        // since the migration must be configured before the target one is used.
+        WCDB::Database source(sourcePath);
+        if (g_options.fts) {
+            source.addTokenizer(WCDB::BuiltinTokenizer::Verbatim);
+        }
+        if (!preload(source)) {
+            return false;
+        }
+        source.close();
+        database.addMigration(sourcePath, WCDB::UnsafeData(), [](WCDB::Database::MigrationInfo &info) {
+            if (info.table.equal(g_table)) {
+                info.sourceTable = g_table;
+            }
+        });
+    }
+    if (g_options.auto_compression) {
+        database.setCompression([](WCDB::Database::CompressionInfo &info) {
+            if (info.getTableName().equal(g_table)) {
+                info.addZSTDNormalCompressField(WCDB_FIELD(LoadObject::content));
+            }
+        });
+    }
+    if (g_options.auto_vacuum > 0) {
+        database.enableAutoVacuum(g_options.auto_vacuum == 2);
+    }
+
+    if (g_options.auto_migration) {
+        if (!database.createTable<LoadObject>(g_table)) {
+            return false;
+        }
+        if (g_options.fts && !database.createVirtualTable<LoadFTSObject>(g_fts_table)) {
+            return false;
+        }
+    } else if (!preload(database)) {
+        return false;
+    }
+    if (g_options.keep) {
+        auto max = database.getValueFromStatement(
+        WCDB::StatementSelect()
+        .select(WCDB_FIELD(LoadObject::identifier).max())
+        .from(g_table));
+        if (max.succeed()) {
+            g_max_identifier.store(max.value().intValue());
+        }
+    }
+
+    database.enableAutoCheckpoint(g_options.auto_checkpoint);
+    database.enableAutoBackup(g_options.auto_backup);
+    database.enableAutoMigration(g_options.auto_migration);
+    database.enableAutoCompression(g_options.auto_compression);
+    if (g_options.fts) {
+        database.enableAutoMergeFTS5Index(g_options.auto_merge_fts);
+    }
+    return true;
+}
+
+static uint64_t file_size(const std::string &path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    return (uint64_t) st.st_size;
+}
+
+#pragma mark - Report
+
+static void print_operation(FILE *file,
+                            const char *name,
+                            const LatencyHistogram &latency,
+                            uint64_t rows,
+                            uint64_t errors,
+                            double elapsed,
+                            bool last)
+{
+    fprintf(file, "    \"%s\": {\n", name);
+    fprintf(file, "      \"throughput_per_second\": %.3f,\n", elapsed > 0 ? latency.getCount() / elapsed : 0);
+    fprintf(file, "      \"rows\": %llu,\n", (unsigned long long) rows);
+    fprintf(file, "      \"errors\": %llu,\n", (unsigned long long) errors);
+    fprintf(file, "      \"latency\": ");
+    latency.print(file, "      ");
+    fprintf(file, "\n    }%s\n", last ? "" : ",");
+}
+
+static void print_report(FILE *file,
+                         const WorkerStatistics &statistics,
+                         double elapsed,
+                         uint64_t peakWALSize,
+                         uint64_t finalWALSize,
+                         uint64_t filesSize)
+{
+    fprintf(file, "{\n");
+    fprintf(file, "  \"version\": \"%s\",\n", WCDB::Database::getVersion().data());
+    fprintf(file, "  \"config\": {\n");
+    fprintf(file, "    \"duration\": %.3f,\n", g_options.duration);
+    fprintf(file, "    \"threads\": %d,\n", g_options.threads);
+    fprintf(file, "    \"read_ratio\": %d,\n", g_options.read_ratio);
+    fprintf(file, "    \"update_ratio\": %d,\n", g_options.update_ratio);
+    fprintf(file, "    \"fts_threads\": %d,\n", g_options.fts_threads);
+    fprintf(file, "    \"object_size\": %d,\n", g_options.object_size);
+    fprintf(file, "    \"batch\": %d,\n", g_options.batch);
+    fprintf(file, "    \"read_limit\": %d,\n", g_options.read_limit);
+    fprintf(file, "    \"preload\": %d,\n", g_options.preload);
+    fprintf(file, "    \"seed\": %u,\n", g_options.seed);
+    fprintf(file, "    \"fts\": %s,\n", g_options.fts ? "true" : "false");
+    fprintf(file, "    \"auto_checkpoint\": %s,\n", g_options.auto_checkpoint ? "true" : "false");
+    fprintf(file, "    \"auto_backup\": %s,\n", g_options.auto_backup ? "true" : "false");
+    fprintf(file, "    \"auto_migration\": %s,\n", g_options.auto_migration ? "true" : "false");
+    fprintf(file, "    \"auto_compression\": %s,\n", g_options.auto_compression ? "true" : "false");
+    fprintf(file, "    \"auto_merge_fts\": %s,\n", g_options.auto_merge_fts ? "true" : "false");
+    fprintf(file, "    \"auto_vacuum\": \"%s\"\n",
+            g_options.auto_vacuum == 0 ? "off" : (g_options.auto_vacuum == 1 ? "full" : "incremental"));
+    fprintf(file, "  },\n");
+    fprintf(file, "  \"elapsed_seconds\": %.3f,\n", elapsed);
+    fprintf(file, "  \"operations\": {\n");
+    print_operation(file, "read", statistics.read, statistics.read_rows, statistics.read_errors, elapsed, false);
+    print_operation(file, "write", statistics.write, statistics.written_rows, statistics.write_errors, elapsed, false);
+    print_operation(file, "search", statistics.search, statistics.searched_rows, statistics.search_errors, elapsed, true);
+    fprintf(file, "  },\n");
+    fprintf(file, "  \"busy\": {\n");
+    fprintf(file, "    \"wait_total_us\": %.3f,\n", statistics.busy_wait.getSum() / 1000.0);
+    fprintf(file, "    \"events_over_timeout\": %llu,\n", (unsigned long long) g_busy_events.load());
+    fprintf(file, "    \"wait\": ");
+    statistics.busy_wait.print(file, "    ");
+    fprintf(file, "\n  },\n");
+    fprintf(file, "  \"wal\": {\n");
+    fprintf(file, "    \"peak_bytes\": %llu,\n", (unsigned long long) peakWALSize);
+    fprintf(file, "    \"final_bytes\": %llu\n", (unsigned long long) finalWALSize);
+    fprintf(file, "  },\n");
+    fprintf(file, "  \"files_bytes\": %llu,\n", (unsigned long long) filesSize);
+    fprintf(file, "  \"errors\": %llu\n", (unsigned long long) g_errors.load());
+    fprintf(file, "}\n");
+}
+
+#pragma mark - Main
+
+int main(int argc, char *argv[])
+{
+    parse_options(argc, argv);
+
+    WCDB::Database::globalTraceError([](const WCDB::Error &error) {
+        if (error.level < WCDB::Error::Level::Error) {
+            return;
+        }
+        ++g_errors;
+        if (g_options.verbose) {
+            fprintf(stderr, "%s\n", error.getDescription().data());
+        }
+    });
+    WCDB::Database::globalTraceBusy(
+    [](long, const WCDB::UnsafeStringView &, uint64_t, const WCDB::UnsafeStringView &) {
+        ++g_busy_events;
+    },
+    g_options.busy_timeout);
+
+    generate_vocabulary();
+    WCDB::Database database(g_options.path);
+    if (!setup(database)) {
+        fprintf(stderr, "Failed to set up the database at %s.\n", g_options.path);
+        return -1;
+    }
+
+    std::vector<WorkerStatistics> statistics(g_options.threads + g_options.fts_threads);
+    std::vector<std::thread> workers;
+    Clock::time_point begin = Clock::now();
+    for (int i = 0; i < g_options.threads + g_options.fts_threads; ++i) {
+        bool searcher = i >= g_options.threads;
+        workers.emplace_back(run_worker, std::ref(database), (unsigned int) i, searcher, std::ref(statistics[i]));
+    }
+
+    std::string walPath = std::string(g_options.path) + "-wal";
+    uint64_t peakWALSize = 0;
+    Clock::time_point end = begin + std::chrono::microseconds((int64_t) (g_options.duration * 1000000));
+    while (Clock::now() < end) {
+        peakWALSize = std::max(peakWALSize, file_size(walPath));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    g_stop.store(true);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    double elapsed = nanoseconds_between(begin, Clock::now()) / 1e9;
+    uint64_t finalWALSize = file_size(walPath);
+    peakWALSize = std::max(peakWALSize, finalWALSize);
+
+    WorkerStatistics total;
+    for (const auto &statistic : statistics) {
+        total.merge(statistic);
+    }
+    auto filesSize = database.getFilesSize();
+    database.close();
+
+    FILE *file = stdout;
+    if (g_options.output != NULL) {
+        file = fopen(g_options.output, "w");
+        if (file == NULL) {
+            fprintf(stderr, "Failed to open %s.\n", g_options.output);
+            return -1;
+        }
+    }
+    print_report(file, total, elapsed, peakWALSize, finalWALSize, filesSize.succeed() ? filesSize.value() : 0);
+    if (file != stdout) {
+        fclose(file);
+    }
+    return 0;
+}